@@ -0,0 +1,260 @@
+/**
+ * @file app_anim.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief Flashに置いたLEDアニメーション(差分 + RLE圧縮)の再生
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026 Chimipupu All Rights Reserved.
+ *
+ * エフェクトエンジン(app_fx)に"play"として登録し、アニメーションのfpsで固定周期に再生する。
+ * 描画のたびにFlash(XIP)の圧縮データを読みながら、前のフレームが残った展開バッファに上書きして
+ * 必要なフレームまで展開する(スロットを飛ばしたら間のフレームも展開、先頭に戻ったら全消灯から)。
+ * ヘッダの読み込みと展開バッファはCore0(描画側)だけが触り、Core1はs_play_seqを進めて知らせる。
+ * Flashへの書き込みはpx play demo(F/W内でデモを圧縮)か、ホストのツールで作ったファイルを
+ * picotool load -o <XIP_BASE + ANIM_FLASH_OFFSET> で書く。
+ */
+#include "app_anim.h"
+#include "app_anim_codec.h"
+#include "muc_rpxxx_util.h"
+#include "app_event.h"
+
+#define ANIM_FLASH_ADDR         (XIP_BASE + ANIM_FLASH_OFFSET)
+
+// 再生の要求(Core1が進める)
+static volatile uint32_t s_play_seq = 0;
+
+// 再生の状態(Core0)
+static uint32_t s_play_applied = 0;
+static bool s_is_valid = false;
+static anim_hdr_t s_hdr;
+static const uint8_t *s_p_data = NULL;
+static uint8_t s_frame[ANIM_LED_MAX * ANIM_BYTE_PER_LED];   // 展開バッファ(前のフレームが残る)
+static uint32_t s_pos = 0;                                  // 次のフレームの圧縮データの位置
+static uint32_t s_next = 0;                                 // 次に展開するフレーム
+
+// 展開の統計
+static uint32_t s_decode_cnt = 0;
+static uint32_t s_loop_cnt = 0;
+static uint32_t s_err_cnt = 0;
+static uint64_t s_decode_bytes = 0;
+static uint64_t s_decode_sum_cyc = 0;
+static uint32_t s_decode_max_cyc = 0;
+
+// 先頭のフレームに戻る(先頭のフレームは全消灯との差分)
+static void anim_rewind(void)
+{
+    s_pos = 0;
+    s_next = 0;
+    memset(s_frame, 0, sizeof(s_frame));
+}
+
+// Flashのヘッダを読んで再生の準備(Core0)
+static void anim_load(void)
+{
+    memcpy(&s_hdr, (const void *)ANIM_FLASH_ADDR, sizeof(s_hdr));
+    s_is_valid = anim_check_hdr(&s_hdr, ANIM_FLASH_SIZE) && (s_hdr.led_cnt <= ANIM_LED_MAX);
+    s_p_data = (const uint8_t *)(ANIM_FLASH_ADDR + sizeof(anim_hdr_t));
+    s_decode_cnt = 0;
+    s_loop_cnt = 0;
+    s_err_cnt = 0;
+    s_decode_bytes = 0;
+    s_decode_sum_cyc = 0;
+    s_decode_max_cyc = 0;
+    anim_rewind();
+}
+
+// [エフェクト] Flashのアニメーションを展開して描く
+static void anim_render_play(rgb_color_t *p_buf, uint32_t led_cnt, uint32_t frame)
+{
+    uint32_t target, t0_cyc, cyc, len, cnt;
+
+    if (s_play_applied != s_play_seq) {
+        s_play_applied = s_play_seq;
+        anim_load();
+    }
+    if (!s_is_valid) {
+        return;
+    }
+
+    // 今のフレームより前なら(ループ)先頭から展開し直す
+    target = frame % s_hdr.frame_cnt;
+    if ((s_next != 0) && (target < (s_next - 1))) {
+        anim_rewind();
+        s_loop_cnt++;
+    }
+    while (s_next <= target)
+    {
+        t0_cyc = rp2xxx_get_cycle_cnt();
+        len = anim_decode_frame(&s_p_data[s_pos], s_hdr.data_len - s_pos, s_frame, s_hdr.led_cnt);
+        cyc = rp2xxx_get_cycle_cnt() - t0_cyc;
+        if (len == 0) {
+            s_err_cnt++;
+            s_is_valid = false;
+            return;
+        }
+        s_pos += len;
+        s_next++;
+        s_decode_cnt++;
+        s_decode_bytes += len;
+        s_decode_sum_cyc += cyc;
+        s_decode_max_cyc = (cyc > s_decode_max_cyc) ? cyc : s_decode_max_cyc;
+    }
+
+    // 展開バッファ(GRB) -> エフェクトの作業バッファ(ストリップの方が長ければ残りは消灯)
+    cnt = (led_cnt < s_hdr.led_cnt) ? led_cnt : s_hdr.led_cnt;
+    for (uint32_t i = 0; i < cnt; i++)
+    {
+        const uint8_t *p_px = &s_frame[i * ANIM_BYTE_PER_LED];
+        p_buf[i].grb_color.u32_grb = ((uint32_t)p_px[0] << 16) | ((uint32_t)p_px[1] << 8) | p_px[2];
+    }
+    for (uint32_t i = cnt; i < led_cnt; i++)
+    {
+        p_buf[i].grb_color.u32_grb = 0;
+    }
+}
+
+/**
+ * @brief アニメーション再生の初期化(エフェクトエンジンに"play"を登録)
+ */
+void app_anim_init(void)
+{
+    app_fx_register("play", anim_render_play);
+}
+
+/**
+ * @brief Flashのアニメーションを再生(アニメーションのfpsでエフェクトエンジンを開始)
+ *
+ * @return true 開始した
+ * @return false アニメーションが無い or 壊れている
+ */
+bool app_anim_play(void)
+{
+    anim_hdr_t hdr;
+
+    memcpy(&hdr, (const void *)ANIM_FLASH_ADDR, sizeof(hdr));
+    if (!anim_check_hdr(&hdr, ANIM_FLASH_SIZE)) {
+        printf("Error: No animation in flash (offset:0x%08X), create one with px play demo\n", ANIM_FLASH_OFFSET);
+        return false;
+    }
+    if (hdr.led_cnt > ANIM_LED_MAX) {
+        printf("Error: Animation has %u LEDs (max %d)\n", hdr.led_cnt, ANIM_LED_MAX);
+        return false;
+    }
+
+    s_play_seq++;
+    app_fx_set_fps(hdr.fps);
+    app_fx_start("play");
+
+    return true;
+}
+
+/**
+ * @brief デモのアニメーションを圧縮してFlashに保存
+ *
+ * @param led_cnt LEDの数(1～ANIM_LED_MAX)
+ * @param frame_cnt フレーム数
+ * @param fps フレームレート
+ * @return true 保存した
+ * @note Flash書き込み中はCore0をRAM上で待たせるので、Core0(ジョブ)からは保存できない
+ */
+bool app_anim_demo_save(uint32_t led_cnt, uint32_t frame_cnt, uint32_t fps)
+{
+    static uint8_t s_enc_frame[2][ANIM_LED_MAX * ANIM_BYTE_PER_LED];
+    anim_hdr_t hdr;
+    uint8_t *p_img;
+    uint32_t img_size, len = sizeof(anim_hdr_t), raw_len, t0_us, enc_us;
+    uint8_t cur = 0;
+
+    if ((led_cnt == 0) || (led_cnt > ANIM_LED_MAX) || (frame_cnt == 0)) {
+        printf("Error: Demo must be 1-%d LEDs and 1 or more frames\n", ANIM_LED_MAX);
+        return false;
+    }
+    if (get_core_num() == EVENT_CORE_NUM) {
+        printf("Error: Cannot write flash from Core %d, run px play demo without bg\n", EVENT_CORE_NUM);
+        return false;
+    }
+    img_size = sizeof(anim_hdr_t) + (frame_cnt * ANIM_FRAME_BOUND(led_cnt));
+    img_size = (img_size < ANIM_FLASH_SIZE) ? img_size : ANIM_FLASH_SIZE;
+    img_size = ((img_size + FLASH_PAGE_SIZE - 1) / FLASH_PAGE_SIZE) * FLASH_PAGE_SIZE;
+    p_img = malloc(img_size);
+    if (p_img == NULL) {
+        printf("Error: Failed to allocate %u bytes for the encoder\n", img_size);
+        return false;
+    }
+    memset(p_img, 0xFF, img_size);
+
+    // 1フレームずつ前のフレームとの差分を圧縮
+    t0_us = time_us_32();
+    memset(s_enc_frame[1], 0, sizeof(s_enc_frame[1]));
+    for (uint32_t f = 0; f < frame_cnt; f++)
+    {
+        if ((len + ANIM_FRAME_BOUND(led_cnt)) > img_size) {
+            printf("Error: Animation does not fit in %u bytes (frame %u)\n", img_size, f);
+            free(p_img);
+            return false;
+        }
+        anim_render_demo(s_enc_frame[cur], led_cnt, f);
+        len += anim_encode_frame(s_enc_frame[cur], s_enc_frame[cur ^ 1u], led_cnt, &p_img[len]);
+        cur ^= 1u;
+    }
+    enc_us = time_us_32() - t0_us;
+
+    hdr.magic = ANIM_MAGIC;
+    hdr.led_cnt = (uint16_t)led_cnt;
+    hdr.fps = (uint16_t)fps;
+    hdr.frame_cnt = frame_cnt;
+    hdr.data_len = len - sizeof(anim_hdr_t);
+    memcpy(p_img, &hdr, sizeof(hdr));
+
+    // 再生中なら止めてから書く(書き込み中はCore0がRAM上で待つので展開とは重ならない)
+    app_fx_stop();
+    s_play_seq++;
+    if (!rp2xxx_flash_write(ANIM_FLASH_OFFSET, p_img, len)) {
+        printf("Error: Failed to write animation to flash\n");
+        free(p_img);
+        return false;
+    }
+    free(p_img);
+
+    raw_len = frame_cnt * led_cnt * ANIM_BYTE_PER_LED;
+    printf("Animation saved to flash (offset:0x%08X): %u LEDs x %u frames @ %u fps\n",
+            ANIM_FLASH_OFFSET, led_cnt, frame_cnt, fps);
+    // px play statと同じくヘッダを除いたデータ長で表示
+    printf("Data: %u B (raw %u B, ratio %u.%02ux), encode %u us\n", hdr.data_len, raw_len,
+            raw_len / hdr.data_len, ((raw_len % hdr.data_len) * 100u) / hdr.data_len, enc_us);
+
+    return true;
+}
+
+/**
+ * @brief アニメーションと展開の統計を表示
+ */
+void app_anim_show_stat(void)
+{
+    uint32_t cyc_per_us = clock_get_hz(clk_sys) / 1000000;
+    anim_hdr_t hdr;
+    uint32_t raw_len, cnt = s_decode_cnt;
+    uint64_t decode_us;
+
+    memcpy(&hdr, (const void *)ANIM_FLASH_ADDR, sizeof(hdr));
+    printf("\n[Anim] flash offset:0x%08X (%u KB)\n", ANIM_FLASH_OFFSET, ANIM_FLASH_SIZE / 1024);
+    if (!anim_check_hdr(&hdr, ANIM_FLASH_SIZE)) {
+        printf("No animation\n");
+        return;
+    }
+    raw_len = hdr.frame_cnt * hdr.led_cnt * ANIM_BYTE_PER_LED;
+    printf("Clip     : %u LEDs x %u frames @ %u fps (%u ms)\n", hdr.led_cnt, hdr.frame_cnt, hdr.fps,
+            (hdr.frame_cnt * 1000u) / hdr.fps);
+    printf("Data     : %u B (raw %u B, ratio %u.%02ux, avg %u B/frame)\n", hdr.data_len, raw_len,
+            raw_len / hdr.data_len, ((raw_len % hdr.data_len) * 100u) / hdr.data_len, hdr.data_len / hdr.frame_cnt);
+    printf("Decode   : %u frames, %u loops, %u errors\n", cnt, s_loop_cnt, s_err_cnt);
+    if (cnt == 0) {
+        return;
+    }
+    decode_us = s_decode_sum_cyc / cyc_per_us;
+    printf("CPU      : avg %u cyc/frame (max %u), %u cyc/LED, %u KB/s compressed\n",
+            (uint32_t)(s_decode_sum_cyc / cnt), s_decode_max_cyc,
+            (uint32_t)(s_decode_sum_cyc / cnt / hdr.led_cnt),
+            (decode_us != 0) ? (uint32_t)((s_decode_bytes * 1000u) / decode_us) : 0);
+}
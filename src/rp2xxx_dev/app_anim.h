@@ -0,0 +1,35 @@
+/**
+ * @file app_anim.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief Flashに置いたLEDアニメーション(差分 + RLE圧縮)の再生のヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026 Chimipupu All Rights Reserved.
+ *
+ */
+#ifndef APP_ANIM_H
+#define APP_ANIM_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "pico/stdlib.h"
+#include "hardware/flash.h"
+#include "app_fx.h"
+
+#define ANIM_FLASH_SIZE         (256 * 1024)    // アニメーションの格納領域(Byte)
+#define ANIM_FLASH_OFFSET       (PICO_FLASH_SIZE_BYTES - FLASH_SECTOR_SIZE - ANIM_FLASH_SIZE) // 保存先(スクリプトの保存セクタの手前)
+#define ANIM_LED_MAX            FX_LED_MAX      // 再生できるアニメーションの最大LED数
+#define ANIM_DEMO_FRAMES        288             // デモの既定のフレーム数
+#define ANIM_DEMO_FPS           60              // デモのフレームレート
+
+// 関数プロトタイプ
+void app_anim_init(void);
+bool app_anim_play(void);
+bool app_anim_demo_save(uint32_t led_cnt, uint32_t frame_cnt, uint32_t fps);
+void app_anim_show_stat(void);
+
+#endif // APP_ANIM_H
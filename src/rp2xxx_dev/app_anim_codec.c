@@ -0,0 +1,175 @@
+/**
+ * @file app_anim_codec.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief LEDアニメーションの圧縮形式(差分 + RLE)のエンコード/デコード ※F/Wとホストのエンコーダで共用
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026 Chimipupu All Rights Reserved.
+ *
+ * Pico SDKに依存しない(ホストのツールでもそのままビルドする)。
+ * エンコードは貪欲法 ... 前と同じ並び -> SKIP、同じ色が2個以上 -> RUN、それ以外はLIT
+ * (LITは前と同じLEDか同じ色の並びが始まったところで切る)。
+ */
+#include "app_anim_codec.h"
+
+#define ANIM_DEMO_SCENE_FRAMES  96          // デモの背景の色を変える間隔(フレーム)
+#define ANIM_DEMO_TAIL          6           // デモの光の尾の長さ
+
+static inline bool anim_px_eq(const uint8_t *p_a, const uint8_t *p_b)
+{
+    return (p_a[0] == p_b[0]) && (p_a[1] == p_b[1]) && (p_a[2] == p_b[2]);
+}
+
+/**
+ * @brief 1フレームの圧縮
+ *
+ * @param p_cur このフレーム(GRB x led_cnt)
+ * @param p_prev 前のフレーム(先頭のフレームは全消灯を渡す)
+ * @param led_cnt LEDの数
+ * @param p_dst 出力先(ANIM_FRAME_BOUND(led_cnt)バイト以上)
+ * @return uint32_t 出力したバイト数
+ */
+uint32_t anim_encode_frame(const uint8_t *p_cur, const uint8_t *p_prev, uint32_t led_cnt, uint8_t *p_dst)
+{
+    uint32_t i = 0, n, len = 0;
+
+    while (i < led_cnt)
+    {
+        const uint8_t *p_px = &p_cur[i * ANIM_BYTE_PER_LED];
+
+        // 前のフレームと同じ
+        n = 0;
+        while (((i + n) < led_cnt) && (n < ANIM_SKIP_MAX) &&
+               anim_px_eq(&p_cur[(i + n) * ANIM_BYTE_PER_LED], &p_prev[(i + n) * ANIM_BYTE_PER_LED]))
+        {
+            n++;
+        }
+        if (n != 0) {
+            p_dst[len++] = (uint8_t)(ANIM_OP_SKIP | (n - 1));
+            i += n;
+            continue;
+        }
+
+        // 同じ色が2個以上
+        n = 1;
+        while (((i + n) < led_cnt) && (n < ANIM_RUN_MAX) && anim_px_eq(&p_cur[(i + n) * ANIM_BYTE_PER_LED], p_px))
+        {
+            n++;
+        }
+        if (n >= 2) {
+            p_dst[len++] = (uint8_t)(ANIM_OP_RUN | (n - 1));
+            memcpy(&p_dst[len], p_px, ANIM_BYTE_PER_LED);
+            len += ANIM_BYTE_PER_LED;
+            i += n;
+            continue;
+        }
+
+        // そのまま(前と同じLEDか、同じ色の並びが始まるところまで)
+        n = 1;
+        while (((i + n) < led_cnt) && (n < ANIM_LIT_MAX) &&
+               !anim_px_eq(&p_cur[(i + n) * ANIM_BYTE_PER_LED], &p_prev[(i + n) * ANIM_BYTE_PER_LED]) &&
+               !(((i + n + 1) < led_cnt) &&
+                 anim_px_eq(&p_cur[(i + n) * ANIM_BYTE_PER_LED], &p_cur[(i + n + 1) * ANIM_BYTE_PER_LED])))
+        {
+            n++;
+        }
+        p_dst[len++] = (uint8_t)(ANIM_OP_LIT | (n - 1));
+        memcpy(&p_dst[len], p_px, n * ANIM_BYTE_PER_LED);
+        len += n * ANIM_BYTE_PER_LED;
+        i += n;
+    }
+
+    return len;
+}
+
+/**
+ * @brief 1フレームの展開(前のフレームが入ったバッファに上書き)
+ *
+ * @param p_src 圧縮データ(このフレームの先頭)
+ * @param src_len p_srcから読めるバイト数
+ * @param p_frame 前のフレーム -> このフレーム(GRB x led_cnt)
+ * @param led_cnt LEDの数
+ * @return uint32_t 読んだバイト数(0 = データが壊れている)
+ */
+uint32_t anim_decode_frame(const uint8_t *p_src, uint32_t src_len, uint8_t *p_frame, uint32_t led_cnt)
+{
+    uint32_t i = 0, pos = 0, n, op;
+
+    while (i < led_cnt)
+    {
+        if (pos >= src_len) {
+            return 0;
+        }
+        op = p_src[pos++];
+        if (op & ANIM_OP_LIT) {
+            n = (op & (ANIM_LIT_MAX - 1)) + 1;
+            if (((i + n) > led_cnt) || ((pos + (n * ANIM_BYTE_PER_LED)) > src_len)) {
+                return 0;
+            }
+            memcpy(&p_frame[i * ANIM_BYTE_PER_LED], &p_src[pos], n * ANIM_BYTE_PER_LED);
+            pos += n * ANIM_BYTE_PER_LED;
+        } else if (op & ANIM_OP_RUN) {
+            n = (op & (ANIM_RUN_MAX - 1)) + 1;
+            if (((i + n) > led_cnt) || ((pos + ANIM_BYTE_PER_LED) > src_len)) {
+                return 0;
+            }
+            for (uint32_t k = i; k < (i + n); k++)
+            {
+                p_frame[(k * ANIM_BYTE_PER_LED) + 0] = p_src[pos + 0];
+                p_frame[(k * ANIM_BYTE_PER_LED) + 1] = p_src[pos + 1];
+                p_frame[(k * ANIM_BYTE_PER_LED) + 2] = p_src[pos + 2];
+            }
+            pos += ANIM_BYTE_PER_LED;
+        } else {
+            n = op + 1;
+            if ((i + n) > led_cnt) {
+                return 0;
+            }
+        }
+        i += n;
+    }
+
+    return pos;
+}
+
+/**
+ * @brief ヘッダのチェック
+ *
+ * @param p_hdr ヘッダ
+ * @param area_size ヘッダを含む格納領域のサイズ
+ * @return true 正しいヘッダ
+ */
+bool anim_check_hdr(const anim_hdr_t *p_hdr, uint32_t area_size)
+{
+    return (p_hdr->magic == ANIM_MAGIC) && (p_hdr->led_cnt != 0) && (p_hdr->fps != 0) && (p_hdr->fps <= 1000) &&
+           (p_hdr->frame_cnt != 0) && (p_hdr->data_len != 0) && (p_hdr->data_len <= (area_size - sizeof(anim_hdr_t)));
+}
+
+/**
+ * @brief デモのアニメーションの1フレームを描く(暗い背景の上を尾を引いた光が走る、背景は一定間隔で色が変わる)
+ *
+ * @param p_frame 出力先(GRB x led_cnt)
+ * @param led_cnt LEDの数
+ * @param frame フレーム番号
+ */
+void anim_render_demo(uint8_t *p_frame, uint32_t led_cnt, uint32_t frame)
+{
+    static const uint8_t s_bg_tbl[3][3] = {{0, 4, 1}, {3, 0, 4}, {1, 1, 5}};    // G, R, B
+    const uint8_t *p_bg = s_bg_tbl[(frame / ANIM_DEMO_SCENE_FRAMES) % 3];
+    uint32_t head = frame % (led_cnt + ANIM_DEMO_TAIL);
+
+    for (uint32_t i = 0; i < led_cnt; i++)
+    {
+        memcpy(&p_frame[i * ANIM_BYTE_PER_LED], p_bg, ANIM_BYTE_PER_LED);
+    }
+    for (uint32_t t = 0; t < ANIM_DEMO_TAIL; t++)
+    {
+        if ((head >= t) && ((head - t) < led_cnt)) {
+            uint8_t *p_px = &p_frame[(head - t) * ANIM_BYTE_PER_LED];
+            p_px[0] = (uint8_t)(0xC0u >> t);
+            p_px[1] = (uint8_t)(0x60u >> t);
+            p_px[2] = (uint8_t)(0xFFu >> t);
+        }
+    }
+}
@@ -0,0 +1,50 @@
+/**
+ * @file app_anim_codec.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief LEDアニメーションの圧縮形式(差分 + RLE)のヘッダ ※F/Wとホストのエンコーダで共用
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026 Chimipupu All Rights Reserved.
+ *
+ * 形式 ... ヘッダ(anim_hdr_t) + フレームの並び。フレームは前のフレーム(先頭は全消灯)との差分を
+ * 命令バイトの並びで表し、LEDの数だけ進んだら終わり。色はGRBを詰めた3バイト(ワイヤの順)。
+ *   0x00～0x3F ... SKIP (n + 1)個のLEDは前のフレームのまま
+ *   0x40～0x7F ... RUN  (n + 1)個のLEDを続く1色(3バイト)で埋める
+ *   0x80～0xFF ... LIT  続く(n + 1)色(3バイト x (n + 1))をそのまま
+ */
+#ifndef APP_ANIM_CODEC_H
+#define APP_ANIM_CODEC_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#define ANIM_MAGIC              0x304D4E41  // "ANM0"
+#define ANIM_BYTE_PER_LED       3           // 1LEDのバイト数(GRB)
+#define ANIM_OP_SKIP            0x00
+#define ANIM_OP_RUN             0x40
+#define ANIM_OP_LIT             0x80
+#define ANIM_SKIP_MAX           64          // 1命令で飛ばせるLEDの数
+#define ANIM_RUN_MAX            64          // 1命令で埋められるLEDの数
+#define ANIM_LIT_MAX            128         // 1命令でそのまま送れるLEDの数
+
+// 1フレームの圧縮後の最大バイト数(全部LITの場合)
+#define ANIM_FRAME_BOUND(led_cnt)   (((led_cnt) * ANIM_BYTE_PER_LED) + (((led_cnt) + ANIM_LIT_MAX - 1) / ANIM_LIT_MAX))
+
+// ヘッダ(リトルエンディアン、16バイト)
+typedef struct {
+    uint32_t magic;
+    uint16_t led_cnt;
+    uint16_t fps;
+    uint32_t frame_cnt;
+    uint32_t data_len;      // ヘッダの後ろの圧縮データのバイト数
+} anim_hdr_t;
+
+// 関数プロトタイプ
+uint32_t anim_encode_frame(const uint8_t *p_cur, const uint8_t *p_prev, uint32_t led_cnt, uint8_t *p_dst);
+uint32_t anim_decode_frame(const uint8_t *p_src, uint32_t src_len, uint8_t *p_frame, uint32_t led_cnt);
+bool anim_check_hdr(const anim_hdr_t *p_hdr, uint32_t area_size);
+void anim_render_demo(uint8_t *p_frame, uint32_t led_cnt, uint32_t frame);
+
+#endif // APP_ANIM_CODEC_H
@@ -11,24 +11,79 @@
 #include "app_cpu_core_0.h"
 #include "pcb_def.h"
 #include "muc_rpxxx_util.h"
+#include "app_job.h"
+#include "drv_ipc.h"
+#include "app_event.h"
+#include "app_task.h"
+#include "app_rtos.h"
+#include "app_mct.h"
+#include "drv_lock.h"
+#include "drv_debounce.h"
 #include "drv_neopixel.h"
+#include "app_fx.h"
+#include "app_sha.h"
 
 volatile uint32_t g_core_num_core_0 = 0xFF;
-static uint32_t s_core_fifo_data = 0;
-static uint8_t s_fade_pixel_flg = 0;
+static int32_t s_fx_event_id = -1;
 
 static void app_multicore_state_machine(uint32_t state);
+static void core_0_fifo_handler(uint32_t data);
+static void core_0_ipc_handler(uint32_t data);
+static void core_0_fx_handler(uint32_t data);
+#if defined(PCB_PICO2W)
+static void core_0_led_handler(uint32_t data);
+#endif
 
 static void app_multicore_state_machine(uint32_t state)
 {
         switch (state)
         {
             case MULTI_CORE_TEST_DATA:
-                printf("[Core 0] RX FIFO Data from Core 1 :  0x%08X\n", s_core_fifo_data);
+                printf("[Core 0] RX FIFO Data from Core 1 :  0x%08X\n", state);
                 break;
 
-            case PROC_NEOPIXEL_FADE:
-                s_fade_pixel_flg = 1;
+            case PROC_NEOPIXEL_FX:
+#if defined(RP2XXX_USE_FREERTOS)
+                app_rtos_fx_update();
+#else
+                if (app_fx_get_period_us() == 0) {
+                    app_event_timer_stop(s_fx_event_id);
+                } else {
+                    app_event_timer_start(s_fx_event_id, app_fx_get_period_us());
+                }
+#endif
+                break;
+
+            case PROC_FLASH_PARK:
+                rp2xxx_flash_park();
+                break;
+
+            case PROC_JOB_RUN:
+                app_job_core_0_run();
+                break;
+
+            case PROC_IPC_SERVER:
+                drv_ipc_server();
+                break;
+
+            case PROC_TASK_RUN:
+                app_task_worker();
+                break;
+
+            case PROC_MCT_SERVER:
+                app_mct_server();
+                break;
+
+            case PROC_LOCK_SERVER:
+                drv_lock_server();
+                break;
+
+            case PROC_DEBOUNCE_ARM:
+                drv_debounce_arm();
+                break;
+
+            case PROC_SHA_RUN:
+                app_sha_core_0_run();
                 break;
 
             default:
@@ -37,31 +92,97 @@ static void app_multicore_state_machine(uint32_t state)
         }
 }
 
+// FIFOの受信ワード(0も有効なデータ)
+static void core_0_fifo_handler(uint32_t data)
+{
+    app_multicore_state_machine(data);
+}
+
+// コア間メッセージキューの受信
+static void core_0_ipc_handler(uint32_t data)
+{
+    app_core_0_ipc_rx();
+}
+
+// NeoPixelのエフェクト(設定したfpsの周期)
+static void core_0_fx_handler(uint32_t data)
+{
+    app_fx_tick();
+}
+
+#if defined(PCB_PICO2W)
+// 基板LEDの点滅(1000ms周期)
+static void core_0_led_handler(uint32_t data)
+{
+    cyw43_led_tgl();
+}
+#endif
+
+/**
+ * @brief CPU Core0の初期化(RTOS版はI/Oタスクから呼ぶ)
+ * 
+ */
+void app_core_0_init(void)
+{
+    g_core_num_core_0 = get_core_num();
+    rp2xxx_cycle_cnt_init();
+}
+
+/**
+ * @brief 処理コード(PROC_xxx)の実行
+ * 
+ * @param code 処理コード
+ */
+void app_core_0_proc(uint32_t code)
+{
+    app_multicore_state_machine(code);
+}
+
+/**
+ * @brief コア間メッセージキューの受信処理
+ * @note 処理コードはFIFOと同じく実行、それ以外は捨てる
+ * 
+ */
+void app_core_0_ipc_rx(void)
+{
+    const ipc_msg_t *p_msg;
+    uint32_t code;
+
+    while ((p_msg = drv_ipc_peek()) != NULL)
+    {
+        if ((p_msg->type == IPC_MSG_CODE) && (p_msg->len == sizeof(code))) {
+            memcpy(&code, p_msg->data, sizeof(code));
+            drv_ipc_pop();
+            app_multicore_state_machine(code);
+        } else {
+            drv_ipc_pop();
+        }
+    }
+}
+
 /**
  * @brief CPU Core0のアプリメイン関数
  * 
  */
 void app_core_0_main(void)
 {
-    g_core_num_core_0 = get_core_num();
+    app_core_0_init();
 
     // Core 1 起動待ち（ブロッキングでFIFOを待つ）
-    s_core_fifo_data = get_multicore_fifo();
+    multicore_fifo_pop_blocking();
 
-    while(1)
-    {
+    // イベントループ初期化(WFEで待機してFIFO/Doorbell/タイマー/GPIOで起床)
+    app_event_init();
+    app_event_add("fifo", EVENT_SRC_FIFO, core_0_fifo_handler);
+    app_event_add("ipc", EVENT_SRC_DOORBELL, core_0_ipc_handler);
+    s_fx_event_id = app_event_add("px_fx", EVENT_SRC_TIMER, core_0_fx_handler);
 #if defined(PCB_PICO2W)
-        cyw43_led_tgl();
-        sleep_ms(1000);
-#else
-        s_core_fifo_data = get_multicore_fifo();
-        app_multicore_state_machine(s_core_fifo_data);
-
-        if (s_fade_pixel_flg != 0) {
-            drv_neopixel_pixel_color_fade();
-            sleep_ms(1);
-        }
+    app_event_timer_start(app_event_add("led", EVENT_SRC_TIMER, core_0_led_handler), 1000000);
 #endif
-        WDT_RST;
-    }
+    drv_debounce_init();
+#if defined(PCB_BTN_PIN)
+    hw_btn_event_init();
+#endif
+
+    app_event_loop();
 }
\ No newline at end of file
@@ -15,6 +15,9 @@
 #include "pcb_def.h"
 #include "pico/multicore.h"
 
+void app_core_0_init(void);
+void app_core_0_proc(uint32_t code);
+void app_core_0_ipc_rx(void);
 void app_core_0_main(void);
 
 #endif // APP_CPU_CORE_0_H
\ No newline at end of file
@@ -11,20 +11,39 @@
 #include "app_cpu_core_1.h"
 #include "app_main.h"
 #include "dbg_com.h"
+#include "app_script.h"
+#include "app_job.h"
+#include "drv_ipc.h"
+#include "app_task.h"
+#include "app_rtos.h"
 #include "muc_rpxxx_util.h"
 
 #include "drv_neopixel.h"
+#include "app_fx.h"
+#include "app_anim.h"
 neopixel_t s_neopixel;
-static rgb_color_t s_rgb_buf[NEOPIXEL_LED_CNT] = {0};
+#if defined(PCB_NEOPIXEL_MULTI)
+#include "drv_neopixel_multi.h"
+neopixel_multi_t s_neopixel_multi;
+static rgb_color_t s_multi_rgb_buf[NEOPIXEL_MULTI_STRIP_CNT][NEOPIXEL_MULTI_LED_CNT];
+#endif
 volatile uint32_t g_core_num_core_1 = 0xFF;
 
 /**
- * @brief CPU Core1のアプリメイン関数
+ * @brief CPU Core1の初期化(RTOS版はモニタタスクから呼ぶ)
  * 
  */
-void app_core_1_main(void)
+void app_core_1_init(void)
 {
     g_core_num_core_1 = get_core_num();
+    rp2xxx_cycle_cnt_init();
+
+    // コア間メッセージキュー初期化(Core0が使う前に行う)
+    // ※RTOS版はタスクの起動前にapp_rtos_start()で初期化済み
+#if !defined(RP2XXX_USE_FREERTOS)
+    drv_ipc_init();
+#endif
+    drv_ipc_core_init(NULL);
 
      // Core0に起動通知
     set_multicore_fifo(CORE_1_WUP_RESULT_DATA);
@@ -32,20 +51,45 @@ void app_core_1_main(void)
     // NeoPixel初期化(PIOで並列処理)
     s_neopixel.led_cnt = NEOPIXEL_LED_CNT;
     s_neopixel.data_pin = PCB_NEOPIXEL_PIN;
-    memset(s_rgb_buf, 0, sizeof(s_rgb_buf));
-    s_neopixel.p_pixel_grb_buf = &s_rgb_buf[0];
+    s_neopixel.p_pixel_buf = NULL;     // ドライバがLEDの数に合わせて確保
     drv_neopixel_init(&s_neopixel);
+    app_fx_init(&s_neopixel);
+    app_anim_init();
+
+#if defined(PCB_NEOPIXEL_MULTI)
+    // NeoPixel 複数ストリップ並列出力(1つのステートマシン + DMA)
+    s_neopixel_multi.pin_base = PCB_NEOPIXEL_MULTI_PIN_BASE;
+    s_neopixel_multi.strip_cnt = NEOPIXEL_MULTI_STRIP_CNT;
+    for (uint32_t i = 0; i < NEOPIXEL_MULTI_STRIP_CNT; i++)
+    {
+        s_neopixel_multi.strip[i].led_cnt = NEOPIXEL_MULTI_LED_CNT;
+        s_neopixel_multi.strip[i].p_pixel_grb_buf = &s_multi_rgb_buf[i][0];
+    }
+    drv_neopixel_multi_init(&s_neopixel_multi);
+#endif
 
     printf("MCU:\tRP2350\n");
     printf("System Clock:\t%d MHz\n", clock_get_hz(clk_sys) / 1000000);
     printf("USB Clock:\t%d MHz\n", clock_get_hz(clk_usb) / 1000000);
 
     // デバッグモニタ初期化
+    app_job_init();
+    app_task_init();
+    app_script_init();
     dbg_com_init();
+}
+
+/**
+ * @brief CPU Core1のアプリメイン関数
+ * 
+ */
+void app_core_1_main(void)
+{
+    app_core_1_init();
 
     while(1)
     {
         dbg_com_main();
         WDT_RST();
     }
-}
\ No newline at end of file
+}
\ No newline at end of file
@@ -15,6 +15,7 @@
 #include "pcb_def.h"
 #include "pico/multicore.h"
 
+void app_core_1_init(void);
 void app_core_1_main(void);
 
 #endif // APP_CPU_CORE_1H
\ No newline at end of file
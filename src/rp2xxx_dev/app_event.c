@@ -0,0 +1,321 @@
+/**
+ * @file app_event.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief Core0のイベントループ(WFEで待機してイベントをハンドラへ配送)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026 Chimipupu All Rights Reserved.
+ *
+ * Core0はイベントが無い間WFEで眠り、以下で起きる。
+ *   FIFO     ... 送信側のSEV(SDKのFIFO送信がSEVを出す)
+ *   Doorbell ... SIO_IRQ_BELL(RP2040はSEV)
+ *   Timer/GPIO/SW ... 割り込み(例外からの復帰でイベントレジスタが立つ)
+ * ISRはapp_event_post()で保留ビットを立てるだけで、処理はハンドラで行う。
+ * 保留ビットはCore0内のISRとループだけが触るので割り込み禁止で排他する。
+ */
+#include "app_event.h"
+#include "muc_rpxxx_util.h"
+#include "drv_ipc.h"
+#include "app_load.h"
+#include "pico/multicore.h"
+
+// イベント
+typedef struct {
+    const char *p_name;                 // 表示名
+    event_src_t src;                    // 発生源
+    event_handler_t p_handler;          // ハンドラ
+    repeating_timer_t timer;            // 周期タイマー(EVENT_SRC_TIMER)
+    bool is_timer_run;                  // 周期タイマー動作中
+    uint32_t data;                      // 配送までORしたデータ
+    uint32_t post_cyc;                  // 保留になった時刻(サイクル)
+    // 統計
+    uint32_t cnt;                       // 配送回数
+    uint32_t merge_cnt;                 // 保留中に重なって1回にまとめた回数
+    uint64_t lat_sum_cyc;               // 発生 -> ハンドラ開始
+    uint32_t lat_max_cyc;
+    uint64_t run_sum_cyc;               // ハンドラの実行時間
+    uint32_t run_max_cyc;
+} event_t;
+
+static const char *s_p_src_str[] = {"FIFO", "Bell", "Timer", "GPIO", "SW"};
+
+static event_t s_event[EVENT_MAX];
+static uint32_t s_event_cnt = 0;
+static volatile uint32_t s_pending = 0;     // 保留ビット(bit n = s_event[n])
+static int32_t s_fifo_id = -1;
+static int32_t s_bell_id = -1;
+
+// アイドル率の統計
+static volatile uint64_t s_idle_us = 0;     // WFEで寝ていた時間
+static volatile uint64_t s_stat_start_us = 0;
+static volatile uint32_t s_wakeup_cnt = 0;
+
+static void event_dispatch(event_t *p_evt, uint32_t data, uint32_t post_cyc);
+static void event_ipc_rx_callback(void);
+static bool event_timer_callback(repeating_timer_t *p_timer);
+
+static void event_dispatch(event_t *p_evt, uint32_t data, uint32_t post_cyc)
+{
+    uint32_t t0_cyc = rp2xxx_get_cycle_cnt();
+    uint32_t lat = t0_cyc - post_cyc;
+    uint32_t run;
+
+    p_evt->p_handler(data);
+    run = rp2xxx_get_cycle_cnt() - t0_cyc;
+
+    p_evt->cnt++;
+    p_evt->lat_sum_cyc += lat;
+    p_evt->lat_max_cyc = (lat > p_evt->lat_max_cyc) ? lat : p_evt->lat_max_cyc;
+    p_evt->run_sum_cyc += run;
+    p_evt->run_max_cyc = (run > p_evt->run_max_cyc) ? run : p_evt->run_max_cyc;
+}
+
+// Doorbell割り込み(Core0)
+static void event_ipc_rx_callback(void)
+{
+    app_event_post(s_bell_id, 0);
+}
+
+// 周期タイマー割り込み(Core0)
+static bool event_timer_callback(repeating_timer_t *p_timer)
+{
+    app_event_post((int32_t)(intptr_t)p_timer->user_data, 0);
+
+    return true;
+}
+
+/**
+ * @brief イベントループの初期化(EVENT_CORE_NUMで呼ぶ)
+ */
+void app_event_init(void)
+{
+    drv_ipc_core_init(event_ipc_rx_callback);
+    app_event_clear_stat();
+}
+
+/**
+ * @brief イベントの登録(FIFO/Doorbellは各1つまで)
+ *
+ * @param p_name 表示名
+ * @param src 発生源
+ * @param p_handler ハンドラ
+ * @return int32_t イベントID、登録できなければ-1
+ */
+int32_t app_event_add(const char *p_name, event_src_t src, event_handler_t p_handler)
+{
+    int32_t id = (int32_t)s_event_cnt;
+    event_t *p_evt;
+
+    if ((s_event_cnt >= EVENT_MAX) ||
+        ((src == EVENT_SRC_FIFO) && (s_fifo_id >= 0)) ||
+        ((src == EVENT_SRC_DOORBELL) && (s_bell_id >= 0))) {
+        return -1;
+    }
+
+    p_evt = &s_event[id];
+    memset(p_evt, 0, sizeof(event_t));
+    p_evt->p_name = p_name;
+    p_evt->src = src;
+    p_evt->p_handler = p_handler;
+    s_event_cnt++;
+
+    if (src == EVENT_SRC_FIFO) {
+        s_fifo_id = id;
+    } else if (src == EVENT_SRC_DOORBELL) {
+        s_bell_id = id;
+        // 登録前のベルは配送先が無く捨てられ、送信側は非空のリングでは鳴らし直さないので
+        // 溜まっていればここで保留にする
+        if (drv_ipc_peek() != NULL) {
+            app_event_post(id, 0);
+        }
+    }
+
+    return id;
+}
+
+/**
+ * @brief イベントを保留にする(EVENT_CORE_NUMのISR/スレッドから呼ぶ)
+ *
+ * @param id イベントID
+ * @param data ハンドラに渡すデータ(配送までOR)
+ */
+void app_event_post(int32_t id, uint32_t data)
+{
+    event_t *p_evt;
+    uint32_t irq;
+
+    if ((id < 0) || ((uint32_t)id >= s_event_cnt)) {
+        return;
+    }
+
+    p_evt = &s_event[id];
+    irq = save_and_disable_interrupts();
+    if (s_pending & (1u << id)) {
+        p_evt->merge_cnt++;
+        p_evt->data |= data;
+    } else {
+        p_evt->data = data;
+        p_evt->post_cyc = rp2xxx_get_cycle_cnt();
+        s_pending |= (1u << id);
+    }
+    restore_interrupts(irq);
+}
+
+/**
+ * @brief 周期タイマーの開始(EVENT_CORE_NUMで呼ぶ ※タイマー割り込みを受けるコア)
+ *
+ * @param id イベントID(EVENT_SRC_TIMER)
+ * @param period_us 周期(us)
+ * @return true 開始した
+ * @return false IDエラー or タイマー不足
+ */
+bool app_event_timer_start(int32_t id, uint32_t period_us)
+{
+    event_t *p_evt;
+
+    if ((id < 0) || ((uint32_t)id >= s_event_cnt) || (s_event[id].src != EVENT_SRC_TIMER)) {
+        return false;
+    }
+
+    p_evt = &s_event[id];
+    if (p_evt->is_timer_run) {
+        cancel_repeating_timer(&p_evt->timer);
+    }
+    // 負の周期 ... 前回の予定時刻から次を数える(ハンドラの遅れで周期がずれない)
+    p_evt->is_timer_run = add_repeating_timer_us(-(int64_t)period_us, event_timer_callback,
+                                                 (void *)(intptr_t)id, &p_evt->timer);
+
+    return p_evt->is_timer_run;
+}
+
+/**
+ * @brief 周期タイマーの停止
+ *
+ * @param id イベントID(EVENT_SRC_TIMER)
+ */
+void app_event_timer_stop(int32_t id)
+{
+    if ((id < 0) || ((uint32_t)id >= s_event_cnt) || !s_event[id].is_timer_run) {
+        return;
+    }
+
+    cancel_repeating_timer(&s_event[id].timer);
+    s_event[id].is_timer_run = false;
+}
+
+/**
+ * @brief イベントループ(戻らない)
+ */
+void app_event_loop(void)
+{
+    uint32_t pending;
+    uint32_t data[EVENT_MAX];
+    uint32_t post_cyc[EVENT_MAX];
+    uint32_t wake_cyc;
+    uint32_t irq;
+    uint64_t t0_us;
+
+    while(1)
+    {
+        wake_cyc = rp2xxx_get_cycle_cnt();
+
+        // FIFO ... 0も含めて受信したワードを全て配送
+        while (multicore_fifo_rvalid())
+        {
+            uint32_t fifo_data = multicore_fifo_pop_blocking();
+            if (s_fifo_id >= 0) {
+                event_dispatch(&s_event[s_fifo_id], fifo_data, wake_cyc);
+            }
+        }
+
+#if !defined(MCU_RP2350)
+        // Doorbellが無いので受信をポーリング(SEVで起きる)
+        if ((s_bell_id >= 0) && (drv_ipc_peek() != NULL)) {
+            app_event_post(s_bell_id, 0);
+        }
+#endif
+
+        // 保留ビットとデータを一度に取り出す(配送中のpostは次の周回で配送)
+        irq = save_and_disable_interrupts();
+        pending = s_pending;
+        s_pending = 0;
+        for (uint32_t bits = pending; bits != 0; bits &= bits - 1)
+        {
+            uint32_t id = (uint32_t)__builtin_ctz(bits);
+            data[id] = s_event[id].data;
+            post_cyc[id] = s_event[id].post_cyc;
+        }
+        restore_interrupts(irq);
+
+        while (pending != 0)
+        {
+            uint32_t id = (uint32_t)__builtin_ctz(pending);
+
+            pending &= pending - 1;
+            event_dispatch(&s_event[id], data[id], post_cyc[id]);
+        }
+
+        WDT_RST();
+
+        // 何も無ければ眠る(判定後に来たイベントはイベントレジスタに残るので取りこぼさない)
+        if ((s_pending == 0) && !multicore_fifo_rvalid()) {
+            t0_us = time_us_64();
+            app_load_idle_enter();
+            __wfe();
+            app_load_idle_exit();
+            s_idle_us += time_us_64() - t0_us;
+            s_wakeup_cnt++;
+        }
+    }
+}
+
+/**
+ * @brief イベントループの統計表示
+ */
+void app_event_show_stat(void)
+{
+    uint32_t cyc_per_us = clock_get_hz(clk_sys) / 1000000;
+    uint64_t window_us = time_us_64() - s_stat_start_us;
+    uint64_t idle_us = s_idle_us;
+    uint32_t idle_permil = (window_us != 0) ? (uint32_t)((idle_us * 1000u) / window_us) : 0;
+
+    printf("\n[Event Loop (Core %d)] idle %u.%u%% (window %llu ms, wakeups %u)\n",
+            EVENT_CORE_NUM, idle_permil / 10, idle_permil % 10,
+            (unsigned long long)(window_us / 1000), s_wakeup_cnt);
+    printf("ID Name         Src        Count   Merged Lat avg(us) Lat max(us) Run avg(us) Run max(us)\n");
+    for (uint32_t i = 0; i < s_event_cnt; i++)
+    {
+        const event_t *p_evt = &s_event[i];
+        uint32_t cnt = p_evt->cnt;
+        uint32_t lat_avg = (cnt != 0) ? (uint32_t)(p_evt->lat_sum_cyc / cnt) : 0;
+        uint32_t run_avg = (cnt != 0) ? (uint32_t)(p_evt->run_sum_cyc / cnt) : 0;
+
+        printf("%2u %-12s %-5s %10u %8u %8u.%02u %8u.%02u %8u.%02u %8u.%02u\n",
+                i, p_evt->p_name, s_p_src_str[p_evt->src], cnt, p_evt->merge_cnt,
+                lat_avg / cyc_per_us, ((lat_avg % cyc_per_us) * 100u) / cyc_per_us,
+                p_evt->lat_max_cyc / cyc_per_us, ((p_evt->lat_max_cyc % cyc_per_us) * 100u) / cyc_per_us,
+                run_avg / cyc_per_us, ((run_avg % cyc_per_us) * 100u) / cyc_per_us,
+                p_evt->run_max_cyc / cyc_per_us, ((p_evt->run_max_cyc % cyc_per_us) * 100u) / cyc_per_us);
+    }
+}
+
+/**
+ * @brief イベントループの統計クリア
+ */
+void app_event_clear_stat(void)
+{
+    for (uint32_t i = 0; i < s_event_cnt; i++)
+    {
+        event_t *p_evt = &s_event[i];
+        p_evt->cnt = 0;
+        p_evt->merge_cnt = 0;
+        p_evt->lat_sum_cyc = 0;
+        p_evt->lat_max_cyc = 0;
+        p_evt->run_sum_cyc = 0;
+        p_evt->run_max_cyc = 0;
+    }
+    s_idle_us = 0;
+    s_wakeup_cnt = 0;
+    s_stat_start_us = time_us_64();
+}
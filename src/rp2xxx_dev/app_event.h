@@ -0,0 +1,47 @@
+/**
+ * @file app_event.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief Core0のイベントループ(WFEで待機してイベントをハンドラへ配送)のヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026 Chimipupu All Rights Reserved.
+ *
+ */
+#ifndef APP_EVENT_H
+#define APP_EVENT_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "pico/stdlib.h"
+
+#define EVENT_MAX               16      // 登録できるイベントの最大数(32以下)
+#define EVENT_CORE_NUM          0       // イベントループを回すコア
+
+// イベントの発生源
+typedef enum {
+    EVENT_SRC_FIFO,         // SIO FIFOの受信(1ワードごとにハンドラを呼ぶ)
+    EVENT_SRC_DOORBELL,     // コア間メッセージキューの受信(RP2350 ... Doorbell割り込み)
+    EVENT_SRC_TIMER,        // 周期タイマー(app_event_timer_start())
+    EVENT_SRC_GPIO,         // GPIO割り込み(ISRからapp_event_post())
+    EVENT_SRC_SW,           // ソフトウェア(ISRからapp_event_post())
+} event_src_t;
+
+// イベントハンドラ(イベントループ = スレッド文脈から呼ばれる)
+// data ... FIFOは受信ワード、それ以外はapp_event_post()のdataを配送までOR
+typedef void (*event_handler_t)(uint32_t data);
+
+// 関数プロトタイプ
+void app_event_init(void);
+int32_t app_event_add(const char *p_name, event_src_t src, event_handler_t p_handler);
+void app_event_post(int32_t id, uint32_t data);
+bool app_event_timer_start(int32_t id, uint32_t period_us);
+void app_event_timer_stop(int32_t id);
+void app_event_loop(void);
+void app_event_show_stat(void);
+void app_event_clear_stat(void);
+
+#endif // APP_EVENT_H
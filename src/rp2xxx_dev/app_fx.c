@@ -0,0 +1,556 @@
+/**
+ * @file app_fx.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief NeoPixelのエフェクトエンジン(固定フレームレート + ガンマ/輝度/色補正 + 時間方向ディザ)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026 Chimipupu All Rights Reserved.
+ *
+ * Core0の周期タイマー(RTOS版はタスク)から1フレームずつapp_fx_tick()を呼ぶ。
+ *   描画   ... 選択したエフェクトが作業バッファ(8bit RGB、知覚的な明るさ)に描く
+ *   色変換 ... ガンマのLUT(8bit -> 16bitリニア) x 輝度 x 色補正を固定小数点で掛けて16bitのバッファへ
+ *   ディザ ... 16bitを8bitに落とすときの誤差を画素/チャンネルごとに持ち越し、次の出力フレームに足す
+ *              (時間方向の誤差拡散。低輝度で8bitの段が見えなくなる)
+ *   出力   ... ドライバのバッファへコピーしてコミット(DMA送信)
+ * ディザが有効なときは、エフェクトのfpsとは別にストリップの長さで決まる最大の速さ(タイマーは最短1ms)で出力し、
+ * エフェクトは自分のfpsのフレームが来たときだけ描画/色変換する。ディザの深さ(自動)は
+ * 出力の速さ / 2^bit がFX_DITHER_MIN_HZ以上になる最大のbit数。
+ * 設定(エフェクト/fps/輝度/ガンマ/色補正)はCore1のコマンドが書き、次のフレームの先頭でCore0が反映する。
+ * ジッタ ... 前のフレームからの間隔と周期の差。間隔が周期の1.5倍を超えたら飛ばしたスロットとして数え、
+ * エフェクトには飛ばした分も進めたスロット番号を渡す(描画が遅れても動きの速さは変わらない)。
+ */
+#include "app_fx.h"
+#include "app_event.h"
+#include "drv_ipc.h"
+#include "app_cpu_core_0.h"
+#include "muc_rpxxx_util.h"
+#include <math.h>
+
+// エフェクト
+typedef struct {
+    const char *p_name;
+    fx_render_t p_render;
+} fx_effect_t;
+
+static fx_effect_t s_effect[FX_EFFECT_MAX];
+static uint32_t s_effect_cnt = 0;
+static neopixel_t *s_p_neopixel = NULL;
+
+// 設定(Core1が書いて、s_cfg_seqを進める)
+static volatile int32_t s_req_effect = -1;          // -1 = 停止
+static volatile uint32_t s_req_fps = FX_FPS_DEFAULT;
+static volatile uint8_t s_req_brightness = FX_BRIGHTNESS_DEFAULT;
+static volatile uint32_t s_req_gamma_x10 = FX_GAMMA_DEFAULT;
+static volatile uint8_t s_req_corr[3] = {0xFF, 0xFF, 0xFF};     // R, G, B
+static volatile int32_t s_req_dither = FX_DITHER_AUTO;
+static volatile uint32_t s_cfg_seq = 1;
+
+// Core0が反映した設定と色変換のテーブル
+static uint32_t s_cfg_applied = 0;
+static int32_t s_effect_id = -1;
+static uint32_t s_gamma_x10 = 0;
+static uint16_t s_gamma_lut[256];                   // 8bit -> 16bitリニア
+static uint32_t s_scale[3];                         // 輝度 x 色補正(1～65536)
+
+static uint32_t s_dither_bits = 0;
+
+static rgb_color_t s_fx_buf[FX_LED_MAX];            // エフェクトの作業バッファ
+static uint16_t s_lin_buf[FX_LED_MAX][3];           // 色変換後(16bitリニア、R, G, B)
+static uint8_t s_err_buf[FX_LED_MAX][3];            // ディザの持ち越し誤差(下位s_dither_bitsビット)
+static rgb_color_t s_out_buf[FX_LED_MAX];           // ディザ後(8bit)
+
+// フレームの予定と統計
+static uint64_t s_prev_us = 0;                      // 前の出力フレームの開始時刻(0 = 最初のフレーム)
+static uint32_t s_period_us = 0;                    // 出力の周期
+static uint32_t s_fx_period_us = 0;                 // エフェクトの周期(1000000 / fps)
+static uint32_t s_slot = 0;                         // 最後に出力したスロット
+static uint32_t s_fx_frame = 0;                     // 最後に描いたエフェクトのフレーム
+static bool s_is_rendered = false;
+static uint64_t s_stat_start_us = 0;
+static uint32_t s_frame_cnt = 0;
+static uint32_t s_render_cnt = 0;
+static uint32_t s_miss_cnt = 0;                     // 飛ばしたスロット
+static uint32_t s_busy_cnt = 0;                     // 前のフレームがまだワイヤ上(送信は保留/上書き)
+static uint64_t s_jitter_sum_us = 0;
+static uint32_t s_jitter_max_us = 0;
+static uint64_t s_render_sum_cyc = 0;
+static uint32_t s_render_max_cyc = 0;
+static uint64_t s_color_sum_cyc = 0;
+static uint32_t s_color_max_cyc = 0;
+static uint64_t s_dither_sum_cyc = 0;
+static uint32_t s_dither_max_cyc = 0;
+static uint64_t s_total_sum_cyc = 0;
+static uint32_t s_total_max_cyc = 0;
+
+// 0～255の色相を虹色に
+static uint32_t fx_wheel(uint8_t pos)
+{
+    if (pos < 85) {
+        return RGB_TO_GRB((uint32_t)(255 - pos * 3), (uint32_t)(pos * 3), 0u);
+    } else if (pos < 170) {
+        pos -= 85;
+        return RGB_TO_GRB(0u, (uint32_t)(255 - pos * 3), (uint32_t)(pos * 3));
+    }
+    pos -= 170;
+    return RGB_TO_GRB((uint32_t)(pos * 3), 0u, (uint32_t)(255 - pos * 3));
+}
+
+// 全画素を暗くする(3チャンネルまとめて x num/8)
+static void fx_decay(rgb_color_t *p_buf, uint32_t led_cnt, uint32_t num)
+{
+    for (uint32_t i = 0; i < led_cnt; i++)
+    {
+        uint32_t px = p_buf[i].grb_color.u32_grb;
+        uint32_t rb = ((px & 0x00FF00FFu) * num >> 3) & 0x00FF00FFu;
+        uint32_t g = ((px & 0x0000FF00u) * num >> 3) & 0x0000FF00u;
+        p_buf[i].grb_color.u32_grb = rb | g;
+    }
+}
+
+// [エフェクト] 1LEDずつR -> G -> Bを増やす(従来のフェード、1フレーム1ステップ)
+static void fx_render_fade(rgb_color_t *p_buf, uint32_t led_cnt, uint32_t frame)
+{
+    static uint32_t s_idx = 0;
+    static uint8_t s_r = 0, s_g = 0, s_b = 0;
+
+    (void)frame;
+    if (s_r < 0xFF) {
+        s_r++;
+    } else if (s_g < 0xFF) {
+        s_g++;
+    } else if (s_b < 0xFF) {
+        s_b++;
+    } else {
+        s_r = 0;
+        s_g = 0;
+        s_b = 0;
+        s_idx++;
+        if (s_idx >= led_cnt) {
+            s_idx = 0;
+            memset(p_buf, 0, led_cnt * sizeof(rgb_color_t));
+        }
+    }
+    s_idx = (s_idx < led_cnt) ? s_idx : 0;
+    p_buf[s_idx].grb_color.u32_grb = RGB_TO_GRB((uint32_t)s_r, (uint32_t)s_g, (uint32_t)s_b);
+}
+
+// [エフェクト] 流れる虹
+static void fx_render_rainbow(rgb_color_t *p_buf, uint32_t led_cnt, uint32_t frame)
+{
+    for (uint32_t i = 0; i < led_cnt; i++)
+    {
+        p_buf[i].grb_color.u32_grb = fx_wheel((uint8_t)(((i * 256u) / led_cnt) + (frame * 2u)));
+    }
+}
+
+// [エフェクト] 尾を引いて走る光(色相も回る)
+static void fx_render_chase(rgb_color_t *p_buf, uint32_t led_cnt, uint32_t frame)
+{
+    fx_decay(p_buf, led_cnt, 6);
+    p_buf[(frame / 2u) % led_cnt].grb_color.u32_grb = fx_wheel((uint8_t)frame);
+}
+
+// [エフェクト] 全体がゆっくり明滅(三角波、約4秒周期 @60fps)
+static void fx_render_breathe(rgb_color_t *p_buf, uint32_t led_cnt, uint32_t frame)
+{
+    uint32_t phase = (frame * 2u) % 512u;
+    uint32_t level = (phase < 256u) ? phase : (511u - phase);
+
+    for (uint32_t i = 0; i < led_cnt; i++)
+    {
+        p_buf[i].grb_color.u32_grb = RGB_TO_GRB(level, level, level);
+    }
+}
+
+// [エフェクト] ランダムにきらめいて消える
+static void fx_render_sparkle(rgb_color_t *p_buf, uint32_t led_cnt, uint32_t frame)
+{
+    uint32_t rnd = get_rand_32();
+
+    (void)frame;
+    fx_decay(p_buf, led_cnt, 7);
+    if ((rnd & 3u) == 0) {
+        p_buf[(rnd >> 8) % led_cnt].grb_color.u32_grb = fx_wheel((uint8_t)(rnd >> 24));
+    }
+}
+
+// 設定をCore0に知らせる(タイマーの開始/停止/周期の変更)
+static void fx_notify(void)
+{
+    s_cfg_seq++;
+    if (get_core_num() == EVENT_CORE_NUM) {
+        app_core_0_proc(PROC_NEOPIXEL_FX);
+    } else if (!drv_ipc_send_code(PROC_NEOPIXEL_FX)) {
+        printf("Error: Failed to notify Core %d (queue full)\n", EVENT_CORE_NUM);
+    }
+}
+
+// 出力の周期 ... ディザ無しはエフェクトの周期、有りはワイヤ + ラッチ時間とタイマーの最短周期の長い方
+static uint32_t fx_calc_out_period_us(uint32_t fps, int32_t dither)
+{
+    uint32_t fx_period_us = 1000000u / fps;
+    uint32_t out_period_us = 1000000u / FX_FPS_MAX;
+    uint32_t wire_us;
+
+    if ((dither == 0) || (s_p_neopixel == NULL)) {
+        return fx_period_us;
+    }
+    wire_us = (s_p_neopixel->led_cnt * NEOPIXEL_WORD_US) + NEOPIXEL_LATCH_US;
+    out_period_us = (wire_us > out_period_us) ? wire_us : out_period_us;
+
+    return (out_period_us < fx_period_us) ? out_period_us : fx_period_us;
+}
+
+// ディザの深さ ... 自動なら出力の速さ / 2^bitがFX_DITHER_MIN_HZ以上になる最大のbit数
+static uint32_t fx_calc_dither_bits(uint32_t out_period_us, int32_t dither)
+{
+    uint32_t out_hz = 1000000u / out_period_us;
+    uint32_t bits = 0;
+
+    if (dither != FX_DITHER_AUTO) {
+        return (uint32_t)dither;
+    }
+    while ((bits < FX_DITHER_BITS_MAX) && ((out_hz >> (bits + 1u)) >= FX_DITHER_MIN_HZ))
+    {
+        bits++;
+    }
+
+    return bits;
+}
+
+// 設定の反映(Core0、フレームの先頭)
+static void fx_apply_config(void)
+{
+    uint32_t seq = s_cfg_seq;
+    uint32_t fps = s_req_fps;
+    uint32_t gamma_x10 = s_req_gamma_x10;
+    int32_t effect_id = s_req_effect;
+    uint32_t out_period_us = fx_calc_out_period_us(fps, s_req_dither);
+    uint32_t dither_bits = fx_calc_dither_bits(out_period_us, s_req_dither);
+
+    if (gamma_x10 != s_gamma_x10) {
+        float gamma = (float)gamma_x10 / 10.0f;
+        for (uint32_t i = 0; i < 256; i++)
+        {
+            s_gamma_lut[i] = (uint16_t)(powf((float)i / 255.0f, gamma) * 65535.0f + 0.5f);
+        }
+        s_gamma_x10 = gamma_x10;
+    }
+    for (uint32_t c = 0; c < 3; c++)
+    {
+        s_scale[c] = ((uint32_t)s_req_brightness + 1u) * ((uint32_t)s_req_corr[c] + 1u);
+    }
+
+    if (dither_bits != s_dither_bits) {
+        memset(s_err_buf, 0, sizeof(s_err_buf));
+        s_dither_bits = dither_bits;
+    }
+
+    // エフェクトか周期が変わったらスロットを数え直す
+    if ((effect_id != s_effect_id) || ((1000000u / fps) != s_fx_period_us) || (out_period_us != s_period_us)) {
+        if (effect_id != s_effect_id) {
+            memset(s_fx_buf, 0, sizeof(s_fx_buf));
+        }
+        s_effect_id = effect_id;
+        s_fx_period_us = 1000000u / fps;
+        s_period_us = out_period_us;
+        s_prev_us = 0;
+        s_slot = 0;
+    }
+    // 色変換の設定が変わっても描き直す
+    s_is_rendered = false;
+    s_cfg_applied = seq;
+}
+
+/**
+ * @brief エフェクトエンジンの初期化(組み込みエフェクトの登録)
+ *
+ * @param p_neopixel 出力先のNeoPixel
+ */
+void app_fx_init(neopixel_t *p_neopixel)
+{
+    s_p_neopixel = p_neopixel;
+    s_effect_cnt = 0;
+    app_fx_register("fade", fx_render_fade);
+    app_fx_register("rainbow", fx_render_rainbow);
+    app_fx_register("chase", fx_render_chase);
+    app_fx_register("breathe", fx_render_breathe);
+    app_fx_register("sparkle", fx_render_sparkle);
+    app_fx_clear_stat();
+}
+
+/**
+ * @brief エフェクトの登録
+ *
+ * @param p_name 名前(px fx <name>で選ぶ)
+ * @param p_render 描画関数
+ * @return int32_t エフェクトID(-1 = 登録数オーバー)
+ */
+int32_t app_fx_register(const char *p_name, fx_render_t p_render)
+{
+    if (s_effect_cnt >= FX_EFFECT_MAX) {
+        printf("Error: Effect table is full (max %d)\n", FX_EFFECT_MAX);
+        return -1;
+    }
+    s_effect[s_effect_cnt].p_name = p_name;
+    s_effect[s_effect_cnt].p_render = p_render;
+
+    return (int32_t)s_effect_cnt++;
+}
+
+/**
+ * @brief エフェクトを選んで開始(動作中なら切り替え)
+ *
+ * @param p_name エフェクト名
+ * @return true 開始した
+ * @return false 該当するエフェクトが無い
+ */
+bool app_fx_start(const char *p_name)
+{
+    for (uint32_t i = 0; i < s_effect_cnt; i++)
+    {
+        if (strcasecmp(p_name, s_effect[i].p_name) == 0) {
+            s_req_effect = (int32_t)i;
+            app_fx_clear_stat();
+            fx_notify();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief エフェクトを停止(表示はそのまま)
+ */
+void app_fx_stop(void)
+{
+    s_req_effect = -1;
+    fx_notify();
+}
+
+/**
+ * @brief フレームレートの設定(1～FX_FPS_MAX)
+ */
+void app_fx_set_fps(uint32_t fps)
+{
+    s_req_fps = (fps == 0) ? 1 : ((fps > FX_FPS_MAX) ? FX_FPS_MAX : fps);
+    fx_notify();
+}
+
+/**
+ * @brief 全体の輝度の設定(0～255、ガンマの後のリニアな明るさに掛ける)
+ */
+void app_fx_set_brightness(uint8_t brightness)
+{
+    s_req_brightness = brightness;
+    fx_notify();
+}
+
+/**
+ * @brief ガンマ値の設定(x10、10 = リニア)
+ */
+void app_fx_set_gamma(uint32_t gamma_x10)
+{
+    s_req_gamma_x10 = (gamma_x10 < 10) ? 10 : ((gamma_x10 > 40) ? 40 : gamma_x10);
+    fx_notify();
+}
+
+/**
+ * @brief 色補正の設定(LEDの色ごとの明るさの差を合わせる、0xFF = 補正なし)
+ */
+void app_fx_set_correction(uint8_t red, uint8_t green, uint8_t blue)
+{
+    s_req_corr[0] = red;
+    s_req_corr[1] = green;
+    s_req_corr[2] = blue;
+    fx_notify();
+}
+
+/**
+ * @brief 時間方向ディザの設定
+ *
+ * @param dither_bits FX_DITHER_AUTO(出力の速さから決める) | 0(無効) | 1～FX_DITHER_BITS_MAX
+ */
+void app_fx_set_dither(int32_t dither_bits)
+{
+    s_req_dither = (dither_bits < 0) ? FX_DITHER_AUTO :
+                   ((dither_bits > FX_DITHER_BITS_MAX) ? FX_DITHER_BITS_MAX : dither_bits);
+    fx_notify();
+}
+
+/**
+ * @brief 出力フレームの周期(Core0がタイマーの設定に使う)
+ *
+ * @return uint32_t 周期(us)、0 = 停止中
+ */
+uint32_t app_fx_get_period_us(void)
+{
+    return (s_req_effect < 0) ? 0 : fx_calc_out_period_us(s_req_fps, s_req_dither);
+}
+
+/**
+ * @brief 1フレームの描画と送信(Core0の周期タイマーから呼ぶ)
+ */
+void app_fx_tick(void)
+{
+    uint64_t now_us = time_us_64();
+    uint32_t t0_cyc = rp2xxx_get_cycle_cnt();
+    uint32_t t1_cyc, t2_cyc, t3_cyc, cyc, led_cnt, step, fx_frame, jitter_us = 0;
+    uint32_t shift, mask;
+
+    if (s_cfg_applied != s_cfg_seq) {
+        fx_apply_config();
+    }
+    if ((s_effect_id < 0) || (s_p_neopixel == NULL)) {
+        return;
+    }
+
+    // スロットとジッタ(前のフレームからの間隔 - 周期)
+    if (s_prev_us != 0) {
+        uint32_t dt_us = (uint32_t)(now_us - s_prev_us);
+
+        step = (dt_us + (s_period_us / 2u)) / s_period_us;
+        step = (step != 0) ? step : 1u;
+        s_miss_cnt += step - 1u;
+        s_slot += step;
+        jitter_us = (dt_us > (step * s_period_us)) ? (dt_us - (step * s_period_us)) : ((step * s_period_us) - dt_us);
+    }
+    s_prev_us = now_us;
+    s_jitter_sum_us += jitter_us;
+    s_jitter_max_us = (jitter_us > s_jitter_max_us) ? jitter_us : s_jitter_max_us;
+    s_busy_cnt += drv_neopixel_is_busy() ? 1u : 0u;
+
+    // 描画と色変換はエフェクトのフレームが進んだときだけ
+    led_cnt = (s_p_neopixel->led_cnt < FX_LED_MAX) ? s_p_neopixel->led_cnt : FX_LED_MAX;
+    fx_frame = (uint32_t)(((uint64_t)s_slot * s_period_us) / s_fx_period_us);
+    if (!s_is_rendered || (fx_frame != s_fx_frame)) {
+        s_effect[s_effect_id].p_render(s_fx_buf, led_cnt, fx_frame);
+        t1_cyc = rp2xxx_get_cycle_cnt();
+
+        // 色変換 ... ガンマ(16bitリニア) x 輝度 x 色補正 >> 16 = 16bitリニア
+        for (uint32_t i = 0; i < led_cnt; i++)
+        {
+            uint32_t px = s_fx_buf[i].grb_color.u32_grb;
+            s_lin_buf[i][0] = (uint16_t)((s_gamma_lut[(px >> 8) & 0xFFu] * s_scale[0]) >> 16);
+            s_lin_buf[i][1] = (uint16_t)((s_gamma_lut[(px >> 16) & 0xFFu] * s_scale[1]) >> 16);
+            s_lin_buf[i][2] = (uint16_t)((s_gamma_lut[px & 0xFFu] * s_scale[2]) >> 16);
+        }
+        t2_cyc = rp2xxx_get_cycle_cnt();
+
+        cyc = t1_cyc - t0_cyc;
+        s_render_sum_cyc += cyc;
+        s_render_max_cyc = (cyc > s_render_max_cyc) ? cyc : s_render_max_cyc;
+        cyc = t2_cyc - t1_cyc;
+        s_color_sum_cyc += cyc;
+        s_color_max_cyc = (cyc > s_color_max_cyc) ? cyc : s_color_max_cyc;
+        s_fx_frame = fx_frame;
+        s_is_rendered = true;
+        s_render_cnt++;
+    }
+
+    // ディザ ... 16bitの上位(8 + bits)ビットに持ち越した誤差を足し、上位8bitを出して下位を次へ持ち越す
+    t2_cyc = rp2xxx_get_cycle_cnt();
+    shift = 8u - s_dither_bits;
+    mask = (1u << s_dither_bits) - 1u;
+    for (uint32_t i = 0; i < led_cnt; i++)
+    {
+        uint32_t ch[3];
+        for (uint32_t c = 0; c < 3; c++)
+        {
+            uint32_t acc = (uint32_t)s_err_buf[i][c] + ((uint32_t)s_lin_buf[i][c] >> shift);
+            s_err_buf[i][c] = (uint8_t)(acc & mask);
+            acc >>= s_dither_bits;
+            ch[c] = (acc > 0xFFu) ? 0xFFu : acc;
+        }
+        s_out_buf[i].grb_color.u32_grb = (ch[1] << 16) | (ch[0] << 8) | ch[2];
+    }
+    t3_cyc = rp2xxx_get_cycle_cnt();
+
+    drv_neopixel_write(s_p_neopixel, s_out_buf, led_cnt);
+    drv_neopixel_commit(s_p_neopixel);
+
+    // 統計
+    cyc = t3_cyc - t2_cyc;
+    s_dither_sum_cyc += cyc;
+    s_dither_max_cyc = (cyc > s_dither_max_cyc) ? cyc : s_dither_max_cyc;
+    cyc = rp2xxx_get_cycle_cnt() - t0_cyc;
+    s_total_sum_cyc += cyc;
+    s_total_max_cyc = (cyc > s_total_max_cyc) ? cyc : s_total_max_cyc;
+    s_frame_cnt++;
+}
+
+/**
+ * @brief 登録されているエフェクトの一覧
+ */
+void app_fx_list(void)
+{
+    printf("Effects:");
+    for (uint32_t i = 0; i < s_effect_cnt; i++)
+    {
+        printf(" %s", s_effect[i].p_name);
+    }
+    printf("\n");
+}
+
+/**
+ * @brief 設定とフレームの統計(描画時間、画素あたりのCPU、ジッタ、余裕)を表示
+ */
+void app_fx_show_stat(void)
+{
+    uint32_t cyc_per_us = clock_get_hz(clk_sys) / 1000000;
+    uint32_t cnt = s_frame_cnt;
+    uint32_t render_cnt = s_render_cnt;
+    uint32_t period_us = fx_calc_out_period_us(s_req_fps, s_req_dither);
+    uint32_t dither_bits = fx_calc_dither_bits(period_us, s_req_dither);
+    uint32_t led_cnt = (s_p_neopixel != NULL) ? s_p_neopixel->led_cnt : 0;
+    uint32_t wire_us = (led_cnt * NEOPIXEL_WORD_US) + NEOPIXEL_LATCH_US;
+    uint64_t elapsed_us = time_us_64() - s_stat_start_us;
+    uint32_t total_max_us = s_total_max_cyc / cyc_per_us;
+
+    led_cnt = (led_cnt < FX_LED_MAX) ? led_cnt : FX_LED_MAX;
+    printf("\n[NeoPixel FX] %s, %u fps (wire + latch %u us = max %u fps)\n",
+            (s_req_effect >= 0) ? s_effect[s_req_effect].p_name : "stopped", s_req_fps, wire_us, 1000000u / wire_us);
+    printf("Pipeline : gamma %u.%u, brightness %u, correction #%02X%02X%02X\n",
+            s_req_gamma_x10 / 10, s_req_gamma_x10 % 10, s_req_brightness, s_req_corr[0], s_req_corr[1], s_req_corr[2]);
+    printf("Dither   : %u bit%s (%u bit effective), output %u fps (period %u us)\n", dither_bits,
+            (s_req_dither == FX_DITHER_AUTO) ? " auto" : "", 8u + dither_bits, 1000000u / period_us, period_us);
+    printf("Frames   : output %u (measured %u fps), rendered %u, missed slots %u, wire busy %u\n", cnt,
+            (elapsed_us != 0) ? (uint32_t)(((uint64_t)cnt * 1000000u) / elapsed_us) : 0, render_cnt, s_miss_cnt, s_busy_cnt);
+    if ((cnt == 0) || (render_cnt == 0) || (led_cnt == 0)) {
+        return;
+    }
+    printf("CPU (us) : render avg %u max %u, color avg %u max %u, dither avg %u max %u, frame avg %u max %u\n",
+            (uint32_t)(s_render_sum_cyc / render_cnt) / cyc_per_us, s_render_max_cyc / cyc_per_us,
+            (uint32_t)(s_color_sum_cyc / render_cnt) / cyc_per_us, s_color_max_cyc / cyc_per_us,
+            (uint32_t)(s_dither_sum_cyc / cnt) / cyc_per_us, s_dither_max_cyc / cyc_per_us,
+            (uint32_t)(s_total_sum_cyc / cnt) / cyc_per_us, total_max_us);
+    printf("Per pixel: color %u cyc/rendered frame, dither %u cyc/output frame\n",
+            (uint32_t)(s_color_sum_cyc / render_cnt / led_cnt), (uint32_t)(s_dither_sum_cyc / cnt / led_cnt));
+    printf("Jitter   : avg %u us, max %u us\n", (uint32_t)(s_jitter_sum_us / cnt), s_jitter_max_us);
+    printf("Headroom : %u%% of the frame period at the worst frame\n",
+            (total_max_us < period_us) ? ((period_us - total_max_us) * 100u) / period_us : 0);
+}
+
+/**
+ * @brief フレームの統計クリア
+ */
+void app_fx_clear_stat(void)
+{
+    s_stat_start_us = time_us_64();
+    s_frame_cnt = 0;
+    s_render_cnt = 0;
+    s_miss_cnt = 0;
+    s_busy_cnt = 0;
+    s_jitter_sum_us = 0;
+    s_jitter_max_us = 0;
+    s_render_sum_cyc = 0;
+    s_render_max_cyc = 0;
+    s_color_sum_cyc = 0;
+    s_color_max_cyc = 0;
+    s_dither_sum_cyc = 0;
+    s_dither_max_cyc = 0;
+    s_total_sum_cyc = 0;
+    s_total_max_cyc = 0;
+}
@@ -0,0 +1,52 @@
+/**
+ * @file app_fx.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief NeoPixelのエフェクトエンジン(固定フレームレート + ガンマ/輝度/色補正)のヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026 Chimipupu All Rights Reserved.
+ *
+ */
+#ifndef APP_FX_H
+#define APP_FX_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "pico/stdlib.h"
+#include "drv_neopixel.h"
+
+#define FX_EFFECT_MAX           8       // 登録できるエフェクトの最大数
+#define FX_LED_MAX              256     // エンジンが描画するLEDの最大数
+#define FX_FPS_DEFAULT          60      // 既定のフレームレート
+#define FX_FPS_MAX              1000    // 最大フレームレート(イベントループのタイマー周期1ms)
+#define FX_GAMMA_DEFAULT        22      // 既定のガンマ値(x10)
+#define FX_BRIGHTNESS_DEFAULT   255     // 既定の輝度(0～255)
+#define FX_DITHER_AUTO          -1      // ディザの深さをフレームレートから決める
+#define FX_DITHER_BITS_MAX      8       // ディザで足せる最大のビット数(16bitリニア -> 8bit出力)
+#define FX_DITHER_MIN_HZ        100     // ディザの1周期の最低の速さ(これ以下はちらつきが見える)
+
+// エフェクトの描画関数(Core0のスレッド文脈、フレームごと)
+// p_buf ... 作業バッファ(前のフレームの内容が残っている)、frame ... 開始からのフレーム番号
+typedef void (*fx_render_t)(rgb_color_t *p_buf, uint32_t led_cnt, uint32_t frame);
+
+// 関数プロトタイプ
+void app_fx_init(neopixel_t *p_neopixel);
+int32_t app_fx_register(const char *p_name, fx_render_t p_render);
+bool app_fx_start(const char *p_name);
+void app_fx_stop(void);
+void app_fx_set_fps(uint32_t fps);
+void app_fx_set_brightness(uint8_t brightness);
+void app_fx_set_gamma(uint32_t gamma_x10);
+void app_fx_set_correction(uint8_t red, uint8_t green, uint8_t blue);
+void app_fx_set_dither(int32_t dither_bits);
+uint32_t app_fx_get_period_us(void);
+void app_fx_tick(void);
+void app_fx_list(void);
+void app_fx_show_stat(void);
+void app_fx_clear_stat(void);
+
+#endif // APP_FX_H
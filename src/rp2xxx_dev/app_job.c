@@ -0,0 +1,431 @@
+/**
+ * @file app_job.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief ジョブ(Core0へのコマンドのオフロード)アプリ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026 Chimipupu All Rights Reserved.
+ *
+ * Core1(モニタ)がジョブを登録してIPCリングでCore0に通知し、Core0がコマンドを実行する。
+ * ジョブ実行中のCore0の出力はstdioのフィルタドライバでジョブごとの
+ * リングバッファに振り分け、Core1のwaitで取り出して表示する。
+ * 状態の書き込みは FREE->QUEUED と DONE/KILLED->FREE がCore1、
+ * QUEUED->RUNNING->DONE/KILLED がCore0 の片側だけなのでロック不要。
+ */
+#include "app_job.h"
+#include "muc_rpxxx_util.h"
+#include "drv_ipc.h"
+#include "pico/multicore.h"
+#if LIB_PICO_STDIO_USB
+#include "pico/stdio_usb.h"
+#endif
+
+#define JOB_WAIT_POLL_US        1000    // waitで出力を取り出す間隔
+#define KEY_CTRL_C              0x03
+
+// ジョブ
+typedef struct {
+    uint32_t id;                        // ジョブID(1～)
+    volatile job_state_t state;         // 状態
+    volatile bool is_cancel;            // 中断要求(協調的に中断)
+    char cmd[DBG_CMD_MAX_LEN];          // コマンド文字列
+    uint64_t queue_time_us;             // 登録時刻
+    volatile uint64_t start_time_us;    // 実行開始時刻
+    volatile uint64_t end_time_us;      // 実行終了時刻
+    volatile uint32_t cycle;            // 実行サイクル数(32bitでラップ)
+    volatile uint32_t out_wr;           // 出力リングバッファの書き込み位置(Core0)
+    volatile uint32_t out_rd;           // 出力リングバッファの読み出し位置(Core1)
+    volatile uint32_t out_total;        // 出力の総Byte数
+    volatile uint32_t out_lost;         // バッファ溢れで捨てたByte数
+    char out_buf[JOB_OUT_BUF_SIZE];
+} job_t;
+
+static job_t s_job[JOB_MAX];
+static uint32_t s_job_id_seq = 0;
+static job_t *volatile s_p_cur_job = NULL;    // Core0で実行中のジョブ
+
+static const char *s_p_state_str[] = {"Free", "Queued", "Running", "Done", "Killed"};
+
+static job_t *job_find(uint32_t id);
+static bool job_is_finished(const job_t *p_job);
+static void job_out_write(job_t *p_job, const char *p_buf, int len);
+static void job_out_drain(job_t *p_job);
+static void job_print_summary(const job_t *p_job);
+
+#if LIB_PICO_STDIO_USB
+static bool s_is_last_cr = false;
+
+static void job_stdio_out_chars(const char *p_buf, int len);
+static void job_stdio_out_flush(void);
+static int job_stdio_in_chars(char *p_buf, int len);
+
+// 全出力を受けるフィルタドライバ(ジョブ以外はstdio_usbにそのまま流す)
+static stdio_driver_t s_job_stdio = {
+    .out_chars = job_stdio_out_chars,
+    .out_flush = job_stdio_out_flush,
+    .in_chars = job_stdio_in_chars,
+};
+
+// stdio_usbの改行変換の設定に従ってUSBに出力
+static void job_usb_out(const char *p_buf, int len)
+{
+    int32_t first = 0;
+
+    if (!stdio_usb.crlf_enabled) {
+        stdio_usb.out_chars(p_buf, len);
+        return;
+    }
+
+    for (int32_t i = 0; i < len; i++)
+    {
+        bool is_prev_cr = (i > 0) ? (p_buf[i - 1] == '\r') : s_is_last_cr;
+
+        if ((p_buf[i] == '\n') && !is_prev_cr) {
+            if (i > first) {
+                stdio_usb.out_chars(&p_buf[first], i - first);
+            }
+            stdio_usb.out_chars("\r", 1);
+            first = i;
+        }
+    }
+    if (len > first) {
+        stdio_usb.out_chars(&p_buf[first], len - first);
+    }
+    if (len > 0) {
+        s_is_last_cr = (p_buf[len - 1] == '\r');
+    }
+}
+
+static void job_stdio_out_chars(const char *p_buf, int len)
+{
+    job_t *p_job = s_p_cur_job;
+
+    if ((p_job != NULL) && (get_core_num() == JOB_CORE_NUM)) {
+        job_out_write(p_job, p_buf, len);
+    } else {
+        job_usb_out(p_buf, len);
+    }
+}
+
+static void job_stdio_out_flush(void)
+{
+    if ((s_p_cur_job == NULL) || (get_core_num() != JOB_CORE_NUM)) {
+        if (stdio_usb.out_flush != NULL) {
+            stdio_usb.out_flush();
+        }
+    }
+}
+
+static int job_stdio_in_chars(char *p_buf, int len)
+{
+    return stdio_usb.in_chars(p_buf, len);
+}
+#endif // LIB_PICO_STDIO_USB
+
+static job_t *job_find(uint32_t id)
+{
+    for (uint32_t i = 0; i < JOB_MAX; i++)
+    {
+        if ((s_job[i].state != JOB_STATE_FREE) && (s_job[i].id == id)) {
+            return &s_job[i];
+        }
+    }
+
+    return NULL;
+}
+
+static bool job_is_finished(const job_t *p_job)
+{
+    return (p_job->state == JOB_STATE_DONE) || (p_job->state == JOB_STATE_KILLED);
+}
+
+// Core0から出力をリングバッファに書く(溢れた分は捨てて数える)
+static void job_out_write(job_t *p_job, const char *p_buf, int len)
+{
+    uint32_t wr = p_job->out_wr;
+    uint32_t free_len = JOB_OUT_BUF_SIZE - (wr - p_job->out_rd);
+    uint32_t n = ((uint32_t)len < free_len) ? (uint32_t)len : free_len;
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        p_job->out_buf[(wr + i) & (JOB_OUT_BUF_SIZE - 1)] = p_buf[i];
+    }
+    __mem_fence_release();
+    p_job->out_wr = wr + n;
+    p_job->out_total += (uint32_t)len;
+    p_job->out_lost += (uint32_t)len - n;
+}
+
+// Core1でリングバッファの出力を表示する
+static void job_out_drain(job_t *p_job)
+{
+    uint32_t wr = p_job->out_wr;
+    uint32_t rd = p_job->out_rd;
+
+    __mem_fence_acquire();
+    while (rd != wr)
+    {
+        uint32_t pos = rd & (JOB_OUT_BUF_SIZE - 1);
+        uint32_t len = JOB_OUT_BUF_SIZE - pos;
+
+        if (len > (wr - rd)) {
+            len = wr - rd;
+        }
+        fwrite(&p_job->out_buf[pos], 1, len, stdout);
+        rd += len;
+    }
+    fflush(stdout);
+    __mem_fence_release();
+    p_job->out_rd = rd;
+}
+
+static void job_print_summary(const job_t *p_job)
+{
+    // 出力が改行で終わっていなければ改行してから表示
+    if ((p_job->out_wr != 0) && (p_job->out_buf[(p_job->out_wr - 1) & (JOB_OUT_BUF_SIZE - 1)] != '\n')) {
+        printf("\n");
+    }
+    printf("[%u] %s '%s' (queue: %llu us, run: %llu us, %u cycles, out: %u bytes",
+            p_job->id, s_p_state_str[p_job->state], p_job->cmd,
+            (unsigned long long)(p_job->start_time_us - p_job->queue_time_us),
+            (unsigned long long)(p_job->end_time_us - p_job->start_time_us),
+            p_job->cycle, p_job->out_total);
+    if (p_job->out_lost != 0) {
+        printf(", lost: %u bytes", p_job->out_lost);
+    }
+    printf(")\n");
+}
+
+/**
+ * @brief ジョブの初期化(stdioのフィルタドライバを登録)
+ */
+void app_job_init(void)
+{
+    memset(s_job, 0, sizeof(s_job));
+    s_job_id_seq = 0;
+    s_p_cur_job = NULL;
+
+#if LIB_PICO_STDIO_USB
+    s_job_stdio.crlf_enabled = false;
+    stdio_set_driver_enabled(&s_job_stdio, true);
+    stdio_filter_driver(&s_job_stdio);
+#endif
+}
+
+/**
+ * @brief ジョブを登録してCore0に通知
+ *
+ * @param p_cmd_line コマンド文字列
+ * @return int32_t ジョブID、空きが無ければ-1、Core0に通知できなければ-2
+ */
+int32_t app_job_submit(const char *p_cmd_line)
+{
+    job_t *p_job = NULL;
+
+    for (uint32_t i = 0; i < JOB_MAX; i++)
+    {
+        if (s_job[i].state == JOB_STATE_FREE) {
+            p_job = &s_job[i];
+            break;
+        }
+    }
+    if (p_job == NULL) {
+        return -1;
+    }
+
+    p_job->id = ++s_job_id_seq;
+    strncpy(p_job->cmd, p_cmd_line, DBG_CMD_MAX_LEN - 1);
+    p_job->cmd[DBG_CMD_MAX_LEN - 1] = '\0';
+    p_job->is_cancel = false;
+    p_job->out_wr = 0;
+    p_job->out_rd = 0;
+    p_job->out_total = 0;
+    p_job->out_lost = 0;
+    p_job->cycle = 0;
+    p_job->queue_time_us = time_us_64();
+    p_job->start_time_us = p_job->queue_time_us;
+    p_job->end_time_us = p_job->queue_time_us;
+    __mem_fence_release();
+    p_job->state = JOB_STATE_QUEUED;
+
+#if defined(RP2XXX_USE_FREERTOS)
+    set_multicore_fifo(PROC_JOB_RUN);
+#else
+    // FIFOは満杯だと通知を落とすのでリングで送る(送れなければ登録を取り消す)
+    if (!drv_ipc_send_code(PROC_JOB_RUN)) {
+        p_job->state = JOB_STATE_FREE;
+        return -2;
+    }
+#endif
+
+    return (int32_t)p_job->id;
+}
+
+/**
+ * @brief ジョブの中断要求(終了済みのジョブは出力を捨てて解放)
+ *
+ * @param id ジョブID
+ * @return true 中断を要求した or 解放した
+ * @return false ジョブが無い
+ */
+bool app_job_kill(uint32_t id)
+{
+    job_t *p_job = job_find(id);
+
+    if (p_job == NULL) {
+        return false;
+    }
+
+    if (job_is_finished(p_job)) {
+        p_job->state = JOB_STATE_FREE;
+    } else {
+        p_job->is_cancel = true;
+    }
+
+    return true;
+}
+
+/**
+ * @brief ジョブの終了を待ち、出力を表示する(ESC or Ctrl-Cで待ちを抜ける)
+ *
+ * @param id ジョブID(0 ... 全ジョブ)
+ * @return true 終了した
+ * @return false ジョブが無い or 待ちを中断した
+ */
+bool app_job_wait(uint32_t id)
+{
+    job_t *p_job;
+    bool is_finished;
+    int c;
+
+    if (id == 0) {
+        // ID順に全ジョブを待つ
+        for (uint32_t next = 1; next <= s_job_id_seq; next++)
+        {
+            if ((job_find(next) != NULL) && !app_job_wait(next)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    p_job = job_find(id);
+    if (p_job == NULL) {
+        printf("Error: No such job [%u]\n", id);
+        return false;
+    }
+
+    while (1)
+    {
+        is_finished = job_is_finished(p_job);
+        job_out_drain(p_job);
+        if (is_finished) {
+            break;
+        }
+
+        WDT_RST();
+        c = getchar_timeout_us(JOB_WAIT_POLL_US);
+        if ((c == KEY_ESC) || (c == KEY_CTRL_C)) {
+            printf("\n[%u] Wait interrupted (job is still %s)\n", p_job->id, s_p_state_str[p_job->state]);
+            return false;
+        }
+    }
+
+    job_print_summary(p_job);
+    p_job->state = JOB_STATE_FREE;
+
+    return true;
+}
+
+/**
+ * @brief ジョブの一覧表示(出力を取り出し済みの終了ジョブは解放する)
+ */
+void app_job_list(void)
+{
+    uint64_t now = time_us_64();
+
+    printf("\n[Jobs (core %d)]\n", JOB_CORE_NUM);
+    printf(" ID  State     Queue(us)     Run(us)   Out(B)  Lost(B)  Command\n");
+    for (uint32_t i = 0; i < JOB_MAX; i++)
+    {
+        job_t *p_job = &s_job[i];
+        job_state_t state = p_job->state;
+        uint64_t start = (state == JOB_STATE_QUEUED) ? now : p_job->start_time_us;
+        uint64_t end = (state == JOB_STATE_RUNNING) ? now : p_job->end_time_us;
+
+        if (state == JOB_STATE_FREE) {
+            continue;
+        }
+
+        printf("%3u  %-8s %10llu %11llu %8u %8u  %s\n", p_job->id, s_p_state_str[state],
+                (unsigned long long)(start - p_job->queue_time_us),
+                (unsigned long long)((state == JOB_STATE_QUEUED) ? 0 : (end - start)),
+                p_job->out_total, p_job->out_lost, p_job->cmd);
+
+        if (job_is_finished(p_job) && (p_job->out_rd == p_job->out_wr)) {
+            p_job->state = JOB_STATE_FREE;
+        }
+    }
+}
+
+/**
+ * @brief 待ちジョブを登録順に実行する(Core0がPROC_JOB_RUNで呼ぶ)
+ */
+void app_job_core_0_run(void)
+{
+    job_t *p_job;
+    uint32_t t0_cyc;
+
+    while (1)
+    {
+        p_job = NULL;
+        for (uint32_t i = 0; i < JOB_MAX; i++)
+        {
+            if ((s_job[i].state == JOB_STATE_QUEUED) && ((p_job == NULL) || (s_job[i].id < p_job->id))) {
+                p_job = &s_job[i];
+            }
+        }
+        if (p_job == NULL) {
+            break;
+        }
+        __mem_fence_acquire();
+
+        p_job->start_time_us = time_us_64();
+        if (p_job->is_cancel) {
+            p_job->end_time_us = p_job->start_time_us;
+            __mem_fence_release();
+            p_job->state = JOB_STATE_KILLED;
+            continue;
+        }
+
+        p_job->state = JOB_STATE_RUNNING;
+        s_p_cur_job = p_job;
+        __mem_fence_release();
+
+        t0_cyc = rp2xxx_get_cycle_cnt();
+        if (!dbg_com_exec_line(p_job->cmd)) {
+            printf("Error: Unknown command '%s'\n", p_job->cmd);
+        }
+        p_job->cycle = rp2xxx_get_cycle_cnt() - t0_cyc;
+        p_job->end_time_us = time_us_64();
+
+        s_p_cur_job = NULL;
+        __mem_fence_release();
+        p_job->state = p_job->is_cancel ? JOB_STATE_KILLED : JOB_STATE_DONE;
+        WDT_RST();
+    }
+}
+
+/**
+ * @brief 実行中のジョブに中断要求が来ているか(長い処理のループから呼ぶ)
+ *
+ * @return true 中断要求あり
+ * @return false 中断要求なし or ジョブ以外から呼ばれた
+ */
+bool app_job_is_cancel(void)
+{
+    job_t *p_job = s_p_cur_job;
+
+    return (p_job != NULL) && (get_core_num() == JOB_CORE_NUM) && p_job->is_cancel;
+}
@@ -0,0 +1,44 @@
+/**
+ * @file app_job.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief ジョブ(Core0へのコマンドのオフロード)アプリのヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026 Chimipupu All Rights Reserved.
+ *
+ */
+#ifndef APP_JOB_H
+#define APP_JOB_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "pico/stdlib.h"
+#include "dbg_com.h"
+
+#define JOB_MAX                 4       // 同時に保持するジョブの最大数
+#define JOB_OUT_BUF_SIZE        4096    // ジョブごとの出力バッファ(Byte) ※2のべき乗
+#define JOB_CORE_NUM            0       // ジョブを実行するコア
+
+// ジョブの状態
+typedef enum {
+    JOB_STATE_FREE,         // 未使用
+    JOB_STATE_QUEUED,       // 実行待ち
+    JOB_STATE_RUNNING,      // 実行中
+    JOB_STATE_DONE,         // 完了
+    JOB_STATE_KILLED,       // 中断
+} job_state_t;
+
+// 関数プロトタイプ
+void app_job_init(void);
+int32_t app_job_submit(const char *p_cmd_line);
+bool app_job_kill(uint32_t id);
+bool app_job_wait(uint32_t id);
+void app_job_list(void);
+void app_job_core_0_run(void);
+bool app_job_is_cancel(void);
+
+#endif // APP_JOB_H
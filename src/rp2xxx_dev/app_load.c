@@ -0,0 +1,222 @@
+/**
+ * @file app_load.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief コアごとのCPU負荷(アイドル時間)とスタック最大使用量の計測
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026 Chimipupu All Rights Reserved.
+ *
+ * アイドル ... 各コアが仕事を待つ所でapp_load_idle_enter()/exit()を呼び、待ち時間を積算する
+ *   Core0 ... イベントループのWFE
+ *   Core1 ... モニタのキー入力待ち(getchar)
+ * 1秒ごとにCore0のタイマー割り込みで積算値の差分から負荷を出し、直近60秒分を保持する。
+ * 積算値は持ち主のコアが書いて他のコアが読むのでシーケンスロックで守る。
+ * スタック ... 起動時に未使用部分を塗り、塗った値が残っていない深さを最大使用量とする。
+ */
+#include "app_load.h"
+#include "muc_rpxxx_util.h"
+#include "drv_lock.h"
+
+// リンカスクリプトのスタック領域(Core0 ... SCRATCH_Y, Core1 ... SCRATCH_X)
+extern uint32_t __StackBottom;
+extern uint32_t __StackTop;
+extern uint32_t __StackOneBottom;
+extern uint32_t __StackOneTop;
+
+// コアごとのアイドル時間
+typedef struct {
+    lock_seq_t seq;
+    uint64_t idle_us;                   // 積算(待ち中の分は含まない)
+    uint64_t idle_start_us;             // 待ちに入った時刻
+    bool is_idle;
+} load_core_t;
+
+static const uint8_t s_win_tbl[] = {1, 10, 60};    // 移動平均の秒数
+
+static load_core_t s_core[NUM_CORES];
+static bool s_is_init = false;
+static repeating_timer_t s_timer;
+
+// サンプル(Core0のタイマー割り込みが書く)
+static uint64_t s_prev_idle_us[NUM_CORES];
+static uint64_t s_prev_us = 0;
+static uint16_t s_busy_permil[NUM_CORES][LOAD_HIST_LEN];
+static volatile uint32_t s_hist_idx = 0;            // 次に書く位置
+static volatile uint32_t s_hist_cnt = 0;
+
+static bool load_timer_callback(repeating_timer_t *p_timer);
+
+// 待ち中の分も含めたアイドル時間
+static uint64_t load_idle_snapshot(load_core_t *p_core, uint64_t now_us)
+{
+    uint64_t idle_us;
+    uint32_t seq;
+
+    do {
+        seq = drv_lock_seq_read_begin(&p_core->seq);
+        idle_us = p_core->idle_us;
+        if (p_core->is_idle) {
+            idle_us += now_us - p_core->idle_start_us;
+        }
+    } while (drv_lock_seq_read_retry(&p_core->seq, seq));
+
+    return idle_us;
+}
+
+// 負荷のサンプリング(Core0のタイマー割り込み)
+static bool load_timer_callback(repeating_timer_t *p_timer)
+{
+    uint64_t now_us = time_us_64();
+    uint64_t dt_us = now_us - s_prev_us;
+    uint32_t idx = s_hist_idx;
+
+    (void)p_timer;
+    for (uint32_t core = 0; core < NUM_CORES; core++)
+    {
+        uint64_t idle_us = load_idle_snapshot(&s_core[core], now_us);
+        uint64_t d_idle_us = idle_us - s_prev_idle_us[core];
+
+        d_idle_us = (d_idle_us > dt_us) ? dt_us : d_idle_us;
+        s_busy_permil[core][idx] = (dt_us != 0) ? (uint16_t)(1000u - ((d_idle_us * 1000u) / dt_us)) : 0;
+        s_prev_idle_us[core] = idle_us;
+    }
+    s_prev_us = now_us;
+    s_hist_idx = (idx + 1) % LOAD_HIST_LEN;
+    s_hist_cnt = (s_hist_cnt < LOAD_HIST_LEN) ? (s_hist_cnt + 1) : LOAD_HIST_LEN;
+
+    return true;
+}
+
+// 未使用部分を塗る(p_limit以上は塗らない)
+static void load_stack_paint(uint32_t *p_bottom, uint32_t *p_top, const uint8_t *p_limit)
+{
+    uint32_t *p_end = p_top;
+
+    if (((const uint8_t *)p_bottom < p_limit) && (p_limit < (const uint8_t *)p_top)) {
+        p_end = (uint32_t *)((uintptr_t)p_limit & ~(uintptr_t)3u);
+    }
+    for (uint32_t *p = p_bottom; p < p_end; p++)
+    {
+        *p = LOAD_STACK_PAINT;
+    }
+}
+
+// 最大使用量(塗った値が残っていない深さ)
+static uint32_t load_stack_used(const uint32_t *p_bottom, const uint32_t *p_top)
+{
+    const uint32_t *p = p_bottom;
+
+    while ((p < p_top) && (*p == LOAD_STACK_PAINT)) {
+        p++;
+    }
+
+    return (uint32_t)((uintptr_t)p_top - (uintptr_t)p);
+}
+
+/**
+ * @brief スタックを塗って負荷のサンプリングを開始(Core0でCore1の起動前に呼ぶ)
+ */
+void app_load_init(void)
+{
+    const uint8_t *p_sp = (const uint8_t *)__builtin_frame_address(0);
+
+    // Core0は今使っている所より上を残す、Core1はまだ起動していないので全部
+    load_stack_paint(&__StackBottom, &__StackTop, p_sp - LOAD_STACK_MARGIN);
+    load_stack_paint(&__StackOneBottom, &__StackOneTop, NULL);
+
+    for (uint32_t core = 0; core < NUM_CORES; core++)
+    {
+        memset(&s_core[core], 0, sizeof(load_core_t));
+        drv_lock_seq_init(&s_core[core].seq, (core == 0) ? "load-c0" : "load-c1");
+        s_prev_idle_us[core] = 0;
+    }
+    s_prev_us = time_us_64();
+    s_is_init = add_repeating_timer_ms(LOAD_SAMPLE_MS, load_timer_callback, NULL, &s_timer);
+}
+
+/**
+ * @brief アイドル開始(仕事を待つ直前に呼ぶ、呼んだコアの分)
+ */
+void app_load_idle_enter(void)
+{
+    load_core_t *p_core = &s_core[get_core_num()];
+    uint32_t irq;
+
+    if (!s_is_init) {
+        return;
+    }
+
+    irq = drv_lock_seq_write_begin(&p_core->seq);
+    p_core->idle_start_us = time_us_64();
+    p_core->is_idle = true;
+    drv_lock_seq_write_end(&p_core->seq, irq);
+}
+
+/**
+ * @brief アイドル終了(仕事が来たら呼ぶ、呼んだコアの分)
+ */
+void app_load_idle_exit(void)
+{
+    load_core_t *p_core = &s_core[get_core_num()];
+    uint32_t irq;
+
+    if (!s_is_init || !p_core->is_idle) {
+        return;
+    }
+
+    irq = drv_lock_seq_write_begin(&p_core->seq);
+    p_core->idle_us += time_us_64() - p_core->idle_start_us;
+    p_core->is_idle = false;
+    drv_lock_seq_write_end(&p_core->seq, irq);
+}
+
+/**
+ * @brief コアごとの負荷(直近1/10/60秒)とスタックの最大使用量を表示
+ */
+void app_load_show(void)
+{
+    uint32_t hist_cnt = s_hist_cnt;
+    uint32_t idx = s_hist_idx;
+    uint32_t stack_top[NUM_CORES] = {(uint32_t)(uintptr_t)&__StackTop, (uint32_t)(uintptr_t)&__StackOneTop};
+    uint32_t stack_size[NUM_CORES] = {
+        (uint32_t)((uintptr_t)&__StackTop - (uintptr_t)&__StackBottom),
+        (uint32_t)((uintptr_t)&__StackOneTop - (uintptr_t)&__StackOneBottom),
+    };
+    uint32_t stack_used[NUM_CORES] = {
+        load_stack_used(&__StackBottom, &__StackTop),
+        load_stack_used(&__StackOneBottom, &__StackOneTop),
+    };
+
+    if (!s_is_init) {
+        printf("Error: Load sampling is not running\n");
+        return;
+    }
+
+    printf("\n[CPU Load] busy %% over the last 1/10/60 s (%u s sampled)\n", hist_cnt);
+    printf("Core      1s     10s     60s   Stack used/size (top)\n");
+    for (uint32_t core = 0; core < NUM_CORES; core++)
+    {
+        printf("%4u", core);
+        for (uint32_t w = 0; w < count_of(s_win_tbl); w++)
+        {
+            uint32_t n = (s_win_tbl[w] < hist_cnt) ? s_win_tbl[w] : hist_cnt;
+            uint32_t sum = 0;
+
+            for (uint32_t i = 1; i <= n; i++)
+            {
+                sum += s_busy_permil[core][(idx + LOAD_HIST_LEN - i) % LOAD_HIST_LEN];
+            }
+            if (n == 0) {
+                printf("       -");
+            } else {
+                printf("  %3u.%u%%", (sum / n) / 10, (sum / n) % 10);
+            }
+        }
+        printf("   %4u/%4u B %3u%% (0x%08X)\n", stack_used[core], stack_size[core],
+                (stack_size[core] != 0) ? (stack_used[core] * 100u) / stack_size[core] : 0, stack_top[core]);
+    }
+#if defined(RP2XXX_USE_FREERTOS)
+    printf("FreeRTOS: idle hooks are not wired, per-task load is in 'top' (stack = MSP used by ISRs)\n");
+#endif
+}
@@ -0,0 +1,32 @@
+/**
+ * @file app_load.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief コアごとのCPU負荷(アイドル時間)とスタック最大使用量の計測のヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026 Chimipupu All Rights Reserved.
+ *
+ */
+#ifndef APP_LOAD_H
+#define APP_LOAD_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "pico/stdlib.h"
+
+#define LOAD_SAMPLE_MS          1000        // 負荷のサンプリング周期
+#define LOAD_HIST_LEN           60          // 保持するサンプル数(= 最長の移動平均の秒数)
+#define LOAD_STACK_PAINT        0x57AC57ACu // スタックを塗る値
+#define LOAD_STACK_MARGIN       256         // 起動時に塗らない現在のSPより上の余白(バイト)
+
+// 関数プロトタイプ
+void app_load_init(void);
+void app_load_idle_enter(void);
+void app_load_idle_exit(void);
+void app_load_show(void);
+
+#endif // APP_LOAD_H
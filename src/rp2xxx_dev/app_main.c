@@ -20,9 +20,9 @@
  * @param dump_addr ダンプするメモリの32bitアドレス
  * @param dump_size ダンプするサイズ(Byte)
  */
-void show_mem_dump(uint32_t dump_addr, uint32_t dump_size)
+void show_mem_dump(uintptr_t dump_addr, uint32_t dump_size)
 {
-    printf("\n[Memory Dump '(addr:0x%04X)]\n", dump_addr);
+    printf("\n[Memory Dump '(addr:0x%04X)]\n", (uint32_t)dump_addr);
 
     // ヘッダー行を表示
     printf("Address  ");
@@ -41,7 +41,7 @@ void show_mem_dump(uint32_t dump_addr, uint32_t dump_size)
     // 16バイトずつダンプ
     for (uint32_t offset = 0; offset < dump_size; offset += 16)
     {
-        printf("%08X: ", dump_addr + offset);
+        printf("%08X: ", (uint32_t)(dump_addr + offset));
 
         // 16バイト分のデータを表示
         for (int i = 0; i < 16; i++)
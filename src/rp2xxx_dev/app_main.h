@@ -28,7 +28,7 @@
 #define FW_VERSION_MINOR        1
 #define FW_VERSION_REVISION     0
 
-void show_mem_dump(uint32_t dump_addr, uint32_t dump_size);
+void show_mem_dump(uintptr_t dump_addr, uint32_t dump_size);
 void core_0_main(void);
 void core_1_main(void);
 void i2c_slave_scan(uint8_t i2c_port);
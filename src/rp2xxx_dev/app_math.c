@@ -10,12 +10,13 @@
  */
 #include "app_math.h"
 #include "muc_rpxxx_util.h"
+#include "app_job.h"
 
 #define MATH_PI_CALC_TIME   3
 #define FIBONACCI_N         20
 #define INVSQRT_N           7
-#define WIDTH               80
-#define HEIGHT              40
+#define WIDTH               MANDELBROT_WIDTH
+#define HEIGHT              MANDELBROT_HEIGHT
 #define MAX_ITER            1000
 
 // 計算精度の表示（期待値:-7497258.185...）
@@ -125,13 +126,13 @@ double app_math_napier_calc(void)
 // 高速逆平方根
 float app_math_fast_inv_sqrt(float num)
 {
-    long i;
+    int32_t i;
     float x2, y;
     const float threehalfs = 1.5F;
 
     x2 = num * 0.5F;
     y = num;
-    i = *(long *)&y;                     // 浮動小数点数をビットパターンとして解釈
+    i = *(int32_t *)&y;                    // 浮動小数点数をビットパターンとして解釈
     i = 0x5f3759df - (i >> 1);           // ビット操作による初期推定値
     y = *(float *)&i;                    // 初期推定値を浮動小数点数に戻す
     y = y * (threehalfs - (x2 * y * y)); // ニュートン法による補正
@@ -184,35 +185,55 @@ void app_math_pi_show(uint32_t n)
     printf("proc time : %d usec\n", end_time - start_time);
 }
 
-// マンデルブロ集合の描画
-void app_math_mandelbrot(void)
+/**
+ * @brief マンデルブロ集合の1行を計算
+ *
+ * @param y 行(0 ～ MANDELBROT_HEIGHT - 1)
+ * @param p_line 描画文字の格納先(MANDELBROT_WIDTH文字、不要ならNULL)
+ * @return uint32_t 行の反復回数の合計(行ごとの計算量)
+ */
+uint32_t app_math_mandelbrot_row(uint32_t y, char *p_line)
 {
-    for (int y = 0; y < HEIGHT; y++)
+    uint32_t iter_sum = 0;
+
+    for (int x = 0; x < WIDTH; x++)
     {
-        for (int x = 0; x < WIDTH; x++)
+        double c_re = (x - WIDTH / 2.0) * 4.0 / WIDTH;   // xのスケーリング
+        double c_im = ((int)y - HEIGHT / 2.0) * 4.0 / HEIGHT; // yのスケーリング
+        double z_re = c_re, z_im = c_im;
+        int iteration;
+
+        for (iteration = 0; iteration < MAX_ITER; iteration++)
         {
-            double c_re = (x - WIDTH / 2.0) * 4.0 / WIDTH;   // xのスケーリング
-            double c_im = (y - HEIGHT / 2.0) * 4.0 / HEIGHT; // yのスケーリング
-            double z_re = c_re, z_im = c_im;
-            int iteration;
-
-            for (iteration = 0; iteration < MAX_ITER; iteration++)
-            {
-                if (z_re * z_re + z_im * z_im > 4.0)
-                    break; // 発散判定
-
-                double z_re_new = z_re * z_re - z_im * z_im + c_re;
-                z_im = 2.0 * z_re * z_im + c_im;
-                z_re = z_re_new;
-            }
-
-            char symbol = (iteration == MAX_ITER) ? '#' : ' ';
-            printf("%c", symbol);
+            if (z_re * z_re + z_im * z_im > 4.0)
+                break; // 発散判定
+
+            double z_re_new = z_re * z_re - z_im * z_im + c_re;
+            z_im = 2.0 * z_re * z_im + c_im;
+            z_re = z_re_new;
+        }
+
+        iter_sum += iteration;
+        if (p_line != NULL) {
+            p_line[x] = (iteration == MAX_ITER) ? '#' : ' ';
         }
-        printf("\n");
     }
+
+    return iter_sum;
 }
 
+// マンデルブロ集合の描画
+void app_math_mandelbrot(void)
+{
+    char line[WIDTH + 1];
+
+    line[WIDTH] = '\0';
+    for (int y = 0; (y < HEIGHT) && !app_job_is_cancel(); y++)
+    {
+        app_math_mandelbrot_row(y, line);
+        printf("%s\n", line);
+    }
+}
 
 void int_add_test(void)
 {
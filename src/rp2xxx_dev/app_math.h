@@ -30,6 +30,9 @@
 #define MATH_E      M_E
 #endif
 
+#define MANDELBROT_WIDTH    80  // マンデルブロ集合の横幅(文字)
+#define MANDELBROT_HEIGHT   40  // マンデルブロ集合の行数
+
 #define UNKNOWN_VAL    0
 
 // 四則演算の回数（整数、float,double）100万回
@@ -49,6 +52,7 @@ float app_math_fast_inv_sqrt(float num);
 void app_math_fibonacci(uint32_t n);
 void app_math_prime(uint32_t n);
 void app_math_mandelbrot(void);
+uint32_t app_math_mandelbrot_row(uint32_t y, char *p_line);
 void app_math_math_test(void);
 void trig_functions_test(void);
 void atan2_test(void);
@@ -0,0 +1,623 @@
+/**
+ * @file app_mct.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief コア間通信のベンチマーク(FIFO/Doorbell/共有メモリ/H/Wスピンロック)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026 Chimipupu All Rights Reserved.
+ *
+ * Core1が要求側、Core0が応答側(PROC_MCT_SERVERで起動)で同じ往復を繰り返し、
+ * Core1のサイクルカウンタで1往復ごとの時間を記録してヒストグラムにする。
+ * 応答側は計測中イベントループに戻らないので、FIFOも計測用に占有できる。
+ * ※RP2040はDWTが無いのでサイクル数はタイマー(1us)からの換算
+ */
+#include "app_mct.h"
+#include "muc_rpxxx_util.h"
+#include "drv_ipc.h"
+#include "pico/multicore.h"
+#include "hardware/sync.h"
+#include "hardware/irq.h"
+
+#define MCT_WARMUP_CNT          1       // 先頭の往復は暖機として記録しない
+
+// 応答側の状態
+typedef enum {
+    MCT_STATE_IDLE,
+    MCT_STATE_READY,        // 応答側が待機に入った
+    MCT_STATE_DONE,         // 応答側が終わった(割り込み設定も元に戻した)
+} mct_state_t;
+
+// 両コアで共有する計測の状態
+typedef struct {
+    volatile uint32_t mode;
+    volatile uint32_t cnt;              // 往復数(一括転送はスロット数)
+    volatile uint32_t state;
+    volatile uint32_t err;              // 応答側で起きたタイムアウト/不一致
+    volatile uint32_t ping;             // spin/sev ... Core1 -> Core0
+    volatile uint32_t pong;             // spin/sev ... Core0 -> Core1
+    volatile uint32_t token;            // lock ... スピンロックで守る受け渡し
+    volatile uint32_t bulk_wr;          // bulk ... 書いたスロット数
+    volatile uint32_t bulk_rd;          // bulk ... 読んだスロット数
+    volatile uint32_t bulk_sum;         // bulk ... 応答側が読んだデータの和
+    uint32_t bulk_buf[MCT_BULK_SLOT_NUM][MCT_BULK_SLOT_SIZE / sizeof(uint32_t)];
+} mct_shared_t;
+
+// 計測結果
+typedef struct {
+    uint32_t cnt;
+    uint32_t min;
+    uint32_t p50;
+    uint32_t p90;
+    uint32_t p99;
+    uint32_t max;
+    uint64_t sum;
+} mct_result_t;
+
+static const char *s_p_mode_str[] = {"fifo", "bell", "spin", "sev", "lock", "bulk"};
+
+static mct_shared_t s_mct;
+static uint32_t s_sample[MCT_SAMPLE_MAX];
+static int32_t s_spin_lock_num = -1;
+#if defined(MCU_RP2350)
+static int32_t s_doorbell = -1;
+#endif
+
+// スピン待ち1回分 + 計測全体の締め切り(ループ内で毎回時刻を読まないよう256回に1回だけ判定)
+static inline bool mct_is_timeout(uint32_t *p_spin, uint64_t end_us)
+{
+    tight_loop_contents();
+    if ((++(*p_spin) & 0xFF) != 0) {
+        return false;
+    }
+
+    return time_us_64() > end_us;
+}
+
+static int mct_cmp_u32(const void *p_a, const void *p_b)
+{
+    uint32_t a = *(const uint32_t *)p_a;
+    uint32_t b = *(const uint32_t *)p_b;
+
+    return (a > b) - (a < b);
+}
+
+// 計測前の準備(両コア共通のリソースを確保)
+static bool mct_prepare(mct_mode_t mode)
+{
+    if ((mode == MCT_MODE_LOCK) && (s_spin_lock_num < 0)) {
+        s_spin_lock_num = spin_lock_claim_unused(false);
+        if (s_spin_lock_num < 0) {
+            printf("Error: No free H/W spinlock\n");
+            return false;
+        }
+    }
+#if defined(MCU_RP2350)
+    if ((mode == MCT_MODE_BELL) && (s_doorbell < 0)) {
+        s_doorbell = multicore_doorbell_claim_unused((1u << NUM_CORES) - 1u, false);
+        if (s_doorbell < 0) {
+            printf("Error: No free doorbell\n");
+            return false;
+        }
+    }
+#endif
+
+    return true;
+}
+
+// Doorbell計測中はSIO_IRQ_BELL(全Doorbell共通)を止める
+// ※コア間メッセージキューのハンドラは自分のビットしか消さないので割り込みが鳴り続ける
+static bool mct_bell_irq_disable(mct_mode_t mode)
+{
+    bool is_enabled = false;
+
+#if defined(MCU_RP2350)
+    if (mode == MCT_MODE_BELL) {
+        is_enabled = irq_is_enabled(multicore_doorbell_irq_num((uint)s_doorbell));
+        irq_set_enabled(multicore_doorbell_irq_num((uint)s_doorbell), false);
+        multicore_doorbell_clear_current_core((uint)s_doorbell);
+    }
+#endif
+
+    return is_enabled;
+}
+
+static void mct_bell_irq_restore(mct_mode_t mode, bool is_enabled)
+{
+#if defined(MCU_RP2350)
+    if (mode == MCT_MODE_BELL) {
+        multicore_doorbell_clear_current_core((uint)s_doorbell);
+        irq_set_enabled(multicore_doorbell_irq_num((uint)s_doorbell), is_enabled);
+    }
+#endif
+}
+
+/**
+ * @brief 文字列から計測の種類を得る
+ *
+ * @param p_str "fifo", "bell", "spin", "sev", "lock", "bulk"
+ * @return int32_t mct_mode_t、不明なら-1
+ */
+int32_t app_mct_mode_from_str(const char *p_str)
+{
+    for (uint32_t i = 0; i < MCT_MODE_NUM; i++)
+    {
+        if (strcmp(p_str, s_p_mode_str[i]) == 0) {
+            return (int32_t)i;
+        }
+    }
+
+    return -1;
+}
+
+/**
+ * @brief 計測の応答側(Core0がPROC_MCT_SERVERで呼ぶ)
+ */
+void app_mct_server(void)
+{
+    mct_mode_t mode = (mct_mode_t)s_mct.mode;
+    uint32_t cnt = s_mct.cnt;
+    uint64_t end_us = time_us_64() + MCT_TIMEOUT_US;
+    uint32_t spin = 0;
+    uint32_t err = 0;
+    uint32_t data, irq;
+    bool is_bell_irq = mct_bell_irq_disable(mode);
+
+    __mem_fence_release();
+    s_mct.state = MCT_STATE_READY;
+
+    for (uint32_t i = 0; (i < cnt) && (err == 0); i++)
+    {
+        switch (mode)
+        {
+            case MCT_MODE_FIFO:
+                while (!multicore_fifo_rvalid()) {
+                    if (mct_is_timeout(&spin, end_us)) {
+                        err++;
+                        break;
+                    }
+                }
+                if (err == 0) {
+                    data = multicore_fifo_pop_blocking();
+                    multicore_fifo_push_blocking(data);
+                }
+                break;
+
+#if defined(MCU_RP2350)
+            case MCT_MODE_BELL:
+                while (!multicore_doorbell_is_set_current_core((uint)s_doorbell)) {
+                    if (mct_is_timeout(&spin, end_us)) {
+                        err++;
+                        break;
+                    }
+                }
+                if (err == 0) {
+                    multicore_doorbell_clear_current_core((uint)s_doorbell);
+                    multicore_doorbell_set_other_core((uint)s_doorbell);
+                }
+                break;
+#endif
+
+            case MCT_MODE_SPIN:
+                while (s_mct.ping != i + 1) {
+                    if (mct_is_timeout(&spin, end_us)) {
+                        err++;
+                        break;
+                    }
+                }
+                s_mct.pong = i + 1;
+                break;
+
+            case MCT_MODE_SEV:
+                while (s_mct.ping != i + 1) {
+                    if (mct_is_timeout(&spin, end_us)) {
+                        err++;
+                        break;
+                    }
+                    __wfe();
+                }
+                s_mct.pong = i + 1;
+                __sev();
+                break;
+
+            case MCT_MODE_LOCK:
+                // 奇数(要求)を見つけたら偶数(応答)にする
+                while (1) {
+                    irq = spin_lock_blocking(spin_lock_instance((uint)s_spin_lock_num));
+                    if (s_mct.token == (2u * i) + 1u) {
+                        s_mct.token = (2u * i) + 2u;
+                        spin_unlock(spin_lock_instance((uint)s_spin_lock_num), irq);
+                        break;
+                    }
+                    spin_unlock(spin_lock_instance((uint)s_spin_lock_num), irq);
+                    if (mct_is_timeout(&spin, end_us)) {
+                        err++;
+                        break;
+                    }
+                }
+                break;
+
+            case MCT_MODE_BULK:
+                // スロットを読んで和を取り、読み終えたら解放
+                while (s_mct.bulk_wr == i) {
+                    if (mct_is_timeout(&spin, end_us)) {
+                        err++;
+                        break;
+                    }
+                }
+                if (err == 0) {
+                    const uint32_t *p_slot;
+                    uint32_t sum = 0;
+
+                    __mem_fence_acquire();
+                    p_slot = s_mct.bulk_buf[i % MCT_BULK_SLOT_NUM];
+                    for (uint32_t w = 0; w < (MCT_BULK_SLOT_SIZE / sizeof(uint32_t)); w++)
+                    {
+                        sum += p_slot[w];
+                    }
+                    s_mct.bulk_sum += sum;
+                    __mem_fence_release();
+                    s_mct.bulk_rd = i + 1;
+                }
+                break;
+
+            default:
+                err++;
+                break;
+        }
+    }
+
+    mct_bell_irq_restore(mode, is_bell_irq);
+    s_mct.err = err;
+    __mem_fence_release();
+    s_mct.state = MCT_STATE_DONE;
+    __sev();
+}
+
+// 応答側をCore0で起動して待機に入るまで待つ
+// ※起動コードはコア間メッセージキューで送る(FIFOは計測に使うため)
+static bool mct_server_start(mct_mode_t mode, uint32_t cnt)
+{
+    uint64_t end_us;
+
+    s_mct.mode = (uint32_t)mode;
+    s_mct.cnt = cnt;
+    s_mct.err = 0;
+    s_mct.ping = 0;
+    s_mct.pong = 0;
+    s_mct.token = 0;
+    s_mct.bulk_wr = 0;
+    s_mct.bulk_rd = 0;
+    s_mct.bulk_sum = 0;
+    s_mct.state = MCT_STATE_IDLE;
+    __mem_fence_release();
+
+    if (!drv_ipc_send_code(PROC_MCT_SERVER)) {
+        printf("Error: Failed to start Core 0 server (queue full)\n");
+        return false;
+    }
+
+    end_us = time_us_64() + 1000000;
+    while (s_mct.state != MCT_STATE_READY) {
+        if (time_us_64() > end_us) {
+            printf("Error: Core 0 did not respond\n");
+            return false;
+        }
+        tight_loop_contents();
+    }
+    __mem_fence_acquire();
+
+    return true;
+}
+
+// 応答側の終了待ち
+static bool mct_server_end(void)
+{
+    uint64_t end_us = time_us_64() + MCT_TIMEOUT_US;
+
+    while (s_mct.state != MCT_STATE_DONE) {
+        if (time_us_64() > end_us) {
+            return false;
+        }
+        tight_loop_contents();
+    }
+    __mem_fence_acquire();
+
+    return (s_mct.err == 0);
+}
+
+// 1往復(要求側)
+static inline bool mct_round_trip(mct_mode_t mode, uint32_t i, uint64_t end_us, uint32_t *p_spin)
+{
+    uint32_t irq;
+
+    switch (mode)
+    {
+        case MCT_MODE_FIFO:
+            multicore_fifo_push_blocking(i);
+            while (!multicore_fifo_rvalid()) {
+                if (mct_is_timeout(p_spin, end_us)) {
+                    return false;
+                }
+            }
+            return (multicore_fifo_pop_blocking() == i);
+
+#if defined(MCU_RP2350)
+        case MCT_MODE_BELL:
+            multicore_doorbell_set_other_core((uint)s_doorbell);
+            while (!multicore_doorbell_is_set_current_core((uint)s_doorbell)) {
+                if (mct_is_timeout(p_spin, end_us)) {
+                    return false;
+                }
+            }
+            multicore_doorbell_clear_current_core((uint)s_doorbell);
+            return true;
+#endif
+
+        case MCT_MODE_SPIN:
+            s_mct.ping = i + 1;
+            while (s_mct.pong != i + 1) {
+                if (mct_is_timeout(p_spin, end_us)) {
+                    return false;
+                }
+            }
+            return true;
+
+        case MCT_MODE_SEV:
+            s_mct.ping = i + 1;
+            __sev();
+            while (s_mct.pong != i + 1) {
+                if (mct_is_timeout(p_spin, end_us)) {
+                    return false;
+                }
+                __wfe();
+            }
+            return true;
+
+        case MCT_MODE_LOCK:
+            irq = spin_lock_blocking(spin_lock_instance((uint)s_spin_lock_num));
+            s_mct.token = (2u * i) + 1u;
+            spin_unlock(spin_lock_instance((uint)s_spin_lock_num), irq);
+            while (1) {
+                irq = spin_lock_blocking(spin_lock_instance((uint)s_spin_lock_num));
+                if (s_mct.token == (2u * i) + 2u) {
+                    spin_unlock(spin_lock_instance((uint)s_spin_lock_num), irq);
+                    return true;
+                }
+                spin_unlock(spin_lock_instance((uint)s_spin_lock_num), irq);
+                if (mct_is_timeout(p_spin, end_us)) {
+                    return false;
+                }
+            }
+
+        default:
+            return false;
+    }
+}
+
+// 往復時間を計測してソート済みの結果にする
+static bool mct_measure(mct_mode_t mode, uint32_t cnt, mct_result_t *p_result)
+{
+    uint64_t end_us;
+    uint32_t spin = 0;
+    uint32_t t0_cyc, cyc;
+    bool is_ok = true;
+    bool is_bell_irq;
+
+    memset(p_result, 0, sizeof(mct_result_t));
+    if (!mct_prepare(mode) || !mct_server_start(mode, cnt + MCT_WARMUP_CNT)) {
+        return false;
+    }
+
+    is_bell_irq = mct_bell_irq_disable(mode);
+    end_us = time_us_64() + MCT_TIMEOUT_US;
+    for (uint32_t i = 0; i < (cnt + MCT_WARMUP_CNT); i++)
+    {
+        t0_cyc = rp2xxx_get_cycle_cnt();
+        if (!mct_round_trip(mode, i, end_us, &spin)) {
+            is_ok = false;
+            break;
+        }
+        cyc = rp2xxx_get_cycle_cnt() - t0_cyc;
+
+        if (i >= MCT_WARMUP_CNT) {
+            s_sample[i - MCT_WARMUP_CNT] = cyc;
+        }
+    }
+    mct_bell_irq_restore(mode, is_bell_irq);
+
+    if (!mct_server_end() || !is_ok) {
+        printf("Error: %s round trip timed out or mismatched\n", s_p_mode_str[mode]);
+        return false;
+    }
+
+    qsort(s_sample, cnt, sizeof(uint32_t), mct_cmp_u32);
+    p_result->cnt = cnt;
+    p_result->min = s_sample[0];
+    p_result->p50 = s_sample[cnt / 2];
+    p_result->p90 = s_sample[(cnt * 90u) / 100u];
+    p_result->p99 = s_sample[(cnt * 99u) / 100u];
+    p_result->max = s_sample[cnt - 1];
+    for (uint32_t i = 0; i < cnt; i++)
+    {
+        p_result->sum += s_sample[i];
+    }
+
+    return true;
+}
+
+// log2のヒストグラム(s_sampleはソート済み)
+static void mct_show_hist(uint32_t cnt)
+{
+    uint32_t bin[MCT_HIST_BIN_NUM];
+    uint32_t bin_max = 0;
+    int32_t first = -1, last = -1;
+
+    memset(bin, 0, sizeof(bin));
+    for (uint32_t i = 0; i < cnt; i++)
+    {
+        uint32_t b = (s_sample[i] == 0) ? 0 : (31u - (uint32_t)__builtin_clz(s_sample[i]));
+        b = (b >= MCT_HIST_BIN_NUM) ? (MCT_HIST_BIN_NUM - 1) : b;
+        bin[b]++;
+    }
+    for (int32_t b = 0; b < MCT_HIST_BIN_NUM; b++)
+    {
+        if (bin[b] != 0) {
+            first = (first < 0) ? b : first;
+            last = b;
+            bin_max = (bin[b] > bin_max) ? bin[b] : bin_max;
+        }
+    }
+
+    printf("     Cycles          Count\n");
+    for (int32_t b = first; (b >= 0) && (b <= last); b++)
+    {
+        uint32_t len = (uint32_t)(((uint64_t)bin[b] * MCT_HIST_BAR_LEN + bin_max - 1) / bin_max);
+
+        printf("%8u-%-8u %7u |", (b == 0) ? 0 : (1u << b), (1u << (b + 1)) - 1u, bin[b]);
+        for (uint32_t i = 0; i < len; i++)
+        {
+            putchar('#');
+        }
+        printf("\n");
+    }
+}
+
+static void mct_show_result_line(mct_mode_t mode, const mct_result_t *p_result)
+{
+    uint32_t cyc_per_us = clock_get_hz(clk_sys) / 1000000;
+    uint32_t avg = (uint32_t)(p_result->sum / p_result->cnt);
+
+    printf("%-5s %8u %8u %8u %8u %8u %8u %5u.%02u\n",
+            s_p_mode_str[mode], p_result->min, p_result->p50, p_result->p90, p_result->p99,
+            p_result->max, avg, avg / cyc_per_us, ((avg % cyc_per_us) * 100u) / cyc_per_us);
+}
+
+/**
+ * @brief 往復時間の計測(Core1から呼ぶ)
+ *
+ * @param mode 計測の種類(MCT_MODE_BULK以外)
+ * @param cnt 往復数(MCT_SAMPLE_MAX以下)
+ * @param is_hist ヒストグラムを表示する
+ * @return true 成功
+ * @return false 引数エラー/タイムアウト
+ */
+bool app_mct_latency(mct_mode_t mode, uint32_t cnt, bool is_hist)
+{
+    mct_result_t result;
+
+    if ((mode >= MCT_MODE_BULK) || (cnt == 0) || (cnt > MCT_SAMPLE_MAX)) {
+        printf("Error: Count must be 1-%u\n", MCT_SAMPLE_MAX);
+        return false;
+    }
+#if !defined(MCU_RP2350)
+    if (mode == MCT_MODE_BELL) {
+        printf("%-5s N/A (no SIO doorbell on RP2040)\n", s_p_mode_str[mode]);
+        return true;
+    }
+#endif
+#if defined(RP2XXX_USE_FREERTOS)
+    if (mode == MCT_MODE_FIFO) {
+        printf("%-5s N/A (FIFO is used by FreeRTOS SMP)\n", s_p_mode_str[mode]);
+        return true;
+    }
+#endif
+
+    if (!mct_measure(mode, cnt, &result)) {
+        return false;
+    }
+
+    if (is_hist) {
+        printf("\n[MCT %s] %u round trips, %u MHz (cycles on Core 1)\n",
+                s_p_mode_str[mode], cnt, clock_get_hz(clk_sys) / 1000000);
+        printf("Mode       min      p50      p90      p99      max      avg avg(us)\n");
+    }
+    mct_show_result_line(mode, &result);
+    if (is_hist) {
+        mct_show_hist(cnt);
+    }
+
+    return true;
+}
+
+/**
+ * @brief 共有バッファでの一括転送(Core1 -> Core0)のスループット
+ *
+ * @param kb 転送量(KB)
+ * @return true 成功(データの和が一致)
+ * @return false タイムアウト/不一致
+ */
+bool app_mct_bulk(uint32_t kb)
+{
+    uint32_t slot_cnt = (kb * 1024u) / MCT_BULK_SLOT_SIZE;
+    uint32_t words = MCT_BULK_SLOT_SIZE / sizeof(uint32_t);
+    uint32_t sum = 0, val = 0, spin = 0, stall = 0;
+    uint64_t t0_us, us, end_us;
+    bool is_ok = true;
+
+    if (slot_cnt == 0) {
+        printf("Error: Size must be >= %u KB\n", (MCT_BULK_SLOT_SIZE + 1023u) / 1024u);
+        return false;
+    }
+    if (!mct_server_start(MCT_MODE_BULK, slot_cnt)) {
+        return false;
+    }
+
+    t0_us = time_us_64();
+    end_us = t0_us + MCT_TIMEOUT_US;
+    for (uint32_t i = 0; (i < slot_cnt) && is_ok; i++)
+    {
+        uint32_t *p_slot = s_mct.bulk_buf[i % MCT_BULK_SLOT_NUM];
+
+        // 空きスロット待ち(リングが満杯 = 応答側が遅い)
+        if ((i - s_mct.bulk_rd) >= MCT_BULK_SLOT_NUM) {
+            stall++;
+            while ((i - s_mct.bulk_rd) >= MCT_BULK_SLOT_NUM) {
+                if (mct_is_timeout(&spin, end_us)) {
+                    is_ok = false;
+                    break;
+                }
+            }
+            __mem_fence_acquire();
+        }
+        for (uint32_t w = 0; w < words; w++)
+        {
+            p_slot[w] = val;
+            sum += val;
+            val = (val * 1664525u) + 1013904223u;
+        }
+        __mem_fence_release();
+        s_mct.bulk_wr = i + 1;
+    }
+    is_ok = mct_server_end() && is_ok;
+    us = time_us_64() - t0_us;
+    us = (us == 0) ? 1 : us;
+
+    printf("bulk  %u KB in %llu us : %u.%02u MB/s, %u x %u B slots, producer stalls %u : %s\n",
+            kb, (unsigned long long)us,
+            (uint32_t)(((uint64_t)slot_cnt * MCT_BULK_SLOT_SIZE) / us),
+            (uint32_t)((((uint64_t)slot_cnt * MCT_BULK_SLOT_SIZE * 100u) / us) % 100u),
+            MCT_BULK_SLOT_NUM, MCT_BULK_SLOT_SIZE, stall,
+            (is_ok && (s_mct.bulk_sum == sum)) ? "OK" : "NG");
+
+    return is_ok && (s_mct.bulk_sum == sum);
+}
+
+/**
+ * @brief 全種類の往復時間と一括転送をまとめて計測
+ *
+ * @param cnt 種類ごとの往復数
+ */
+void app_mct_suite(uint32_t cnt)
+{
+    printf("\n[MCT Suite] %u round trips each, %u MHz (cycles on Core 1)\n",
+            cnt, clock_get_hz(clk_sys) / 1000000);
+    printf("Mode       min      p50      p90      p99      max      avg avg(us)\n");
+    for (uint32_t mode = 0; mode < MCT_MODE_BULK; mode++)
+    {
+        if (!app_mct_latency((mct_mode_t)mode, cnt, false)) {
+            return;
+        }
+    }
+    app_mct_bulk(256);
+}
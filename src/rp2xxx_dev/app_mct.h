@@ -0,0 +1,46 @@
+/**
+ * @file app_mct.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief コア間通信のベンチマーク(FIFO/Doorbell/共有メモリ/H/Wスピンロック)のヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026 Chimipupu All Rights Reserved.
+ *
+ */
+#ifndef APP_MCT_H
+#define APP_MCT_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "pico/stdlib.h"
+
+#define MCT_SAMPLE_MAX          4096    // 1回の計測で記録する往復の最大数
+#define MCT_HIST_BIN_NUM        24      // ヒストグラムのビン数(2^nサイクルごと)
+#define MCT_HIST_BAR_LEN        40      // ヒストグラムの棒の最大長
+#define MCT_BULK_SLOT_SIZE      1024    // 一括転送の1スロットのバイト数
+#define MCT_BULK_SLOT_NUM       4       // 一括転送のスロット数(共有バッファ = スロット数 x サイズ)
+#define MCT_TIMEOUT_US          5000000 // 1回の計測の最大時間
+
+// 計測の種類
+typedef enum {
+    MCT_MODE_FIFO,          // SIO FIFOで1ワードを往復
+    MCT_MODE_BELL,          // SIO Doorbellを往復(RP2350のみ、割り込み無しでポーリング)
+    MCT_MODE_SPIN,          // 共有メモリのフラグをスピンで待つ
+    MCT_MODE_SEV,           // 共有メモリのフラグ + SEV/WFEで待つ
+    MCT_MODE_LOCK,          // H/Wスピンロックで守った共有変数の受け渡し
+    MCT_MODE_BULK,          // 共有バッファでの一括転送(スループット)
+    MCT_MODE_NUM,
+} mct_mode_t;
+
+// 関数プロトタイプ
+int32_t app_mct_mode_from_str(const char *p_str);
+void app_mct_server(void);
+bool app_mct_latency(mct_mode_t mode, uint32_t cnt, bool is_hist);
+bool app_mct_bulk(uint32_t kb);
+void app_mct_suite(uint32_t cnt);
+
+#endif // APP_MCT_H
@@ -0,0 +1,1006 @@
+/**
+ * @file app_mem.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief メモリ操作アプリ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026 Chimipupu All Rights Reserved.
+ *
+ */
+#include "app_mem.h"
+#include "app_job.h"
+#include "muc_rpxxx_util.h"
+
+#include "hardware/dma.h"
+#if LIB_PICO_STDIO_USB
+#include "pico/stdio_usb.h"
+#endif
+
+#define MEM_HEX_LINE_BYTES      16
+#define MEM_HEX_LINE_LEN        (10 + (MEM_HEX_LINE_BYTES * 3) + 2 + MEM_HEX_LINE_BYTES + 1)
+#define MEM_OUT_BUF_SIZE        (MEM_LZ_WINDOW_SIZE + (MEM_LZ_WINDOW_SIZE / 8) + 16)
+#define MEM_LZ_HASH_SIZE        (1u << MEM_LZ_HASH_BITS)
+#define MEM_LZ_HASH_NONE        0xFFFF
+
+static const char *s_dump_mode_str_tbl[MEM_DUMP_MODE_NUM] = {
+    "hex",
+    "raw",
+    "rle",
+    "lz",
+};
+
+// HEX/ASCII変換テーブル(初回に生成)
+static uint8_t s_hex_tbl[256][2];
+static uint8_t s_ascii_tbl[256];
+static bool s_is_tbl_init = false;
+
+// 読み出しはステージングバッファ2面で、DMA読み出しと整形/圧縮/検索を並行させる
+typedef struct {
+    uint32_t addr;      // 読み出し元の先頭アドレス
+    uint32_t size;      // 読み出しサイズ(Byte)
+    uint32_t offset;    // 次に返すチャンクのオフセット
+    uint32_t cur;       // 次に返すステージングバッファの面
+    int32_t dma_ch;     // DMAチャンネル(-1 ... 未確保)
+    bool is_dma;        // DMAで読み出すか
+    uint32_t stage_buf[2][MEM_STAGE_BUF_SIZE / sizeof(uint32_t)];
+} mem_reader_t;
+
+// [0] ... ダンプ/検索/比較元, [1] ... 比較先
+static mem_reader_t s_reader[2] = {
+    { .dma_ch = -1 },
+    { .dma_ch = -1 },
+};
+static int32_t s_fill_dma_ch = -1;
+
+static uint8_t s_out_buf[MEM_OUT_BUF_SIZE];
+static uint32_t s_out_len = 0;
+static uint32_t s_out_total = 0;
+
+static uint8_t s_comp_buf[MEM_OUT_BUF_SIZE];
+static uint8_t s_lz_buf[MEM_LZ_WINDOW_SIZE];
+static uint16_t s_lz_head[MEM_LZ_HASH_SIZE];
+
+// 上のバッファ/DMAは1組なので、モニタとジョブ(bg)で同時に使わせない
+static bool s_is_busy = false;
+
+static bool mem_lock(void)
+{
+    return !__atomic_exchange_n(&s_is_busy, true, __ATOMIC_ACQUIRE);
+}
+
+static void mem_unlock(void)
+{
+    __atomic_store_n(&s_is_busy, false, __ATOMIC_RELEASE);
+}
+
+static void mem_tbl_init(void)
+{
+    static const char s_hex_char[] = "0123456789ABCDEF";
+
+    for (uint32_t i = 0; i < 256; i++)
+    {
+        s_hex_tbl[i][0] = s_hex_char[i >> 4];
+        s_hex_tbl[i][1] = s_hex_char[i & 0x0F];
+        // 表示可能なASCII文字のみ表示
+        s_ascii_tbl[i] = ((i >= 32) && (i <= 126)) ? (uint8_t)i : '.';
+    }
+    s_is_tbl_init = true;
+}
+
+// -------------------------------------------------------------------------
+// [出力]
+// -------------------------------------------------------------------------
+static void mem_out_flush(void)
+{
+    if (s_out_len != 0) {
+        fwrite(s_out_buf, 1, s_out_len, stdout);
+        fflush(stdout);
+        s_out_total += s_out_len;
+        s_out_len = 0;
+    }
+}
+
+static void mem_out_write(const void *p_data, uint32_t len)
+{
+    if ((s_out_len + len) > sizeof(s_out_buf)) {
+        mem_out_flush();
+    }
+
+    if (len > sizeof(s_out_buf)) {
+        fwrite(p_data, 1, len, stdout);
+        fflush(stdout);
+        s_out_total += len;
+    } else {
+        memcpy(&s_out_buf[s_out_len], p_data, len);
+        s_out_len += len;
+    }
+}
+
+// 圧縮ブロックの出力 ... [ペイロード長 u16 LE][ペイロード]
+static void mem_out_block(const uint8_t *p_payload, uint32_t len)
+{
+    uint8_t hdr[2] = { (uint8_t)(len & 0xFF), (uint8_t)(len >> 8) };
+
+    mem_out_write(hdr, sizeof(hdr));
+    if (len != 0) {
+        mem_out_write(p_payload, len);
+    }
+}
+
+// 生バイナリ出力中はCR/LF変換を止める
+static void mem_out_set_binary(bool is_binary)
+{
+#if LIB_PICO_STDIO_USB
+    stdio_set_translate_crlf(&stdio_usb, !is_binary);
+#else
+    (void)is_binary;
+#endif
+}
+
+// -------------------------------------------------------------------------
+// [読み出し]
+// -------------------------------------------------------------------------
+static bool mem_is_dma_readable(uint32_t addr, uint32_t size)
+{
+    if (((addr | size) & 0x3) != 0) {
+        return false;
+    }
+
+    // ペリフェラル(レジスタ)はCPUで読む ※addr + sizeは32bitでラップするので引き算で比べる
+    if ((addr >= XIP_BASE) && (addr <= (XIP_BASE + PICO_FLASH_SIZE_BYTES)) &&
+        (size <= ((XIP_BASE + PICO_FLASH_SIZE_BYTES) - addr))) {
+        return true;
+    }
+    if ((addr >= SRAM_BASE) && (addr <= SRAM_END) && (size <= (SRAM_END - addr))) {
+        return true;
+    }
+
+    return false;
+}
+
+// 先頭/末尾の端数はByte、それ以外はアラインした32bitロードで読む
+static void mem_cpu_read(uint32_t addr, uint8_t *p_dst, uint32_t len)
+{
+    uint32_t i = 0;
+
+    while ((i < len) && (((addr + i) & 0x3) != 0))
+    {
+        p_dst[i] = *((volatile uint8_t *)(uintptr_t)(addr + i));
+        i++;
+    }
+
+    while ((i + 4) <= len)
+    {
+        uint32_t word = *((volatile uint32_t *)(uintptr_t)(addr + i));
+        memcpy(&p_dst[i], &word, sizeof(word));
+        i += 4;
+    }
+
+    while (i < len)
+    {
+        p_dst[i] = *((volatile uint8_t *)(uintptr_t)(addr + i));
+        i++;
+    }
+}
+
+static void mem_read_start(mem_reader_t *p_rd, uint32_t offset, uint8_t *p_dst)
+{
+    uint32_t len = ((p_rd->size - offset) < MEM_STAGE_BUF_SIZE) ? (p_rd->size - offset) : MEM_STAGE_BUF_SIZE;
+
+    if (p_rd->is_dma) {
+        dma_channel_config c = dma_channel_get_default_config((uint)p_rd->dma_ch);
+        channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+        channel_config_set_read_increment(&c, true);
+        channel_config_set_write_increment(&c, true);
+        dma_channel_configure((uint)p_rd->dma_ch, &c, p_dst, (const void *)(uintptr_t)(p_rd->addr + offset), len / 4, true);
+    } else {
+        mem_cpu_read(p_rd->addr + offset, p_dst, len);
+    }
+}
+
+static void mem_reader_open(mem_reader_t *p_rd, uint32_t addr, uint32_t size)
+{
+    if (p_rd->dma_ch < 0) {
+        p_rd->dma_ch = dma_claim_unused_channel(false);
+    }
+    p_rd->addr = addr;
+    p_rd->size = size;
+    p_rd->offset = 0;
+    p_rd->cur = 0;
+    p_rd->is_dma = (p_rd->dma_ch >= 0) && mem_is_dma_readable(addr, size);
+
+    if (size != 0) {
+        mem_read_start(p_rd, 0, (uint8_t *)p_rd->stage_buf[0]);
+    }
+}
+
+/**
+ * @brief 次のチャンクを取得し、その次のチャンクの読み出しを開始する
+ *
+ * @param p_rd リーダー
+ * @param p_len チャンクのサイズ(Byte)
+ * @return const uint8_t* チャンク(4Byteアライン)。終端ならNULL
+ */
+static const uint8_t *mem_reader_next(mem_reader_t *p_rd, uint32_t *p_len)
+{
+    const uint8_t *p_data = (const uint8_t *)p_rd->stage_buf[p_rd->cur];
+    uint32_t len;
+
+    if (p_rd->offset >= p_rd->size) {
+        return NULL;
+    }
+
+    // ジョブの中断要求で打ち切る(読み出し中のDMAは完了を待つ)
+    if (app_job_is_cancel()) {
+        if (p_rd->is_dma) {
+            dma_channel_wait_for_finish_blocking((uint)p_rd->dma_ch);
+        }
+        p_rd->offset = p_rd->size;
+        return NULL;
+    }
+
+    len = ((p_rd->size - p_rd->offset) < MEM_STAGE_BUF_SIZE) ? (p_rd->size - p_rd->offset) : MEM_STAGE_BUF_SIZE;
+    if (p_rd->is_dma) {
+        dma_channel_wait_for_finish_blocking((uint)p_rd->dma_ch);
+    }
+
+    p_rd->offset += len;
+    p_rd->cur ^= 1;
+    if (p_rd->offset < p_rd->size) {
+        mem_read_start(p_rd, p_rd->offset, (uint8_t *)p_rd->stage_buf[p_rd->cur]);
+    }
+
+    *p_len = len;
+    return p_data;
+}
+
+// 読み出し中のDMAを止める(中断で途中のリーダーが残ったとき、バッファを再利用する前に呼ぶ)
+static void mem_reader_close(mem_reader_t *p_rd)
+{
+    if (p_rd->is_dma) {
+        dma_channel_abort((uint)p_rd->dma_ch);
+        while (dma_channel_is_busy((uint)p_rd->dma_ch))
+        {
+            tight_loop_contents();
+        }
+    }
+    p_rd->offset = p_rd->size;
+}
+
+// -------------------------------------------------------------------------
+// [整形/圧縮]
+// -------------------------------------------------------------------------
+static void mem_hex_format(uint32_t addr, const uint8_t *p_data, uint32_t len)
+{
+    uint8_t line[MEM_HEX_LINE_LEN];
+
+    for (uint32_t offset = 0; offset < len; offset += MEM_HEX_LINE_BYTES)
+    {
+        uint32_t line_addr = addr + offset;
+        uint32_t cnt = ((len - offset) < MEM_HEX_LINE_BYTES) ? (len - offset) : MEM_HEX_LINE_BYTES;
+        uint8_t *p = &line[0];
+
+        for (int32_t shift = 24; shift >= 0; shift -= 8)
+        {
+            memcpy(p, s_hex_tbl[(line_addr >> shift) & 0xFF], 2);
+            p += 2;
+        }
+        *p++ = ':';
+        *p++ = ' ';
+
+        for (uint32_t i = 0; i < MEM_HEX_LINE_BYTES; i++)
+        {
+            if (i < cnt) {
+                memcpy(p, s_hex_tbl[p_data[offset + i]], 2);
+            } else {
+                p[0] = ' ';
+                p[1] = ' ';
+            }
+            p[2] = ' ';
+            p += 3;
+        }
+        *p++ = '|';
+        *p++ = ' ';
+
+        for (uint32_t i = 0; i < MEM_HEX_LINE_BYTES; i++)
+        {
+            *p++ = (i < cnt) ? s_ascii_tbl[p_data[offset + i]] : ' ';
+        }
+        *p++ = '\n';
+
+        mem_out_write(line, (uint32_t)(p - &line[0]));
+    }
+}
+
+/**
+ * @brief PackBits形式のRLE圧縮
+ *
+ * 制御Byte n ... 0～127: 後続のn+1Byteがリテラル, 129～255: 次の1Byteを257-n回繰り返し
+ */
+static uint32_t mem_rle_compress(const uint8_t *p_src, uint32_t len, uint8_t *p_dst)
+{
+    uint32_t i = 0;
+    uint32_t out = 0;
+
+    while (i < len)
+    {
+        uint32_t run = 1;
+        while (((i + run) < len) && (run < 128) && (p_src[i + run] == p_src[i]))
+        {
+            run++;
+        }
+
+        if (run >= 2) {
+            p_dst[out++] = (uint8_t)(257 - run);
+            p_dst[out++] = p_src[i];
+            i += run;
+        } else {
+            // 3Byte以上の連続が始まるまでリテラル
+            uint32_t start = i;
+            while ((i < len) && ((i - start) < 128))
+            {
+                if (((i + 2) < len) && (p_src[i] == p_src[i + 1]) && (p_src[i] == p_src[i + 2])) {
+                    break;
+                }
+                i++;
+            }
+            p_dst[out++] = (uint8_t)(i - start - 1);
+            memcpy(&p_dst[out], &p_src[start], i - start);
+            out += i - start;
+        }
+    }
+
+    return out;
+}
+
+static inline uint32_t mem_lz_hash(const uint8_t *p)
+{
+    uint32_t v = ((uint32_t)p[0] << 16) | ((uint32_t)p[1] << 8) | p[2];
+    return (v * 2654435761u) >> (32 - MEM_LZ_HASH_BITS);
+}
+
+/**
+ * @brief LZSS圧縮(窓はブロック内のみ、一致候補はハッシュの1候補のみ)
+ *
+ * フラグByte(LSBから1bitずつ, 1=リテラル/0=一致)の後に8個分の要素が続く
+ * 一致 ... 2Byte [offset-1 下位8bit][offset-1 上位4bit << 4 | 一致長-3]
+ */
+static uint32_t mem_lz_compress(const uint8_t *p_src, uint32_t len, uint8_t *p_dst)
+{
+    uint32_t pos = 0;
+    uint32_t out = 0;
+    uint32_t flag_pos = 0;
+    uint32_t flag_bit = 8;
+
+    memset(s_lz_head, 0xFF, sizeof(s_lz_head));
+
+    while (pos < len)
+    {
+        uint32_t best_len = 0;
+        uint32_t best_off = 0;
+
+        if (flag_bit == 8) {
+            flag_pos = out++;
+            p_dst[flag_pos] = 0;
+            flag_bit = 0;
+        }
+
+        if ((pos + MEM_LZ_MIN_MATCH) <= len) {
+            uint32_t h = mem_lz_hash(&p_src[pos]);
+            uint32_t cand = s_lz_head[h];
+
+            s_lz_head[h] = (uint16_t)pos;
+            if (cand != MEM_LZ_HASH_NONE) {
+                uint32_t max = ((len - pos) < MEM_LZ_MAX_MATCH) ? (len - pos) : MEM_LZ_MAX_MATCH;
+                uint32_t l = 0;
+                while ((l < max) && (p_src[cand + l] == p_src[pos + l]))
+                {
+                    l++;
+                }
+                if (l >= MEM_LZ_MIN_MATCH) {
+                    best_len = l;
+                    best_off = pos - cand;
+                }
+            }
+        }
+
+        if (best_len != 0) {
+            p_dst[out++] = (uint8_t)((best_off - 1) & 0xFF);
+            p_dst[out++] = (uint8_t)((((best_off - 1) >> 8) << 4) | (best_len - MEM_LZ_MIN_MATCH));
+            for (uint32_t i = 1; i < best_len; i++)
+            {
+                if ((pos + i + MEM_LZ_MIN_MATCH) <= len) {
+                    s_lz_head[mem_lz_hash(&p_src[pos + i])] = (uint16_t)(pos + i);
+                }
+            }
+            pos += best_len;
+        } else {
+            p_dst[flag_pos] |= (uint8_t)(1u << flag_bit);
+            p_dst[out++] = p_src[pos++];
+        }
+        flag_bit++;
+    }
+
+    return out;
+}
+
+// -------------------------------------------------------------------------
+// [API]
+// -------------------------------------------------------------------------
+/**
+ * @brief 文字列からバルクダンプの出力形式を取得
+ *
+ * @param p_mode_str "hex" | "raw" | "rle" | "lz"
+ * @return int32_t 出力形式(不明なら-1)
+ */
+int32_t app_mem_get_dump_mode(const char *p_mode_str)
+{
+    for (int32_t i = 0; i < MEM_DUMP_MODE_NUM; i++)
+    {
+        if (strcasecmp(p_mode_str, s_dump_mode_str_tbl[i]) == 0) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+const char *app_mem_get_dump_mode_str(mem_dump_mode_t mode)
+{
+    return (mode < MEM_DUMP_MODE_NUM) ? s_dump_mode_str_tbl[mode] : "?";
+}
+
+/**
+ * @brief メモリのバルクダンプ
+ *
+ * SRAM/Flash(XIP)の4Byteアラインな領域はDMA、それ以外はCPUの32bitロードで読み出す。
+ * raw/rle/lzはバイナリ出力で、rle/lzは[長さu16 LE][圧縮データ]のブロック列を
+ * 長さ0のブロックで終端する(lzの1ブロックは元データ最大4KB)。
+ *
+ * @param addr ダンプするメモリの32bitアドレス
+ * @param size ダンプするサイズ(Byte)
+ * @param mode 出力形式
+ * @param p_result 結果(読み出し/出力サイズ、処理時間)
+ * @return true ダンプした
+ * @return false 他のメモリ操作の実行中
+ */
+bool app_mem_bulk_dump(uint32_t addr, uint32_t size, mem_dump_mode_t mode, mem_dump_result_t *p_result)
+{
+    mem_reader_t *p_rd = &s_reader[0];
+    const uint8_t *p_data;
+    uint32_t offset = 0;
+    uint32_t lz_len = 0;
+    uint32_t len;
+    uint64_t start_time;
+
+    if (!mem_lock()) {
+        return false;
+    }
+
+    if (!s_is_tbl_init) {
+        mem_tbl_init();
+    }
+
+    s_out_len = 0;
+    s_out_total = 0;
+
+    if (mode == MEM_DUMP_MODE_HEX) {
+        printf("\n[Memory Dump (addr:0x%08X)]\n", addr);
+        printf("Address  00 01 02 03 04 05 06 07 08 09 0A 0B 0C 0D 0E 0F | ASCII\n");
+        printf("-------- ------------------------------------------------| ------\n");
+    } else {
+        printf("\n[Memory Dump %s (addr:0x%08X, size:0x%X)]\n", app_mem_get_dump_mode_str(mode), addr, size);
+        fflush(stdout);
+        mem_out_set_binary(true);
+    }
+
+    start_time = time_us_64();
+    mem_reader_open(p_rd, addr, size);
+
+    while ((p_data = mem_reader_next(p_rd, &len)) != NULL)
+    {
+        switch (mode)
+        {
+            case MEM_DUMP_MODE_HEX:
+                mem_hex_format(addr + offset, p_data, len);
+                break;
+
+            case MEM_DUMP_MODE_RAW:
+                mem_out_write(p_data, len);
+                break;
+
+            case MEM_DUMP_MODE_RLE:
+                mem_out_block(s_comp_buf, mem_rle_compress(p_data, len, s_comp_buf));
+                break;
+
+            case MEM_DUMP_MODE_LZ:
+                memcpy(&s_lz_buf[lz_len], p_data, len);
+                lz_len += len;
+                if ((lz_len == MEM_LZ_WINDOW_SIZE) || ((offset + len) >= size)) {
+                    mem_out_block(s_comp_buf, mem_lz_compress(s_lz_buf, lz_len, s_comp_buf));
+                    lz_len = 0;
+                }
+                break;
+
+            default:
+                break;
+        }
+
+        offset += len;
+    }
+
+    if ((mode == MEM_DUMP_MODE_RLE) || (mode == MEM_DUMP_MODE_LZ)) {
+        mem_out_block(NULL, 0);
+    }
+    mem_out_flush();
+
+    p_result->proc_time_us = (uint32_t)(time_us_64() - start_time);
+    p_result->in_size = size;
+    p_result->out_size = s_out_total;
+    p_result->is_dma = p_rd->is_dma;
+
+    if (mode != MEM_DUMP_MODE_HEX) {
+        mem_out_set_binary(false);
+        printf("\n");
+    }
+    mem_unlock();
+
+    return true;
+}
+
+// -------------------------------------------------------------------------
+// [検索/比較カーネル] ※ステージングバッファに依存しない(ホストでも同じコードで動く)
+// -------------------------------------------------------------------------
+static inline void mem_hit_add(uint32_t *p_ofs_buf, uint32_t ofs_max, uint32_t *p_cnt, uint32_t ofs)
+{
+    if (*p_cnt < ofs_max) {
+        p_ofs_buf[*p_cnt] = ofs;
+    }
+    (*p_cnt)++;
+}
+
+/**
+ * @brief パターン検索カーネル(マスク付き)
+ *
+ * 1Byteパターンは4Byteずつ読み、ゼロByte検出(SWAR)で一致候補のワードだけを1Byteずつ確認する。
+ * 2/4Byteパターンはパターン幅にアラインした位置のみ比較する(LE)。
+ *
+ * @param p_buf 検索するバッファ
+ * @param len バッファのサイズ(Byte)
+ * @param p_pat パターン
+ * @param base_ofs p_buf先頭の検索開始位置からのオフセット
+ * @param p_hit_ofs 一致位置(オフセット)の格納先
+ * @param hit_max p_hit_ofsの要素数
+ * @param hit_cnt これまでの一致数
+ * @return uint32_t 一致数(これまでの分を含む)
+ */
+uint32_t app_mem_find_kernel(const uint8_t *p_buf, uint32_t len, const mem_pattern_t *p_pat,
+                             uint32_t base_ofs, uint32_t *p_hit_ofs, uint32_t hit_max, uint32_t hit_cnt)
+{
+    uint32_t i = 0;
+
+    if (p_pat->width == 1) {
+        uint8_t pat = (uint8_t)(p_pat->value & p_pat->mask);
+        uint8_t mask = (uint8_t)p_pat->mask;
+        uint32_t rep_pat = pat * 0x01010101u;
+        uint32_t rep_mask = mask * 0x01010101u;
+
+        while ((i < len) && (((uintptr_t)&p_buf[i] & 0x3) != 0))
+        {
+            if ((p_buf[i] & mask) == pat) {
+                mem_hit_add(p_hit_ofs, hit_max, &hit_cnt, base_ofs + i);
+            }
+            i++;
+        }
+
+        for (; (i + 4) <= len; i += 4)
+        {
+            uint32_t x = (*(const uint32_t *)&p_buf[i] & rep_mask) ^ rep_pat;
+
+            // xに0x00のByteが有れば一致候補
+            if (((x - 0x01010101u) & ~x & 0x80808080u) != 0) {
+                for (uint32_t b = 0; b < 4; b++)
+                {
+                    if ((p_buf[i + b] & mask) == pat) {
+                        mem_hit_add(p_hit_ofs, hit_max, &hit_cnt, base_ofs + i + b);
+                    }
+                }
+            }
+        }
+
+        for (; i < len; i++)
+        {
+            if ((p_buf[i] & mask) == pat) {
+                mem_hit_add(p_hit_ofs, hit_max, &hit_cnt, base_ofs + i);
+            }
+        }
+    } else if (p_pat->width == 2) {
+        uint16_t pat = (uint16_t)(p_pat->value & p_pat->mask);
+        uint16_t mask = (uint16_t)p_pat->mask;
+
+        for (; (i + 2) <= len; i += 2)
+        {
+            if ((*(const uint16_t *)&p_buf[i] & mask) == pat) {
+                mem_hit_add(p_hit_ofs, hit_max, &hit_cnt, base_ofs + i);
+            }
+        }
+    } else {
+        uint32_t pat = p_pat->value & p_pat->mask;
+        uint32_t mask = p_pat->mask;
+
+        for (; (i + 4) <= len; i += 4)
+        {
+            if ((*(const uint32_t *)&p_buf[i] & mask) == pat) {
+                mem_hit_add(p_hit_ofs, hit_max, &hit_cnt, base_ofs + i);
+            }
+        }
+    }
+
+    return hit_cnt;
+}
+
+/**
+ * @brief 比較カーネル
+ *
+ * 両方が4Byteアラインなら16Byte単位のXORで一致区間を読み飛ばし、
+ * 不一致を含む区間だけ1Byteずつ確認する。
+ *
+ * @param p_a 比較元
+ * @param p_b 比較先
+ * @param len サイズ(Byte)
+ * @param base_ofs 比較開始位置からのオフセット
+ * @param p_diff_ofs 不一致位置(オフセット)の格納先
+ * @param diff_max p_diff_ofsの要素数
+ * @param diff_cnt これまでの不一致Byte数
+ * @return uint32_t 不一致Byte数(これまでの分を含む)
+ */
+uint32_t app_mem_cmp_kernel(const uint8_t *p_a, const uint8_t *p_b, uint32_t len,
+                            uint32_t base_ofs, uint32_t *p_diff_ofs, uint32_t diff_max, uint32_t diff_cnt)
+{
+    uint32_t i = 0;
+
+    if ((((uintptr_t)p_a | (uintptr_t)p_b) & 0x3) == 0) {
+        const uint32_t *p_wa = (const uint32_t *)p_a;
+        const uint32_t *p_wb = (const uint32_t *)p_b;
+
+        for (; (i + 16) <= len; i += 16, p_wa += 4, p_wb += 4)
+        {
+            uint32_t x = (p_wa[0] ^ p_wb[0]) | (p_wa[1] ^ p_wb[1]) |
+                         (p_wa[2] ^ p_wb[2]) | (p_wa[3] ^ p_wb[3]);
+            if (x != 0) {
+                for (uint32_t b = 0; b < 16; b++)
+                {
+                    if (p_a[i + b] != p_b[i + b]) {
+                        mem_hit_add(p_diff_ofs, diff_max, &diff_cnt, base_ofs + i + b);
+                    }
+                }
+            }
+        }
+    }
+
+    for (; i < len; i++)
+    {
+        if (p_a[i] != p_b[i]) {
+            mem_hit_add(p_diff_ofs, diff_max, &diff_cnt, base_ofs + i);
+        }
+    }
+
+    return diff_cnt;
+}
+
+// -------------------------------------------------------------------------
+// [検索/フィル/比較]
+// -------------------------------------------------------------------------
+/**
+ * @brief "#HEX"文字列からパターンを取得(桁数でパターン幅を決める)
+ *
+ * @param p_str "#41"(1Byte) | "#4142"(2Byte) | "#41424344"(4Byte)
+ * @param p_value 値
+ * @param p_width パターン幅(Byte)
+ * @return true 成功
+ * @return false 失敗
+ */
+bool app_mem_parse_pattern(const char *p_str, uint32_t *p_value, uint32_t *p_width)
+{
+    size_t digits;
+
+    if ((p_str[0] != '#') || (sscanf(p_str, "#%x", p_value) != 1)) {
+        return false;
+    }
+
+    digits = strlen(&p_str[1]);
+    if (digits <= 2) {
+        *p_width = 1;
+    } else if (digits <= 4) {
+        *p_width = 2;
+    } else if (digits <= 8) {
+        *p_width = 4;
+    } else {
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief メモリのパターン検索
+ *
+ * @param addr 検索するメモリの32bitアドレス(2/4Byteパターンはパターン幅にアライン)
+ * @param size 検索するサイズ(Byte)
+ * @param p_pat パターン
+ * @param p_hit_addr 一致アドレスの格納先
+ * @param hit_max p_hit_addrの要素数
+ * @param p_result 結果(一致数、処理時間)
+ * @return true 検索した
+ * @return false 他のメモリ操作の実行中
+ */
+bool app_mem_find(uint32_t addr, uint32_t size, const mem_pattern_t *p_pat,
+                  uint32_t *p_hit_addr, uint32_t hit_max, mem_op_result_t *p_result)
+{
+    mem_reader_t *p_rd = &s_reader[0];
+    const uint8_t *p_data;
+    uint32_t offset = 0;
+    uint32_t hit_cnt = 0;
+    uint32_t len;
+    uint64_t start_time = time_us_64();
+
+    if (!mem_lock()) {
+        return false;
+    }
+
+    mem_reader_open(p_rd, addr, size);
+    while ((p_data = mem_reader_next(p_rd, &len)) != NULL)
+    {
+        hit_cnt = app_mem_find_kernel(p_data, len, p_pat, offset, p_hit_addr, hit_max, hit_cnt);
+        offset += len;
+    }
+
+    for (uint32_t i = 0; (i < hit_cnt) && (i < hit_max); i++)
+    {
+        p_hit_addr[i] += addr;
+    }
+
+    p_result->proc_time_us = (uint32_t)(time_us_64() - start_time);
+    p_result->size = size;
+    p_result->cnt = hit_cnt;
+    p_result->is_dma = p_rd->is_dma;
+    mem_unlock();
+
+    return true;
+}
+
+/**
+ * @brief メモリの比較
+ *
+ * @param addr_a 比較元の32bitアドレス
+ * @param addr_b 比較先の32bitアドレス
+ * @param size 比較するサイズ(Byte)
+ * @param p_diff_ofs 不一致位置(先頭からのオフセット)の格納先
+ * @param diff_max p_diff_ofsの要素数
+ * @param p_result 結果(不一致Byte数、処理時間)
+ * @return true 比較した
+ * @return false 他のメモリ操作の実行中
+ */
+bool app_mem_cmp(uint32_t addr_a, uint32_t addr_b, uint32_t size,
+                 uint32_t *p_diff_ofs, uint32_t diff_max, mem_op_result_t *p_result)
+{
+    mem_reader_t *p_rd_a = &s_reader[0];
+    mem_reader_t *p_rd_b = &s_reader[1];
+    const uint8_t *p_a;
+    const uint8_t *p_b;
+    uint32_t offset = 0;
+    uint32_t diff_cnt = 0;
+    uint32_t len_a;
+    uint32_t len_b;
+    uint64_t start_time = time_us_64();
+
+    if (!mem_lock()) {
+        return false;
+    }
+
+    mem_reader_open(p_rd_a, addr_a, size);
+    mem_reader_open(p_rd_b, addr_b, size);
+    while (((p_a = mem_reader_next(p_rd_a, &len_a)) != NULL) &&
+           ((p_b = mem_reader_next(p_rd_b, &len_b)) != NULL))
+    {
+        diff_cnt = app_mem_cmp_kernel(p_a, p_b, len_a, offset, p_diff_ofs, diff_max, diff_cnt);
+        offset += len_a;
+    }
+    // 中断すると片方は次のチャンクを読み出し中のまま抜けてくる
+    mem_reader_close(p_rd_a);
+    mem_reader_close(p_rd_b);
+
+    p_result->proc_time_us = (uint32_t)(time_us_64() - start_time);
+    p_result->size = size;
+    p_result->cnt = diff_cnt;
+    p_result->is_dma = p_rd_a->is_dma && p_rd_b->is_dma;
+    mem_unlock();
+
+    return true;
+}
+
+/**
+ * @brief メモリのフィル
+ *
+ * SRAMはDMA(読み出し側アドレス固定)、それ以外はCPUで書き込む。
+ * パターン幅に満たない先頭/末尾はCPUで書き込む。
+ *
+ * @param addr フィルするメモリの32bitアドレス
+ * @param size フィルするサイズ(Byte)
+ * @param value 値
+ * @param width 値の幅(1/2/4Byte)
+ * @param p_result 結果(処理時間)
+ * @return true フィルした
+ * @return false 他のメモリ操作の実行中
+ */
+bool app_mem_fill(uint32_t addr, uint32_t size, uint32_t value, uint32_t width, mem_op_result_t *p_result)
+{
+    static uint32_t s_fill_word;
+    uint32_t head = 0;
+    uint32_t body;
+    uint32_t i;
+    uint64_t start_time = time_us_64();
+
+    if (!mem_lock()) {
+        return false;
+    }
+
+    // 4Byteに複製して、Byte位置に関係なく同じ値を書けるようにする
+    if (width == 1) {
+        s_fill_word = (value & 0xFF) * 0x01010101u;
+    } else if (width == 2) {
+        s_fill_word = (value & 0xFFFF) * 0x00010001u;
+    } else {
+        s_fill_word = value;
+    }
+
+    if (s_fill_dma_ch < 0) {
+        s_fill_dma_ch = dma_claim_unused_channel(false);
+    }
+
+    while ((head < size) && (((addr + head) & 0x3) != 0))
+    {
+        *((volatile uint8_t *)(uintptr_t)(addr + head)) = (uint8_t)(s_fill_word >> (8 * ((addr + head) & 0x3)));
+        head++;
+    }
+    body = (size - head) & ~0x3u;
+
+    p_result->is_dma = (s_fill_dma_ch >= 0) && (body != 0) &&
+                       ((addr + head) >= SRAM_BASE) && ((addr + head) <= SRAM_END) &&
+                       (body <= (SRAM_END - (addr + head)));
+    if (p_result->is_dma) {
+        dma_channel_config c = dma_channel_get_default_config((uint)s_fill_dma_ch);
+        channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+        channel_config_set_read_increment(&c, false);
+        channel_config_set_write_increment(&c, true);
+        dma_channel_configure((uint)s_fill_dma_ch, &c, (void *)(uintptr_t)(addr + head), &s_fill_word, body / 4, true);
+        dma_channel_wait_for_finish_blocking((uint)s_fill_dma_ch);
+    } else {
+        for (i = 0; i < body; i += 4)
+        {
+            *((volatile uint32_t *)(uintptr_t)(addr + head + i)) = s_fill_word;
+        }
+    }
+
+    for (i = head + body; i < size; i++)
+    {
+        *((volatile uint8_t *)(uintptr_t)(addr + i)) = (uint8_t)(s_fill_word >> (8 * ((addr + i) & 0x3)));
+    }
+
+    p_result->proc_time_us = (uint32_t)(time_us_64() - start_time);
+    p_result->size = size;
+    p_result->cnt = 0;
+    mem_unlock();
+
+    return true;
+}
+
+// -------------------------------------------------------------------------
+// [カーネルのセルフテスト]
+// -------------------------------------------------------------------------
+static uint32_t mem_test_ref_find(const uint8_t *p_buf, uint32_t len, const mem_pattern_t *p_pat,
+                                  uintptr_t align_base, uint32_t *p_ofs, uint32_t ofs_max)
+{
+    uint32_t cnt = 0;
+
+    for (uint32_t i = 0; (i + p_pat->width) <= len; i++)
+    {
+        uint32_t v = 0;
+        if ((((uintptr_t)&p_buf[i] - align_base) % p_pat->width) != 0) {
+            continue;
+        }
+        memcpy(&v, &p_buf[i], p_pat->width);
+        if ((v & p_pat->mask) == (p_pat->value & p_pat->mask)) {
+            mem_hit_add(p_ofs, ofs_max, &cnt, i);
+        }
+    }
+
+    return cnt;
+}
+
+/**
+ * @brief 検索/比較カーネルを1Byteずつの素朴な実装と突き合わせる
+ *
+ * @return true 全て一致
+ * @return false 不一致有り or 他のメモリ操作の実行中
+ */
+bool app_mem_kernel_self_test(void)
+{
+    static uint32_t s_buf_a[260 / 4];
+    static uint32_t s_buf_b[260 / 4];
+    static const mem_pattern_t s_pat_tbl[] = {
+        { 0x5A,       0xFF,       1 },
+        { 0x40,       0xF0,       1 },
+        { 0x00,       0xFF,       1 },
+        { 0x5A5A,     0xFFFF,     2 },
+        { 0xA500,     0xFF00,     2 },
+        { 0x5A5A5A5A, 0xFFFFFFFF, 4 },
+        { 0x0000005A, 0x000000FF, 4 },
+    };
+    uint8_t *p_a = (uint8_t *)s_buf_a;
+    uint8_t *p_b = (uint8_t *)s_buf_b;
+    uint32_t ofs[8];
+    uint32_t ref_ofs[8];
+    uint32_t rnd = 0x12345678;
+    uint32_t err_cnt = 0;
+    uint32_t test_cnt = 0;
+
+    if (!mem_lock()) {
+        printf("Error: Memory tool is busy (another mem command or job is running)\n");
+        return false;
+    }
+
+    for (uint32_t i = 0; i < sizeof(s_buf_a); i++)
+    {
+        rnd ^= rnd << 13;
+        rnd ^= rnd >> 17;
+        rnd ^= rnd << 5;
+        // 一致が出るように値の種類を絞る
+        p_a[i] = ((rnd & 0x3) == 0) ? 0x5A : (uint8_t)(rnd >> 8) & 0xF5;
+    }
+
+    // 検索 ... 先頭位置(1Byteパターンのみ非アライン)と長さを変えて確認
+    for (uint32_t p = 0; p < count_of(s_pat_tbl); p++)
+    {
+        const mem_pattern_t *p_pat = &s_pat_tbl[p];
+        for (uint32_t start = 0; start < 4; start += p_pat->width)
+        {
+            for (uint32_t len = 0; len <= 64; len++)
+            {
+                uint32_t cnt = app_mem_find_kernel(&p_a[start], len, p_pat, 0, ofs, count_of(ofs), 0);
+                uint32_t ref = mem_test_ref_find(&p_a[start], len, p_pat, (uintptr_t)&p_a[start], ref_ofs, count_of(ref_ofs));
+                uint32_t n = (cnt < count_of(ofs)) ? cnt : count_of(ofs);
+                test_cnt++;
+                if ((cnt != ref) || (memcmp(ofs, ref_ofs, n * sizeof(uint32_t)) != 0)) {
+                    err_cnt++;
+                }
+            }
+        }
+    }
+
+    // 比較 ... 1Byteだけ変えた位置と長さ/先頭位置を変えて確認
+    for (uint32_t start = 0; start < 4; start++)
+    {
+        for (uint32_t pos = 0; pos < 40; pos += 3)
+        {
+            memcpy(p_b, p_a, sizeof(s_buf_a));
+            p_b[start + pos] ^= 0x10;
+            p_b[start + pos + 17] ^= 0x01;
+            for (uint32_t len = 0; len <= 80; len += 7)
+            {
+                uint32_t cnt = app_mem_cmp_kernel(&p_a[start], &p_b[start], len, 0, ofs, count_of(ofs), 0);
+                uint32_t ref = ((pos < len) ? 1 : 0) + (((pos + 17) < len) ? 1 : 0);
+                test_cnt++;
+                if ((cnt != ref) || ((ref != 0) && (ofs[0] != pos))) {
+                    err_cnt++;
+                }
+            }
+        }
+    }
+
+    printf("Memory kernel self test : %u / %u passed\n", test_cnt - err_cnt, test_cnt);
+    mem_unlock();
+
+    return (err_cnt == 0);
+}
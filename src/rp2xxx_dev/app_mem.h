@@ -0,0 +1,76 @@
+/**
+ * @file app_mem.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief メモリ操作アプリのヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026 Chimipupu All Rights Reserved.
+ * 
+ */
+#ifndef APP_MEM_H
+#define APP_MEM_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "pico/stdlib.h"
+
+#define MEM_STAGE_BUF_SIZE      1024    // 読み出しステージングバッファ(Byte) ※16の倍数
+#define MEM_LZ_WINDOW_SIZE      4096    // LZSSのスライド窓(=ブロック)サイズ
+#define MEM_LZ_MIN_MATCH        3       // LZSSの最小一致長
+#define MEM_LZ_MAX_MATCH        18      // LZSSの最大一致長(4bit + MIN_MATCH)
+#define MEM_LZ_HASH_BITS        10      // LZSSの一致候補ハッシュのビット数
+#define MEM_FIND_HIT_MAX        16      // mfindで表示する一致アドレスの最大数
+#define MEM_CMP_DIFF_DEFAULT    16      // mcmpで表示する不一致の既定数
+#define MEM_CMP_DIFF_MAX        64      // mcmpで表示する不一致の最大数
+
+// バルクダンプの出力形式
+typedef enum {
+    MEM_DUMP_MODE_HEX,      // HEX & ASCII (1行まとめて整形)
+    MEM_DUMP_MODE_RAW,      // 生バイナリ
+    MEM_DUMP_MODE_RLE,      // PackBits形式のRLE圧縮
+    MEM_DUMP_MODE_LZ,       // LZSS圧縮
+    MEM_DUMP_MODE_NUM
+} mem_dump_mode_t;
+
+// バルクダンプの結果
+typedef struct {
+    uint32_t in_size;       // 読み出したサイズ(Byte)
+    uint32_t out_size;      // 出力したサイズ(Byte) ※HEXは文字数
+    uint32_t proc_time_us;  // 処理時間(us)
+    bool is_dma;            // DMAで読み出したか
+} mem_dump_result_t;
+
+// 検索パターン
+typedef struct {
+    uint32_t value;         // 値(2/4ByteはLE)
+    uint32_t mask;          // マスク(1のビットのみ比較)
+    uint32_t width;         // パターン幅(1/2/4Byte)
+} mem_pattern_t;
+
+// 検索/フィル/比較の結果
+typedef struct {
+    uint32_t size;          // 処理したサイズ(Byte)
+    uint32_t cnt;           // 一致数(検索) / 不一致Byte数(比較)
+    uint32_t proc_time_us;  // 処理時間(us)
+    bool is_dma;            // DMAを使ったか
+} mem_op_result_t;
+
+int32_t app_mem_get_dump_mode(const char *p_mode_str);
+const char *app_mem_get_dump_mode_str(mem_dump_mode_t mode);
+bool app_mem_bulk_dump(uint32_t addr, uint32_t size, mem_dump_mode_t mode, mem_dump_result_t *p_result);
+bool app_mem_parse_pattern(const char *p_str, uint32_t *p_value, uint32_t *p_width);
+uint32_t app_mem_find_kernel(const uint8_t *p_buf, uint32_t len, const mem_pattern_t *p_pat,
+                             uint32_t base_ofs, uint32_t *p_hit_ofs, uint32_t hit_max, uint32_t hit_cnt);
+uint32_t app_mem_cmp_kernel(const uint8_t *p_a, const uint8_t *p_b, uint32_t len,
+                            uint32_t base_ofs, uint32_t *p_diff_ofs, uint32_t diff_max, uint32_t diff_cnt);
+bool app_mem_find(uint32_t addr, uint32_t size, const mem_pattern_t *p_pat,
+                  uint32_t *p_hit_addr, uint32_t hit_max, mem_op_result_t *p_result);
+bool app_mem_cmp(uint32_t addr_a, uint32_t addr_b, uint32_t size,
+                 uint32_t *p_diff_ofs, uint32_t diff_max, mem_op_result_t *p_result);
+bool app_mem_fill(uint32_t addr, uint32_t size, uint32_t value, uint32_t width, mem_op_result_t *p_result);
+bool app_mem_kernel_self_test(void);
+#endif // APP_MEM_H
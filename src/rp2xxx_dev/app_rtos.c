@@ -0,0 +1,500 @@
+/**
+ * @file app_rtos.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief FreeRTOS SMP版のタスク構成、top表示、カーネルのベンチマーク
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026 Chimipupu All Rights Reserved.
+ *
+ * RP2XXX_USE_FREERTOS=ONのビルドだけで使う。ベアメタル版の2つのスーパーループを
+ * コア固定のタスクに置き換える。
+ *   shell (Core1) ... デバッグモニタ。入力が無い間は受信コールバックの通知で眠る
+ *   io    (Core0) ... FIFOの代わりのキューで処理コード(PROC_xxx)を受けて実行
+ *   px    (Core0) ... NeoPixelのフェード(1ms周期)
+ *   led   (Core0) ... 基板LEDの点滅(Pico2Wのみ)
+ * SMPポートはコア間のyieldにSIO FIFOを使うので、アプリはFIFOを使わない。
+ */
+#include "app_rtos.h"
+
+#if defined(RP2XXX_USE_FREERTOS)
+#include "app_cpu_core_0.h"
+#include "app_cpu_core_1.h"
+#include "dbg_com.h"
+#include "drv_ipc.h"
+#include "app_fx.h"
+#include "muc_rpxxx_util.h"
+
+#define RTOS_IPC_RX_CODE        0xFFFFFFFFu     // 処理コードと被らない「メッセージ受信」の印
+#define RTOS_BENCH_NOTIFY_IDX   1               // ベンチの通知番号(0はstdinの受信通知)
+
+// ベンチマークの種類
+typedef enum {
+    RTOS_BENCH_NOTIFY,      // タスク通知
+    RTOS_BENCH_SEM,         // バイナリセマフォ
+    RTOS_BENCH_QUEUE,       // キュー(1ワード)
+    RTOS_BENCH_SPIN,        // 共有メモリのスピン(カーネル無しの下限、相手コアのみ)
+    RTOS_BENCH_KIND_NUM,
+} rtos_bench_kind_t;
+
+// ベンチマークの応答タスクとの共有
+typedef struct {
+    rtos_bench_kind_t kind;
+    uint32_t cnt;
+    TaskHandle_t p_master;
+    TaskHandle_t p_echo;
+    SemaphoreHandle_t p_req_sem;
+    SemaphoreHandle_t p_resp_sem;
+    QueueHandle_t p_req_queue;
+    QueueHandle_t p_resp_queue;
+    volatile uint32_t spin_req;
+    volatile uint32_t spin_resp;
+    volatile bool is_done;
+} rtos_bench_ctx_t;
+
+static const char *s_p_bench_str[] = {"notify", "sem", "queue", "spin"};
+
+static QueueHandle_t s_p_io_queue = NULL;
+static TaskHandle_t s_p_shell_task = NULL;
+static TaskHandle_t s_p_px_task = NULL;
+
+static void rtos_shell_task(void *p_arg);
+static void rtos_io_task(void *p_arg);
+static void rtos_px_task(void *p_arg);
+#if defined(PCB_PICO2W)
+static void rtos_led_task(void *p_arg);
+#endif
+static void rtos_ipc_rx_callback(void);
+static void rtos_stdin_callback(void *p_arg);
+static void rtos_bench_echo_task(void *p_arg);
+static bool rtos_bench_one(rtos_bench_kind_t kind, uint32_t core, uint32_t cnt);
+
+static TaskHandle_t rtos_create(TaskFunction_t p_func, const char *p_name, uint32_t stack,
+                                UBaseType_t prio, uint32_t core)
+{
+    TaskHandle_t p_task = NULL;
+
+    if (xTaskCreateAffinitySet(p_func, p_name, stack, NULL, prio, (1u << core), &p_task) != pdPASS) {
+        printf("Error: Failed to create task '%s'\n", p_name);
+        return NULL;
+    }
+
+    return p_task;
+}
+
+// モニタ(Core1)
+static void rtos_shell_task(void *p_arg)
+{
+    int32_t c;
+
+    app_core_1_init();
+    stdio_set_chars_available_callback(rtos_stdin_callback, NULL);
+
+    while(1)
+    {
+        c = dbg_com_getchar_timeout_us(0);
+        if (c == PICO_ERROR_TIMEOUT) {
+            ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(RTOS_SHELL_POLL_MS));
+        } else {
+            dbg_com_input(c);
+        }
+        WDT_RST();
+    }
+}
+
+// 処理コードの実行(Core0) ... ベアメタル版のFIFO/Doorbellハンドラと同じ処理
+static void rtos_io_task(void *p_arg)
+{
+    uint32_t code;
+
+    app_core_0_init();
+    drv_ipc_core_init(rtos_ipc_rx_callback);
+
+    while(1)
+    {
+        if (xQueueReceive(s_p_io_queue, &code, portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+
+        if (code == RTOS_IPC_RX_CODE) {
+            app_core_0_ipc_rx();
+        } else {
+            app_core_0_proc(code);
+        }
+    }
+}
+
+// NeoPixelのエフェクト(Core0、開始の通知から設定したfpsの周期 ※ティック単位に丸める)
+static void rtos_px_task(void *p_arg)
+{
+    TickType_t wake, period;
+    uint32_t period_us;
+
+    while(1)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        wake = xTaskGetTickCount();
+        while ((period_us = app_fx_get_period_us()) != 0)
+        {
+            app_fx_tick();
+            period = (TickType_t)(((uint64_t)period_us * configTICK_RATE_HZ) / 1000000u);
+            xTaskDelayUntil(&wake, (period != 0) ? period : 1);
+        }
+    }
+}
+
+#if defined(PCB_PICO2W)
+// 基板LEDの点滅(1000ms周期)
+static void rtos_led_task(void *p_arg)
+{
+    while(1)
+    {
+        cyw43_led_tgl();
+        vTaskDelay(pdMS_TO_TICKS(1000));
+    }
+}
+#endif
+
+// Doorbell割り込み(Core0) ... 受信済みを1つ積むだけ(キューが満杯なら既に積まれている)
+static void rtos_ipc_rx_callback(void)
+{
+    uint32_t code = RTOS_IPC_RX_CODE;
+    BaseType_t is_woken = pdFALSE;
+
+    xQueueSendToBackFromISR(s_p_io_queue, &code, &is_woken);
+    portYIELD_FROM_ISR(is_woken);
+}
+
+// stdinの受信コールバック(USB/UARTの割り込み文脈)
+static void rtos_stdin_callback(void *p_arg)
+{
+    BaseType_t is_woken = pdFALSE;
+
+    if (s_p_shell_task != NULL) {
+        vTaskNotifyGiveFromISR(s_p_shell_task, &is_woken);
+        portYIELD_FROM_ISR(is_woken);
+    }
+}
+
+/**
+ * @brief タスクを作ってスケジューラを開始(戻らない)
+ * @note main()からCore1を起動せずに呼ぶ。Core1はスケジューラが起動する
+ */
+void app_rtos_start(void)
+{
+    // コア間メッセージキューはタスクの起動前に初期化
+    drv_ipc_init();
+    s_p_io_queue = xQueueCreate(RTOS_IO_QUEUE_LEN, sizeof(uint32_t));
+
+    s_p_shell_task = rtos_create(rtos_shell_task, "shell", RTOS_SHELL_STACK, RTOS_SHELL_PRIO, RTOS_SHELL_CORE);
+    rtos_create(rtos_io_task, "io", RTOS_IO_STACK, RTOS_IO_PRIO, RTOS_IO_CORE);
+    s_p_px_task = rtos_create(rtos_px_task, "px", RTOS_PX_STACK, RTOS_PX_PRIO, RTOS_IO_CORE);
+#if defined(PCB_PICO2W)
+    rtos_create(rtos_led_task, "led", RTOS_LED_STACK, RTOS_LED_PRIO, RTOS_IO_CORE);
+#endif
+
+    vTaskStartScheduler();
+
+    // ヒープ不足でアイドル/タイマータスクが作れないときだけ来る
+    printf("Error: FreeRTOS scheduler failed to start\n");
+    while(1)
+    {
+        tight_loop_contents();
+    }
+}
+
+/**
+ * @brief Core0へ処理コードを送る(ベアメタル版のFIFO送信の代わり)
+ *
+ * @param code 処理コード(PROC_xxx)
+ */
+void app_rtos_post(uint32_t code)
+{
+    xQueueSendToBack(s_p_io_queue, &code, portMAX_DELAY);
+}
+
+/**
+ * @brief NeoPixelのエフェクトタスクに設定の変更(開始/停止/fps)を通知
+ */
+void app_rtos_fx_update(void)
+{
+    xTaskNotifyGive(s_p_px_task);
+}
+
+/**
+ * @brief タスクごとのCPU使用率とスタック残量の表示(top)
+ *
+ * @param interval_ms 計測区間(ms)
+ */
+void app_rtos_top(uint32_t interval_ms)
+{
+    static const char s_state_chr[] = {'R', 'r', 'B', 'S', 'D', '?'};
+    UBaseType_t max = RTOS_TOP_TASK_MAX;
+    TaskStatus_t *p_before, *p_after;
+    UBaseType_t n_before, n_after;
+    configRUN_TIME_COUNTER_TYPE total_before, total_after, window, idle_sum;
+    configRUN_TIME_COUNTER_TYPE delta[RTOS_TOP_TASK_MAX];
+    uint8_t order[RTOS_TOP_TASK_MAX];
+
+    p_before = pvPortMalloc(sizeof(TaskStatus_t) * max * 2);
+    if (p_before == NULL) {
+        printf("Error: Out of heap\n");
+        return;
+    }
+    p_after = &p_before[max];
+
+    n_before = uxTaskGetSystemState(p_before, max, &total_before);
+    vTaskDelay(pdMS_TO_TICKS(interval_ms));
+    n_after = uxTaskGetSystemState(p_after, max, &total_after);
+    if (n_after == 0) {
+        printf("Error: Too many tasks (max %u)\n", RTOS_TOP_TASK_MAX);
+        vPortFree(p_before);
+        return;
+    }
+    window = total_after - total_before;
+    if (window == 0) {
+        window = 1;
+    }
+
+    // 区間内の実行時間(区間中に作られたタスクは全体)
+    for (UBaseType_t i = 0; i < n_after; i++)
+    {
+        delta[i] = p_after[i].ulRunTimeCounter;
+        for (UBaseType_t j = 0; j < n_before; j++)
+        {
+            if (p_before[j].xTaskNumber == p_after[i].xTaskNumber) {
+                delta[i] -= p_before[j].ulRunTimeCounter;
+                break;
+            }
+        }
+        order[i] = (uint8_t)i;
+    }
+
+    // 使用率の降順
+    for (UBaseType_t i = 1; i < n_after; i++)
+    {
+        uint8_t key = order[i];
+        int32_t j = (int32_t)i - 1;
+        while ((j >= 0) && (delta[order[j]] < delta[key])) {
+            order[j + 1] = order[j];
+            j--;
+        }
+        order[j + 1] = key;
+    }
+
+    printf("\n[top] window %u ms, %u tasks, heap free %u B (min %u B)\n",
+            (uint32_t)(window / 1000), (uint32_t)n_after,
+            (uint32_t)xPortGetFreeHeapSize(), (uint32_t)xPortGetMinimumEverFreeHeapSize());
+    for (uint32_t core = 0; core < configNUMBER_OF_CORES; core++)
+    {
+        TaskHandle_t p_idle = xTaskGetIdleTaskHandleForCore((BaseType_t)core);
+        idle_sum = 0;
+        for (UBaseType_t i = 0; i < n_after; i++)
+        {
+            if (p_after[i].xHandle == p_idle) {
+                idle_sum = delta[i];
+            }
+        }
+        idle_sum = (idle_sum > window) ? window : idle_sum;
+        printf("Core %u load: %3u.%u%%\n", core,
+                (uint32_t)(((window - idle_sum) * 1000u) / window) / 10,
+                (uint32_t)(((window - idle_sum) * 1000u) / window) % 10);
+    }
+    printf("Name         S Prio Core   CPU(%%)  Run(ms) Stack free(B)\n");
+    for (UBaseType_t k = 0; k < n_after; k++)
+    {
+        const TaskStatus_t *p_task = &p_after[order[k]];
+        uint32_t permil = (uint32_t)((delta[order[k]] * 1000u) / window);
+        uint32_t state = ((uint32_t)p_task->eCurrentState < 5) ? (uint32_t)p_task->eCurrentState : 5;
+        char core_str[4];
+
+        if (p_task->uxCoreAffinityMask == (1u << 0)) {
+            strcpy(core_str, "0");
+        } else if (p_task->uxCoreAffinityMask == (1u << 1)) {
+            strcpy(core_str, "1");
+        } else {
+            strcpy(core_str, "*");
+        }
+        printf("%-12s %c %4u %4s %5u.%u %8u %13u\n",
+                p_task->pcTaskName, s_state_chr[state], (uint32_t)p_task->uxCurrentPriority, core_str,
+                permil / 10, permil % 10, (uint32_t)(p_task->ulRunTimeCounter / 1000),
+                (uint32_t)(p_task->usStackHighWaterMark * sizeof(StackType_t)));
+    }
+
+    vPortFree(p_before);
+}
+
+// ベンチマークの応答側(相手の要求を受けてすぐ返す)
+static void rtos_bench_echo_task(void *p_arg)
+{
+    rtos_bench_ctx_t *p_ctx = (rtos_bench_ctx_t *)p_arg;
+    uint32_t data;
+
+    for (uint32_t i = 0; i < p_ctx->cnt; i++)
+    {
+        switch (p_ctx->kind)
+        {
+            case RTOS_BENCH_NOTIFY:
+                ulTaskNotifyTakeIndexed(RTOS_BENCH_NOTIFY_IDX, pdTRUE, portMAX_DELAY);
+                xTaskNotifyGiveIndexed(p_ctx->p_master, RTOS_BENCH_NOTIFY_IDX);
+                break;
+
+            case RTOS_BENCH_SEM:
+                xSemaphoreTake(p_ctx->p_req_sem, portMAX_DELAY);
+                xSemaphoreGive(p_ctx->p_resp_sem);
+                break;
+
+            case RTOS_BENCH_QUEUE:
+                xQueueReceive(p_ctx->p_req_queue, &data, portMAX_DELAY);
+                xQueueSendToBack(p_ctx->p_resp_queue, &data, portMAX_DELAY);
+                break;
+
+            default:
+                while (p_ctx->spin_req == i) {
+                    tight_loop_contents();
+                }
+                __mem_fence_acquire();
+                p_ctx->spin_resp = i + 1;
+                break;
+        }
+    }
+
+    p_ctx->is_done = true;
+    vTaskDelete(NULL);
+}
+
+// 1種類の往復時間を計測(呼び出し元 = Core1のモニタが要求側)
+static bool rtos_bench_one(rtos_bench_kind_t kind, uint32_t core, uint32_t cnt)
+{
+    rtos_bench_ctx_t ctx;
+    uint32_t t0, cyc, data = 0;
+    uint32_t cyc_min = 0xFFFFFFFF, cyc_max = 0;
+    uint64_t cyc_sum = 0;
+    uint32_t cyc_per_us = clock_get_hz(clk_sys) / 1000000;
+    bool is_ok = true;
+
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.kind = kind;
+    ctx.cnt = cnt + 1;      // 1回目は暖機(キャッシュ/初回のリスト操作)として捨てる
+    ctx.p_master = xTaskGetCurrentTaskHandle();
+    ctx.p_req_sem = xSemaphoreCreateBinary();
+    ctx.p_resp_sem = xSemaphoreCreateBinary();
+    ctx.p_req_queue = xQueueCreate(1, sizeof(uint32_t));
+    ctx.p_resp_queue = xQueueCreate(1, sizeof(uint32_t));
+    if ((ctx.p_req_sem == NULL) || (ctx.p_resp_sem == NULL) ||
+        (ctx.p_req_queue == NULL) || (ctx.p_resp_queue == NULL) ||
+        (xTaskCreateAffinitySet(rtos_bench_echo_task, "bench", RTOS_BENCH_STACK, &ctx,
+                                RTOS_BENCH_PRIO, (1u << core), &ctx.p_echo) != pdPASS)) {
+        printf("Error: Out of heap\n");
+        is_ok = false;
+        goto cleanup;
+    }
+    ulTaskNotifyTakeIndexed(RTOS_BENCH_NOTIFY_IDX, pdTRUE, 0);
+
+    for (uint32_t i = 0; i < ctx.cnt; i++)
+    {
+        t0 = rp2xxx_get_cycle_cnt();
+        switch (kind)
+        {
+            case RTOS_BENCH_NOTIFY:
+                xTaskNotifyGiveIndexed(ctx.p_echo, RTOS_BENCH_NOTIFY_IDX);
+                ulTaskNotifyTakeIndexed(RTOS_BENCH_NOTIFY_IDX, pdTRUE, portMAX_DELAY);
+                break;
+
+            case RTOS_BENCH_SEM:
+                xSemaphoreGive(ctx.p_req_sem);
+                xSemaphoreTake(ctx.p_resp_sem, portMAX_DELAY);
+                break;
+
+            case RTOS_BENCH_QUEUE:
+                xQueueSendToBack(ctx.p_req_queue, &i, portMAX_DELAY);
+                xQueueReceive(ctx.p_resp_queue, &data, portMAX_DELAY);
+                is_ok = is_ok && (data == i);
+                break;
+
+            default:
+                __mem_fence_release();
+                ctx.spin_req = i + 1;
+                while (ctx.spin_resp != i + 1) {
+                    tight_loop_contents();
+                }
+                break;
+        }
+        cyc = rp2xxx_get_cycle_cnt() - t0;
+
+        if (i != 0) {
+            cyc_sum += cyc;
+            cyc_min = (cyc < cyc_min) ? cyc : cyc_min;
+            cyc_max = (cyc > cyc_max) ? cyc : cyc_max;
+        }
+    }
+
+    // 応答タスクが削除されるまで待ってから後始末
+    while (!ctx.is_done) {
+        vTaskDelay(1);
+    }
+    vTaskDelay(1);
+
+    printf("%-7s Core %u->%u %9u %9u %9u %7u.%02u %s\n",
+            s_p_bench_str[kind], RTOS_SHELL_CORE, core,
+            cyc_min, (uint32_t)(cyc_sum / cnt), cyc_max,
+            (uint32_t)(cyc_sum / cnt) / cyc_per_us, (((uint32_t)(cyc_sum / cnt) % cyc_per_us) * 100u) / cyc_per_us,
+            is_ok ? "OK" : "NG");
+
+cleanup:
+    if (ctx.p_req_sem != NULL) {
+        vSemaphoreDelete(ctx.p_req_sem);
+    }
+    if (ctx.p_resp_sem != NULL) {
+        vSemaphoreDelete(ctx.p_resp_sem);
+    }
+    if (ctx.p_req_queue != NULL) {
+        vQueueDelete(ctx.p_req_queue);
+    }
+    if (ctx.p_resp_queue != NULL) {
+        vQueueDelete(ctx.p_resp_queue);
+    }
+
+    return is_ok;
+}
+
+/**
+ * @brief カーネルの同期機構の往復時間(コンテキストスイッチ込み)のベンチマーク
+ * @note 同じコア ... 要求 -> 応答タスクへ切替 -> 応答 -> 要求側へ切替
+ *       相手コア ... 相手コアでの起床(コア間割り込み)も含む
+ *       ベアメタル版との比較は同じ往復をするipc bench/mctの結果と比べる
+ *
+ * @param cnt 往復回数
+ */
+void app_rtos_bench(uint32_t cnt)
+{
+    printf("\n[RTOS Bench] %u round trips, %u MHz\n", cnt, clock_get_hz(clk_sys) / 1000000);
+    printf("Kind    Path       min(cyc)  avg(cyc)  max(cyc) avg(us)    Result\n");
+
+    for (uint32_t kind = 0; kind < RTOS_BENCH_KIND_NUM; kind++)
+    {
+        // スピンは同じコアだと相手が動けないので相手コアのみ
+        if (kind != RTOS_BENCH_SPIN) {
+            if (!rtos_bench_one((rtos_bench_kind_t)kind, RTOS_SHELL_CORE, cnt)) {
+                return;
+            }
+        }
+        if (!rtos_bench_one((rtos_bench_kind_t)kind, RTOS_IO_CORE, cnt)) {
+            return;
+        }
+    }
+}
+
+// スタックオーバーフロー(configCHECK_FOR_STACK_OVERFLOW)
+void vApplicationStackOverflowHook(TaskHandle_t p_task, char *p_name)
+{
+    printf("Error: Stack overflow in task '%s'\n", p_name);
+    panic("stack overflow");
+}
+
+// ヒープ不足(configUSE_MALLOC_FAILED_HOOK)
+void vApplicationMallocFailedHook(void)
+{
+    printf("Error: FreeRTOS heap exhausted\n");
+}
+#endif // RP2XXX_USE_FREERTOS
@@ -0,0 +1,57 @@
+/**
+ * @file app_rtos.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief FreeRTOS SMP版のタスク構成、top表示、カーネルのベンチマークのヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026 Chimipupu All Rights Reserved.
+ *
+ */
+#ifndef APP_RTOS_H
+#define APP_RTOS_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "pico/stdlib.h"
+
+#if defined(RP2XXX_USE_FREERTOS)
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+
+// コア割り当て(ベアメタル版と同じ ... Core0 = I/O/NeoPixel、Core1 = モニタ)
+#define RTOS_IO_CORE            0
+#define RTOS_SHELL_CORE         1
+
+// 優先度(数字が大きいほど高い)
+#define RTOS_LED_PRIO           (tskIDLE_PRIORITY + 1)
+#define RTOS_SHELL_PRIO         (tskIDLE_PRIORITY + 2)
+#define RTOS_IO_PRIO            (tskIDLE_PRIORITY + 3)
+#define RTOS_PX_PRIO            (tskIDLE_PRIORITY + 4)
+#define RTOS_BENCH_PRIO         (tskIDLE_PRIORITY + 5)
+
+// スタック(ワード)
+#define RTOS_SHELL_STACK        2048
+#define RTOS_IO_STACK           2048
+#define RTOS_PX_STACK           256
+#define RTOS_LED_STACK          256
+#define RTOS_BENCH_STACK        256
+
+#define RTOS_IO_QUEUE_LEN       16      // Core0への処理コードのキュー長
+#define RTOS_SHELL_POLL_MS      10      // 入力待ちの最大スリープ(受信コールバックの取りこぼし対策)
+#define RTOS_TOP_TASK_MAX       24      // topで表示するタスクの最大数
+
+// 関数プロトタイプ
+void app_rtos_start(void);
+void app_rtos_post(uint32_t code);
+void app_rtos_fx_update(void);
+void app_rtos_top(uint32_t interval_ms);
+void app_rtos_bench(uint32_t cnt);
+#endif // RP2XXX_USE_FREERTOS
+
+#endif // APP_RTOS_H
@@ -0,0 +1,661 @@
+/**
+ * @file app_script.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief コマンドスクリプトアプリ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026 Chimipupu All Rights Reserved.
+ *
+ * [スクリプトの書式] 1行1コマンド
+ *   # コメント
+ *   loop N ... end     N回繰り返し(N=0は無限、ネストはSCRIPT_LOOP_NEST_MAXまで)
+ *   sleep ms           ミリ秒待ち
+ *   echo text          文字列表示
+ *   set VAR val        変数に代入(10進 or #16進)
+ *   inc VAR [step]     変数に加算(stepの既定値は1)
+ *   time cmd           コマンドを実行してサイクル数を行ごとに集計
+ *   その他             モニタのコマンドとして実行
+ *   $VAR は10進、#$VAR は16進に展開する
+ * 実行中にESCかCtrl-Cで中断する
+ */
+#include "app_script.h"
+#include <ctype.h>
+#include <stdlib.h>
+#include "dbg_com.h"
+#include "muc_rpxxx_util.h"
+#include "hardware/flash.h"
+
+#define SCRIPT_LINE_LEN         96      // 1行の最大長(変数展開後)
+#define SCRIPT_SLEEP_SLICE_MS   10      // sleep中に中断キーを確認する間隔
+#define KEY_CTRL_C              0x03
+
+// Flashの保存イメージ(ヘッダ + 本体をページ単位に切り上げ)
+typedef struct {
+    uint32_t magic;
+    uint32_t len;
+    uint32_t sum;
+    uint32_t reserved;
+} script_flash_hdr_t;
+
+#define SCRIPT_FLASH_IMG_SIZE   (((sizeof(script_flash_hdr_t) + SCRIPT_BUF_SIZE + FLASH_PAGE_SIZE - 1) \
+                                    / FLASH_PAGE_SIZE) * FLASH_PAGE_SIZE)
+
+// 変数
+typedef struct {
+    char name[SCRIPT_VAR_NAME_LEN];
+    uint32_t val;
+} script_var_t;
+
+// loopのスタック
+typedef struct {
+    uint32_t start_line;    // loop行の行番号
+    uint32_t remain;        // 残り回数
+    bool is_infinite;       // 無限ループ
+} script_loop_t;
+
+// timeの行ごとの集計
+typedef struct {
+    uint32_t cnt;
+    uint64_t sum_cyc;
+    uint32_t min_cyc;
+    uint32_t max_cyc;
+    uint64_t sum_us;
+} script_time_stat_t;
+
+static char s_script_buf[SCRIPT_BUF_SIZE];
+static uint32_t s_script_len = 0;
+static uint16_t s_line_ofs[SCRIPT_LINE_MAX];
+static uint32_t s_line_num = 0;
+
+static script_var_t s_var[SCRIPT_VAR_MAX];
+static uint32_t s_var_cnt = 0;
+static script_loop_t s_loop_stack[SCRIPT_LOOP_NEST_MAX];
+static uint32_t s_loop_sp = 0;
+static script_time_stat_t s_time_stat[SCRIPT_LINE_MAX];
+
+static bool s_is_rec = false;
+static bool s_is_running = false;
+static uint8_t s_flash_img[SCRIPT_FLASH_IMG_SIZE] __attribute__((aligned(4)));
+
+static uint32_t script_calc_sum(const uint8_t *p_data, uint32_t len);
+static uint32_t script_build_line_tbl(void);
+static void script_get_line(uint32_t line, char *p_buf);
+static char *script_skip_space(char *p_str);
+static char *script_split_word(char *p_str);
+static bool script_parse_val(const char *p_str, uint32_t *p_val);
+static script_var_t *script_find_var(const char *p_name, bool is_create);
+static bool script_expand_var(const char *p_src, char *p_dst, uint32_t dst_size);
+static bool script_is_abort(void);
+static bool script_sleep_ms(uint32_t ms);
+static bool script_check_loop(void);
+static void script_show_time_stat(void);
+static bool script_rec_hook(const char *p_line);
+static bool script_flash_load(void);
+
+// FNV-1a(32bit)
+static uint32_t script_calc_sum(const uint8_t *p_data, uint32_t len)
+{
+    uint32_t hash = 0x811C9DC5;
+
+    for (uint32_t i = 0; i < len; i++)
+    {
+        hash ^= p_data[i];
+        hash *= 0x01000193;
+    }
+
+    return hash;
+}
+
+// 行の先頭オフセット表を作る
+static uint32_t script_build_line_tbl(void)
+{
+    uint32_t ofs = 0;
+
+    s_line_num = 0;
+    while ((ofs < s_script_len) && (s_line_num < SCRIPT_LINE_MAX))
+    {
+        s_line_ofs[s_line_num++] = (uint16_t)ofs;
+        while ((ofs < s_script_len) && (s_script_buf[ofs] != '\n'))
+        {
+            ofs++;
+        }
+        ofs++;
+    }
+
+    return s_line_num;
+}
+
+// 1行をバッファにコピー
+static void script_get_line(uint32_t line, char *p_buf)
+{
+    uint32_t ofs = s_line_ofs[line];
+    uint32_t len = 0;
+
+    while ((ofs + len < s_script_len) && (s_script_buf[ofs + len] != '\n') && (len < SCRIPT_LINE_LEN - 1))
+    {
+        p_buf[len] = s_script_buf[ofs + len];
+        len++;
+    }
+    p_buf[len] = '\0';
+}
+
+static char *script_skip_space(char *p_str)
+{
+    while (*p_str == ' ' || *p_str == '\t')
+    {
+        p_str++;
+    }
+
+    return p_str;
+}
+
+// 先頭の単語を終端して残りの文字列を返す
+static char *script_split_word(char *p_str)
+{
+    while ((*p_str != '\0') && (*p_str != ' ') && (*p_str != '\t'))
+    {
+        p_str++;
+    }
+    if (*p_str != '\0') {
+        *p_str++ = '\0';
+    }
+
+    return script_skip_space(p_str);
+}
+
+// 10進 or #16進の値を解析
+static bool script_parse_val(const char *p_str, uint32_t *p_val)
+{
+    char *p_end;
+    int base = 10;
+
+    if (*p_str == '#') {
+        p_str++;
+        base = 16;
+    }
+    if (*p_str == '\0') {
+        return false;
+    }
+
+    *p_val = (uint32_t)strtoul(p_str, &p_end, base);
+
+    return (*p_end == '\0' || *p_end == ' ');
+}
+
+static script_var_t *script_find_var(const char *p_name, bool is_create)
+{
+    for (uint32_t i = 0; i < s_var_cnt; i++)
+    {
+        if (strcmp(s_var[i].name, p_name) == 0) {
+            return &s_var[i];
+        }
+    }
+
+    if (!is_create || (s_var_cnt >= SCRIPT_VAR_MAX) || (strlen(p_name) >= SCRIPT_VAR_NAME_LEN)) {
+        return NULL;
+    }
+
+    strcpy(s_var[s_var_cnt].name, p_name);
+    s_var[s_var_cnt].val = 0;
+
+    return &s_var[s_var_cnt++];
+}
+
+// $VARを展開(直前が#なら16進、それ以外は10進)
+static bool script_expand_var(const char *p_src, char *p_dst, uint32_t dst_size)
+{
+    char name[SCRIPT_VAR_NAME_LEN];
+    uint32_t pos = 0;
+    uint32_t name_len;
+    script_var_t *p_var;
+
+    while (*p_src != '\0')
+    {
+        if (*p_src != '$') {
+            if (pos + 1 >= dst_size) {
+                return false;
+            }
+            p_dst[pos++] = *p_src++;
+            continue;
+        }
+
+        p_src++;
+        name_len = 0;
+        while ((isalnum((unsigned char)*p_src) || *p_src == '_') && (name_len < SCRIPT_VAR_NAME_LEN - 1))
+        {
+            name[name_len++] = *p_src++;
+        }
+        name[name_len] = '\0';
+
+        p_var = script_find_var(name, false);
+        if (p_var == NULL) {
+            printf("Error: Undefined variable '$%s'\n", name);
+            return false;
+        }
+
+        if ((pos > 0) && (p_dst[pos - 1] == '#')) {
+            pos += snprintf(&p_dst[pos], dst_size - pos, "%X", p_var->val);
+        } else {
+            pos += snprintf(&p_dst[pos], dst_size - pos, "%u", p_var->val);
+        }
+        if (pos >= dst_size) {
+            return false;
+        }
+    }
+    p_dst[pos] = '\0';
+
+    return true;
+}
+
+// ESC or Ctrl-Cで中断(それ以外のキーは先行入力としてモニタに戻す)
+static bool script_is_abort(void)
+{
+    int c = getchar_timeout_us(0);
+
+    if ((c == KEY_ESC) || (c == KEY_CTRL_C)) {
+        return true;
+    }
+    dbg_com_unget_key(c);
+
+    return false;
+}
+
+static bool script_sleep_ms(uint32_t ms)
+{
+    while (ms > 0)
+    {
+        uint32_t slice = (ms > SCRIPT_SLEEP_SLICE_MS) ? SCRIPT_SLEEP_SLICE_MS : ms;
+
+        sleep_ms(slice);
+        ms -= slice;
+        WDT_RST();
+        if (script_is_abort()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// loop/endの対応を実行前に確認
+static bool script_check_loop(void)
+{
+    char line[SCRIPT_LINE_LEN];
+    char *p_word;
+    int32_t depth = 0;
+
+    for (uint32_t i = 0; i < s_line_num; i++)
+    {
+        script_get_line(i, line);
+        p_word = script_skip_space(line);
+        script_split_word(p_word);
+
+        if (strcmp(p_word, "loop") == 0) {
+            if (++depth > SCRIPT_LOOP_NEST_MAX) {
+                printf("Error: loop nested too deep at line %u (max %d)\n", i + 1, SCRIPT_LOOP_NEST_MAX);
+                return false;
+            }
+        } else if (strcmp(p_word, "end") == 0) {
+            if (--depth < 0) {
+                printf("Error: 'end' without 'loop' at line %u\n", i + 1);
+                return false;
+            }
+        }
+    }
+
+    if (depth != 0) {
+        printf("Error: %d 'loop' without 'end'\n", depth);
+        return false;
+    }
+
+    return true;
+}
+
+static void script_show_time_stat(void)
+{
+    char line[SCRIPT_LINE_LEN];
+    uint32_t cyc_per_us = clock_get_hz(clk_sys) / 1000000;
+    bool is_title = false;
+
+    for (uint32_t i = 0; i < s_line_num; i++)
+    {
+        script_time_stat_t *p_stat = &s_time_stat[i];
+
+        if (p_stat->cnt == 0) {
+            continue;
+        }
+
+        if (!is_title) {
+            printf("\n[Script time stats (clk_sys:%u MHz)]\n", cyc_per_us);
+            printf("Line  Count      Avg(cyc)      Min(cyc)      Max(cyc)     Avg(us)  Command\n");
+            is_title = true;
+        }
+
+        script_get_line(i, line);
+        printf("%4u %6u %13llu %13u %13u %11llu  %s\n", i + 1, p_stat->cnt,
+                (unsigned long long)(p_stat->sum_cyc / p_stat->cnt), p_stat->min_cyc, p_stat->max_cyc,
+                (unsigned long long)(p_stat->sum_us / p_stat->cnt), script_skip_space(line));
+    }
+}
+
+// scr recの記録中にモニタの入力行を横取りする
+static bool script_rec_hook(const char *p_line)
+{
+    uint32_t len = strlen(p_line);
+
+    if (strcmp(p_line, ".") == 0) {
+        s_is_rec = false;
+        dbg_com_set_line_hook(NULL);
+        printf("Script recorded (%u lines, %u bytes)\n", script_build_line_tbl(), s_script_len);
+        return true;
+    }
+
+    if ((s_script_len + len + 1 >= SCRIPT_BUF_SIZE) || (script_build_line_tbl() >= SCRIPT_LINE_MAX)) {
+        s_is_rec = false;
+        dbg_com_set_line_hook(NULL);
+        printf("Error: Script is full (max %d bytes, %d lines). Recording stopped\n",
+                SCRIPT_BUF_SIZE, SCRIPT_LINE_MAX);
+        return true;
+    }
+
+    memcpy(&s_script_buf[s_script_len], p_line, len);
+    s_script_len += len;
+    s_script_buf[s_script_len++] = '\n';
+
+    return true;
+}
+
+static bool script_flash_load(void)
+{
+    const uint8_t *p_flash = (const uint8_t *)(XIP_BASE + SCRIPT_FLASH_OFFSET);
+    script_flash_hdr_t hdr;
+
+    memcpy(&hdr, p_flash, sizeof(hdr));
+    if ((hdr.magic != SCRIPT_FLASH_MAGIC) || (hdr.len >= SCRIPT_BUF_SIZE)) {
+        return false;
+    }
+    if (script_calc_sum(p_flash + sizeof(hdr), hdr.len) != hdr.sum) {
+        return false;
+    }
+
+    memcpy(s_script_buf, p_flash + sizeof(hdr), hdr.len);
+    s_script_len = hdr.len;
+
+    return true;
+}
+
+/**
+ * @brief スクリプトの初期化(Flashに保存済みなら読み込む)
+ */
+void app_script_init(void)
+{
+    s_script_len = 0;
+    s_is_rec = false;
+    s_is_running = false;
+    script_flash_load();
+}
+
+/**
+ * @brief スクリプトの記録開始("."のみの行で終了)
+ *
+ * @return true 記録開始
+ * @return false 実行中のため記録できない
+ */
+bool app_script_rec_start(void)
+{
+    if (s_is_running) {
+        printf("Error: Cannot record while a script is running\n");
+        return false;
+    }
+
+    s_script_len = 0;
+    s_is_rec = true;
+    dbg_com_set_line_hook(script_rec_hook);
+    printf("Recording script. Enter one command per line, '.' to finish\n");
+
+    return true;
+}
+
+/**
+ * @brief スクリプトの実行
+ *
+ * @return true 最後まで実行した
+ * @return false エラー or 中断
+ */
+bool app_script_run(void)
+{
+    char raw[SCRIPT_LINE_LEN];
+    char line[SCRIPT_LINE_LEN];
+    char *p_word;
+    char *p_rest;
+    char *p_arg;
+    script_var_t *p_var;
+    uint32_t pc = 0;
+    uint32_t val;
+    uint64_t start_us;
+    bool is_ok = true;
+
+    if (s_is_running) {
+        printf("Error: Script is already running\n");
+        return false;
+    }
+
+    if (script_build_line_tbl() == 0) {
+        printf("Error: Script is empty\n");
+        return false;
+    }
+
+    if (!script_check_loop()) {
+        return false;
+    }
+
+    s_var_cnt = 0;
+    s_loop_sp = 0;
+    memset(s_time_stat, 0, sizeof(s_time_stat));
+    s_is_running = true;
+    start_us = time_us_64();
+
+    while (pc < s_line_num)
+    {
+        WDT_RST();
+        if (script_is_abort()) {
+            printf("\nScript aborted at line %u\n", pc + 1);
+            is_ok = false;
+            break;
+        }
+
+        script_get_line(pc, raw);
+        p_word = script_skip_space(raw);
+        if ((*p_word == '\0') || (*p_word == '#')) {
+            pc++;
+            continue;
+        }
+
+        if (!script_expand_var(p_word, line, sizeof(line))) {
+            printf("Error: at line %u\n", pc + 1);
+            is_ok = false;
+            break;
+        }
+
+        p_word = line;
+        p_rest = script_split_word(p_word);
+
+        if (strcmp(p_word, "loop") == 0) {
+            if (!script_parse_val(p_rest, &val)) {
+                printf("Error: Invalid loop count at line %u\n", pc + 1);
+                is_ok = false;
+                break;
+            }
+            s_loop_stack[s_loop_sp].start_line = pc;
+            s_loop_stack[s_loop_sp].remain = val;
+            s_loop_stack[s_loop_sp].is_infinite = (val == 0);
+            s_loop_sp++;
+        } else if (strcmp(p_word, "end") == 0) {
+            script_loop_t *p_loop = &s_loop_stack[s_loop_sp - 1];
+
+            if (p_loop->is_infinite || (--p_loop->remain > 0)) {
+                pc = p_loop->start_line;
+            } else {
+                s_loop_sp--;
+            }
+        } else if (strcmp(p_word, "sleep") == 0) {
+            if (!script_parse_val(p_rest, &val)) {
+                printf("Error: Invalid sleep time at line %u\n", pc + 1);
+                is_ok = false;
+                break;
+            }
+            if (!script_sleep_ms(val)) {
+                printf("\nScript aborted at line %u\n", pc + 1);
+                is_ok = false;
+                break;
+            }
+        } else if (strcmp(p_word, "echo") == 0) {
+            printf("%s\n", p_rest);
+        } else if ((strcmp(p_word, "set") == 0) || (strcmp(p_word, "inc") == 0)) {
+            bool is_set = (p_word[0] == 's');
+
+            p_arg = script_split_word(p_rest);
+            val = 1;
+            if (is_set || (*p_arg != '\0')) {
+                if (!script_parse_val(p_arg, &val)) {
+                    printf("Error: Invalid value at line %u\n", pc + 1);
+                    is_ok = false;
+                    break;
+                }
+            }
+            p_var = script_find_var(p_rest, true);
+            if (p_var == NULL) {
+                printf("Error: Invalid variable '%s' at line %u (max %d vars, %d chars)\n",
+                        p_rest, pc + 1, SCRIPT_VAR_MAX, SCRIPT_VAR_NAME_LEN - 1);
+                is_ok = false;
+                break;
+            }
+            p_var->val = is_set ? val : (p_var->val + val);
+        } else if (strcmp(p_word, "time") == 0) {
+            script_time_stat_t *p_stat = &s_time_stat[pc];
+            uint64_t t0_us = time_us_64();
+            uint32_t t0_cyc = rp2xxx_get_cycle_cnt();
+            bool is_exec = dbg_com_exec_line(p_rest);
+            uint32_t cyc = rp2xxx_get_cycle_cnt() - t0_cyc;
+            uint64_t us = time_us_64() - t0_us;
+
+            if (!is_exec) {
+                printf("Error: Unknown command '%s' at line %u\n", p_rest, pc + 1);
+                is_ok = false;
+                break;
+            }
+            if ((p_stat->cnt == 0) || (cyc < p_stat->min_cyc)) {
+                p_stat->min_cyc = cyc;
+            }
+            if (cyc > p_stat->max_cyc) {
+                p_stat->max_cyc = cyc;
+            }
+            p_stat->sum_cyc += cyc;
+            p_stat->sum_us += us;
+            p_stat->cnt++;
+        } else {
+            // 分割で終端した単語を戻してモニタのコマンドとして実行
+            if (*p_rest != '\0') {
+                p_rest[-1] = ' ';
+            }
+            if (!dbg_com_exec_line(p_word)) {
+                printf("Error: Unknown command '%s' at line %u\n", p_word, pc + 1);
+                is_ok = false;
+                break;
+            }
+        }
+
+        pc++;
+    }
+
+    script_show_time_stat();
+    printf("Script %s (proc time: %llu us)\n", is_ok ? "completed" : "stopped",
+            (unsigned long long)(time_us_64() - start_us));
+    s_is_running = false;
+
+    return is_ok;
+}
+
+/**
+ * @brief スクリプトの一覧表示
+ */
+void app_script_list(void)
+{
+    char line[SCRIPT_LINE_LEN];
+
+    script_build_line_tbl();
+    printf("\n[Script (%u lines, %u / %d bytes)]\n", s_line_num, s_script_len, SCRIPT_BUF_SIZE);
+    for (uint32_t i = 0; i < s_line_num; i++)
+    {
+        script_get_line(i, line);
+        printf("%3u: %s\n", i + 1, line);
+    }
+}
+
+/**
+ * @brief スクリプトのクリア
+ */
+void app_script_clear(void)
+{
+    if (s_is_running) {
+        printf("Error: Cannot clear while a script is running\n");
+        return;
+    }
+
+    s_script_len = 0;
+    s_line_num = 0;
+    printf("Script cleared\n");
+}
+
+/**
+ * @brief スクリプトをFlashに保存
+ *
+ * @return true 成功
+ * @return false 失敗
+ */
+bool app_script_save(void)
+{
+    script_flash_hdr_t hdr;
+
+    hdr.magic = SCRIPT_FLASH_MAGIC;
+    hdr.len = s_script_len;
+    hdr.sum = script_calc_sum((const uint8_t *)s_script_buf, s_script_len);
+    hdr.reserved = 0xFFFFFFFF;
+
+    memset(s_flash_img, 0xFF, sizeof(s_flash_img));
+    memcpy(s_flash_img, &hdr, sizeof(hdr));
+    memcpy(&s_flash_img[sizeof(hdr)], s_script_buf, s_script_len);
+
+    if (!rp2xxx_flash_write(SCRIPT_FLASH_OFFSET, s_flash_img, sizeof(s_flash_img))) {
+        printf("Error: Flash write failed (Core 0 did not park)\n");
+        return false;
+    }
+
+    printf("Script saved to flash (offset:0x%08X, %u bytes)\n", SCRIPT_FLASH_OFFSET, s_script_len);
+
+    return true;
+}
+
+/**
+ * @brief スクリプトをFlashから読み込み
+ *
+ * @return true 成功
+ * @return false 保存されていない
+ */
+bool app_script_load(void)
+{
+    if (s_is_running) {
+        printf("Error: Cannot load while a script is running\n");
+        return false;
+    }
+
+    if (!script_flash_load()) {
+        printf("Error: No valid script in flash\n");
+        return false;
+    }
+
+    printf("Script loaded from flash (%u lines, %u bytes)\n", script_build_line_tbl(), s_script_len);
+
+    return true;
+}
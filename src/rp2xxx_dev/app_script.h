@@ -0,0 +1,39 @@
+/**
+ * @file app_script.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief コマンドスクリプトアプリのヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026 Chimipupu All Rights Reserved.
+ *
+ */
+#ifndef APP_SCRIPT_H
+#define APP_SCRIPT_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "pico/stdlib.h"
+#include "hardware/flash.h"
+
+#define SCRIPT_BUF_SIZE         2048    // スクリプト本体のバッファ(Byte)
+#define SCRIPT_LINE_MAX         64      // スクリプトの最大行数
+#define SCRIPT_LOOP_NEST_MAX    4       // loopの最大ネスト数
+#define SCRIPT_VAR_MAX          8       // 変数の最大数
+#define SCRIPT_VAR_NAME_LEN     8       // 変数名の最大長(終端含む)
+#define SCRIPT_FLASH_MAGIC      0x53435230  // "SCR0"
+#define SCRIPT_FLASH_OFFSET     (PICO_FLASH_SIZE_BYTES - FLASH_SECTOR_SIZE) // 保存先(Flash最終セクタ)
+
+// 関数プロトタイプ
+void app_script_init(void);
+bool app_script_rec_start(void);
+bool app_script_run(void);
+void app_script_list(void);
+void app_script_clear(void);
+bool app_script_save(void);
+bool app_script_load(void);
+
+#endif // APP_SCRIPT_H
@@ -0,0 +1,888 @@
+/**
+ * @file app_sha.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief SHA-256のストリーミングAPI(H/WアクセラレータへのDMA供給 + ソフトウェア実装)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026 Chimipupu All Rights Reserved.
+ *
+ * init -> update(任意の長さを何回でも) -> final の順に呼ぶ。パディングはfinalで付ける。
+ * H/W(RP2350)はブロック単位の入力をDMAでWDATAに流す(SHA-256のDREQが1ブロックずつ要求する)。
+ *   - 語境界の入力は32bit転送、そうでなければ8bit転送(アクセラレータのDMA_SIZEも合わせる)
+ *   - updateは最後のDMAを走らせたまま戻るので、渡したデータは次のupdate/finalまで書き換えないこと
+ *   - アクセラレータは1つなので、H/Wのハッシュは同時に1つだけ(2つ目のinitはfalse)
+ * ソフトウェアは展開した実装(S/W)がH/Wの無いRP2040の代わり、式のままの参照実装(S/W ref)が検算用。
+ * アドレス範囲はFlashならXIPストリーム(DMA)で2面のバッファに読みながら、SRAMはそのまま入れる。
+ * 大きな範囲は前半をCore1(H/W)、後半をCore0(S/W)で同時に計算し、2つのハッシュ値をまとめてハッシュする。
+ */
+#include "app_sha.h"
+#include "muc_rpxxx_util.h"
+#include "drv_ipc.h"
+#include "app_event.h"
+
+#include "hardware/sync.h"
+#include "hardware/structs/xip_ctrl.h"
+
+#define SHA_ROR(x, n)           (((x) >> (n)) | ((x) << (32 - (n))))
+
+// Σ/σは回転を畳み込み、回転3回 -> 回転の入れ子にする(回転の結果を次のXORにそのまま使える)
+//   Σ0 = ROR2 ^ ROR13 ^ ROR22 = ROR(ROR(ROR(x, 9) ^ x, 11) ^ x, 2)
+#define SHA_BSIG0(x)            SHA_ROR(SHA_ROR(SHA_ROR((x), 9) ^ (x), 11) ^ (x), 2)
+#define SHA_BSIG1(x)            SHA_ROR(SHA_ROR(SHA_ROR((x), 14) ^ (x), 5) ^ (x), 6)
+#define SHA_SSIG0(x)            (SHA_ROR(SHA_ROR((x), 11) ^ (x), 7) ^ ((x) >> 3))
+#define SHA_SSIG1(x)            (SHA_ROR(SHA_ROR((x), 2) ^ (x), 17) ^ ((x) >> 10))
+#define SHA_CH(e, f, g)         ((g) ^ ((e) & ((f) ^ (g))))
+#define SHA_MAJ(a, b, c)        (((a) & (b)) | ((c) & ((a) | (b))))
+
+// メッセージスケジュールは16語の窓で、添字を定数にしてレジスタに置く
+#define SHA_W(i)                w[(i) & 15]
+#define SHA_W_NEXT(i)           (SHA_W(i) += SHA_SSIG1(SHA_W((i) - 2)) + SHA_W((i) - 7) + SHA_SSIG0(SHA_W((i) - 15)))
+
+// 1ラウンド(a～hの入れ替えはせず、呼び出し側で引数をずらす)
+#define SHA_ROUND(a, b, c, d, e, f, g, h, i, W) \
+    do { \
+        uint32_t t1_ = (h) + SHA_BSIG1(e) + SHA_CH(e, f, g) + s_sha_k[i] + (W); \
+        (d) += t1_; \
+        (h) = t1_ + SHA_BSIG0(a) + SHA_MAJ(a, b, c); \
+    } while (0)
+
+// 8ラウンドで変数の並びが一周する
+#define SHA_ROUND_8(i, W) \
+    do { \
+        SHA_ROUND(a, b, c, d, e, f, g, h, (i) + 0, W((i) + 0)); \
+        SHA_ROUND(h, a, b, c, d, e, f, g, (i) + 1, W((i) + 1)); \
+        SHA_ROUND(g, h, a, b, c, d, e, f, (i) + 2, W((i) + 2)); \
+        SHA_ROUND(f, g, h, a, b, c, d, e, (i) + 3, W((i) + 3)); \
+        SHA_ROUND(e, f, g, h, a, b, c, d, (i) + 4, W((i) + 4)); \
+        SHA_ROUND(d, e, f, g, h, a, b, c, (i) + 5, W((i) + 5)); \
+        SHA_ROUND(c, d, e, f, g, h, a, b, (i) + 6, W((i) + 6)); \
+        SHA_ROUND(b, c, d, e, f, g, h, a, (i) + 7, W((i) + 7)); \
+    } while (0)
+
+static const uint32_t s_sha_k[64] = {
+    0x428A2F98, 0x71374491, 0xB5C0FBCF, 0xE9B5DBA5, 0x3956C25B, 0x59F111F1, 0x923F82A4, 0xAB1C5ED5,
+    0xD807AA98, 0x12835B01, 0x243185BE, 0x550C7DC3, 0x72BE5D74, 0x80DEB1FE, 0x9BDC06A7, 0xC19BF174,
+    0xE49B69C1, 0xEFBE4786, 0x0FC19DC6, 0x240CA1CC, 0x2DE92C6F, 0x4A7484AA, 0x5CB0A9DC, 0x76F988DA,
+    0x983E5152, 0xA831C66D, 0xB00327C8, 0xBF597FC7, 0xC6E00BF3, 0xD5A79147, 0x06CA6351, 0x14292967,
+    0x27B70A85, 0x2E1B2138, 0x4D2C6DFC, 0x53380D13, 0x650A7354, 0x766A0ABB, 0x81C2C92E, 0x92722C85,
+    0xA2BFE8A1, 0xA81A664B, 0xC24B8B70, 0xC76C51A3, 0xD192E819, 0xD6990624, 0xF40E3585, 0x106AA070,
+    0x19A4C116, 0x1E376C08, 0x2748774C, 0x34B0BCB5, 0x391C0CB3, 0x4ED8AA4A, 0x5B9CCA4F, 0x682E6FF3,
+    0x748F82EE, 0x78A5636F, 0x84C87814, 0x8CC70208, 0x90BEFFFA, 0xA4506CEB, 0xBEF9A3F7, 0xC67178F2,
+};
+
+static const uint32_t s_sha_iv[8] = {
+    0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A, 0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19,
+};
+
+static const char *s_p_engine_name[] = {"H/W DMA", "H/W CPU", "S/W", "S/W ref"};
+
+#if defined(MCU_RP2350)
+static bool s_is_hw_busy = false;   // アクセラレータを使っているハッシュがある
+#endif
+
+// FlashのXIPストリームの読み先(2面)
+static uint32_t s_stream_buf[2][SHA_STREAM_CHUNK_SIZE / 4];
+static bool s_is_stream_busy = false;
+
+// 2コア分割の後半(Core0が計算)
+static struct {
+    uint32_t addr;
+    uint32_t len;
+    uint32_t proc_time_us;
+    uint8_t digest[SHA_DIGEST_SIZE];
+    volatile bool is_ready;
+    volatile bool is_done;
+    volatile bool is_busy;      // Core0に依頼中(タイムアウト後もCore0が終わるまで立てたまま)
+} s_split;
+
+// ソフトウェアの圧縮関数の参照実装(FIPS 180-4の式のまま、blk_cnt個のブロック)
+static void sha_sw_ref_compress(uint32_t *p_state, const uint8_t *p_data, size_t blk_cnt)
+{
+    uint32_t w[64];
+    uint32_t a, b, c, d, e, f, g, h, t1, t2;
+
+    while (blk_cnt-- != 0)
+    {
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            w[i] = ((uint32_t)p_data[i * 4] << 24) | ((uint32_t)p_data[(i * 4) + 1] << 16) |
+                   ((uint32_t)p_data[(i * 4) + 2] << 8) | (uint32_t)p_data[(i * 4) + 3];
+        }
+        for (uint32_t i = 16; i < 64; i++)
+        {
+            uint32_t s0 = SHA_ROR(w[i - 15], 7) ^ SHA_ROR(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            uint32_t s1 = SHA_ROR(w[i - 2], 17) ^ SHA_ROR(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+
+        a = p_state[0]; b = p_state[1]; c = p_state[2]; d = p_state[3];
+        e = p_state[4]; f = p_state[5]; g = p_state[6]; h = p_state[7];
+        for (uint32_t i = 0; i < 64; i++)
+        {
+            t1 = h + (SHA_ROR(e, 6) ^ SHA_ROR(e, 11) ^ SHA_ROR(e, 25)) + ((e & f) ^ (~e & g)) + s_sha_k[i] + w[i];
+            t2 = (SHA_ROR(a, 2) ^ SHA_ROR(a, 13) ^ SHA_ROR(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+            h = g; g = f; f = e; e = d + t1;
+            d = c; c = b; b = a; a = t1 + t2;
+        }
+        p_state[0] += a; p_state[1] += b; p_state[2] += c; p_state[3] += d;
+        p_state[4] += e; p_state[5] += f; p_state[6] += g; p_state[7] += h;
+
+        p_data += SHA_BLOCK_SIZE;
+    }
+}
+
+static inline uint32_t sha_load_be32(const uint8_t *p_data)
+{
+    uint32_t word;
+
+    memcpy(&word, p_data, sizeof(word));
+    return __builtin_bswap32(word);
+}
+
+/**
+ * @brief ソフトウェアの圧縮関数(64ラウンドを展開、blk_cnt個のブロック)
+ * @note Cortex-M33はRORをEORのオペランドで回せ、M0+は回転の回数がそのまま命令数になるので
+ *       Σ/σの回転を畳み込む。a～hとスケジュールの窓は全てローカル変数で、ブロック間で配列に戻さない
+ */
+static void sha_sw_compress(uint32_t *p_state, const uint8_t *p_data, size_t blk_cnt)
+{
+    uint32_t a = p_state[0], b = p_state[1], c = p_state[2], d = p_state[3];
+    uint32_t e = p_state[4], f = p_state[5], g = p_state[6], h = p_state[7];
+    uint32_t w[16];
+
+    while (blk_cnt-- != 0)
+    {
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            w[i] = sha_load_be32(&p_data[i * 4]);
+        }
+
+        SHA_ROUND_8(0, SHA_W);
+        SHA_ROUND_8(8, SHA_W);
+        SHA_ROUND_8(16, SHA_W_NEXT);
+        SHA_ROUND_8(24, SHA_W_NEXT);
+        SHA_ROUND_8(32, SHA_W_NEXT);
+        SHA_ROUND_8(40, SHA_W_NEXT);
+        SHA_ROUND_8(48, SHA_W_NEXT);
+        SHA_ROUND_8(56, SHA_W_NEXT);
+
+        a += p_state[0]; b += p_state[1]; c += p_state[2]; d += p_state[3];
+        e += p_state[4]; f += p_state[5]; g += p_state[6]; h += p_state[7];
+        p_state[0] = a; p_state[1] = b; p_state[2] = c; p_state[3] = d;
+        p_state[4] = e; p_state[5] = f; p_state[6] = g; p_state[7] = h;
+
+        p_data += SHA_BLOCK_SIZE;
+    }
+}
+
+#if defined(MCU_RP2350)
+static void sha_hw_wait_dma(sha_ctx_t *p_ctx)
+{
+    if (p_ctx->dma_ch >= 0) {
+        dma_channel_wait_for_finish_blocking((uint)p_ctx->dma_ch);
+    }
+}
+
+/**
+ * @brief ブロック単位のデータをアクセラレータに書く(DMAは走らせたまま戻る)
+ *
+ * @param p_ctx コンテキスト
+ * @param p_src データ
+ * @param len バイト数(64の倍数)
+ */
+static void sha_hw_write(sha_ctx_t *p_ctx, const uint8_t *p_src, size_t len)
+{
+    bool is_aligned = (((uintptr_t)p_src & 3u) == 0);
+    dma_channel_config cfg;
+    uint32_t word;
+
+    sha_hw_wait_dma(p_ctx);
+
+    // CPUで1ブロック(16語)ずつ
+    if ((p_ctx->engine == SHA_ENGINE_HW_CPU) || (p_ctx->dma_ch < 0)) {
+        for (size_t i = 0; i < len; i += 4)
+        {
+            if ((i % SHA_BLOCK_SIZE) == 0) {
+                sha256_wait_ready_blocking();
+            }
+            memcpy(&word, &p_src[i], sizeof(word));
+            sha256_put_word(word);
+        }
+        return;
+    }
+
+    // DMAで全ブロック(DREQでアクセラレータが1ブロックずつ取り込む)
+    if (p_ctx->dma_size != (is_aligned ? 4u : 1u)) {
+        p_ctx->dma_size = is_aligned ? 4u : 1u;
+        sha256_wait_ready_blocking();
+        sha256_set_dma_size(p_ctx->dma_size);
+    }
+    cfg = dma_channel_get_default_config((uint)p_ctx->dma_ch);
+    channel_config_set_transfer_data_size(&cfg, is_aligned ? DMA_SIZE_32 : DMA_SIZE_8);
+    channel_config_set_read_increment(&cfg, true);
+    channel_config_set_write_increment(&cfg, false);
+    channel_config_set_dreq(&cfg, DREQ_SHA256);
+    dma_channel_configure((uint)p_ctx->dma_ch, &cfg, &sha256_hw->wdata, p_src,
+                            is_aligned ? (uint)(len / 4u) : (uint)len, true);
+}
+#endif // MCU_RP2350
+
+// ブロック単位のデータを計算に回す
+static void sha_feed_blocks(sha_ctx_t *p_ctx, const uint8_t *p_src, size_t len)
+{
+#if defined(MCU_RP2350)
+    if (p_ctx->engine < SHA_ENGINE_SW) {
+        sha_hw_write(p_ctx, p_src, len);
+        return;
+    }
+#endif
+    if (p_ctx->engine == SHA_ENGINE_SW_REF) {
+        sha_sw_ref_compress(p_ctx->state, p_src, len / SHA_BLOCK_SIZE);
+    } else {
+        sha_sw_compress(p_ctx->state, p_src, len / SHA_BLOCK_SIZE);
+    }
+}
+
+// 端数のバッファを書き換える前に、それを読んでいるDMAを待つ
+static void sha_wait_block(sha_ctx_t *p_ctx)
+{
+#if defined(MCU_RP2350)
+    if (p_ctx->engine < SHA_ENGINE_SW) {
+        sha_hw_wait_dma(p_ctx);
+    }
+#else
+    (void)p_ctx;
+#endif
+}
+
+/**
+ * @brief ハッシュの計算を開始
+ *
+ * @param p_ctx コンテキスト
+ * @param engine 計算の方法
+ * @return true 開始した
+ * @return false H/Wが無い or 他のハッシュがアクセラレータを使っている
+ */
+bool app_sha_init(sha_ctx_t *p_ctx, sha_engine_t engine)
+{
+    memset(p_ctx, 0, sizeof(sha_ctx_t));
+    p_ctx->engine = engine;
+    p_ctx->dma_ch = -1;
+    memcpy(p_ctx->state, s_sha_iv, sizeof(p_ctx->state));
+
+    if (engine >= SHA_ENGINE_SW) {
+        return true;
+    }
+#if defined(MCU_RP2350)
+    if (__atomic_exchange_n(&s_is_hw_busy, true, __ATOMIC_ACQUIRE)) {
+        return false;
+    }
+    if (engine == SHA_ENGINE_HW_DMA) {
+        // チャネルが無ければCPUで書く
+        p_ctx->dma_ch = dma_claim_unused_channel(false);
+    }
+    p_ctx->dma_size = 4;
+    sha256_set_dma_size(4);
+    sha256_set_bswap(true); // メモリ上のバイト順(LE)をメッセージ順に
+    sha256_start();
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief データを追加(任意の長さ、何回でも)
+ *
+ * @param p_ctx コンテキスト
+ * @param p_data データ(H/W DMAの場合は次のupdate/finalまで書き換えないこと)
+ * @param len バイト数
+ */
+void app_sha_update(sha_ctx_t *p_ctx, const void *p_data, size_t len)
+{
+    const uint8_t *p_src = (const uint8_t *)p_data;
+    uint8_t *p_block = (uint8_t *)p_ctx->block;
+    size_t n;
+
+    p_ctx->total_len += len;
+
+    // 溜まっている端数を1ブロックにする
+    if (p_ctx->block_len != 0) {
+        n = SHA_BLOCK_SIZE - p_ctx->block_len;
+        n = (len < n) ? len : n;
+        sha_wait_block(p_ctx);
+        memcpy(&p_block[p_ctx->block_len], p_src, n);
+        p_ctx->block_len += n;
+        p_src += n;
+        len -= n;
+        if (p_ctx->block_len < SHA_BLOCK_SIZE) {
+            return;
+        }
+        sha_feed_blocks(p_ctx, p_block, SHA_BLOCK_SIZE);
+        p_ctx->block_len = 0;
+    }
+
+    // ブロック単位はコピーせずにそのまま
+    n = len & ~(size_t)(SHA_BLOCK_SIZE - 1);
+    if (n != 0) {
+        sha_feed_blocks(p_ctx, p_src, n);
+        p_src += n;
+        len -= n;
+    }
+
+    // 残りは次のupdate/finalまで溜める
+    if (len != 0) {
+        sha_wait_block(p_ctx);
+        memcpy(p_block, p_src, len);
+        p_ctx->block_len = len;
+    }
+}
+
+/**
+ * @brief パディングを付けてハッシュ値を得る(コンテキストは終わり)
+ *
+ * @param p_ctx コンテキスト
+ * @param p_digest ハッシュ値の格納先(32バイト、ビッグエンディアン)
+ */
+void app_sha_final(sha_ctx_t *p_ctx, uint8_t *p_digest)
+{
+    uint8_t *p_block = (uint8_t *)p_ctx->block;
+    uint64_t bit_len = p_ctx->total_len * 8u;
+
+    // 0x80 + 0埋め + ビット長(BE 8バイト)、長さが入らなければもう1ブロック
+    sha_wait_block(p_ctx);
+    p_block[p_ctx->block_len++] = 0x80;
+    if (p_ctx->block_len > (SHA_BLOCK_SIZE - 8)) {
+        memset(&p_block[p_ctx->block_len], 0, SHA_BLOCK_SIZE - p_ctx->block_len);
+        sha_feed_blocks(p_ctx, p_block, SHA_BLOCK_SIZE);
+        p_ctx->block_len = 0;
+        sha_wait_block(p_ctx);
+    }
+    memset(&p_block[p_ctx->block_len], 0, (SHA_BLOCK_SIZE - 8) - p_ctx->block_len);
+    for (uint32_t i = 0; i < 8; i++)
+    {
+        p_block[SHA_BLOCK_SIZE - 1 - i] = (uint8_t)(bit_len >> (i * 8));
+    }
+    sha_feed_blocks(p_ctx, p_block, SHA_BLOCK_SIZE);
+    p_ctx->block_len = 0;
+
+#if defined(MCU_RP2350)
+    if (p_ctx->engine < SHA_ENGINE_SW) {
+        sha256_result_t result;
+
+        sha_hw_wait_dma(p_ctx);
+        sha256_wait_valid_blocking();
+        sha256_get_result(&result, SHA256_BIG_ENDIAN);
+        memcpy(p_digest, result.bytes, SHA_DIGEST_SIZE);
+        if (p_ctx->dma_ch >= 0) {
+            dma_channel_unclaim((uint)p_ctx->dma_ch);
+            p_ctx->dma_ch = -1;
+        }
+        __atomic_store_n(&s_is_hw_busy, false, __ATOMIC_RELEASE);
+        return;
+    }
+#endif
+    for (uint32_t i = 0; i < 8; i++)
+    {
+        p_digest[(i * 4) + 0] = (uint8_t)(p_ctx->state[i] >> 24);
+        p_digest[(i * 4) + 1] = (uint8_t)(p_ctx->state[i] >> 16);
+        p_digest[(i * 4) + 2] = (uint8_t)(p_ctx->state[i] >> 8);
+        p_digest[(i * 4) + 3] = (uint8_t)(p_ctx->state[i]);
+    }
+}
+
+/**
+ * @brief 1回でハッシュ値を計算
+ *
+ * @return true 計算した
+ * @return false その方法が使えない
+ */
+bool app_sha_calc(sha_engine_t engine, const void *p_data, size_t len, uint8_t *p_digest)
+{
+    sha_ctx_t ctx;
+
+    if (!app_sha_init(&ctx, engine)) {
+        return false;
+    }
+    app_sha_update(&ctx, p_data, len);
+    app_sha_final(&ctx, p_digest);
+
+    return true;
+}
+
+const char *app_sha_engine_name(sha_engine_t engine)
+{
+    return (engine <= SHA_ENGINE_SW_REF) ? s_p_engine_name[engine] : "?";
+}
+
+void app_sha_print_digest(const uint8_t *p_digest)
+{
+    for (uint32_t i = 0; i < SHA_DIGEST_SIZE; i++)
+    {
+        printf("%02X", p_digest[i]);
+    }
+    printf("\n");
+}
+
+// -------------------------------------------------------------------------
+// [アドレス範囲]
+// -------------------------------------------------------------------------
+static bool sha_is_flash(uint32_t addr, uint32_t len)
+{
+    return (addr >= XIP_BASE) && (((uint64_t)addr + len) <= ((uint64_t)XIP_BASE + PICO_FLASH_SIZE_BYTES));
+}
+
+// ストリームで読む長さ(語単位に切り上げ、ステージングバッファ1面まで)
+static uint32_t sha_stream_len(uint32_t pos, uint32_t end)
+{
+    uint32_t n = (end - pos + 3u) & ~3u;
+
+    return (n < SHA_STREAM_CHUNK_SIZE) ? n : SHA_STREAM_CHUNK_SIZE;
+}
+
+// FlashのposからwordsをXIPストリームでp_dstに読む(DMAは走らせたまま戻る)
+static void sha_stream_start(uint ch, uint32_t pos, uint32_t *p_dst, uint32_t words)
+{
+    dma_channel_config cfg;
+
+    // 前のストリームを止めてFIFOを空にする
+    xip_ctrl_hw->stream_ctr = 0;
+    while ((xip_ctrl_hw->stat & XIP_STAT_FIFO_EMPTY_BITS) == 0)
+    {
+        (void)xip_ctrl_hw->stream_fifo;
+    }
+    xip_ctrl_hw->stream_addr = pos;
+    xip_ctrl_hw->stream_ctr = words;
+
+    cfg = dma_channel_get_default_config(ch);
+    channel_config_set_transfer_data_size(&cfg, DMA_SIZE_32);
+    channel_config_set_read_increment(&cfg, false);
+    channel_config_set_write_increment(&cfg, true);
+    channel_config_set_dreq(&cfg, DREQ_XIP_STREAM);
+    dma_channel_configure(ch, &cfg, p_dst, (const volatile void *)XIP_AUX_BASE, words, true);
+}
+
+/**
+ * @brief Flashの範囲をXIPストリームで2面のバッファに読みながらハッシュに入れる
+ * @note チャンクkのハッシュ(H/WならDMA)とチャンクk+1のストリームを並行させる
+ */
+static void sha_update_stream(sha_ctx_t *p_ctx, uint ch, uint32_t addr, uint32_t len)
+{
+    uint32_t pos = addr & ~3u;      // ストリームは語単位
+    uint32_t end = addr + len;
+    uint32_t n = sha_stream_len(pos, end);
+    uint32_t k = 0;
+
+    sha_stream_start(ch, pos, s_stream_buf[0], n / 4u);
+    while (pos < end)
+    {
+        const uint8_t *p_chunk = (const uint8_t *)s_stream_buf[k & 1u];
+        uint32_t head = (pos < addr) ? (addr - pos) : 0;
+        uint32_t valid = ((end - pos) < n) ? (end - pos) : n;
+
+        dma_channel_wait_for_finish_blocking(ch);
+
+        // 次のバッファ面を読んでいるハッシュのDMAが終わってから次を読む
+        pos += n;
+        if (pos < end) {
+            sha_wait_block(p_ctx);
+            n = sha_stream_len(pos, end);
+            sha_stream_start(ch, pos, s_stream_buf[(k + 1u) & 1u], n / 4u);
+        }
+        app_sha_update(p_ctx, &p_chunk[head], valid - head);
+        k++;
+    }
+    xip_ctrl_hw->stream_ctr = 0;
+}
+
+// 範囲をハッシュに入れる(Flashはストリームが空いていればストリーム、それ以外は直接)
+static bool sha_update_range(sha_ctx_t *p_ctx, uint32_t addr, uint32_t len, bool is_stream_ok)
+{
+    int32_t ch;
+
+    if (is_stream_ok && (len != 0) && sha_is_flash(addr, len) &&
+        !__atomic_exchange_n(&s_is_stream_busy, true, __ATOMIC_ACQUIRE)) {
+        ch = dma_claim_unused_channel(false);
+        if (ch >= 0) {
+            sha_update_stream(p_ctx, (uint)ch, addr, len);
+            dma_channel_unclaim((uint)ch);
+        }
+        __atomic_store_n(&s_is_stream_busy, false, __ATOMIC_RELEASE);
+        if (ch >= 0) {
+            return true;
+        }
+    }
+
+    // SRAMはH/W DMAならDMAがそのまま読む
+    app_sha_update(p_ctx, (const void *)(uintptr_t)addr, len);
+    return false;
+}
+
+/**
+ * @brief アドレス範囲のハッシュ値を計算
+ *
+ * @param engine 計算の方法
+ * @param addr 先頭アドレス(アラインは不要)
+ * @param len バイト数
+ * @param p_result 結果の格納先
+ * @return true 計算した
+ * @return false その方法が使えない
+ */
+bool app_sha_range(sha_engine_t engine, uint32_t addr, uint32_t len, sha_range_result_t *p_result)
+{
+    sha_ctx_t ctx;
+    uint64_t t0_us = time_us_64();
+
+    if (!app_sha_init(&ctx, engine)) {
+        return false;
+    }
+    p_result->is_stream = sha_update_range(&ctx, addr, len, true);
+    app_sha_final(&ctx, p_result->digest);
+    p_result->proc_time_us = (uint32_t)(time_us_64() - t0_us);
+
+    return true;
+}
+
+/**
+ * @brief 2コア分割の後半(Core0がPROC_SHA_RUNで呼ぶ)
+ * @note ストリームはCore1が使うので、ソフトウェアで直接読む
+ */
+void app_sha_core_0_run(void)
+{
+    sha_ctx_t ctx;
+    uint64_t t0_us = time_us_64();
+
+    __mem_fence_release();
+    s_split.is_ready = true;
+
+    (void)app_sha_init(&ctx, SHA_ENGINE_SW);
+    (void)sha_update_range(&ctx, s_split.addr, s_split.len, false);
+    app_sha_final(&ctx, s_split.digest);
+    s_split.proc_time_us = (uint32_t)(time_us_64() - t0_us);
+
+    __mem_fence_release();
+    s_split.is_done = true;
+    s_split.is_busy = false;
+}
+
+// 1行の表示(bytes / us = MB/s)
+static void sha_range_print(const char *p_name, uint32_t addr, uint32_t len, uint32_t us, const uint8_t *p_digest)
+{
+    us = (us != 0) ? us : 1;
+    printf("%-26s 0x%08X +0x%08X %8u us %4u.%02u MB/s : ", p_name, addr, len, us,
+            len / us, ((len % us) * 100u) / us);
+    app_sha_print_digest(p_digest);
+}
+
+/**
+ * @brief 範囲を2つに分け、前半をCore1(H/W、無ければS/W)、後半をCore0(S/W)で同時に計算
+ * @note 結果は SHA-256(前半のハッシュ値 || 後半のハッシュ値) の2段のハッシュ木で、
+ *       範囲全体のSHA-256とは別の値(分割位置は割合から64バイト単位で決まる)
+ *
+ * @param addr 先頭アドレス
+ * @param len バイト数
+ * @param pct 前半(Core1)の割合(1～99%)
+ * @return true 計算した
+ * @return false 分割できない or Core0から呼んだ or Core0が応答しない/前回の後半を計算中
+ */
+bool app_sha_range_split(uint32_t addr, uint32_t len, uint32_t pct)
+{
+    uint32_t hw_len = (uint32_t)(((uint64_t)len * pct) / 100u) & ~(uint32_t)(SHA_BLOCK_SIZE - 1);
+    uint8_t pair[SHA_DIGEST_SIZE * 2];
+    uint8_t tree[SHA_DIGEST_SIZE];
+    sha_range_result_t result;
+    sha_engine_t engine;
+    uint64_t t0_us, end_us;
+    uint32_t us;
+    char name[32];
+
+    if ((pct == 0) || (pct >= 100) || (hw_len == 0) || (hw_len >= len)) {
+        printf("Error: Range too small to split at %u%% (64 byte units)\n", pct);
+        return false;
+    }
+
+    // 後半はCore0に頼むので、Core0(ジョブ)からは自分を待つことになる
+    if (get_core_num() == EVENT_CORE_NUM) {
+        printf("Error: split cannot run on Core %d\n", EVENT_CORE_NUM);
+        return false;
+    }
+
+    // タイムアウトした前回の後半をCore0がまだ計算していればs_splitに書かれるので待たない
+    if (s_split.is_busy) {
+        printf("Error: Core 0 is still running the previous split\n");
+        return false;
+    }
+
+    s_split.addr = addr + hw_len;
+    s_split.len = len - hw_len;
+    s_split.is_ready = false;
+    s_split.is_done = false;
+    s_split.is_busy = true;
+    __mem_fence_release();
+
+    t0_us = time_us_64();
+    if (!drv_ipc_send_code(PROC_SHA_RUN)) {
+        s_split.is_busy = false;
+        printf("Error: Failed to start Core 0 (queue full)\n");
+        return false;
+    }
+    end_us = t0_us + 1000000;
+    while (!s_split.is_ready) {
+        if (time_us_64() > end_us) {
+            printf("Error: Core 0 did not respond\n");
+            return false;
+        }
+        tight_loop_contents();
+    }
+
+    // 前半はこのコアでH/W(無い or 使用中ならS/W)
+    engine = SHA_ENGINE_DEFAULT;
+    if (!app_sha_range(engine, addr, hw_len, &result)) {
+        engine = SHA_ENGINE_SW;
+        (void)app_sha_range(engine, addr, hw_len, &result);
+    }
+
+    end_us = time_us_64() + SHA_SPLIT_TIMEOUT_US;
+    while (!s_split.is_done) {
+        if (time_us_64() > end_us) {
+            printf("Error: Core 0 did not finish\n");
+            return false;
+        }
+        tight_loop_contents();
+    }
+    __mem_fence_acquire();
+
+    memcpy(&pair[0], result.digest, SHA_DIGEST_SIZE);
+    memcpy(&pair[SHA_DIGEST_SIZE], s_split.digest, SHA_DIGEST_SIZE);
+    (void)app_sha_calc(SHA_ENGINE_SW, pair, sizeof(pair), tree);
+    us = (uint32_t)(time_us_64() - t0_us);
+
+    printf("\n[SHA-256 split] %u%% Core 1 / %u%% Core 0, tree = SHA-256(part0 || part1)\n", pct, 100u - pct);
+    snprintf(name, sizeof(name), "part0 (Core 1, %s)", app_sha_engine_name(engine));
+    sha_range_print(name, addr, hw_len, result.proc_time_us, result.digest);
+    snprintf(name, sizeof(name), "part1 (Core 0, %s)", app_sha_engine_name(SHA_ENGINE_SW));
+    sha_range_print(name, s_split.addr, s_split.len, s_split.proc_time_us, s_split.digest);
+    sha_range_print("tree", addr, len, us, tree);
+
+    return true;
+}
+
+// ベンチマークの1行(bytes / us = MB/s)
+static void sha_bench_print(const char *p_name, uint32_t len, uint32_t us, uint32_t cyc,
+                            const uint8_t *p_digest, const uint8_t *p_ref)
+{
+    us = (us != 0) ? us : 1;
+    printf("%-22s | %8u | %4u.%02u | %6u.%02u | %s\n", p_name, us, len / us, ((len % us) * 100u) / us,
+            cyc / len, ((cyc % len) * 100u) / len,
+            (memcmp(p_digest, p_ref, SHA_DIGEST_SIZE) == 0) ? "OK" : "NG");
+}
+
+/**
+ * @brief 方法ごとのSHA-256の速さ(MB/s, cycles/Byte)を比べる
+ *
+ * @param kb データサイズ(KB)
+ */
+void app_sha_bench(uint32_t kb)
+{
+    static const sha_engine_t s_engine_tbl[] = {SHA_ENGINE_HW_DMA, SHA_ENGINE_HW_CPU, SHA_ENGINE_SW, SHA_ENGINE_SW_REF};
+    uint32_t len = kb * 1024u;
+    uint8_t ref[2][SHA_DIGEST_SIZE], digest[SHA_DIGEST_SIZE];
+    uint32_t seed = 0x12345678, t0_us, t0_cyc, us, cyc;
+    uint8_t *p_buf;
+    char name[32];
+
+    if ((kb == 0) || (kb > SHA_BENCH_KB_MAX)) {
+        printf("Error: Size must be 1-%d KB\n", SHA_BENCH_KB_MAX);
+        return;
+    }
+    // 語境界と語境界でない(+1)の両方を測るので1語多く確保
+    p_buf = malloc(len + 4u);
+    if (p_buf == NULL) {
+        printf("Error: Failed to allocate %u bytes\n", len + 4u);
+        return;
+    }
+    for (uint32_t i = 0; i < (len + 4u); i++)
+    {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        p_buf[i] = (uint8_t)seed;
+    }
+
+    printf("\n[SHA-256 Bench] %u KB\n", kb);
+    printf("engine                 |       us |    MB/s |  cycles/B | digest\n");
+    (void)app_sha_calc(SHA_ENGINE_SW_REF, &p_buf[0], len, ref[0]);
+    (void)app_sha_calc(SHA_ENGINE_SW_REF, &p_buf[1], len, ref[1]);
+
+    for (uint32_t i = 0; i < count_of(s_engine_tbl); i++)
+    {
+        for (uint32_t ofs = 0; ofs < 2; ofs++)
+        {
+            t0_us = time_us_32();
+            t0_cyc = rp2xxx_get_cycle_cnt();
+            if (!app_sha_calc(s_engine_tbl[i], &p_buf[ofs], len, digest)) {
+                printf("%-22s | not available\n", app_sha_engine_name(s_engine_tbl[i]));
+                break;
+            }
+            cyc = rp2xxx_get_cycle_cnt() - t0_cyc;
+            us = time_us_32() - t0_us;
+            snprintf(name, sizeof(name), "%s%s", app_sha_engine_name(s_engine_tbl[i]), (ofs != 0) ? " (unaligned)" : "");
+            sha_bench_print(name, len, us, cyc, digest, ref[ofs]);
+        }
+    }
+
+#if defined(MCU_RP2350)
+    // 従来の経路(呼び出し側でパディング済み、CPUがバイトから語を組み立てて1語ずつ書く)
+    {
+        size_t padded_len;
+        uint8_t *p_padded = malloc(len + SHA_BLOCK_SIZE + 8u);
+
+        if (p_padded != NULL) {
+            sha256_padding(p_buf, len, p_padded, &padded_len);
+            t0_us = time_us_32();
+            t0_cyc = rp2xxx_get_cycle_cnt();
+            hardware_calc_sha256(p_padded, padded_len, digest);
+            cyc = rp2xxx_get_cycle_cnt() - t0_cyc;
+            us = time_us_32() - t0_us;
+            sha_bench_print("H/W legacy (pre-pad)", len, us, cyc, digest, ref[0]);
+            free(p_padded);
+        }
+    }
+#endif
+
+    free(p_buf);
+}
+
+/**
+ * @brief 既知のテストベクタ(FIPS 180-2)と分割入力/範囲の読み方の違いで全ての方法を確かめる
+ *
+ * @return true 全て一致
+ * @return false 不一致有り
+ */
+bool app_sha_self_test(void)
+{
+    static const struct {
+        const char *p_msg;
+        uint32_t repeat;            // p_msgを繰り返す回数
+        const char *p_digest;
+    } s_vec_tbl[] = {
+        { "",    1, "E3B0C44298FC1C149AFBF4C8996FB92427AE41E4649B934CA495991B7852B855" },
+        { "abc", 1, "BA7816BF8F01CFEA414140DE5DAE2223B00361A396177A9CB410FF61F20015AD" },
+        { "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", 1,
+          "248D6A61D20638B8E5C026930C3E6039A33CE45964FF2167F6ECEDD419DB06C1" },
+        { "abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmnhijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu", 1,
+          "CF5B16A778AF8380036CE59E7B0492370B249B11E8F07A51AFAC45037AFEE9D1" },
+        { "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa", 10000,
+          "CDC76E5C9914FB9281A1C7E284D73E67F1809A48A497200E046D39CCC7112CD0" },
+    };
+    static const sha_engine_t s_engine_tbl[] = {SHA_ENGINE_HW_DMA, SHA_ENGINE_HW_CPU, SHA_ENGINE_SW, SHA_ENGINE_SW_REF};
+    // Flashの範囲(語境界/端数/チャンク境界をまたぐ)
+    static const uint32_t s_flash_tbl[][2] = {
+        { 0, 0 }, { 3, 1 }, { 1, 63 }, { 0, 4096 }, { 2, 4095 }, { 4093, 8195 }, { 0, 65536 },
+    };
+    uint8_t ref[SHA_DIGEST_SIZE], digest[SHA_DIGEST_SIZE];
+    char hex[(SHA_DIGEST_SIZE * 2) + 1];
+    uint32_t test_cnt = 0, err_cnt = 0, skip_cnt = 0;
+    sha_range_result_t result;
+    uint32_t seed = 0x2468ACE0;
+    sha_ctx_t ctx;
+    uint8_t *p_buf;
+
+    p_buf = malloc(SHA_STREAM_CHUNK_SIZE + 4u);
+    if (p_buf == NULL) {
+        printf("Error: Failed to allocate %u bytes\n", SHA_STREAM_CHUNK_SIZE + 4u);
+        return false;
+    }
+    for (uint32_t i = 0; i < (SHA_STREAM_CHUNK_SIZE + 4u); i++)
+    {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        p_buf[i] = (uint8_t)seed;
+    }
+
+    for (uint32_t e = 0; e < count_of(s_engine_tbl); e++)
+    {
+        sha_engine_t engine = s_engine_tbl[e];
+
+        // テストベクタ
+        for (uint32_t v = 0; v < count_of(s_vec_tbl); v++)
+        {
+            size_t msg_len = strlen(s_vec_tbl[v].p_msg);
+
+            if (!app_sha_init(&ctx, engine)) {
+                skip_cnt++;
+                continue;
+            }
+            for (uint32_t r = 0; r < s_vec_tbl[v].repeat; r++)
+            {
+                app_sha_update(&ctx, s_vec_tbl[v].p_msg, msg_len);
+            }
+            app_sha_final(&ctx, digest);
+            for (uint32_t i = 0; i < SHA_DIGEST_SIZE; i++)
+            {
+                snprintf(&hex[i * 2], 3, "%02X", digest[i]);
+            }
+            test_cnt++;
+            if (strcmp(hex, s_vec_tbl[v].p_digest) != 0) {
+                err_cnt++;
+                printf("  NG : %s vector #%u\n", app_sha_engine_name(engine), v);
+            }
+        }
+
+        // 分割入力 ... 先頭の位置(語境界/非語境界)と区切りを変えて1回の計算と比べる
+        for (uint32_t ofs = 0; ofs < 4; ofs++)
+        {
+            uint32_t pos = 0, step = 1;
+
+            (void)app_sha_calc(SHA_ENGINE_SW_REF, &p_buf[ofs], SHA_STREAM_CHUNK_SIZE, ref);
+            if (!app_sha_init(&ctx, engine)) {
+                skip_cnt++;
+                continue;
+            }
+            while (pos < SHA_STREAM_CHUNK_SIZE)
+            {
+                uint32_t n = ((SHA_STREAM_CHUNK_SIZE - pos) < step) ? (SHA_STREAM_CHUNK_SIZE - pos) : step;
+                app_sha_update(&ctx, &p_buf[ofs + pos], n);
+                pos += n;
+                step = (step * 3u) + 1u;   // 1, 4, 13, 40, 121, 364, ...
+            }
+            app_sha_final(&ctx, digest);
+            test_cnt++;
+            if (memcmp(digest, ref, SHA_DIGEST_SIZE) != 0) {
+                err_cnt++;
+                printf("  NG : %s chunked input (offset %u)\n", app_sha_engine_name(engine), ofs);
+            }
+        }
+
+        // 範囲 ... SRAM(バッファ)とFlash(ストリーム)をCPUで直接読んだ結果と比べる
+        for (uint32_t f = 0; f <= count_of(s_flash_tbl); f++)
+        {
+            uint32_t addr = (f == 0) ? (uint32_t)(uintptr_t)&p_buf[1] : (XIP_BASE + s_flash_tbl[f - 1][0]);
+            uint32_t len = (f == 0) ? (SHA_STREAM_CHUNK_SIZE - 1u) : s_flash_tbl[f - 1][1];
+
+            // アドレスが32bitに入らない(ホストビルドのヒープ)なら範囲のAPIは使えない
+            if ((uintptr_t)addr != ((f == 0) ? (uintptr_t)&p_buf[1] : (uintptr_t)addr)) {
+                skip_cnt++;
+                continue;
+            }
+            (void)app_sha_calc(SHA_ENGINE_SW_REF, (const void *)(uintptr_t)addr, len, ref);
+            if (!app_sha_range(engine, addr, len, &result)) {
+                skip_cnt++;
+                continue;
+            }
+            test_cnt++;
+            if (memcmp(result.digest, ref, SHA_DIGEST_SIZE) != 0) {
+                err_cnt++;
+                printf("  NG : %s range 0x%08X +0x%X\n", app_sha_engine_name(engine), addr, len);
+            }
+        }
+    }
+    free(p_buf);
+
+    printf("SHA-256 self test : %u / %u passed (%u skipped)\n",
+            test_cnt - err_cnt, test_cnt, skip_cnt);
+
+    return (err_cnt == 0);
+}
@@ -0,0 +1,75 @@
+/**
+ * @file app_sha.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief SHA-256のストリーミングAPI(H/WアクセラレータへのDMA供給 + ソフトウェア実装)のヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026 Chimipupu All Rights Reserved.
+ *
+ */
+#ifndef APP_SHA_H
+#define APP_SHA_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "pico/stdlib.h"
+#include "muc_rpxxx_util.h"
+
+#define SHA_BLOCK_SIZE          64      // SHA-256のブロック(Byte)
+#define SHA_DIGEST_SIZE         32      // ハッシュ値(Byte)
+#define SHA_BENCH_KB_DEFAULT    32      // ベンチマークの既定のデータサイズ(KB)
+#define SHA_BENCH_KB_MAX        128     // ベンチマークの最大のデータサイズ(KB)
+#define SHA_STREAM_CHUNK_SIZE   4096    // FlashをXIPストリームで読むステージングバッファ(Byte、2面)
+#define SHA_SPLIT_PCT_DEFAULT   75      // 2コア分割でCore1(H/W)が受け持つ割合(%)
+#define SHA_SPLIT_TIMEOUT_US    30000000
+
+// 計算の方法
+typedef enum {
+    SHA_ENGINE_HW_DMA = 0,  // H/Wアクセラレータ、DMAでブロックを供給(DREQで1ブロックずつ)
+    SHA_ENGINE_HW_CPU,      // H/Wアクセラレータ、CPUが1語ずつ書き込む
+    SHA_ENGINE_SW,          // ソフトウェア(64ラウンド展開)
+    SHA_ENGINE_SW_REF,      // ソフトウェアの参照実装(FIPS 180-4の式のまま、検算用)
+} sha_engine_t;
+
+// 既定の方法(H/Wが無ければソフトウェア)
+#if defined(MCU_RP2350)
+#define SHA_ENGINE_DEFAULT      SHA_ENGINE_HW_DMA
+#else
+#define SHA_ENGINE_DEFAULT      SHA_ENGINE_SW
+#endif
+
+typedef struct {
+    sha_engine_t engine;
+    uint64_t total_len;             // 入力したバイト数
+    uint32_t block_len;             // blockに溜まっているバイト数
+    uint32_t block[SHA_BLOCK_SIZE / 4];  // 端数の入力(語境界に揃えてDMA/CPUで書く)
+    uint32_t state[8];              // ソフトウェアの中間ハッシュ値
+    int32_t dma_ch;                 // DMAのチャネル(-1 = CPUで書く)
+    uint32_t dma_size;              // アクセラレータに設定したDMAの転送サイズ(1 or 4)
+} sha_ctx_t;
+
+// アドレス範囲のハッシュの結果
+typedef struct {
+    uint8_t digest[SHA_DIGEST_SIZE];
+    uint32_t proc_time_us;
+    bool is_stream;                 // FlashをXIPストリーム(DMA)で読んだ
+} sha_range_result_t;
+
+// 関数プロトタイプ
+bool app_sha_init(sha_ctx_t *p_ctx, sha_engine_t engine);
+void app_sha_update(sha_ctx_t *p_ctx, const void *p_data, size_t len);
+void app_sha_final(sha_ctx_t *p_ctx, uint8_t *p_digest);
+bool app_sha_calc(sha_engine_t engine, const void *p_data, size_t len, uint8_t *p_digest);
+const char *app_sha_engine_name(sha_engine_t engine);
+void app_sha_print_digest(const uint8_t *p_digest);
+void app_sha_bench(uint32_t kb);
+bool app_sha_range(sha_engine_t engine, uint32_t addr, uint32_t len, sha_range_result_t *p_result);
+bool app_sha_range_split(uint32_t addr, uint32_t len, uint32_t pct);
+void app_sha_core_0_run(void);
+bool app_sha_self_test(void);
+
+#endif // APP_SHA_H
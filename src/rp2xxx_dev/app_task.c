@@ -0,0 +1,773 @@
+/**
+ * @file app_task.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief ワークスティーリングのタスクスケジューラ(両コアで実行)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026 Chimipupu All Rights Reserved.
+ *
+ * RTOSを使わない軽量なタスクスケジューラ。
+ * コアごとにデック(Chase-Lev)を持ち、所有コアは底からLIFOで取り出し、
+ * 手が空いたコアは相手のデックの頭からFIFOで盗む。
+ * タスクは作成直後は保留(HELD)で、依存(app_task_depend())を張ってから
+ * app_task_submit()で投入する。先行タスクが全て終わると実行可能になる。
+ * 実行中のタスクは自分の後続を継続タスクに引き継げる(app_task_continue_with())ので、
+ * 子タスクを投入して戻り、子の結果を継続タスクでまとめる形で書ける。
+ *
+ * 1回の実行(app_task_run())はCore1が呼び、Core0にはPROC_TASK_RUNで参加させる。
+ * Core0がジョブ等で塞がっていてもCore1だけで完了する。
+ */
+#include "app_task.h"
+#include "app_math.h"
+#include "muc_rpxxx_util.h"
+#include "drv_ipc.h"
+
+#define TASK_DEQUE_MASK         (TASK_DEQUE_SIZE - 1)
+#define TASK_WORKER_TIMEOUT_US  1000000 // 前回のワーカーの終了待ちの最大時間
+#define TASK_REDUCE_LEAF_NUM    32      // 範囲リダクションの葉の目安の数
+
+// タスクの状態
+typedef enum {
+    TASK_STATE_HELD,        // 作成直後(依存を張れる)
+    TASK_STATE_READY,       // 投入済み(先行タスク待ち or デック内)
+    TASK_STATE_RUNNING,     // 実行中
+    TASK_STATE_DONE,        // 完了
+} task_state_t;
+
+// タスク
+typedef struct {
+    task_func_t p_func;
+    uint32_t arg;
+    void *p_ctx;
+    volatile int32_t dep_cnt;           // 未完了の先行タスク数 + 保留(1)
+    volatile uint8_t state;             // task_state_t
+    uint8_t succ_cnt;                   // 後続タスク数
+    uint16_t succ[TASK_SUCC_MAX];       // 後続タスク
+} task_t;
+
+// コアごとのデック(bottomは所有コアだけ、topは両コアがCASで進める)
+typedef struct {
+    volatile int32_t top;
+    volatile int32_t bottom;
+    volatile uint16_t buf[TASK_DEQUE_SIZE];
+} task_deque_t;
+
+static task_t s_task[TASK_MAX];
+static task_deque_t s_deque[TASK_WORKER_NUM];
+static volatile int32_t s_task_cnt = 0;             // 作成したタスク数
+static volatile int32_t s_pending_cnt = 0;          // 未完了のタスク数
+static volatile bool s_is_run = false;              // 実行中
+static volatile bool s_is_dual = false;             // 両コアで実行
+static volatile bool s_is_worker_busy[TASK_WORKER_NUM] = {false, false};
+static int32_t s_cur_task[TASK_WORKER_NUM] = {-1, -1};
+static task_stat_t s_stat[TASK_WORKER_NUM];
+
+static bool deque_push(task_deque_t *p_deque, uint16_t id);
+static int32_t deque_pop(task_deque_t *p_deque);
+static int32_t deque_steal(task_deque_t *p_deque);
+static void task_ready(uint32_t core, int32_t id);
+static void task_execute(uint32_t core, int32_t id);
+
+// -------------------------------------------------------------------------
+// [デック]
+// -------------------------------------------------------------------------
+static bool deque_push(task_deque_t *p_deque, uint16_t id)
+{
+    int32_t b = __atomic_load_n(&p_deque->bottom, __ATOMIC_RELAXED);
+    int32_t t = __atomic_load_n(&p_deque->top, __ATOMIC_ACQUIRE);
+
+    if ((b - t) >= TASK_DEQUE_SIZE) {
+        return false;
+    }
+
+    __atomic_store_n(&p_deque->buf[b & TASK_DEQUE_MASK], id, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    __atomic_store_n(&p_deque->bottom, b + 1, __ATOMIC_RELAXED);
+
+    return true;
+}
+
+// 所有コアが底から取り出す(空なら-1)
+static int32_t deque_pop(task_deque_t *p_deque)
+{
+    int32_t b = __atomic_load_n(&p_deque->bottom, __ATOMIC_RELAXED) - 1;
+    int32_t t;
+    int32_t id = -1;
+
+    __atomic_store_n(&p_deque->bottom, b, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    t = __atomic_load_n(&p_deque->top, __ATOMIC_RELAXED);
+
+    if (t <= b) {
+        id = __atomic_load_n(&p_deque->buf[b & TASK_DEQUE_MASK], __ATOMIC_RELAXED);
+        if (t == b) {
+            // 最後の1個は盗む側と取り合う
+            if (!__atomic_compare_exchange_n(&p_deque->top, &t, t + 1, false,
+                                             __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)) {
+                id = -1;
+            }
+            __atomic_store_n(&p_deque->bottom, b + 1, __ATOMIC_RELAXED);
+        }
+    } else {
+        __atomic_store_n(&p_deque->bottom, b + 1, __ATOMIC_RELAXED);
+    }
+
+    return id;
+}
+
+// 他コアが頭から盗む(空 or 競合で負け なら-1)
+static int32_t deque_steal(task_deque_t *p_deque)
+{
+    int32_t t = __atomic_load_n(&p_deque->top, __ATOMIC_ACQUIRE);
+    int32_t b;
+    int32_t id;
+
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    b = __atomic_load_n(&p_deque->bottom, __ATOMIC_ACQUIRE);
+    if (t >= b) {
+        return -1;
+    }
+
+    id = __atomic_load_n(&p_deque->buf[t & TASK_DEQUE_MASK], __ATOMIC_RELAXED);
+    if (!__atomic_compare_exchange_n(&p_deque->top, &t, t + 1, false,
+                                     __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)) {
+        return -1;
+    }
+
+    return id;
+}
+
+// -------------------------------------------------------------------------
+// [スケジューラ]
+// -------------------------------------------------------------------------
+// 実行可能になったタスクを自コアのデックへ(満杯ならその場で実行)
+static void task_ready(uint32_t core, int32_t id)
+{
+    if (!deque_push(&s_deque[core], (uint16_t)id)) {
+        s_stat[core].inline_cnt++;
+        task_execute(core, id);
+    }
+}
+
+static void task_execute(uint32_t core, int32_t id)
+{
+    task_t *p_task = &s_task[id];
+    int32_t prev = s_cur_task[core];
+
+    s_cur_task[core] = id;
+    p_task->state = TASK_STATE_RUNNING;
+    p_task->p_func(p_task->arg, p_task->p_ctx);
+    __atomic_store_n(&p_task->state, TASK_STATE_DONE, __ATOMIC_RELEASE);
+    s_cur_task[core] = prev;
+    s_stat[core].exec_cnt++;
+
+    // 後続タスクの先行数を減らし、0になったら実行可能へ
+    for (uint32_t i = 0; i < p_task->succ_cnt; i++)
+    {
+        int32_t succ = p_task->succ[i];
+        if (__atomic_sub_fetch(&s_task[succ].dep_cnt, 1, __ATOMIC_ACQ_REL) == 0) {
+            task_ready(core, succ);
+        }
+    }
+
+    __atomic_sub_fetch(&s_pending_cnt, 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief タスクスケジューラの初期化
+ */
+void app_task_init(void)
+{
+    memset(s_deque, 0, sizeof(s_deque));
+    app_task_clear_stat();
+}
+
+/**
+ * @brief タスクの作成(保留状態、app_task_submit()で投入するまで実行されない)
+ *
+ * @param p_func タスク関数
+ * @param arg タスク関数に渡す値
+ * @param p_ctx タスク関数に渡す共有領域
+ * @return int32_t タスクID、TASK_MAXを超えたら-1
+ */
+int32_t app_task_create(task_func_t p_func, uint32_t arg, void *p_ctx)
+{
+    int32_t id = __atomic_fetch_add(&s_task_cnt, 1, __ATOMIC_RELAXED);
+    task_t *p_task;
+
+    if (id >= TASK_MAX) {
+        return -1;
+    }
+
+    p_task = &s_task[id];
+    p_task->p_func = p_func;
+    p_task->arg = arg;
+    p_task->p_ctx = p_ctx;
+    p_task->dep_cnt = 1;
+    p_task->state = TASK_STATE_HELD;
+    p_task->succ_cnt = 0;
+    __atomic_add_fetch(&s_pending_cnt, 1, __ATOMIC_RELAXED);
+
+    return id;
+}
+
+/**
+ * @brief 依存の追加(taskをbeforeの完了後に実行)
+ * @note taskは保留中であること。beforeは保留中 or 自コアで実行中のタスク自身(継続)
+ *
+ * @param task 後続タスク
+ * @param before 先行タスク
+ * @return true 追加した
+ * @return false 状態エラー or 後続タスクが多すぎる
+ */
+bool app_task_depend(int32_t task, int32_t before)
+{
+    task_t *p_before;
+
+    if ((task < 0) || (before < 0) || (task == before) ||
+        (s_task[task].state != TASK_STATE_HELD)) {
+        return false;
+    }
+
+    p_before = &s_task[before];
+    if ((p_before->state != TASK_STATE_HELD) && (before != app_task_self())) {
+        return false;
+    }
+    if (p_before->succ_cnt >= TASK_SUCC_MAX) {
+        return false;
+    }
+
+    __atomic_add_fetch(&s_task[task].dep_cnt, 1, __ATOMIC_RELAXED);
+    p_before->succ[p_before->succ_cnt++] = (uint16_t)task;
+
+    return true;
+}
+
+/**
+ * @brief 実行中のタスクの後続を継続タスクに引き継ぐ(自分の代わりにcontの完了を待たせる)
+ * @note 子タスクを投入して戻るタスクが、子の結果をまとめる継続タスクを作るときに使う
+ *
+ * @param cont 継続タスク(保留中)
+ * @return true 引き継いだ
+ * @return false タスク外 or 状態エラー or 後続タスクが多すぎる
+ */
+bool app_task_continue_with(int32_t cont)
+{
+    int32_t self = app_task_self();
+    task_t *p_self;
+    task_t *p_cont;
+
+    if ((self < 0) || (cont < 0) || (cont == self) || (s_task[cont].state != TASK_STATE_HELD)) {
+        return false;
+    }
+
+    p_self = &s_task[self];
+    p_cont = &s_task[cont];
+    if ((p_cont->succ_cnt + p_self->succ_cnt) > TASK_SUCC_MAX) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < p_self->succ_cnt; i++)
+    {
+        p_cont->succ[p_cont->succ_cnt++] = p_self->succ[i];
+    }
+    p_self->succ_cnt = 0;
+
+    return true;
+}
+
+/**
+ * @brief 保留を解除して投入(先行タスクが全て終わっていれば実行可能)
+ *
+ * @param task タスクID
+ */
+void app_task_submit(int32_t task)
+{
+    if ((task < 0) || (s_task[task].state != TASK_STATE_HELD)) {
+        return;
+    }
+
+    s_task[task].state = TASK_STATE_READY;
+    if (__atomic_sub_fetch(&s_task[task].dep_cnt, 1, __ATOMIC_ACQ_REL) == 0) {
+        task_ready(get_core_num(), task);
+    }
+}
+
+/**
+ * @brief 自コアで実行中のタスクID(継続タスクの先行に使う)
+ *
+ * @return int32_t タスクID、タスク外なら-1
+ */
+int32_t app_task_self(void)
+{
+    return s_cur_task[get_core_num()];
+}
+
+/**
+ * @brief ワーカー(タスクが全て終わるまで自分のデックを消化し、空なら相手から盗む)
+ * @note Core0はPROC_TASK_RUNで呼ぶ
+ */
+void app_task_worker(void)
+{
+    uint32_t core = get_core_num();
+    uint32_t other = core ^ 1u;
+    uint32_t t0_cyc, cyc;
+    int32_t id;
+
+    if (!__atomic_load_n(&s_is_run, __ATOMIC_ACQUIRE)) {
+        return;
+    }
+
+    s_is_worker_busy[core] = true;
+    __mem_fence_release();
+    t0_cyc = rp2xxx_get_cycle_cnt();
+
+    while (__atomic_load_n(&s_pending_cnt, __ATOMIC_ACQUIRE) > 0)
+    {
+        id = deque_pop(&s_deque[core]);
+        if ((id < 0) && s_is_dual) {
+            id = deque_steal(&s_deque[other]);
+            if (id >= 0) {
+                s_stat[core].steal_cnt++;
+            } else {
+                s_stat[core].steal_fail++;
+            }
+        }
+
+        if (id >= 0) {
+            task_execute(core, id);
+            cyc = rp2xxx_get_cycle_cnt();
+            s_stat[core].busy_cyc += cyc - t0_cyc;
+        } else {
+            tight_loop_contents();
+            cyc = rp2xxx_get_cycle_cnt();
+            s_stat[core].idle_cyc += cyc - t0_cyc;
+        }
+        t0_cyc = cyc;
+    }
+
+    __mem_fence_release();
+    s_is_worker_busy[core] = false;
+}
+
+/**
+ * @brief タスクを1回実行(ルートタスクから生えたタスクが全て終わるまで戻らない)
+ *
+ * @param p_root ルートタスク
+ * @param arg ルートタスクに渡す値
+ * @param p_ctx 共有領域
+ * @param is_dual true ... 相手コアも参加させる, false ... 呼び出しコアだけ
+ * @return true 完了
+ * @return false 前回のワーカーが終わらない
+ */
+bool app_task_run(task_func_t p_root, uint32_t arg, void *p_ctx, bool is_dual)
+{
+    uint32_t other = get_core_num() ^ 1u;
+    uint64_t timeout = time_us_64() + TASK_WORKER_TIMEOUT_US;
+
+    // 前回から相手コアがまだ抜けていなければ待つ(デックは空なので抜けるだけ)
+    while (s_is_worker_busy[other])
+    {
+        if (time_us_64() > timeout) {
+            return false;
+        }
+        tight_loop_contents();
+    }
+
+    s_task_cnt = 0;
+    s_pending_cnt = 0;
+    s_is_dual = is_dual;
+    app_task_submit(app_task_create(p_root, arg, p_ctx));   // 自コアのデックに積まれる
+    __atomic_store_n(&s_is_run, true, __ATOMIC_RELEASE);
+
+    if (is_dual) {
+        drv_ipc_send_code(PROC_TASK_RUN);
+    }
+    app_task_worker();
+
+    __atomic_store_n(&s_is_run, false, __ATOMIC_RELEASE);
+
+    return true;
+}
+
+/**
+ * @brief コアごとの統計を取得
+ *
+ * @param core コア
+ * @param p_stat 統計の格納先
+ */
+void app_task_get_stat(uint32_t core, task_stat_t *p_stat)
+{
+    memcpy(p_stat, &s_stat[core % TASK_WORKER_NUM], sizeof(task_stat_t));
+}
+
+/**
+ * @brief 統計クリア
+ */
+void app_task_clear_stat(void)
+{
+    memset(s_stat, 0, sizeof(s_stat));
+}
+
+/**
+ * @brief 統計表示
+ */
+void app_task_show_stat(void)
+{
+    task_stat_t stat;
+    uint64_t total;
+
+    printf("Core       Exec   Steal  StealFail  Inline      Busy(cyc)      Idle(cyc)  Idle\n");
+    for (uint32_t core = 0; core < TASK_WORKER_NUM; core++)
+    {
+        app_task_get_stat(core, &stat);
+        total = stat.busy_cyc + stat.idle_cyc;
+        printf("%4u %10u %7u %10u %7u %14llu %14llu %4u%%\n",
+                core, stat.exec_cnt, stat.steal_cnt, stat.steal_fail, stat.inline_cnt,
+                (unsigned long long)stat.busy_cyc, (unsigned long long)stat.idle_cyc,
+                (total != 0) ? (uint32_t)((stat.idle_cyc * 100u) / total) : 0);
+    }
+}
+
+// -------------------------------------------------------------------------
+// [範囲リダクション] [lo, hi)を2分割しながらタスクにし、継続タスクで結果を足し合わせる
+// -------------------------------------------------------------------------
+typedef uint64_t (*task_leaf_func_t)(uint32_t lo, uint32_t hi);
+
+// 分割ノード(タスクIDで引く)
+typedef struct {
+    uint32_t lo;
+    uint32_t hi;
+    uint64_t *p_out;        // 結果の格納先
+    uint64_t left;          // 継続タスクが足し合わせる左右の結果
+    uint64_t right;
+} task_range_t;
+
+typedef struct {
+    task_leaf_func_t p_leaf;
+    uint32_t lo;
+    uint32_t hi;
+    uint32_t cutoff;        // これ以下の幅は分割しない
+    uint64_t result;
+    bool is_error;          // タスク不足
+} task_reduce_t;
+
+static task_range_t s_range[TASK_MAX];
+
+static void task_nop(uint32_t arg, void *p_ctx)
+{
+    NOP();
+}
+
+// 作成済みで使わないタスクを空で完了させる
+static void task_discard(int32_t id)
+{
+    if (id >= 0) {
+        s_task[id].p_func = task_nop;
+        app_task_submit(id);
+    }
+}
+
+static void task_reduce_join(uint32_t arg, void *p_ctx)
+{
+    task_range_t *p_node = &s_range[app_task_self()];
+
+    *p_node->p_out = p_node->left + p_node->right;
+}
+
+static void task_reduce_split(uint32_t arg, void *p_ctx)
+{
+    task_reduce_t *p_reduce = (task_reduce_t *)p_ctx;
+    task_range_t *p_node = &s_range[app_task_self()];
+    uint32_t mid;
+    int32_t left, right, join;
+
+    if ((p_node->hi - p_node->lo) > p_reduce->cutoff) {
+        mid = p_node->lo + ((p_node->hi - p_node->lo) / 2);
+        left = app_task_create(task_reduce_split, 0, p_ctx);
+        right = app_task_create(task_reduce_split, 0, p_ctx);
+        join = app_task_create(task_reduce_join, 0, p_ctx);
+        if ((left >= 0) && (right >= 0) && (join >= 0)) {
+            // 自分の後続(親の継続)はjoinの完了を待つ
+            s_range[join].p_out = p_node->p_out;
+            s_range[left] = (task_range_t){p_node->lo, mid, &s_range[join].left, 0, 0};
+            s_range[right] = (task_range_t){mid, p_node->hi, &s_range[join].right, 0, 0};
+            app_task_continue_with(join);
+            app_task_depend(join, left);
+            app_task_depend(join, right);
+            app_task_submit(join);
+            app_task_submit(right);
+            app_task_submit(left);
+            return;
+        }
+        // 作れなかった分はその場で計算(作れたタスクは空で完了させる)
+        p_reduce->is_error = true;
+        task_discard(left);
+        task_discard(right);
+        task_discard(join);
+    }
+
+    *p_node->p_out = p_reduce->p_leaf(p_node->lo, p_node->hi);
+}
+
+static void task_reduce_root(uint32_t arg, void *p_ctx)
+{
+    task_reduce_t *p_reduce = (task_reduce_t *)p_ctx;
+    int32_t id = app_task_create(task_reduce_split, 0, p_ctx);
+
+    if (id < 0) {
+        p_reduce->is_error = true;
+        return;
+    }
+    s_range[id] = (task_range_t){p_reduce->lo, p_reduce->hi, &p_reduce->result, 0, 0};
+    app_task_submit(id);
+}
+
+/**
+ * @brief 範囲[lo, hi)のリダクションをタスクで実行
+ *
+ * @param p_leaf 葉の計算(部分範囲の結果を返す)
+ * @param lo 範囲の先頭
+ * @param hi 範囲の終端(含まない)
+ * @param is_dual 両コアで実行
+ * @param p_time_us 処理時間の格納先
+ * @return uint64_t 結果の合計
+ */
+static uint64_t task_reduce(task_leaf_func_t p_leaf, uint32_t lo, uint32_t hi, bool is_dual, uint32_t *p_time_us)
+{
+    task_reduce_t reduce = {
+        .p_leaf = p_leaf,
+        .lo = lo,
+        .hi = hi,
+        .cutoff = ((hi - lo) + TASK_REDUCE_LEAF_NUM - 1) / TASK_REDUCE_LEAF_NUM,
+        .result = 0,
+        .is_error = false,
+    };
+    uint32_t t0_us = time_us_32();
+
+    if (reduce.cutoff == 0) {
+        reduce.cutoff = 1;
+    }
+    if (!app_task_run(task_reduce_root, 0, &reduce, is_dual)) {
+        printf("Error: Core %u worker did not finish the previous run\n", get_core_num() ^ 1u);
+    }
+    *p_time_us = time_us_32() - t0_us;
+    if (reduce.is_error) {
+        printf("Error: Out of tasks (max %d), part of the range ran inline\n", TASK_MAX);
+    }
+
+    return reduce.result;
+}
+
+// -------------------------------------------------------------------------
+// [ベンチマーク] 負荷が不均一な処理を1コアと2コアで比べる
+// -------------------------------------------------------------------------
+// 総和(自己テスト用)
+static uint64_t task_leaf_sum(uint32_t lo, uint32_t hi)
+{
+    uint64_t sum = 0;
+
+    for (uint32_t i = lo; i < hi; i++)
+    {
+        sum += i;
+    }
+
+    return sum;
+}
+
+// 素数の個数(大きい数ほど重い)
+static uint64_t task_leaf_sieve(uint32_t lo, uint32_t hi)
+{
+    uint64_t cnt = 0;
+
+    for (uint32_t n = lo; n < hi; n++)
+    {
+        cnt += app_math_is_prime_num(n) ? 1 : 0;
+    }
+
+    return cnt;
+}
+
+// マンデルブロ集合の行(行ごとに反復回数が大きく違う)
+static uint64_t task_leaf_mandel(uint32_t lo, uint32_t hi)
+{
+    uint64_t iter = 0;
+
+    for (uint32_t y = lo; y < hi; y++)
+    {
+        iter += app_math_mandelbrot_row(y, NULL);
+    }
+
+    return iter;
+}
+
+// FlashのKB単位のブロックのFNV-1aハッシュ(順序に依らない和で集約)
+static uint64_t task_leaf_hash(uint32_t lo, uint32_t hi)
+{
+    uint64_t sum = 0;
+
+    for (uint32_t blk = lo; blk < hi; blk++)
+    {
+        const uint8_t *p = (const uint8_t *)(uintptr_t)(XIP_BASE + (blk * 1024u));
+        uint32_t hash = 0x811C9DC5;
+
+        for (uint32_t i = 0; i < 1024u; i++)
+        {
+            hash = (hash ^ p[i]) * 0x01000193;
+        }
+        sum += hash;
+    }
+
+    return sum;
+}
+
+/**
+ * @brief 不均一な処理を1コアと2コアで実行して比較
+ *
+ * @param kind 処理の種類
+ * @param param 範囲(sieve ... 上限の数, hash ... KB, mandel ... 未使用)
+ */
+void app_task_bench(task_bench_t kind, uint32_t param)
+{
+    static const char *s_p_name[] = {"sieve", "mandel", "hash"};
+    static const task_leaf_func_t s_p_leaf[] = {task_leaf_sieve, task_leaf_mandel, task_leaf_hash};
+    uint32_t hi = (kind == TASK_BENCH_MANDEL) ? MANDELBROT_HEIGHT : param;
+    uint32_t single_us, dual_us;
+    uint64_t single, dual;
+
+    single = task_reduce(s_p_leaf[kind], 0, hi, false, &single_us);
+    app_task_clear_stat();
+    dual = task_reduce(s_p_leaf[kind], 0, hi, true, &dual_us);
+
+    printf("\n[Task Bench] %s [0, %u) : %d tasks\n", s_p_name[kind], hi, (int)s_task_cnt);
+    printf("1 core  : %10u us (result %llu)\n", single_us, (unsigned long long)single);
+    printf("2 cores : %10u us (result %llu) %s\n", dual_us, (unsigned long long)dual, (single == dual) ? "OK" : "NG");
+    printf("Speedup : %u.%02ux\n", (dual_us != 0) ? (single_us / dual_us) : 0,
+            (dual_us != 0) ? (uint32_t)((((uint64_t)single_us * 100u) / dual_us) % 100u) : 0);
+    app_task_show_stat();
+}
+
+// -------------------------------------------------------------------------
+// [自己テスト]
+// -------------------------------------------------------------------------
+#define TASK_TEST_FAN_NUM       48
+#define TASK_TEST_CHAIN_NUM     16
+
+typedef struct {
+    volatile uint32_t val[TASK_TEST_FAN_NUM];
+    volatile uint32_t order[TASK_TEST_CHAIN_NUM + 1];
+    volatile uint32_t order_cnt;
+    uint32_t err;
+} task_test_t;
+
+static void task_test_fan_leaf(uint32_t arg, void *p_ctx)
+{
+    ((task_test_t *)p_ctx)->val[arg] = arg * arg;
+}
+
+static void task_test_fan_join(uint32_t arg, void *p_ctx)
+{
+    task_test_t *p_test = (task_test_t *)p_ctx;
+    uint32_t sum = 0;
+
+    for (uint32_t i = 0; i < TASK_TEST_FAN_NUM; i++)
+    {
+        sum += p_test->val[i];
+    }
+    // Σi^2 = n(n-1)(2n-1)/6
+    if (sum != ((TASK_TEST_FAN_NUM * (TASK_TEST_FAN_NUM - 1) * (2 * TASK_TEST_FAN_NUM - 1)) / 6)) {
+        p_test->err++;
+    }
+}
+
+// 実行順を記録(依存が守られていればargの昇順)
+static void task_test_chain(uint32_t arg, void *p_ctx)
+{
+    task_test_t *p_test = (task_test_t *)p_ctx;
+    uint32_t idx = __atomic_fetch_add(&p_test->order_cnt, 1, __ATOMIC_RELAXED);
+
+    p_test->order[idx] = arg;
+}
+
+// 実行中に自分の継続タスクを作る
+static void task_test_cont(uint32_t arg, void *p_ctx)
+{
+    int32_t cont = app_task_create(task_test_chain, TASK_TEST_CHAIN_NUM, p_ctx);
+
+    if (!app_task_depend(cont, app_task_self())) {
+        ((task_test_t *)p_ctx)->err++;
+    }
+    app_task_submit(cont);
+    task_test_chain(arg, p_ctx);
+}
+
+static void task_test_root(uint32_t arg, void *p_ctx)
+{
+    task_test_t *p_test = (task_test_t *)p_ctx;
+    int32_t join = app_task_create(task_test_fan_join, 0, p_ctx);
+    int32_t prev = -1;
+    int32_t id;
+
+    // ファンアウト/ファンイン
+    for (uint32_t i = 0; i < TASK_TEST_FAN_NUM; i++)
+    {
+        id = app_task_create(task_test_fan_leaf, i, p_ctx);
+        if (!app_task_depend(join, id)) {
+            p_test->err++;
+        }
+        app_task_submit(id);
+    }
+    app_task_submit(join);
+
+    // 依存の鎖(最後は継続タスクを作る)
+    for (uint32_t i = 0; i < TASK_TEST_CHAIN_NUM; i++)
+    {
+        id = app_task_create((i == (TASK_TEST_CHAIN_NUM - 1)) ? task_test_cont : task_test_chain, i, p_ctx);
+        if ((prev >= 0) && !app_task_depend(id, prev)) {
+            p_test->err++;
+        }
+        if (prev >= 0) {
+            app_task_submit(prev);
+        }
+        prev = id;
+    }
+    app_task_submit(prev);
+}
+
+/**
+ * @brief スケジューラの自己テスト(ファンイン、依存の鎖、継続、範囲リダクション)
+ *
+ * @param cnt 繰り返し回数
+ * @return true 成功
+ * @return false 失敗
+ */
+bool app_task_self_test(uint32_t cnt)
+{
+    task_test_t test;
+    uint32_t err = 0;
+    uint32_t time_us;
+    uint32_t n = 20000;
+    uint64_t sum;
+
+    app_task_clear_stat();
+    for (uint32_t i = 0; i < cnt; i++)
+    {
+        memset(&test, 0, sizeof(test));
+        app_task_run(task_test_root, 0, &test, true);
+        err += test.err;
+        for (uint32_t j = 0; j <= TASK_TEST_CHAIN_NUM; j++)
+        {
+            err += ((test.order_cnt != (TASK_TEST_CHAIN_NUM + 1)) || (test.order[j] != j)) ? 1 : 0;
+        }
+
+        // Σi = n(n-1)/2 (範囲の大きさを変えて分割の形を変える)
+        sum = task_reduce(task_leaf_sum, 0, n + i, true, &time_us);
+        err += (sum != (((uint64_t)(n + i) * (n + i - 1)) / 2)) ? 1 : 0;
+    }
+
+    printf("[Task Test] %u runs : %s (err:%u)\n", cnt, (err == 0) ? "OK" : "NG", err);
+    app_task_show_stat();
+
+    return (err == 0);
+}
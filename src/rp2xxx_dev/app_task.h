@@ -0,0 +1,61 @@
+/**
+ * @file app_task.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief ワークスティーリングのタスクスケジューラ(両コアで実行)のヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026 Chimipupu All Rights Reserved.
+ *
+ */
+#ifndef APP_TASK_H
+#define APP_TASK_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "pico/stdlib.h"
+
+#define TASK_MAX                256     // 1回の実行で作れるタスクの最大数
+#define TASK_DEQUE_SIZE         64      // コアごとのデックの容量 ※2のべき乗
+#define TASK_SUCC_MAX           4       // 1タスクの後続タスクの最大数
+#define TASK_WORKER_NUM         2       // ワーカー数(= コア数)
+
+// ベンチマークの処理
+typedef enum {
+    TASK_BENCH_SIEVE,       // 素数の個数(大きい数ほど重い)
+    TASK_BENCH_MANDEL,      // マンデルブロ集合の行
+    TASK_BENCH_HASH,        // Flashのブロックごとのハッシュ
+} task_bench_t;
+
+// タスク関数(arg ... タスクごとの値, p_ctx ... 実行全体で共有する領域)
+typedef void (*task_func_t)(uint32_t arg, void *p_ctx);
+
+// コアごとの統計
+typedef struct {
+    uint32_t exec_cnt;      // 実行したタスク数
+    uint32_t steal_cnt;     // 相手コアから盗んだタスク数
+    uint32_t steal_fail;    // 盗みに失敗した回数(空 or 競合)
+    uint32_t inline_cnt;    // デックが満杯でその場で実行した数
+    uint64_t busy_cyc;      // タスク実行のサイクル数
+    uint64_t idle_cyc;      // タスクを探していたサイクル数
+} task_stat_t;
+
+// 関数プロトタイプ
+void app_task_init(void);
+int32_t app_task_create(task_func_t p_func, uint32_t arg, void *p_ctx);
+bool app_task_depend(int32_t task, int32_t before);
+bool app_task_continue_with(int32_t cont);
+void app_task_submit(int32_t task);
+int32_t app_task_self(void);
+bool app_task_run(task_func_t p_root, uint32_t arg, void *p_ctx, bool is_dual);
+void app_task_worker(void);
+void app_task_get_stat(uint32_t core, task_stat_t *p_stat);
+void app_task_clear_stat(void);
+void app_task_show_stat(void);
+void app_task_bench(task_bench_t kind, uint32_t param);
+bool app_task_self_test(uint32_t cnt);
+
+#endif // APP_TASK_H
@@ -15,10 +15,28 @@
 #include "pcb_def.h"
 #include "app_main.h"
 #include "app_math.h"
+#include "app_mem.h"
+#include "app_script.h"
+#include "app_job.h"
+#include "drv_ipc.h"
+#include "app_event.h"
+#include "app_task.h"
+#include "app_rtos.h"
+#include "app_mct.h"
+#include "drv_lock.h"
+#include "drv_debounce.h"
+#include "app_load.h"
 #include "muc_rpxxx_util.h"
 
 #include "drv_neopixel.h"
+#include "app_fx.h"
+#include "app_anim.h"
+#include "app_sha.h"
 extern neopixel_t s_neopixel;
+#if defined(PCB_NEOPIXEL_MULTI)
+#include "drv_neopixel_multi.h"
+extern neopixel_multi_t s_neopixel_multi;
+#endif
 
 static void dbg_com_init_msg(dbg_cmd_args_t *p_args);
 
@@ -27,19 +45,41 @@ static void cmd_cls(dbg_cmd_args_t *p_args);
 static void cmd_system(dbg_cmd_args_t *p_args);
 static void cmd_mt_test(dbg_cmd_args_t *p_args);
 static void cmd_mct_test(dbg_cmd_args_t *p_args);
+static void cmd_lock(dbg_cmd_args_t *p_args);
+static void cmd_deb(dbg_cmd_args_t *p_args);
+static void cmd_load(dbg_cmd_args_t *p_args);
 static void cmd_pi_calc(dbg_cmd_args_t *p_args);
 #if defined(MCU_RP2350)
 static void cmd_rnd(dbg_cmd_args_t *p_args);
-static void cmd_sha(dbg_cmd_args_t *p_args);
 #endif
+static void cmd_sha(dbg_cmd_args_t *p_args);
 static void cmd_rst(dbg_cmd_args_t *p_args);
 static void cmd_timer(dbg_cmd_args_t *p_args);
 static void cmd_rtc(dbg_cmd_args_t *p_args);
 static void cmd_gpio(dbg_cmd_args_t *p_args);
 static void cmd_mem_dump(dbg_cmd_args_t *p_args);
+static void cmd_mem_find(dbg_cmd_args_t *p_args);
+static void cmd_mem_fill(dbg_cmd_args_t *p_args);
+static void cmd_mem_cmp(dbg_cmd_args_t *p_args);
+static void cmd_script(dbg_cmd_args_t *p_args);
+static void cmd_job_bg(dbg_cmd_args_t *p_args);
+static void cmd_jobs(dbg_cmd_args_t *p_args);
+static void cmd_job_kill(dbg_cmd_args_t *p_args);
+static void cmd_job_wait(dbg_cmd_args_t *p_args);
+static void cmd_ipc(dbg_cmd_args_t *p_args);
+static void cmd_event(dbg_cmd_args_t *p_args);
+static void cmd_task(dbg_cmd_args_t *p_args);
+#if defined(RP2XXX_USE_FREERTOS)
+static void cmd_top(dbg_cmd_args_t *p_args);
+static void cmd_rtos(dbg_cmd_args_t *p_args);
+#endif
 static void cmd_i2c(dbg_cmd_args_t *p_args);
 static void cmd_reg(dbg_cmd_args_t *p_args);
 static void cmd_neopixel(dbg_cmd_args_t *p_args);
+static void cmd_neopixel_fx(const char *p_arg_str);
+#if defined(PCB_NEOPIXEL_MULTI)
+static void cmd_neopixel_multi(dbg_cmd_args_t *p_args);
+#endif
 static void cmd_unknown(dbg_cmd_args_t *p_args);
 
 static int get_neopixel_color_from_name(const char* name);
@@ -56,19 +96,41 @@ const dbg_cmd_info_t g_cmd_tbl[] = {
     {"cls",     CMD_CLS,        &cmd_cls,         "Display Clear", 0, 0},
     {"sys",     CMD_SYSTEM,     &cmd_system,      "Show system information", 0, 0},
     {"rst",     CMD_RST,        &cmd_rst,         "Reboot", 0, 0},
-    {"memd",    CMD_MEM_DUMP,   &cmd_mem_dump,    "Memory Dump Command. args -> (#address, length)", 2, 2},
+    {"memd",    CMD_MEM_DUMP,   &cmd_mem_dump,    "Memory Dump Command. args -> (#address, length, [hex|raw|rle|lz])", 2, 3},
+    {"mfind",   CMD_MEM_FIND,   &cmd_mem_find,    "Memory Find: mfind #addr #len #pattern [#mask] | mfind test", 1, 4},
+    {"mfill",   CMD_MEM_FILL,   &cmd_mem_fill,    "Memory Fill: mfill #addr #len #value", 3, 3},
+    {"mcmp",    CMD_MEM_CMP,    &cmd_mem_cmp,     "Memory Compare: mcmp #addr_a #addr_b #len [count]", 3, 4},
+    {"scr",     CMD_SCRIPT,     &cmd_script,      "Command script: scr rec|run|ls|clr|save|load", 1, 1},
+    {"bg",      CMD_JOB_BG,     &cmd_job_bg,      "Run command as a job on Core 0: bg <cmd> [args]", 1, 4},
+    {"jobs",    CMD_JOBS,       &cmd_jobs,        "List jobs", 0, 0},
+    {"kill",    CMD_JOB_KILL,   &cmd_job_kill,    "Cancel job (or discard finished job): kill <id>", 1, 1},
+    {"wait",    CMD_JOB_WAIT,   &cmd_job_wait,    "Wait for job and show its output: wait [id]", 0, 1},
+    {"ipc",     CMD_IPC,        &cmd_ipc,         "Core-to-core message queue: ipc bench [n] [size] | ipc test [n] | ipc stat", 1, 3},
+    {"evt",     CMD_EVENT,      &cmd_event,       "Core 0 event loop stats (handler latency, idle): evt [clr]", 0, 1},
+    {"task",    CMD_TASK,       &cmd_task,        "Work-stealing tasks: task test [n] | sieve [n] | mandel | hash [kb] | stat", 1, 2},
+#if defined(RP2XXX_USE_FREERTOS)
+    {"top",     CMD_TOP,        &cmd_top,         "FreeRTOS task CPU usage and stack high-water: top [ms]", 0, 1},
+    {"rtos",    CMD_RTOS,       &cmd_rtos,        "FreeRTOS notify/sem/queue round-trip latency: rtos bench [n]", 1, 2},
+#endif
     {"reg",     CMD_REG,        &cmd_reg,         "Register read/write: reg #addr r|w bits [#val]", 3, 4},
     {"i2c",     CMD_I2C,        &cmd_i2c,         "I2C control (port, command)", 2, 2},
     {"gpio",    CMD_GPIO,       &cmd_gpio,        "Control GPIO pin (pin, value)", 2, 2},
-    {"px",      CMD_NEOPIXEL,   &cmd_neopixel,    "Control NeoPixel (command, args)", 1, 2},
+    {"px",      CMD_NEOPIXEL,   &cmd_neopixel,    "NeoPixel: px <idx|all> <color|#RRGGBB> | cls | stat | bench [n] | scale | fade | fx [name|list|stop|clr] | play [demo [frames]|stat|stop] | fps|bri|gamma <n> | dither <auto|0-8> | cc #RRGGBB", 1, 3},
+#if defined(PCB_NEOPIXEL_MULTI)
+    {"pxm",     CMD_NEOPIXEL_MULTI, &cmd_neopixel_multi, "Parallel NeoPixel strips: pxm cls | pxm <strip|all> #RRGGBB | pxm bench [leds] | pxm test [n]", 1, 2},
+#endif
     {"tm",      CMD_TIMER,      &cmd_timer,       "Set timer alarm (seconds)", 0, 1},
     {"rtc",     CMD_RTC,        &cmd_rtc,         "RTC Cmd (RP2040 ... H/W RTC, RP2350 ... AON Timer)", 0, 1},
 #if defined(MCU_RP2350)
     {"rnd",     CMD_RND,        &cmd_rnd,         "Generate true random numbers using TRNG", 0, 1},
-    {"sha",     CMD_SHA,        &cmd_sha,         "Calc SHA-256 Hash using H/W Accelerator", 0, 1},
 #endif
+    {"sha",     CMD_SHA,        &cmd_sha,         "SHA-256: sha <text> | sha #addr #len [dma|cpu|sw|ref|split [pct]] | sha bench [kb] | sha test", 1, 4},
     {"mt",      CMD_MT_TEST,    &cmd_mt_test,     "Math test", 0, 0},
-    {"mct",     CMD_MCT,        &cmd_mct_test,    "Multi Core test", 0, 0},
+    {"mct",     CMD_MCT,        &cmd_mct_test,    "Inter-core bench: mct [fifo|bell|spin|sev|lock] [n] | mct bulk [kb]", 0, 2},
+    {"lock",    CMD_LOCK,       &cmd_lock,        "Cross-core locks: lock stat|clr | lock bench [n] | lock test [n]", 1, 2},
+    {"load",    CMD_LOAD,       &cmd_load,        "Per-core CPU load (1/10/60 s) and stack high-water", 0, 0},
+    {"deb",     CMD_DEB,        &cmd_deb,         "Debounced inputs: deb | deb clr | deb add pin [ms] | deb sim pin [n]", 0, 3},
+    {"pi",      CMD_PI,         &cmd_pi_calc,     "Calc Pi (Gauss-Legendre): pi [iterations]", 0, 1},
 };
 
 // コマンドテーブルのコマンド数(const)
@@ -231,6 +293,9 @@ static void cmd_mt_test(dbg_cmd_args_t *p_args)
 {
     // 数学関連テスト
     app_math_math_test();
+    if (app_job_is_cancel()) {
+        return;
+    }
 
     // 四則演算テスト(inr,float,double)
     printf("\nInteger Arithmetic Test: @%d\n", TEST_LOOP_CNT);
@@ -254,12 +319,92 @@ static void cmd_mt_test(dbg_cmd_args_t *p_args)
 
 static void cmd_mct_test(dbg_cmd_args_t *p_args)
 {
-    uint32_t data = 0;
+    int32_t mode;
+    int32_t param = 0;
 
-    // Core1からCore0にテストデータを投げる
-    data = MULTI_CORE_TEST_DATA;
-    set_multicore_fifo(data);
-    printf("[Core 1] TX FIFO Data to Core 0 : 0x%08X\n", data);
+    if (p_args->argc == 1) {
+        app_mct_suite(1000);
+        return;
+    }
+
+    mode = app_mct_mode_from_str(p_args->p_argv[1]);
+    if ((p_args->argc == 3) && ((param = atoi(p_args->p_argv[2])) <= 0)) {
+        printf("Error: Invalid parameter. Must be positive.\n");
+        return;
+    }
+
+    if (mode == MCT_MODE_BULK) {
+        app_mct_bulk((param != 0) ? (uint32_t)param : 256);
+    } else if (mode >= 0) {
+        app_mct_latency((mct_mode_t)mode, (param != 0) ? (uint32_t)param : 1000, true);
+    } else {
+        printf("Error: Usage: mct [fifo|bell|spin|sev|lock] [n] | mct bulk [kb]\n");
+    }
+}
+
+static void cmd_lock(dbg_cmd_args_t *p_args)
+{
+    int32_t param = 0;
+
+    if (p_args->argc < 2) {
+        printf("Error: Usage: lock stat|clr | lock bench [n] | lock test [n]\n");
+        return;
+    }
+
+    if ((p_args->argc == 3) && ((param = atoi(p_args->p_argv[2])) <= 0)) {
+        printf("Error: Invalid parameter. Must be positive.\n");
+        return;
+    }
+
+    if (strcmp(p_args->p_argv[1], "stat") == 0) {
+        drv_lock_show_stat();
+    } else if (strcmp(p_args->p_argv[1], "clr") == 0) {
+        drv_lock_clear_stat();
+    } else if (strcmp(p_args->p_argv[1], "bench") == 0) {
+        drv_lock_bench((param != 0) ? (uint32_t)param : 1000);
+    } else if (strcmp(p_args->p_argv[1], "test") == 0) {
+        drv_lock_self_test((param != 0) ? (uint32_t)param : 10000);
+    } else {
+        printf("Error: Usage: lock stat|clr | lock bench [n] | lock test [n]\n");
+    }
+}
+
+static void cmd_load(dbg_cmd_args_t *p_args)
+{
+    (void)p_args;
+    app_load_show();
+}
+
+static void cmd_deb(dbg_cmd_args_t *p_args)
+{
+    int32_t pin, param = 0;
+
+    if (p_args->argc == 1) {
+        drv_debounce_show_stat();
+        return;
+    }
+    if (strcmp(p_args->p_argv[1], "clr") == 0) {
+        drv_debounce_clear_stat();
+        return;
+    }
+
+    if ((p_args->argc < 3) || ((pin = atoi(p_args->p_argv[2])) < 0) ||
+        ((p_args->argc == 4) && ((param = atoi(p_args->p_argv[3])) <= 0))) {
+        printf("Error: Usage: deb | deb clr | deb add pin [ms] | deb sim pin [n]\n");
+        return;
+    }
+
+    if (strcmp(p_args->p_argv[1], "add") == 0) {
+        // 未接続のピンでも試せるようにプルアップ
+        if (drv_debounce_add("gpio", (uint)pin, (param != 0) ? (uint32_t)param * 1000u : DEBOUNCE_DEFAULT_US,
+                             DEBOUNCE_PULL_UP, NULL) >= 0) {
+            printf("GPIO %d : debounced input (pull-up)\n", pin);
+        }
+    } else if (strcmp(p_args->p_argv[1], "sim") == 0) {
+        drv_debounce_sim((uint)pin, (param != 0) ? (uint32_t)param : 8);
+    } else {
+        printf("Error: Usage: deb | deb clr | deb add pin [ms] | deb sim pin [n]\n");
+    }
 }
 
 static void cmd_pi_calc(dbg_cmd_args_t *p_args)
@@ -276,7 +421,7 @@ static void cmd_pi_calc(dbg_cmd_args_t *p_args)
     }
 
     printf("\nCalculating Pi using Gauss-Legendre algorithm (%d iterations):\n", iterations);
-    for (uint32_t i = 1; i <= iterations; i++)
+    for (uint32_t i = 1; (i <= iterations) && !app_job_is_cancel(); i++)
     {
         volatile uint32_t start_time = time_us_32();
         pi = app_math_pi_calc(i);
@@ -285,47 +430,98 @@ static void cmd_pi_calc(dbg_cmd_args_t *p_args)
     }
 }
 
-#if defined(MCU_RP2350)
+// アドレス範囲のハッシュ ... sha #addr #len [dma|cpu|sw|ref|split [pct]]
+static void cmd_sha_range(dbg_cmd_args_t *p_args)
+{
+    static const char *s_p_engine_arg[] = {"dma", "cpu", "sw", "ref"};
+    sha_engine_t engine = SHA_ENGINE_DEFAULT;
+    sha_range_result_t result;
+    uint32_t addr, length, pct, us;
+    bool is_flash, is_sram;
+
+    if ((sscanf(p_args->p_argv[1], "#%x", &addr) != 1) || (p_args->argc < 3) ||
+        (sscanf(p_args->p_argv[2], "#%x", &length) != 1)) {
+        printf("Error: Invalid address/length format. Use hexadecimal with # prefix (e.g., #10000000 #10000)\n");
+        return;
+    }
+
+    is_flash = (addr >= XIP_BASE) && (((uint64_t)addr + length) <= ((uint64_t)XIP_BASE + PICO_FLASH_SIZE_BYTES));
+    is_sram = (addr >= SRAM_BASE) && (((uint64_t)addr + length) <= SRAM_END);
+    if (!is_flash && !is_sram) {
+        printf("Error: Range must be within Flash (XIP) or SRAM\n");
+        return;
+    }
+
+    if ((p_args->argc >= 4) && (strcasecmp(p_args->p_argv[3], "split") == 0)) {
+        pct = (p_args->argc >= 5) ? (uint32_t)atoi(p_args->p_argv[4]) : SHA_SPLIT_PCT_DEFAULT;
+        app_sha_range_split(addr, length, pct);
+        return;
+    }
+    if (p_args->argc >= 4) {
+        for (engine = SHA_ENGINE_HW_DMA; engine <= SHA_ENGINE_SW_REF; engine++)
+        {
+            if (strcasecmp(p_args->p_argv[3], s_p_engine_arg[engine]) == 0) {
+                break;
+            }
+        }
+        if (engine > SHA_ENGINE_SW_REF) {
+            printf("Error: Unknown engine '%s'. Use dma, cpu, sw, ref or split\n", p_args->p_argv[3]);
+            return;
+        }
+    }
+
+    if (!app_sha_range(engine, addr, length, &result)) {
+        printf("Error: %s is busy or not available on %s\n", app_sha_engine_name(engine), MCU_NAME);
+        return;
+    }
+    us = (result.proc_time_us != 0) ? result.proc_time_us : 1;
+    printf("\nSHA-256 (0x%08X +0x%X, %s, read:%s)\n", addr, length, app_sha_engine_name(engine),
+            result.is_stream ? "XIP stream" : ((engine == SHA_ENGINE_HW_DMA) ? "DMA" : "CPU"));
+    printf("SHA-256 Hash : ");
+    app_sha_print_digest(result.digest);
+    printf("proc time: %u us, %u.%02u MB/s\n", result.proc_time_us, length / us, ((length % us) * 100u) / us);
+}
+
 static void cmd_sha(dbg_cmd_args_t *p_args)
 {
-    uint8_t padding_buf[64 * 2];
-    uint8_t hash_buf[64 * 2];
-    size_t padding_len;
+    uint8_t digest[SHA_DIGEST_SIZE];
+    const char *p_msg;
+    uint32_t kb;
 
-    if (p_args->argc < 2 || p_args->argc > 2) {
-        printf("Usage: sha <data>\n");
+    if (p_args->argc < 2) {
+        printf("Usage: sha <text> | sha #addr #len [dma|cpu|sw|ref|split [pct]] | sha bench [kb] | sha test\n");
         return;
     }
 
-    memset(hash_buf, 0, sizeof(hash_buf));
-    memset(padding_buf, 0, sizeof(padding_buf));
+    if (strcmp(p_args->p_argv[1], "bench") == 0) {
+        kb = (p_args->argc >= 3) ? (uint32_t)atoi(p_args->p_argv[2]) : SHA_BENCH_KB_DEFAULT;
+        app_sha_bench(kb);
+        return;
+    }
 
-#if 1
-    char *msg;
-    msg = p_args->p_argv[1];
-#else
-    // (DEBUG)
-    // const char msg[] = "RP2350 H/W SHA-256 TEST";    // SHA256期待値「40AEDCA712E82FD6128B6A9AFCA1350ABA27AC1259E92AE3BADE0C0C4FE892E2」
-    const char msg[] = "ABC";                        // SHA256期待値「B5D4045C3F466FA91FE2CC6ABE79232A1A57CDF104F7A26E716E0A1E2789DF78」
-#endif
+    if (strcmp(p_args->p_argv[1], "test") == 0) {
+        app_sha_self_test();
+        return;
+    }
 
-    printf("\nSHA-256 Hash Calc(H/W)\n");
-    printf("\nCalc str : %s\n", msg);
-    // SHA-256のパディング処理
-    sha256_padding((const uint8_t *)msg, strlen(msg), padding_buf, &padding_len);
-    show_mem_dump((uint32_t)padding_buf, 64);
+    if (p_args->p_argv[1][0] == '#') {
+        cmd_sha_range(p_args);
+        return;
+    }
 
-    // SHA-256のハッシュ値を計算
-    hardware_calc_sha256((const uint8_t *)padding_buf, padding_len, hash_buf);
-    printf("\nSHA-256 Hash : ");
-    for (size_t i = 0; i < 32; ++i)
-    {
-        printf("%02X", hash_buf[i]);
+    // パディングはAPIの中で付けるので長さの制限は無い
+    p_msg = p_args->p_argv[1];
+    if (!app_sha_calc(SHA_ENGINE_DEFAULT, p_msg, strlen(p_msg), digest)) {
+        printf("Error: SHA-256 accelerator is busy\n");
+        return;
     }
-    printf("\n");
-    show_mem_dump((uint32_t)hash_buf, 64);
+    printf("\nSHA-256 Hash Calc(%s)\n", app_sha_engine_name(SHA_ENGINE_DEFAULT));
+    printf("\nCalc str : %s\n", p_msg);
+    printf("SHA-256 Hash : ");
+    app_sha_print_digest(digest);
 }
 
+#if defined(MCU_RP2350)
 static void cmd_rnd(dbg_cmd_args_t *p_args)
 {
     int32_t i, count;
@@ -521,6 +717,16 @@ static void cmd_gpio(dbg_cmd_args_t *p_args)
     printf("GPIO %d set to %d (proc time: %u us)\n\n", pin, value, end_time - start_time);
 }
 
+// 処理サイズと時間からKB/sを求める
+static uint32_t calc_kb_per_sec(uint32_t size, uint32_t proc_time_us)
+{
+    if (proc_time_us == 0) {
+        return 0;
+    }
+
+    return (uint32_t)(((uint64_t)size * 1000000u) / 1024u / proc_time_us);
+}
+
 /**
  * @brief メモリダンプコマンド関数
  * 
@@ -530,9 +736,11 @@ static void cmd_mem_dump(dbg_cmd_args_t *p_args)
 {
     uint32_t addr;
     uint32_t length;
+    int32_t mode;
+    mem_dump_result_t result;
 
-    if (p_args->argc != 3) {
-        printf("Error: Invalid number of arguments. Usage: mem_dump <address> <length>\n");
+    if ((p_args->argc != 3) && (p_args->argc != 4)) {
+        printf("Error: Invalid number of arguments. Usage: mem_dump <address> <length> [hex|raw|rle|lz]\n");
         return;
     }
 
@@ -548,12 +756,498 @@ static void cmd_mem_dump(dbg_cmd_args_t *p_args)
         return;
     }
 
-    volatile uint32_t start_time = time_us_32();
-    show_mem_dump(addr, length);
-    volatile uint32_t end_time = time_us_32();
-    printf("\nMemory dump completed (proc time: %u us)\n", end_time - start_time);
+    // 第三引数無し ... 従来の1Byteずつのダンプ
+    if (p_args->argc == 3) {
+        volatile uint32_t start_time = time_us_32();
+        show_mem_dump(addr, length);
+        volatile uint32_t end_time = time_us_32();
+        printf("\nMemory dump completed (proc time: %u us)\n", end_time - start_time);
+        return;
+    }
+
+    // 第三引数有り ... バルクダンプ
+    mode = app_mem_get_dump_mode(p_args->p_argv[3]);
+    if (mode < 0) {
+        printf("Error: Unknown dump mode '%s'. Use hex, raw, rle or lz\n", p_args->p_argv[3]);
+        return;
+    }
+
+    if (!app_mem_bulk_dump(addr, length, (mem_dump_mode_t)mode, &result)) {
+        printf("Error: Memory tool is busy (another mem command or job is running)\n");
+        return;
+    }
+    printf("\nMemory dump completed (%s, read:%s, %u bytes -> %u bytes, proc time: %u us, %u KB/s)\n",
+            app_mem_get_dump_mode_str((mem_dump_mode_t)mode),
+            result.is_dma ? "DMA" : "CPU",
+            result.in_size,
+            result.out_size,
+            result.proc_time_us,
+            calc_kb_per_sec(result.in_size, result.proc_time_us));
+}
+
+/**
+ * @brief メモリ検索コマンド関数
+ * 
+ * @param p_args コマンド引数の構造体ポインタ
+ */
+static void cmd_mem_find(dbg_cmd_args_t *p_args)
+{
+    uint32_t addr;
+    uint32_t length;
+    uint32_t mask_width;
+    uint32_t hit_addr[MEM_FIND_HIT_MAX];
+    mem_pattern_t pat;
+    mem_op_result_t result;
+
+    // 検索/比較カーネルのセルフテスト
+    if ((p_args->argc == 2) && (strcasecmp(p_args->p_argv[1], "test") == 0)) {
+        app_mem_kernel_self_test();
+        return;
+    }
+
+    if ((p_args->argc != 4) && (p_args->argc != 5)) {
+        printf("Error: Usage: mfind #addr #len #pattern [#mask]\n");
+        printf("  pattern width is taken from its digits (#41=8bit, #4142=16bit, #41424344=32bit)\n");
+        return;
+    }
+
+    if ((sscanf(p_args->p_argv[1], "#%x", &addr) != 1) || (sscanf(p_args->p_argv[2], "#%x", &length) != 1)) {
+        printf("Error: Invalid address/length format. Use hexadecimal with # prefix (e.g., #20000000)\n");
+        return;
+    }
+
+    if (!app_mem_parse_pattern(p_args->p_argv[3], &pat.value, &pat.width)) {
+        printf("Error: Invalid pattern format. Use #HEX of 2, 4 or 8 digits\n");
+        return;
+    }
+
+    pat.mask = (pat.width == 4) ? 0xFFFFFFFF : ((1u << (pat.width * 8)) - 1);
+    if ((p_args->argc == 5) && !app_mem_parse_pattern(p_args->p_argv[4], &pat.mask, &mask_width)) {
+        printf("Error: Invalid mask format. Use #HEX\n");
+        return;
+    }
+
+    if ((addr % pat.width) != 0) {
+        printf("Error: Address must be %u byte aligned for this pattern\n", pat.width);
+        return;
+    }
+
+    if (!app_mem_find(addr, length, &pat, hit_addr, MEM_FIND_HIT_MAX, &result)) {
+        printf("Error: Memory tool is busy (another mem command or job is running)\n");
+        return;
+    }
+
+    printf("\n[Memory Find (addr:0x%08X, len:0x%X, pattern:0x%0*X, mask:0x%0*X)]\n",
+            addr, length, pat.width * 2, pat.value, pat.width * 2, pat.mask);
+    for (uint32_t i = 0; (i < result.cnt) && (i < MEM_FIND_HIT_MAX); i++)
+    {
+        printf("  #%u : 0x%08X\n", i + 1, hit_addr[i]);
+    }
+    if (result.cnt > MEM_FIND_HIT_MAX) {
+        printf("  ... (%u more)\n", result.cnt - MEM_FIND_HIT_MAX);
+    }
+    printf("Memory find completed (hit:%u, read:%s, proc time: %u us, %u KB/s)\n",
+            result.cnt, result.is_dma ? "DMA" : "CPU",
+            result.proc_time_us, calc_kb_per_sec(result.size, result.proc_time_us));
+}
+
+/**
+ * @brief メモリフィルコマンド関数
+ * 
+ * @param p_args コマンド引数の構造体ポインタ
+ */
+static void cmd_mem_fill(dbg_cmd_args_t *p_args)
+{
+    uint32_t addr;
+    uint32_t length;
+    uint32_t value;
+    uint32_t width;
+    mem_op_result_t result;
+
+    if (p_args->argc != 4) {
+        printf("Error: Usage: mfill #addr #len #value\n");
+        printf("  value width is taken from its digits (#41=8bit, #4142=16bit, #41424344=32bit)\n");
+        return;
+    }
+
+    if ((sscanf(p_args->p_argv[1], "#%x", &addr) != 1) || (sscanf(p_args->p_argv[2], "#%x", &length) != 1)) {
+        printf("Error: Invalid address/length format. Use hexadecimal with # prefix (e.g., #20000000)\n");
+        return;
+    }
+
+    if (!app_mem_parse_pattern(p_args->p_argv[3], &value, &width)) {
+        printf("Error: Invalid value format. Use #HEX of 2, 4 or 8 digits\n");
+        return;
+    }
+
+    if (!app_mem_fill(addr, length, value, width, &result)) {
+        printf("Error: Memory tool is busy (another mem command or job is running)\n");
+        return;
+    }
+    printf("Memory fill completed (addr:0x%08X, len:0x%X, value:0x%0*X, write:%s, proc time: %u us, %u KB/s)\n",
+            addr, length, width * 2, value, result.is_dma ? "DMA" : "CPU",
+            result.proc_time_us, calc_kb_per_sec(result.size, result.proc_time_us));
+}
+
+/**
+ * @brief メモリ比較コマンド関数
+ * 
+ * @param p_args コマンド引数の構造体ポインタ
+ */
+static void cmd_mem_cmp(dbg_cmd_args_t *p_args)
+{
+    uint32_t addr_a;
+    uint32_t addr_b;
+    uint32_t length;
+    uint32_t diff_max = MEM_CMP_DIFF_DEFAULT;
+    uint32_t diff_ofs[MEM_CMP_DIFF_MAX];
+    mem_op_result_t result;
+
+    if ((p_args->argc != 4) && (p_args->argc != 5)) {
+        printf("Error: Usage: mcmp #addr_a #addr_b #len [count]\n");
+        return;
+    }
+
+    if ((sscanf(p_args->p_argv[1], "#%x", &addr_a) != 1) ||
+        (sscanf(p_args->p_argv[2], "#%x", &addr_b) != 1) ||
+        (sscanf(p_args->p_argv[3], "#%x", &length) != 1)) {
+        printf("Error: Invalid address/length format. Use hexadecimal with # prefix (e.g., #20000000)\n");
+        return;
+    }
+
+    if (p_args->argc == 5) {
+        diff_max = (uint32_t)atoi(p_args->p_argv[4]);
+        if ((diff_max == 0) || (diff_max > MEM_CMP_DIFF_MAX)) {
+            printf("Error: count must be 1 to %d\n", MEM_CMP_DIFF_MAX);
+            return;
+        }
+    }
+
+    if (!app_mem_cmp(addr_a, addr_b, length, diff_ofs, diff_max, &result)) {
+        printf("Error: Memory tool is busy (another mem command or job is running)\n");
+        return;
+    }
+
+    printf("\n[Memory Compare (0x%08X <-> 0x%08X, len:0x%X)]\n", addr_a, addr_b, length);
+    for (uint32_t i = 0; (i < result.cnt) && (i < diff_max); i++)
+    {
+        uint32_t ofs = diff_ofs[i];
+        printf("  +0x%06X : 0x%08X=%02X 0x%08X=%02X\n", ofs,
+                addr_a + ofs, *((volatile uint8_t *)(uintptr_t)(addr_a + ofs)),
+                addr_b + ofs, *((volatile uint8_t *)(uintptr_t)(addr_b + ofs)));
+    }
+    if (result.cnt > diff_max) {
+        printf("  ... (%u more)\n", result.cnt - diff_max);
+    }
+    printf("Memory compare completed (diff:%u bytes, read:%s, proc time: %u us, %u KB/s)\n",
+            result.cnt, result.is_dma ? "DMA" : "CPU",
+            result.proc_time_us, calc_kb_per_sec(result.size * 2, result.proc_time_us));
+}
+
+/**
+ * @brief コマンドスクリプト関数
+ * 
+ * @param p_args コマンド引数の構造体ポインタ
+ */
+static void cmd_script(dbg_cmd_args_t *p_args)
+{
+    const char *p_sub;
+
+    if (p_args->argc != 2) {
+        printf("Error: Usage: scr rec|run|ls|clr|save|load\n");
+        printf("  rec  - Record script lines until a line with only '.'\n");
+        printf("  run  - Run script (ESC or Ctrl-C to abort)\n");
+        printf("  ls   - List script\n");
+        printf("  clr  - Clear script\n");
+        printf("  save - Save script to flash\n");
+        printf("  load - Load script from flash\n");
+        printf("Script: loop N/end, sleep ms, echo text, set VAR val, inc VAR [step], time cmd, $VAR/#$VAR\n");
+        return;
+    }
+
+    p_sub = p_args->p_argv[1];
+    if (strcmp(p_sub, "rec") == 0) {
+        app_script_rec_start();
+    } else if (strcmp(p_sub, "run") == 0) {
+        app_script_run();
+    } else if (strcmp(p_sub, "ls") == 0) {
+        app_script_list();
+    } else if (strcmp(p_sub, "clr") == 0) {
+        app_script_clear();
+    } else if (strcmp(p_sub, "save") == 0) {
+        app_script_save();
+    } else if (strcmp(p_sub, "load") == 0) {
+        app_script_load();
+    } else {
+        printf("Error: Unknown script command '%s'\n", p_sub);
+    }
+}
+
+/**
+ * @brief ジョブ登録コマンド関数(コマンドをCore0で実行)
+ * 
+ * @param p_args コマンド引数の構造体ポインタ
+ */
+static void cmd_job_bg(dbg_cmd_args_t *p_args)
+{
+    // 入力を使う/ジョブを操作するコマンドはジョブにできない
+    static const char *s_p_deny_tbl[] = {"bg", "jobs", "kill", "wait", "scr", "rst", "ipc", "task", "rtos", "mct", "lock", "deb"};
+    char line[DBG_CMD_MAX_LEN];
+    bool is_found = false;
+    int32_t id;
+
+    if (p_args->argc < 2) {
+        printf("Error: Usage: bg <cmd> [args]\n");
+        return;
+    }
+
+    for (uint32_t i = 0; i < count_of(s_p_deny_tbl); i++)
+    {
+        if (strcmp(p_args->p_argv[1], s_p_deny_tbl[i]) == 0) {
+            printf("Error: '%s' cannot run as a job\n", p_args->p_argv[1]);
+            return;
+        }
+    }
+    for (uint32_t i = 0; i < g_cmd_tbl_size; i++)
+    {
+        if (strcmp(p_args->p_argv[1], g_cmd_tbl[i].p_cmd_str) == 0) {
+            is_found = true;
+            break;
+        }
+    }
+    if (!is_found) {
+        printf("Error: Unknown command '%s'\n", p_args->p_argv[1]);
+        return;
+    }
+
+    // 分割された引数を1行に戻す
+    line[0] = '\0';
+    for (int32_t i = 1; i < p_args->argc; i++)
+    {
+        if (i > 1) {
+            strncat(line, " ", sizeof(line) - strlen(line) - 1);
+        }
+        strncat(line, p_args->p_argv[i], sizeof(line) - strlen(line) - 1);
+    }
+
+    id = app_job_submit(line);
+    if (id == -2) {
+        printf("Error: Failed to notify Core %d (queue full)\n", JOB_CORE_NUM);
+        return;
+    }
+    if (id < 0) {
+        printf("Error: Job table is full (max %d). Use 'wait' or 'kill' to free a slot\n", JOB_MAX);
+        return;
+    }
+    printf("[%d] Queued '%s' on Core %d\n", id, line, JOB_CORE_NUM);
+}
+
+/**
+ * @brief ジョブ一覧コマンド関数
+ * 
+ * @param p_args コマンド引数の構造体ポインタ
+ */
+static void cmd_jobs(dbg_cmd_args_t *p_args)
+{
+    app_job_list();
+}
+
+/**
+ * @brief ジョブ中断コマンド関数
+ * 
+ * @param p_args コマンド引数の構造体ポインタ
+ */
+static void cmd_job_kill(dbg_cmd_args_t *p_args)
+{
+    uint32_t id;
+
+    if (p_args->argc != 2) {
+        printf("Error: Usage: kill <id>\n");
+        return;
+    }
+
+    id = (uint32_t)atoi(p_args->p_argv[1]);
+    if (!app_job_kill(id)) {
+        printf("Error: No such job [%u]\n", id);
+        return;
+    }
+    printf("[%u] Kill requested\n", id);
+}
+
+/**
+ * @brief ジョブ終了待ちコマンド関数
+ * 
+ * @param p_args コマンド引数の構造体ポインタ
+ */
+static void cmd_job_wait(dbg_cmd_args_t *p_args)
+{
+    uint32_t id = 0;
+
+    if (p_args->argc == 2) {
+        id = (uint32_t)atoi(p_args->p_argv[1]);
+        if (id == 0) {
+            printf("Error: Invalid job id\n");
+            return;
+        }
+    }
+
+    app_job_wait(id);
+}
+
+/**
+ * @brief コア間メッセージキューのコマンド関数
+ * 
+ * @param p_args コマンド引数の構造体ポインタ
+ */
+static void cmd_ipc(dbg_cmd_args_t *p_args)
+{
+    const char *p_sub;
+    int32_t cnt = 10000;
+    int32_t size = 16;
+    ipc_stat_t stat;
+
+    if (p_args->argc < 2) {
+        printf("Error: Usage: ipc bench [n] [size] | ipc test [n] | ipc stat\n");
+        return;
+    }
+    p_sub = p_args->p_argv[1];
+
+    if ((p_args->argc >= 3) && ((cnt = atoi(p_args->p_argv[2])) <= 0)) {
+        printf("Error: Invalid message count. Must be positive.\n");
+        return;
+    }
+
+    if (strcmp(p_sub, "bench") == 0) {
+        if (p_args->argc == 4) {
+            size = atoi(p_args->p_argv[3]);
+            if ((size < 0) || (size > IPC_MSG_MAX_LEN)) {
+                printf("Error: Invalid size. Must be 0..%d\n", IPC_MSG_MAX_LEN);
+                return;
+            }
+        }
+        drv_ipc_bench((uint32_t)cnt, (uint16_t)size);
+    } else if ((strcmp(p_sub, "test") == 0) && (p_args->argc <= 3)) {
+        drv_ipc_self_test((uint32_t)cnt);
+    } else if ((strcmp(p_sub, "stat") == 0) && (p_args->argc == 2)) {
+        printf("\n[IPC Stat] (ring %u bytes per direction)\n", IPC_RING_SIZE);
+        printf("Direction       send       bytes      full       bell       recv\n");
+        for (uint32_t core = 0; core < 2; core++)
+        {
+            drv_ipc_get_stat(core, &stat);
+            printf("Core %u->%u  %10u %11u %10u %10u %10u\n",
+                    core, core ^ 1u, stat.send_cnt, stat.send_bytes, stat.full_cnt, stat.bell_cnt, stat.recv_cnt);
+        }
+    } else {
+        printf("Error: Usage: ipc bench [n] [size] | ipc test [n] | ipc stat\n");
+    }
+}
+
+/**
+ * @brief Core0のイベントループの統計コマンド関数
+ * 
+ * @param p_args コマンド引数の構造体ポインタ
+ */
+static void cmd_event(dbg_cmd_args_t *p_args)
+{
+    if (p_args->argc == 1) {
+        app_event_show_stat();
+    } else if (strcmp(p_args->p_argv[1], "clr") == 0) {
+        app_event_clear_stat();
+        printf("Event loop stats cleared\n");
+    } else {
+        printf("Error: Usage: evt [clr]\n");
+    }
+}
+
+/**
+ * @brief タスクスケジューラのコマンド関数
+ * 
+ * @param p_args コマンド引数の構造体ポインタ
+ */
+static void cmd_task(dbg_cmd_args_t *p_args)
+{
+    const char *p_sub;
+    int32_t param = 0;
+
+    if (p_args->argc < 2) {
+        printf("Error: Usage: task test [n] | task sieve [n] | task mandel | task hash [kb] | task stat\n");
+        return;
+    }
+    p_sub = p_args->p_argv[1];
+
+    if ((p_args->argc == 3) && ((param = atoi(p_args->p_argv[2])) <= 0)) {
+        printf("Error: Invalid parameter. Must be positive.\n");
+        return;
+    }
+
+    if (strcmp(p_sub, "test") == 0) {
+        app_task_self_test((param != 0) ? (uint32_t)param : 100);
+    } else if (strcmp(p_sub, "sieve") == 0) {
+        app_task_bench(TASK_BENCH_SIEVE, (param != 0) ? (uint32_t)param : 100000);
+    } else if ((strcmp(p_sub, "mandel") == 0) && (p_args->argc == 2)) {
+        app_task_bench(TASK_BENCH_MANDEL, 0);
+    } else if (strcmp(p_sub, "hash") == 0) {
+        if ((uint32_t)param > (PICO_FLASH_SIZE_BYTES / 1024)) {
+            printf("Error: Size must be <= %u KB\n", PICO_FLASH_SIZE_BYTES / 1024);
+            return;
+        }
+        app_task_bench(TASK_BENCH_HASH, (param != 0) ? (uint32_t)param : 256);
+    } else if ((strcmp(p_sub, "stat") == 0) && (p_args->argc == 2)) {
+        printf("\n[Task Stat]\n");
+        app_task_show_stat();
+    } else {
+        printf("Error: Usage: task test [n] | task sieve [n] | task mandel | task hash [kb] | task stat\n");
+    }
+}
+
+#if defined(RP2XXX_USE_FREERTOS)
+/**
+ * @brief topコマンド関数(FreeRTOS版)
+ * 
+ * @param p_args コマンド引数の構造体ポインタ
+ */
+static void cmd_top(dbg_cmd_args_t *p_args)
+{
+    int32_t interval_ms = 1000;
+
+    if (p_args->argc > 1) {
+        interval_ms = atoi(p_args->p_argv[1]);
+        if ((interval_ms <= 0) || (interval_ms > 10000)) {
+            printf("Error: Interval must be 1-10000 ms\n");
+            return;
+        }
+    }
+
+    app_rtos_top((uint32_t)interval_ms);
 }
 
+/**
+ * @brief カーネルのベンチマークコマンド関数(FreeRTOS版)
+ * 
+ * @param p_args コマンド引数の構造体ポインタ
+ */
+static void cmd_rtos(dbg_cmd_args_t *p_args)
+{
+    int32_t cnt = 1000;
+
+    if (p_args->argc < 2) {
+        printf("Error: Usage: rtos bench [n]\n");
+        return;
+    }
+
+    if ((p_args->argc == 3) && ((cnt = atoi(p_args->p_argv[2])) <= 0)) {
+        printf("Error: Invalid parameter. Must be positive.\n");
+        return;
+    }
+
+    if (strcmp(p_args->p_argv[1], "bench") == 0) {
+        app_rtos_bench((uint32_t)cnt);
+    } else {
+        printf("Error: Usage: rtos bench [n]\n");
+    }
+}
+#endif // RP2XXX_USE_FREERTOS
+
 /**
  * @brief I2Cスキャンコマンド関数
  * 
@@ -662,7 +1356,7 @@ static int parse_hex_color(const char* str, uint8_t *r, uint8_t *g, uint8_t *b)
     }
 
     uint8_t rv, gv, bv = 0;
-    if (sscanf(str+1, "%02x%02x%02x", &rv, &gv, &bv) == 3) {
+    if (sscanf(str+1, "%2hhx%2hhx%2hhx", &rv, &gv, &bv) == 3) {
         *r = (uint8_t)rv;
         *g = (uint8_t)gv;
         *b = (uint8_t)bv;
@@ -671,6 +1365,62 @@ static int parse_hex_color(const char* str, uint8_t *r, uint8_t *g, uint8_t *b)
     return -1;
 }
 
+/**
+ * @brief NeoPixelのエフェクトエンジンのサブコマンド(px fx ...)
+ *
+ * @param p_arg_str エフェクト名 | list | stop | clr | NULL(統計を表示)
+ */
+static void cmd_neopixel_fx(const char *p_arg_str)
+{
+    if (p_arg_str == NULL) {
+        app_fx_show_stat();
+    } else if (strcasecmp(p_arg_str, "list") == 0) {
+        app_fx_list();
+    } else if (strcasecmp(p_arg_str, "stop") == 0) {
+        app_fx_stop();
+        printf("FX stopped\n");
+    } else if (strcasecmp(p_arg_str, "clr") == 0) {
+        app_fx_clear_stat();
+    } else if (app_fx_start(p_arg_str)) {
+        printf("FX %s started at Core 0\n", p_arg_str);
+    } else {
+        printf("Error: Unknown effect '%s'\n", p_arg_str);
+        app_fx_list();
+    }
+}
+
+/**
+ * @brief Flashのアニメーション再生のサブコマンド(px play ...)
+ *
+ * @param p_args 引数(p_argv[2] ... demo | stat | stop | 無し(再生))
+ */
+static void cmd_neopixel_play(dbg_cmd_args_t *p_args)
+{
+    const char *p_sub_str = (p_args->argc >= 3) ? p_args->p_argv[2] : NULL;
+    int32_t frame_cnt;
+
+    if (p_sub_str == NULL) {
+        if (app_anim_play()) {
+            printf("Animation playing at Core 0 (px play stat / px fx for timing)\n");
+        }
+    } else if (strcasecmp(p_sub_str, "demo") == 0) {
+        frame_cnt = (p_args->argc >= 4) ? atoi(p_args->p_argv[3]) : ANIM_DEMO_FRAMES;
+        if (frame_cnt < 1) {
+            printf("Error: Frame count must be 1 or more\n");
+            return;
+        }
+        app_anim_demo_save((s_neopixel.led_cnt < ANIM_LED_MAX) ? s_neopixel.led_cnt : ANIM_LED_MAX,
+                           (uint32_t)frame_cnt, ANIM_DEMO_FPS);
+    } else if (strcasecmp(p_sub_str, "stat") == 0) {
+        app_anim_show_stat();
+    } else if (strcasecmp(p_sub_str, "stop") == 0) {
+        app_fx_stop();
+        printf("Animation stopped\n");
+    } else {
+        printf("Usage: px play [demo [frames]|stat|stop]\n");
+    }
+}
+
 /**
  * @brief NeoPixel制御コマンド関数
  * 
@@ -686,18 +1436,100 @@ static void cmd_neopixel(dbg_cmd_args_t *p_args)
     char* p_mode_str = p_args->p_argv[1];
     // 第二引数がcls
     if(strcasecmp(p_mode_str, "cls") == 0) {
-        drv_neopixel_init(&s_neopixel);
+        app_fx_stop();
+        drv_neopixel_clear(&s_neopixel);
+        drv_neopixel_commit(&s_neopixel);
         printf("All NeoPixel Cleared!\n");
         return;
     }
 
+    if(strcasecmp(p_mode_str, "bench") == 0) {
+        // 引数 ... 計測するLEDの数(既定は実際の本数)
+        int32_t led_cnt = (p_args->argc == 3) ? atoi(p_args->p_argv[2]) : s_neopixel.led_cnt;
+        if ((led_cnt < 1) || (led_cnt > NEOPIXEL_LED_MAX)) {
+            printf("Error: LED count must be 1-%d\n", NEOPIXEL_LED_MAX);
+            return;
+        }
+        drv_neopixel_bench((uint32_t)led_cnt, 50);
+        return;
+    }
+
+    if(strcasecmp(p_mode_str, "scale") == 0) {
+        drv_neopixel_scale();
+        return;
+    }
+
+    if(strcasecmp(p_mode_str, "stat") == 0) {
+        drv_neopixel_show_stat();
+        return;
+    }
+
     if(strcasecmp(p_mode_str, "fade") == 0) {
-        // Core 0にLEDフェードを実行要求
-        set_multicore_fifo(PROC_NEOPIXEL_FADE);
+        // 従来のフェード(1msで1ステップ)をCore 0のエフェクトエンジンで実行
+        app_fx_set_fps(FX_FPS_MAX);
+        app_fx_start("fade");
         printf("All NeoPixel Color Fade! at Core 0\n");
         return;
     }
 
+    if(strcasecmp(p_mode_str, "play") == 0) {
+        cmd_neopixel_play(p_args);
+        return;
+    }
+
+    if(strcasecmp(p_mode_str, "fx") == 0) {
+        cmd_neopixel_fx((p_args->argc == 3) ? p_args->p_argv[2] : NULL);
+        return;
+    }
+
+    // エフェクトの色変換/フレームレートの設定
+    if ((p_args->argc == 3) && ((strcasecmp(p_mode_str, "fps") == 0) || (strcasecmp(p_mode_str, "bri") == 0) ||
+                                (strcasecmp(p_mode_str, "gamma") == 0))) {
+        int32_t val = atoi(p_args->p_argv[2]);
+        if (strcasecmp(p_mode_str, "fps") == 0) {
+            if ((val < 1) || (val > FX_FPS_MAX)) {
+                printf("Error: fps must be 1-%d\n", FX_FPS_MAX);
+                return;
+            }
+            app_fx_set_fps((uint32_t)val);
+        } else if (strcasecmp(p_mode_str, "bri") == 0) {
+            if ((val < 0) || (val > UINT8_MAX)) {
+                printf("Error: Brightness must be 0-%d\n", UINT8_MAX);
+                return;
+            }
+            app_fx_set_brightness((uint8_t)val);
+        } else {
+            if ((val < 10) || (val > 40)) {
+                printf("Error: Gamma (x10) must be 10-40\n");
+                return;
+            }
+            app_fx_set_gamma((uint32_t)val);
+        }
+        printf("FX %s = %d\n", p_mode_str, (int)val);
+        return;
+    }
+
+    if ((p_args->argc == 3) && (strcasecmp(p_mode_str, "dither") == 0)) {
+        int32_t bits = (strcasecmp(p_args->p_argv[2], "auto") == 0) ? FX_DITHER_AUTO : atoi(p_args->p_argv[2]);
+        if ((bits != FX_DITHER_AUTO) && ((bits < 0) || (bits > FX_DITHER_BITS_MAX))) {
+            printf("Error: Dither must be auto or 0-%d bits\n", FX_DITHER_BITS_MAX);
+            return;
+        }
+        app_fx_set_dither(bits);
+        printf("FX dither = %s\n", p_args->p_argv[2]);
+        return;
+    }
+
+    if ((p_args->argc == 3) && (strcasecmp(p_mode_str, "cc") == 0)) {
+        if (parse_hex_color(p_args->p_argv[2], &r, &g, &b) != 0) {
+            printf("Usage: px cc #RRGGBB (per-channel colour correction, #FFFFFF = none)\n");
+            return;
+        }
+        app_fx_set_correction(r, g, b);
+        printf("FX correction = #%02X%02X%02X\n", r, g, b);
+        return;
+    }
+
     // コマンド引数チェック
     if (p_args->argc < 3) {
         printf("Usage: neopixel <index|mode> <color|#RRGGBB>\n");
@@ -717,22 +1549,23 @@ static void cmd_neopixel(dbg_cmd_args_t *p_args)
     }
 
     // 第三引数が文字
-    uint8_t led_idx = (uint8_t)idx - 1;
+    uint16_t led_idx = (uint16_t)(idx - 1);
     const char* color_str = p_args->p_argv[2];
     color_enum = get_neopixel_color_from_name(color_str);
     if (color_enum >= 0) {
         if (all_set_flag != 0) {
             // 全てのNeoPixelに同じ色を設定
-            for (uint8_t i = 0; i < s_neopixel.led_cnt; i++)
+            for (uint16_t i = 0; i < s_neopixel.led_cnt; i++)
             {
                 drv_neopixel_get_pixel_color(&s_neopixel, i, color_enum);
             }
-            drv_neopixel_show(&s_neopixel);
+            drv_neopixel_commit(&s_neopixel);
             printf("All NeoPixels set to %s\n", color_str);
             return;
         } else {
             // 指定されたNeoPixelに色を設定
             drv_neopixel_set_pixel_color(&s_neopixel, led_idx, color_enum);
+            drv_neopixel_commit(&s_neopixel);
             printf("NeoPixel[%d] = %s\n", led_idx, color_str);
             return;
         }
@@ -743,12 +1576,83 @@ static void cmd_neopixel(dbg_cmd_args_t *p_args)
         if (all_set_flag != 0) {
             // 全てのNeoPixelに同じ色を設定
             drv_neopixel_set_all_led_color(&s_neopixel, r, g, b);
+            drv_neopixel_commit(&s_neopixel);
             printf("All NeoPixels set to #%02X%02X%02X\n", r, g, b);
             return;
         } else {
             drv_neopixel_set_pixel_rgb(&s_neopixel, led_idx, r, g, b);
+            drv_neopixel_commit(&s_neopixel);
             printf("NeoPixel[%d] = #%02X%02X%02X\n", led_idx, r, g, b);
             return;
         }
     }
-}
\ No newline at end of file
+}
+
+#if defined(PCB_NEOPIXEL_MULTI)
+/**
+ * @brief NeoPixel 複数ストリップ並列出力コマンド関数
+ *
+ * @param p_args
+ */
+static void cmd_neopixel_multi(dbg_cmd_args_t *p_args)
+{
+    uint8_t r, g, b = 0;
+    int32_t strip = 0;
+    char* p_mode_str;
+
+    if (p_args->argc < 2) {
+        printf("Error: Usage: pxm cls | pxm <strip|all> #RRGGBB | pxm bench [leds] | pxm test [n]\n");
+        return;
+    }
+    p_mode_str = p_args->p_argv[1];
+
+    if (strcasecmp(p_mode_str, "cls") == 0) {
+        drv_neopixel_multi_clear(&s_neopixel_multi);
+        drv_neopixel_multi_commit(&s_neopixel_multi);
+        printf("All strips cleared!\n");
+        return;
+    }
+
+    if (strcasecmp(p_mode_str, "bench") == 0) {
+        // 引数 ... 1ストリップのLEDの数(既定は実際の本数)
+        int32_t led_cnt = (p_args->argc == 3) ? atoi(p_args->p_argv[2]) : s_neopixel_multi.strip[0].led_cnt;
+        if ((led_cnt < 1) || (led_cnt > NEOPIXEL_MULTI_LED_MAX)) {
+            printf("Error: LED count must be 1-%d\n", NEOPIXEL_MULTI_LED_MAX);
+            return;
+        }
+        drv_neopixel_multi_bench((uint32_t)led_cnt, 50);
+        return;
+    }
+
+    if (strcasecmp(p_mode_str, "test") == 0) {
+        // 引数 ... テスト回数
+        int32_t loop_cnt = (p_args->argc == 3) ? atoi(p_args->p_argv[2]) : 100;
+        drv_neopixel_multi_test((loop_cnt > 0) ? (uint32_t)loop_cnt : 1);
+        return;
+    }
+
+    if ((p_args->argc < 3) || (parse_hex_color(p_args->p_argv[2], &r, &g, &b) != 0)) {
+        printf("Usage: pxm <strip|all> #RRGGBB\n");
+        return;
+    }
+
+    if (strcasecmp(p_mode_str, "all") == 0) {
+        for (uint32_t i = 0; i < s_neopixel_multi.strip_cnt; i++)
+        {
+            drv_neopixel_multi_set_strip_rgb(&s_neopixel_multi, (uint8_t)i, r, g, b);
+        }
+        drv_neopixel_multi_commit(&s_neopixel_multi);
+        printf("All strips set to #%02X%02X%02X\n", r, g, b);
+        return;
+    }
+
+    strip = atoi(p_mode_str);
+    if ((strip < 1) || (strip > s_neopixel_multi.strip_cnt)) {
+        printf("Error: stripは1～%d\n", s_neopixel_multi.strip_cnt);
+        return;
+    }
+    drv_neopixel_multi_set_strip_rgb(&s_neopixel_multi, (uint8_t)(strip - 1), r, g, b);
+    drv_neopixel_multi_commit(&s_neopixel_multi);
+    printf("Strip[%d] (GPIO%d) = #%02X%02X%02X\n", strip - 1, s_neopixel_multi.pin_base + strip - 1, r, g, b);
+}
+#endif
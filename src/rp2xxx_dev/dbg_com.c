@@ -10,11 +10,14 @@
  */
 #include "dbg_com.h"
 #include "ansi_esc.h"
+#include "app_load.h"
 
 #define KEY_LEFT    'D'    // 左矢印キー（ESC[D）
 #define KEY_RIGHT   'C'    // 右矢印キー（ESC[C）
 #define KEY_DELETE  0x7F   // Deleteキー
 
+#define DBG_KEY_BUF_SIZE    64  // 戻されたキーのバッファ(2のべき乗)
+
 // コマンド履歴
 static char s_cmd_history[CMD_HISTORY_MAX][DBG_CMD_MAX_LEN];
 static uint8_t s_history_count = 0;  // コマンド履歴の数
@@ -38,6 +41,14 @@ static int32_t split_str(char* p_str, dbg_cmd_args_t *p_args);
 static char s_cmd_buffer[DBG_CMD_MAX_LEN];
 static int32_t s_cmd_index = 0;
 
+// 入力行のフック(スクリプト記録など)
+static dbg_com_line_hook_t s_p_line_hook = NULL;
+
+// コマンド実行中に先読みされて戻されたキー(Core1だけが触る)
+static uint8_t s_key_buf[DBG_KEY_BUF_SIZE];
+static uint32_t s_key_wr = 0;
+static uint32_t s_key_rd = 0;
+
 extern const size_t g_cmd_tbl_size;
 extern void cmd_help(dbg_cmd_args_t *p_args);
 
@@ -323,6 +334,85 @@ static void dbg_com_execute_cmd(dbg_cmd_t cmd, dbg_cmd_args_t *p_args)
     }
 }
 
+/**
+ * @brief 1行分のコマンドを実行する(スクリプトなどから呼ぶ)
+ * 
+ * @param p_line コマンド文字列
+ * @return true コマンドを実行した(空行含む)
+ * @return false 不明なコマンド
+ */
+bool dbg_com_exec_line(const char *p_line)
+{
+    char buf[DBG_CMD_MAX_LEN];
+    dbg_cmd_args_t args;
+    dbg_cmd_t cmd;
+
+    strncpy(buf, p_line, DBG_CMD_MAX_LEN - 1);
+    buf[DBG_CMD_MAX_LEN - 1] = '\0';
+
+    split_str(buf, &args);
+    if (args.argc == 0) {
+        return true;
+    }
+
+    cmd = dbg_com_parse_cmd(args.p_argv[0], &args);
+    if (cmd == CMD_UNKNOWN) {
+        return false;
+    }
+    dbg_com_execute_cmd(cmd, &args);
+
+    return true;
+}
+
+/**
+ * @brief 入力行のフックを設定する
+ * 
+ * @param p_hook フック関数(trueを返した行はコマンドとして実行しない)、NULLで解除
+ */
+void dbg_com_set_line_hook(dbg_com_line_hook_t p_hook)
+{
+    s_p_line_hook = p_hook;
+}
+
+/**
+ * @brief 先読みしたキーをモニタに戻す(次の入力として読まれる)
+ * @note バッファが一杯なら捨てる
+ *
+ * @param c 戻す文字
+ */
+void dbg_com_unget_key(int32_t c)
+{
+    if ((c < 0) || ((s_key_wr - s_key_rd) >= DBG_KEY_BUF_SIZE)) {
+        return;
+    }
+
+    s_key_buf[s_key_wr & (DBG_KEY_BUF_SIZE - 1)] = (uint8_t)c;
+    s_key_wr++;
+}
+
+/**
+ * @brief モニタの1文字受信(戻されたキーを先に返す)
+ *
+ * @param timeout_us タイムアウト(us)
+ * @return int32_t 受信した文字、タイムアウトならPICO_ERROR_TIMEOUT
+ */
+int32_t dbg_com_getchar_timeout_us(uint32_t timeout_us)
+{
+    if (s_key_rd != s_key_wr) {
+        return s_key_buf[s_key_rd++ & (DBG_KEY_BUF_SIZE - 1)];
+    }
+
+    return getchar_timeout_us(timeout_us);
+}
+
+// 1文字受信するまでブロック(戻されたキーを先に返す)
+static int32_t dbg_com_getchar(void)
+{
+    int32_t c = dbg_com_getchar_timeout_us(0);
+
+    return (c != PICO_ERROR_TIMEOUT) ? c : getchar();
+}
+
 /**
  * @brief デバッグコマンドモニターの初期化
  */
@@ -335,33 +425,49 @@ void dbg_com_init(void)
 }
 
 /**
- * @brief デバッグコマンドモニターのメイン処理
+ * @brief デバッグコマンドモニターのメイン処理(1文字受信するまでブロック)
  */
 void dbg_com_main(void)
 {
-    dbg_cmd_args_t args;
     int32_t c;
 
+    // キー入力待ちの間はアイドル
+    app_load_idle_enter();
+    c = dbg_com_getchar();
+    app_load_idle_exit();
+    dbg_com_input(c);
+}
+
+/**
+ * @brief デバッグコマンドモニターへの1文字入力
+ * @note 受信待ちを呼び出し側で行うとき(RTOS版など)に使う
+ *
+ * @param c 受信した文字
+ */
+void dbg_com_input(int32_t c)
+{
+    dbg_cmd_args_t args;
+
     if (s_cmd_index >= DBG_CMD_MAX_LEN - 1) {
         s_cmd_index = 0;
         s_cursor_pos = 0;
     }
 
-    c = getchar();
-
     // デリミタでCRかLFが来たらコマンドの受付を終わる
     if (c == '\r' || c == '\n') {
         if (s_cmd_index > 0) {
             s_cmd_buffer[s_cmd_index] = '\0';
             printf("\n");
 
-            // コマンド履歴に入力されたコマンドを追加
-            add_to_cmd_history(s_cmd_buffer);
+            if ((s_p_line_hook == NULL) || !s_p_line_hook(s_cmd_buffer)) {
+                // コマンド履歴に入力されたコマンドを追加
+                add_to_cmd_history(s_cmd_buffer);
 
-            split_str(s_cmd_buffer, &args);
-            if (args.argc > 0) {
-                dbg_cmd_t cmd = dbg_com_parse_cmd(args.p_argv[0], &args);
-                dbg_com_execute_cmd(cmd, &args);
+                split_str(s_cmd_buffer, &args);
+                if (args.argc > 0) {
+                    dbg_cmd_t cmd = dbg_com_parse_cmd(args.p_argv[0], &args);
+                    dbg_com_execute_cmd(cmd, &args);
+                }
             }
             s_cmd_index = 0;
             s_cursor_pos = 0;
@@ -376,9 +482,9 @@ void dbg_com_main(void)
         // Delete処理
         delete_char_at_cursor();
     } else if (c == KEY_ESC) { // ESC
-        c = getchar();
+        c = dbg_com_getchar();
         if (c == KEY_ANSI_ESC) { // ANSI escape sequence
-            c = getchar();
+            c = dbg_com_getchar();
             if (c == KEY_UP) { // キーボードの上矢印
                 if (s_history_pos < s_history_count - 1) {
                     // 現在の入力バッファをクリア
@@ -31,7 +31,7 @@
 // #define DEBUG_DBG_COM      // デバッグ用
 
 // コマンド関連のマクロ
-#define DBG_CMD_MAX_LEN         32 // コマンドの最大長
+#define DBG_CMD_MAX_LEN         64 // コマンドの最大長
 #define DBG_CMD_MAX_ARGS        5 // コマンドの最大引数数
 #define CMD_HISTORY_MAX         16 // コマンド履歴の最大数
 
@@ -77,18 +77,40 @@ typedef enum {
     CMD_SYSTEM,     // システム情報表示
     CMD_RST,        // リセット
     CMD_MEM_DUMP,   // メモリダンプ
+    CMD_MEM_FIND,   // メモリのパターン検索
+    CMD_MEM_FILL,   // メモリのフィル
+    CMD_MEM_CMP,    // メモリの比較
+    CMD_SCRIPT,     // コマンドスクリプト
+    CMD_JOB_BG,     // ジョブ登録(Core0で実行)
+    CMD_JOBS,       // ジョブ一覧
+    CMD_JOB_KILL,   // ジョブ中断
+    CMD_JOB_WAIT,   // ジョブ終了待ち
+    CMD_IPC,        // コア間メッセージキューのベンチ/テスト
+    CMD_EVENT,      // Core0のイベントループの統計
+    CMD_TASK,       // タスクスケジューラのベンチ/テスト
+#if defined(RP2XXX_USE_FREERTOS)
+    CMD_TOP,        // タスクごとのCPU使用率/スタック残量(FreeRTOS版)
+    CMD_RTOS,       // カーネルの同期機構のベンチ(FreeRTOS版)
+#endif
     CMD_REG,        // レジスタ操作8/16/32bit
     CMD_GPIO,       // GPIO制御
     CMD_I2C,        // I2C制御
     CMD_NEOPIXEL,   // NeoPixel制御
+#if defined(PCB_NEOPIXEL_MULTI)
+    CMD_NEOPIXEL_MULTI, // NeoPixel 複数ストリップ並列出力
+#endif
     CMD_TIMER,      // タイマーコマンド
     CMD_RTC,        // RTCコマンド
 #if defined(MCU_RP2350)
     CMD_RND,        // 真性乱数をH/WのTRANGで生成
-    CMD_SHA,        // H/WでSHA-256のハッシュ値を計算
 #endif
+    CMD_SHA,        // SHA-256のハッシュ値を計算(RP2350 ... H/W、RP2040 ... S/W)
     CMD_MCT,        // マルチコアテスト
+    CMD_LOCK,       // コア間ロックの統計/ベンチマーク
+    CMD_DEB,        // GPIO入力のチャタリング除去
+    CMD_LOAD,       // コアごとのCPU負荷とスタック使用量
     CMD_MT_TEST,    // 論理演算/四則演算/数学アプリのテスト
+    CMD_PI,         // 円周率の計算
     CMD_UNKNOWN     // 不明なコマンド
 } dbg_cmd_t;
 
@@ -121,8 +143,16 @@ typedef struct {
     uint8_t order;                   // 登録順序
 } timer_state_t;
 
+// 入力行のフック関数(trueを返すとその行はコマンドとして実行しない)
+typedef bool (*dbg_com_line_hook_t)(const char *p_line);
+
 // 関数プロトタイプ
 void dbg_com_init(void);
 void dbg_com_main(void);
+void dbg_com_input(int32_t c);
+void dbg_com_unget_key(int32_t c);
+int32_t dbg_com_getchar_timeout_us(uint32_t timeout_us);
+bool dbg_com_exec_line(const char *p_line);
+void dbg_com_set_line_hook(dbg_com_line_hook_t p_hook);
 
 #endif // DBG_COM_H
\ No newline at end of file
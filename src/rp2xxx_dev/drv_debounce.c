@@ -0,0 +1,410 @@
+/**
+ * @file drv_debounce.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief GPIO入力のチャタリング除去(エッジ割り込み + タイマーアラーム)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026 Chimipupu All Rights Reserved.
+ *
+ * ISRでは待たない。
+ *   GPIO割り込み ... エッジの時刻を記録し、バースト最初のエッジでだけアラームを仕掛ける
+ *   アラーム     ... 最後のエッジから安定待ち時間が経っていなければ残りで再設定、
+ *                    経っていればレベルを読んで、変化していれば確定イベントをキューへ
+ *   イベントループ ... キューを取り出してハンドラへ配送(printf等はここで行う)
+ * GPIO割り込みとアラームはどちらもCore0(EVENT_CORE_NUM)で同じ優先度なので互いに割り込まない。
+ */
+#include "drv_debounce.h"
+#include "muc_rpxxx_util.h"
+#include "app_event.h"
+#include "drv_ipc.h"
+
+#define DEBOUNCE_SIM_GAP_MIN_US     20      // シミュレーションのバウンス間隔の最小
+
+// 入力
+typedef struct {
+    const char *p_name;
+    uint pin;
+    uint32_t window_us;                 // 安定待ち時間
+    debounce_pull_t pull;
+    debounce_handler_t p_handler;
+    bool is_armed;                      // 割り込み有効化済み(Core0で行う)
+    volatile bool is_pending;           // アラーム待ち
+    volatile bool level;                // 確定レベル
+    volatile uint32_t first_edge_us;    // バースト最初のエッジ
+    volatile uint32_t last_edge_us;     // 直近のエッジ
+    // 統計
+    volatile uint32_t edge_cnt;         // エッジ数
+    volatile uint32_t bounce_cnt;       // アラーム待ち中のエッジ数(= 吸収したバウンス)
+    volatile uint32_t glitch_cnt;       // 確定時にレベルが元に戻っていた(短いパルスを除去)
+    uint32_t event_cnt;                 // 配送したイベント数
+    uint64_t lat_sum_us;                // 最初のエッジ -> ハンドラ開始
+    uint32_t lat_max_us;
+} debounce_in_t;
+
+// 確定イベント
+typedef struct {
+    uint8_t id;
+    bool level;
+    uint32_t edge_us;                   // 最初のエッジ
+    uint32_t stable_us;                 // 確定した時刻
+} debounce_evt_t;
+
+// ISRの実行時間の統計
+typedef struct {
+    volatile uint32_t cnt;
+    volatile uint64_t sum_cyc;
+    volatile uint32_t max_cyc;
+} debounce_isr_stat_t;
+
+static debounce_in_t s_in[DEBOUNCE_MAX];
+static volatile uint32_t s_in_cnt = 0;
+static int8_t s_pin_to_id[NUM_BANK0_GPIOS];
+static int32_t s_event_id = -1;
+static bool s_is_init = false;
+
+// 確定イベントのキュー(Core0のアラーム -> Core0のイベントループ)
+static debounce_evt_t s_queue[DEBOUNCE_QUEUE_LEN];
+static volatile uint32_t s_q_head = 0;
+static volatile uint32_t s_q_tail = 0;
+static volatile uint32_t s_q_max = 0;
+static volatile uint32_t s_drop_cnt = 0;
+static volatile uint32_t s_alarm_err_cnt = 0;
+static uint32_t s_q_wait_max_us = 0;        // 確定 -> ハンドラ開始
+
+static debounce_isr_stat_t s_gpio_isr;
+static debounce_isr_stat_t s_alarm_isr;
+
+static void debounce_gpio_irq(uint gpio, uint32_t event_mask);
+static int64_t debounce_alarm_callback(alarm_id_t id, void *p_user_data);
+static void debounce_event_handler(uint32_t data);
+
+static inline void debounce_isr_stat(debounce_isr_stat_t *p_stat, uint32_t cyc)
+{
+    p_stat->cnt++;
+    p_stat->sum_cyc += cyc;
+    p_stat->max_cyc = (cyc > p_stat->max_cyc) ? cyc : p_stat->max_cyc;
+}
+
+static void debounce_set_pull(uint pin, debounce_pull_t pull)
+{
+    if (pull == DEBOUNCE_PULL_UP) {
+        gpio_pull_up(pin);
+    } else if (pull == DEBOUNCE_PULL_DOWN) {
+        gpio_pull_down(pin);
+    }
+}
+
+// GPIO割り込み(Core0) ... 時刻の記録とアラームの設定だけ
+static void debounce_gpio_irq(uint gpio, uint32_t event_mask)
+{
+    uint32_t t0_cyc = rp2xxx_get_cycle_cnt();
+    uint32_t now_us = time_us_32();
+    int32_t id = (gpio < NUM_BANK0_GPIOS) ? s_pin_to_id[gpio] : -1;
+    debounce_in_t *p_in;
+
+    (void)event_mask;
+    if (id >= 0) {
+        p_in = &s_in[id];
+        p_in->edge_cnt++;
+        p_in->last_edge_us = now_us;
+        if (!p_in->is_pending) {
+            p_in->first_edge_us = now_us;
+            p_in->is_pending = true;
+            if (add_alarm_in_us(p_in->window_us, debounce_alarm_callback, p_in, true) < 0) {
+                p_in->is_pending = false;
+                s_alarm_err_cnt++;
+            }
+        } else {
+            p_in->bounce_cnt++;
+        }
+    }
+
+    debounce_isr_stat(&s_gpio_isr, rp2xxx_get_cycle_cnt() - t0_cyc);
+}
+
+// アラーム(Core0) ... 安定したらレベルを確定してキューへ
+static int64_t debounce_alarm_callback(alarm_id_t id, void *p_user_data)
+{
+    uint32_t t0_cyc = rp2xxx_get_cycle_cnt();
+    debounce_in_t *p_in = (debounce_in_t *)p_user_data;
+    uint32_t now_us = time_us_32();
+    uint32_t elapsed_us = now_us - p_in->last_edge_us;
+    uint32_t head;
+    int64_t ret = 0;
+    bool level;
+
+    (void)id;
+    if (elapsed_us < p_in->window_us) {
+        // 待ち中にエッジがあった ... 最後のエッジから安定待ち時間まで延長
+        ret = (int64_t)(p_in->window_us - elapsed_us);
+    } else {
+        level = gpio_get(p_in->pin);
+        p_in->is_pending = false;
+        if (level == p_in->level) {
+            p_in->glitch_cnt++;
+        } else {
+            p_in->level = level;
+            head = s_q_head;
+            if ((head - s_q_tail) >= DEBOUNCE_QUEUE_LEN) {
+                s_drop_cnt++;
+            } else {
+                s_queue[head & (DEBOUNCE_QUEUE_LEN - 1)] = (debounce_evt_t) {
+                    .id = (uint8_t)(p_in - s_in),
+                    .level = level,
+                    .edge_us = p_in->first_edge_us,
+                    .stable_us = now_us,
+                };
+                s_q_head = head + 1;
+                s_q_max = ((head + 1 - s_q_tail) > s_q_max) ? (head + 1 - s_q_tail) : s_q_max;
+                app_event_post(s_event_id, 0);
+            }
+        }
+    }
+
+    debounce_isr_stat(&s_alarm_isr, rp2xxx_get_cycle_cnt() - t0_cyc);
+
+    return ret;
+}
+
+// 既定のハンドラ(表示だけ)
+static void debounce_default_handler(int32_t id, bool level, uint32_t edge_us)
+{
+    printf("[Debounce] %s (GPIO %u) -> %s @%u us\n",
+            s_in[id].p_name, s_in[id].pin, level ? "High" : "Low", edge_us);
+}
+
+// イベントループ(Core0) ... 確定イベントをハンドラへ配送
+static void debounce_event_handler(uint32_t data)
+{
+    debounce_evt_t evt;
+    debounce_in_t *p_in;
+    uint32_t tail, now_us, lat_us, wait_us;
+
+    (void)data;
+    while ((tail = s_q_tail) != s_q_head)
+    {
+        evt = s_queue[tail & (DEBOUNCE_QUEUE_LEN - 1)];
+        s_q_tail = tail + 1;
+
+        p_in = &s_in[evt.id];
+        now_us = time_us_32();
+        lat_us = now_us - evt.edge_us;
+        wait_us = now_us - evt.stable_us;
+        p_in->event_cnt++;
+        p_in->lat_sum_us += lat_us;
+        p_in->lat_max_us = (lat_us > p_in->lat_max_us) ? lat_us : p_in->lat_max_us;
+        s_q_wait_max_us = (wait_us > s_q_wait_max_us) ? wait_us : s_q_wait_max_us;
+
+        if (p_in->p_handler != NULL) {
+            p_in->p_handler((int32_t)evt.id, evt.level, evt.edge_us);
+        } else {
+            debounce_default_handler((int32_t)evt.id, evt.level, evt.edge_us);
+        }
+    }
+}
+
+/**
+ * @brief チャタリング除去の初期化(EVENT_CORE_NUMでイベントループ登録後に呼ぶ)
+ */
+void drv_debounce_init(void)
+{
+    memset(s_pin_to_id, -1, sizeof(s_pin_to_id));
+    s_event_id = app_event_add("deb", EVENT_SRC_SW, debounce_event_handler);
+    s_is_init = (s_event_id >= 0);
+}
+
+/**
+ * @brief 入力の登録(どちらのコアからでも可、割り込みの有効化はCore0で行う)
+ *
+ * @param p_name 表示名
+ * @param pin GPIOピン
+ * @param window_us 安定待ち時間(us)
+ * @param pull プル
+ * @param p_handler 確定イベントのハンドラ(NULLなら表示だけ)
+ * @return int32_t 入力ID、登録できなければ-1
+ */
+int32_t drv_debounce_add(const char *p_name, uint pin, uint32_t window_us,
+                         debounce_pull_t pull, debounce_handler_t p_handler)
+{
+    int32_t id = (int32_t)s_in_cnt;
+    debounce_in_t *p_in;
+
+    if (!s_is_init) {
+        printf("Error: Debounce is not running on Core %d\n", EVENT_CORE_NUM);
+        return -1;
+    }
+    if ((pin >= NUM_BANK0_GPIOS) || (s_pin_to_id[pin] >= 0)) {
+        printf("Error: GPIO %u is invalid or already registered\n", pin);
+        return -1;
+    }
+    if (s_in_cnt >= DEBOUNCE_MAX) {
+        printf("Error: Too many inputs (max %d)\n", DEBOUNCE_MAX);
+        return -1;
+    }
+
+    gpio_init(pin);
+    gpio_set_dir(pin, GPIO_IN);
+    debounce_set_pull(pin, pull);
+
+    p_in = &s_in[id];
+    memset(p_in, 0, sizeof(debounce_in_t));
+    p_in->p_name = p_name;
+    p_in->pin = pin;
+    p_in->window_us = window_us;
+    p_in->pull = pull;
+    p_in->p_handler = p_handler;
+    p_in->level = gpio_get(pin);
+
+    // 内容を書いてから公開(Core0のISRが参照)
+    __mem_fence_release();
+    s_pin_to_id[pin] = (int8_t)id;
+    s_in_cnt++;
+
+    if (get_core_num() == EVENT_CORE_NUM) {
+        drv_debounce_arm();
+    } else if (!drv_ipc_send_code(PROC_DEBOUNCE_ARM)) {
+        printf("Error: Failed to arm GPIO %u on Core %d (queue full)\n", pin, EVENT_CORE_NUM);
+    }
+
+    return id;
+}
+
+/**
+ * @brief 未有効の入力のエッジ割り込みを有効化(EVENT_CORE_NUMで呼ぶ ※割り込みは呼んだコアに入る)
+ */
+void drv_debounce_arm(void)
+{
+    for (uint32_t i = 0; i < s_in_cnt; i++)
+    {
+        if (!s_in[i].is_armed) {
+            s_in[i].is_armed = true;
+            gpio_set_irq_enabled_with_callback(s_in[i].pin, GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL,
+                                                true, &debounce_gpio_irq);
+        }
+    }
+}
+
+// 確定イベント数が増えるまで待つ
+static bool debounce_sim_wait(const debounce_in_t *p_in, uint32_t event_cnt)
+{
+    uint64_t end_us = time_us_64() + (uint64_t)p_in->window_us * 4u + 100000u;
+
+    while (p_in->event_cnt == event_cnt) {
+        if (time_us_64() > end_us) {
+            return false;
+        }
+        sleep_ms(1);
+    }
+
+    return true;
+}
+
+/**
+ * @brief 未接続のピンのプルを切り替えてバウンスを模擬し、1回の変化に除去されるか確認
+ * @note ボタン等が繋がったピンでは外部の駆動が勝つので確認にならない
+ *
+ * @param pin 登録済みのGPIOピン(プル有り)
+ * @param bounce_cnt 往復の回数
+ * @return true 変化ごとに1イベント
+ */
+bool drv_debounce_sim(uint pin, uint32_t bounce_cnt)
+{
+    int32_t id = (pin < NUM_BANK0_GPIOS) ? s_pin_to_id[pin] : -1;
+    debounce_in_t *p_in;
+    uint32_t edge_cnt, event_cnt, gap_max_us;
+    bool level, is_ok;
+
+    if (id < 0) {
+        printf("Error: GPIO %u is not registered (deb add %u)\n", pin, pin);
+        return false;
+    }
+    p_in = &s_in[id];
+    if (p_in->pull == DEBOUNCE_PULL_NONE) {
+        printf("Error: GPIO %u has no pull to toggle\n", pin);
+        return false;
+    }
+
+    edge_cnt = p_in->edge_cnt;
+    event_cnt = p_in->event_cnt;
+    level = p_in->level;
+    gap_max_us = (p_in->window_us / 4 > DEBOUNCE_SIM_GAP_MIN_US) ? (p_in->window_us / 4) : (DEBOUNCE_SIM_GAP_MIN_US + 1);
+
+    // 反対のレベルへバウンスしながら移り、安定待ち時間より短い間隔で揺らす
+    for (uint32_t i = 0; i <= bounce_cnt * 2; i++)
+    {
+        debounce_set_pull(pin, ((i & 1u) == 0) != level ? DEBOUNCE_PULL_UP : DEBOUNCE_PULL_DOWN);
+        busy_wait_us_32(DEBOUNCE_SIM_GAP_MIN_US + (get_rand_32() % (gap_max_us - DEBOUNCE_SIM_GAP_MIN_US)));
+    }
+    is_ok = debounce_sim_wait(p_in, event_cnt);
+
+    // 元のプルに戻す(もう1回の変化)
+    debounce_set_pull(pin, p_in->pull);
+    is_ok = debounce_sim_wait(p_in, event_cnt + 1) && is_ok;
+
+    printf("[Debounce Sim] GPIO %u : %u edges -> %u events (expect 2) : %s\n",
+            pin, p_in->edge_cnt - edge_cnt, p_in->event_cnt - event_cnt,
+            (is_ok && ((p_in->event_cnt - event_cnt) == 2)) ? "OK" : "NG");
+
+    return is_ok;
+}
+
+/**
+ * @brief 入力ごとの統計とISRの最悪時間を表示
+ */
+void drv_debounce_show_stat(void)
+{
+    uint32_t cyc_per_us = clock_get_hz(clk_sys) / 1000000;
+
+    if (!s_is_init) {
+        printf("Error: Debounce is not running on Core %d\n", EVENT_CORE_NUM);
+        return;
+    }
+
+    printf("\n[Debounce Stat]\n");
+    printf("Id Name       GPIO  Window(us) Level   Edges Bounces Glitches  Events  Lat avg(us)  Lat max(us)\n");
+    for (uint32_t i = 0; i < s_in_cnt; i++)
+    {
+        const debounce_in_t *p_in = &s_in[i];
+
+        printf("%2u %-10s %4u %11u %-5s %7u %7u %8u %7u %12u %12u\n",
+                i, p_in->p_name, p_in->pin, p_in->window_us, p_in->level ? "High" : "Low",
+                p_in->edge_cnt, p_in->bounce_cnt, p_in->glitch_cnt, p_in->event_cnt,
+                (p_in->event_cnt != 0) ? (uint32_t)(p_in->lat_sum_us / p_in->event_cnt) : 0,
+                p_in->lat_max_us);
+    }
+
+    printf("GPIO ISR  : %u calls, avg %u cyc, worst %u cyc (%u us)\n", s_gpio_isr.cnt,
+            (s_gpio_isr.cnt != 0) ? (uint32_t)(s_gpio_isr.sum_cyc / s_gpio_isr.cnt) : 0,
+            s_gpio_isr.max_cyc, s_gpio_isr.max_cyc / cyc_per_us);
+    printf("Alarm ISR : %u calls, avg %u cyc, worst %u cyc (%u us)\n", s_alarm_isr.cnt,
+            (s_alarm_isr.cnt != 0) ? (uint32_t)(s_alarm_isr.sum_cyc / s_alarm_isr.cnt) : 0,
+            s_alarm_isr.max_cyc, s_alarm_isr.max_cyc / cyc_per_us);
+    printf("Queue     : max depth %u/%d, worst wait %u us, dropped %u, alarm errors %u\n",
+            s_q_max, DEBOUNCE_QUEUE_LEN, s_q_wait_max_us, s_drop_cnt, s_alarm_err_cnt);
+}
+
+/**
+ * @brief 統計のクリア
+ */
+void drv_debounce_clear_stat(void)
+{
+    uint32_t irq = save_and_disable_interrupts();
+
+    for (uint32_t i = 0; i < s_in_cnt; i++)
+    {
+        s_in[i].edge_cnt = 0;
+        s_in[i].bounce_cnt = 0;
+        s_in[i].glitch_cnt = 0;
+        s_in[i].event_cnt = 0;
+        s_in[i].lat_sum_us = 0;
+        s_in[i].lat_max_us = 0;
+    }
+    memset(&s_gpio_isr, 0, sizeof(s_gpio_isr));
+    memset(&s_alarm_isr, 0, sizeof(s_alarm_isr));
+    s_q_max = 0;
+    s_q_wait_max_us = 0;
+    s_drop_cnt = 0;
+    s_alarm_err_cnt = 0;
+    restore_interrupts(irq);
+}
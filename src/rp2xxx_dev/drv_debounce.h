@@ -0,0 +1,45 @@
+/**
+ * @file drv_debounce.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief GPIO入力のチャタリング除去(エッジ割り込み + タイマーアラーム)のヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026 Chimipupu All Rights Reserved.
+ *
+ */
+#ifndef DRV_DEBOUNCE_H
+#define DRV_DEBOUNCE_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "pico/stdlib.h"
+
+#define DEBOUNCE_MAX            8       // 登録できる入力の最大数
+#define DEBOUNCE_QUEUE_LEN      32      // 確定イベントのキュー長(2のべき乗)
+#define DEBOUNCE_DEFAULT_US     30000   // 既定の安定待ち時間(最後のエッジからこの時間変化が無ければ確定)
+
+// 入力のプル
+typedef enum {
+    DEBOUNCE_PULL_NONE,
+    DEBOUNCE_PULL_UP,
+    DEBOUNCE_PULL_DOWN,
+} debounce_pull_t;
+
+// 確定イベントのハンドラ(Core0のイベントループ = スレッド文脈から呼ばれる)
+// level ... 確定したレベル、edge_us ... 最初のエッジの時刻(time_us_32)
+typedef void (*debounce_handler_t)(int32_t id, bool level, uint32_t edge_us);
+
+// 関数プロトタイプ
+void drv_debounce_init(void);
+int32_t drv_debounce_add(const char *p_name, uint pin, uint32_t window_us,
+                         debounce_pull_t pull, debounce_handler_t p_handler);
+void drv_debounce_arm(void);
+bool drv_debounce_sim(uint pin, uint32_t bounce_cnt);
+void drv_debounce_show_stat(void);
+void drv_debounce_clear_stat(void);
+
+#endif // DRV_DEBOUNCE_H
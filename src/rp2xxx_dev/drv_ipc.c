@@ -0,0 +1,543 @@
+/**
+ * @file drv_ipc.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief コア間メッセージキュー(共有SRAMのSPSCリング)ドライバ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026 Chimipupu All Rights Reserved.
+ *
+ * 送信元コアごとに1本のリング(Core0->Core1, Core1->Core0)を持ち、
+ * 書き込み位置は送信側、読み出し位置は受信側だけが更新する(ロック不要)。
+ * 各コアの送信はスレッド文脈の1箇所から行うこと(割り込みからの送信は不可)。
+ * 空のリングに書いたときだけ相手コアを起こす。
+ *   RP2350 ... SIO DOORBELL割り込み
+ *   RP2040 ... SEV(受信側はWFEで待つ)
+ */
+#include "drv_ipc.h"
+#include "muc_rpxxx_util.h"
+#include "pico/multicore.h"
+#include "hardware/irq.h"
+
+#define IPC_ALIGN(len)          (((len) + 3u) & ~3u)
+#define IPC_RING_MASK           (IPC_RING_SIZE - 1u)
+#define IPC_SERVER_TIMEOUT_US   1000000 // サーバが受信を待つ最大時間
+#define IPC_CLIENT_TIMEOUT_US   1000000 // ベンチ/テストで進捗が無いときのタイムアウト
+#define IPC_RTT_CNT             1000    // 往復レイテンシの測定回数
+
+// 1方向のリング
+typedef struct {
+    volatile uint32_t wr;   // 書き込み位置(送信側、フリーラン)
+    volatile uint32_t rd;   // 読み出し位置(受信側、フリーラン)
+    ipc_stat_t stat;
+    uint32_t buf[IPC_RING_SIZE / sizeof(uint32_t)];
+} ipc_ring_t;
+
+// [送信元コア]
+static ipc_ring_t s_ring[2];
+static ipc_rx_callback_t s_p_rx_callback[2] = {NULL, NULL};
+#if defined(MCU_RP2350)
+static int32_t s_doorbell = -1;
+#endif
+
+static inline uint8_t *ipc_ring_ptr(ipc_ring_t *p_ring, uint32_t pos)
+{
+    return (uint8_t *)p_ring->buf + (pos & IPC_RING_MASK);
+}
+
+// 相手コアを起こす
+static inline void ipc_notify(void)
+{
+#if defined(MCU_RP2350)
+    multicore_doorbell_set_other_core((uint)s_doorbell);
+#else
+    __sev();
+#endif
+}
+
+#if defined(MCU_RP2350)
+static void ipc_doorbell_irq_handler(void)
+{
+    uint32_t core = get_core_num();
+
+    multicore_doorbell_clear_current_core((uint)s_doorbell);
+    if (s_p_rx_callback[core] != NULL) {
+        s_p_rx_callback[core]();
+    }
+}
+#endif
+
+/**
+ * @brief コア間メッセージキューの初期化(Core1の起動前に1回だけ呼ぶ)
+ */
+void drv_ipc_init(void)
+{
+    memset(s_ring, 0, sizeof(s_ring));
+#if defined(MCU_RP2350)
+    if (s_doorbell < 0) {
+        s_doorbell = multicore_doorbell_claim_unused((1u << NUM_CORES) - 1u, true);
+    }
+#endif
+}
+
+/**
+ * @brief 呼び出したコアの受信通知を有効化(各コアで呼ぶ)
+ *
+ * @param p_callback 受信時のコールバック(不要ならNULL)
+ */
+void drv_ipc_core_init(ipc_rx_callback_t p_callback)
+{
+    s_p_rx_callback[get_core_num()] = p_callback;
+#if defined(MCU_RP2350)
+    // 初期化前に鳴ったベルは消さない(有効化した時点で割り込みが入る)
+    irq_set_exclusive_handler(multicore_doorbell_irq_num((uint)s_doorbell), ipc_doorbell_irq_handler);
+    irq_set_enabled(multicore_doorbell_irq_num((uint)s_doorbell), true);
+
+    // 送信側は空 -> 非空でしかベルを鳴らさないので、溜まっていれば自分で鳴らし直す
+    if (drv_ipc_peek() != NULL) {
+        multicore_doorbell_set_current_core((uint)s_doorbell);
+    }
+#endif
+}
+
+/**
+ * @brief 相手コアへメッセージを送信(ノンブロッキング)
+ *
+ * @param type メッセージの種類
+ * @param p_data ペイロード(lenが0ならNULL可)
+ * @param len ペイロード長(IPC_MSG_MAX_LEN以下)
+ * @return true 送信した
+ * @return false リングが満杯 or 長さエラー
+ */
+bool drv_ipc_send(uint16_t type, const void *p_data, uint16_t len)
+{
+    ipc_ring_t *p_ring = &s_ring[get_core_num()];
+    uint32_t need = IPC_MSG_HDR_SIZE + IPC_ALIGN(len);
+    uint32_t wr = p_ring->wr;
+    uint32_t tail = IPC_RING_SIZE - (wr & IPC_RING_MASK);
+    uint32_t skip = (need > tail) ? tail : 0;
+    ipc_msg_t *p_msg;
+
+    if ((len > IPC_MSG_MAX_LEN) || ((skip + need) > (IPC_RING_SIZE - (wr - p_ring->rd)))) {
+        p_ring->stat.full_cnt += (len <= IPC_MSG_MAX_LEN) ? 1 : 0;
+        return false;
+    }
+
+    // 末尾に収まらなければ読み飛ばし印を置いて先頭から書く
+    if (skip != 0) {
+        ((ipc_msg_t *)ipc_ring_ptr(p_ring, wr))->type = IPC_MSG_WRAP;
+        wr += skip;
+    }
+
+    p_msg = (ipc_msg_t *)ipc_ring_ptr(p_ring, wr);
+    p_msg->type = type;
+    p_msg->len = len;
+    if (len != 0) {
+        memcpy(p_msg->data, p_data, len);
+    }
+
+    __mem_fence_release();
+    p_ring->wr = wr + need;
+    p_ring->stat.send_cnt++;
+    p_ring->stat.send_bytes += len;
+
+    // 受信側が空を見て眠る前に必ず起こす(wrの公開とrdの読み出しの順序を保証)
+    __dmb();
+    if (p_ring->rd == (wr - skip)) {
+        p_ring->stat.bell_cnt++;
+        ipc_notify();
+    }
+
+    return true;
+}
+
+/**
+ * @brief 相手コアへ処理コード(FIFOコード互換)を送信
+ *
+ * @param code 処理コード(PROC_xxx)
+ * @return true 送信した
+ * @return false リングが満杯
+ */
+bool drv_ipc_send_code(uint32_t code)
+{
+    return drv_ipc_send(IPC_MSG_CODE, &code, sizeof(code));
+}
+
+/**
+ * @brief 相手コアからの先頭メッセージを参照(コピーしない)
+ *
+ * @return const ipc_msg_t* メッセージ、空ならNULL ※drv_ipc_pop()までリング上で有効
+ */
+const ipc_msg_t *drv_ipc_peek(void)
+{
+    ipc_ring_t *p_ring = &s_ring[get_core_num() ^ 1u];
+    uint32_t rd = p_ring->rd;
+    const ipc_msg_t *p_msg;
+
+    while (rd != p_ring->wr)
+    {
+        __mem_fence_acquire();
+        p_msg = (const ipc_msg_t *)ipc_ring_ptr(p_ring, rd);
+        if (p_msg->type != IPC_MSG_WRAP) {
+            return p_msg;
+        }
+        rd += IPC_RING_SIZE - (rd & IPC_RING_MASK);
+        __mem_fence_release();
+        p_ring->rd = rd;
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief drv_ipc_peek()で参照した先頭メッセージを捨てる
+ */
+void drv_ipc_pop(void)
+{
+    ipc_ring_t *p_ring = &s_ring[get_core_num() ^ 1u];
+    const ipc_msg_t *p_msg = (const ipc_msg_t *)ipc_ring_ptr(p_ring, p_ring->rd);
+    uint32_t rd = p_ring->rd + IPC_MSG_HDR_SIZE + IPC_ALIGN(p_msg->len);
+
+    __mem_fence_release();
+    p_ring->rd = rd;
+    p_ring->stat.recv_cnt++;
+}
+
+/**
+ * @brief 相手コアからのメッセージをWFEで待つ
+ *
+ * @param timeout_us タイムアウト(us)
+ * @return true メッセージあり
+ * @return false タイムアウト
+ */
+bool drv_ipc_wait(uint32_t timeout_us)
+{
+    absolute_time_t timeout = make_timeout_time_us(timeout_us);
+
+    while (drv_ipc_peek() == NULL)
+    {
+        if (absolute_time_diff_us(get_absolute_time(), timeout) <= 0) {
+            return false;
+        }
+        __wfe();
+    }
+
+    return true;
+}
+
+/**
+ * @brief 送信元コアごとの統計を取得
+ *
+ * @param core 送信元コア
+ * @param p_stat 統計の格納先
+ */
+void drv_ipc_get_stat(uint32_t core, ipc_stat_t *p_stat)
+{
+    memcpy(p_stat, &s_ring[core & 1u].stat, sizeof(ipc_stat_t));
+}
+
+/**
+ * @brief ベンチ/テストの応答側(Core0がPROC_IPC_SERVERで呼ぶ)
+ *
+ * PINGはPONGで返し、BENCHは数えてチェックサムを取り、TESTは検査して送り返す。
+ * ENDを受けたらRESULT(受信数, チェックサム, エラー数)を返して戻る。
+ */
+void drv_ipc_server(void)
+{
+    const ipc_msg_t *p_msg;
+    uint32_t result[3] = {0, 0, 0};     // [0]受信数, [1]チェックサム, [2]エラー数
+
+    while (drv_ipc_wait(IPC_SERVER_TIMEOUT_US))
+    {
+        p_msg = drv_ipc_peek();
+        switch (p_msg->type)
+        {
+            case IPC_MSG_PING:
+                while (!drv_ipc_send(IPC_MSG_PONG, p_msg->data, p_msg->len))
+                {
+                    tight_loop_contents();
+                }
+                break;
+
+            case IPC_MSG_BENCH:
+                result[0]++;
+                result[1] += p_msg->len;
+                if (p_msg->len >= sizeof(uint32_t)) {
+                    uint32_t seq;
+                    memcpy(&seq, p_msg->data, sizeof(seq));
+                    result[1] += seq;
+                }
+                break;
+
+            case IPC_MSG_TEST:
+                // ペイロードは(長さ + 位置)の連番
+                result[0]++;
+                for (uint32_t i = 0; i < p_msg->len; i++)
+                {
+                    if (p_msg->data[i] != (uint8_t)(p_msg->len + i)) {
+                        result[2]++;
+                        break;
+                    }
+                }
+                while (!drv_ipc_send(IPC_MSG_TEST, p_msg->data, p_msg->len))
+                {
+                    tight_loop_contents();
+                }
+                break;
+
+            case IPC_MSG_END:
+                drv_ipc_pop();
+                while (!drv_ipc_send(IPC_MSG_RESULT, result, sizeof(result)))
+                {
+                    tight_loop_contents();
+                }
+                return;
+
+            default:
+                break;
+        }
+        drv_ipc_pop();
+        WDT_RST();
+    }
+}
+
+// ベンチ/テストの進捗タイムアウト(進捗があればtimeoutを延長する)
+static bool ipc_is_stall(absolute_time_t *p_timeout, bool is_progress)
+{
+    if (is_progress) {
+        *p_timeout = make_timeout_time_us(IPC_CLIENT_TIMEOUT_US);
+        return false;
+    }
+
+    return absolute_time_diff_us(get_absolute_time(), *p_timeout) <= 0;
+}
+
+// 応答側を起動する(前回の残りは捨てる)
+// ※起動コードもリングで送り、後続のメッセージより先に届くことを保証する
+static bool ipc_server_start(void)
+{
+    while (drv_ipc_peek() != NULL)
+    {
+        drv_ipc_pop();
+    }
+
+    return drv_ipc_send_code(PROC_IPC_SERVER);
+}
+
+// ENDを送ってRESULTを受け取る
+static bool ipc_server_end(uint32_t *p_result)
+{
+    absolute_time_t timeout = make_timeout_time_us(IPC_CLIENT_TIMEOUT_US);
+    const ipc_msg_t *p_msg;
+
+    while (!drv_ipc_send(IPC_MSG_END, NULL, 0))
+    {
+        if (ipc_is_stall(&timeout, false)) {
+            return false;
+        }
+        tight_loop_contents();
+    }
+
+    while (drv_ipc_wait(IPC_CLIENT_TIMEOUT_US))
+    {
+        p_msg = drv_ipc_peek();
+        if ((p_msg->type == IPC_MSG_RESULT) && (p_msg->len == (sizeof(uint32_t) * 3))) {
+            memcpy(p_result, p_msg->data, sizeof(uint32_t) * 3);
+            drv_ipc_pop();
+            return true;
+        }
+        drv_ipc_pop();
+    }
+
+    return false;
+}
+
+/**
+ * @brief スループットと往復レイテンシのベンチマーク(Core1から呼ぶ)
+ *
+ * @param cnt スループット測定のメッセージ数
+ * @param size 1メッセージのペイロード長(Byte)
+ * @return true 成功
+ * @return false 応答なし or 結果不一致
+ */
+bool drv_ipc_bench(uint32_t cnt, uint16_t size)
+{
+    ipc_ring_t *p_ring = &s_ring[get_core_num()];
+    uint8_t buf[IPC_MSG_MAX_LEN];
+    uint32_t result[3];
+    uint32_t sum = 0;
+    uint32_t full_cnt = p_ring->stat.full_cnt;
+    uint32_t bell_cnt = p_ring->stat.bell_cnt;
+    uint32_t t0_us, proc_time_us;
+    uint32_t t0_cyc, cyc, cyc_min = UINT32_MAX, cyc_max = 0;
+    uint64_t cyc_sum = 0;
+    uint32_t cyc_per_us = clock_get_hz(clk_sys) / 1000000;
+    absolute_time_t timeout = make_timeout_time_us(IPC_CLIENT_TIMEOUT_US);
+
+    if (size > IPC_MSG_MAX_LEN) {
+        printf("Error: Message size must be <= %u\n", IPC_MSG_MAX_LEN);
+        return false;
+    }
+
+    for (uint32_t i = 0; i < size; i++)
+    {
+        buf[i] = (uint8_t)i;
+    }
+    if (!ipc_server_start()) {
+        printf("Error: Message queue to Core %u is full\n", get_core_num() ^ 1u);
+        return false;
+    }
+
+    // スループット(相手コアが全て読み終えるまで)
+    t0_us = time_us_32();
+    for (uint32_t i = 0; i < cnt; i++)
+    {
+        if (size >= sizeof(uint32_t)) {
+            memcpy(buf, &i, sizeof(i));
+            sum += i;
+        }
+        sum += size;
+        while (!drv_ipc_send(IPC_MSG_BENCH, buf, size))
+        {
+            if (ipc_is_stall(&timeout, false)) {
+                printf("Error: No response from Core 0 (busy?)\n");
+                return false;
+            }
+        }
+        ipc_is_stall(&timeout, true);
+    }
+    while (p_ring->rd != p_ring->wr)
+    {
+        if (ipc_is_stall(&timeout, false)) {
+            printf("Error: No response from Core 0 (busy?)\n");
+            return false;
+        }
+    }
+    proc_time_us = time_us_32() - t0_us;
+
+    printf("\n[IPC Bench] Core %u -> Core %u, %u msgs x %u bytes\n", get_core_num(), get_core_num() ^ 1u, cnt, size);
+    printf("Throughput : %u msgs/s, %u KB/s (proc time: %u us, full:%u, bell:%u)\n",
+            (proc_time_us != 0) ? (uint32_t)(((uint64_t)cnt * 1000000u) / proc_time_us) : 0,
+            (proc_time_us != 0) ? (uint32_t)(((uint64_t)cnt * size * 1000000u) / 1024u / proc_time_us) : 0,
+            proc_time_us,
+            p_ring->stat.full_cnt - full_cnt,
+            p_ring->stat.bell_cnt - bell_cnt);
+
+    // 往復レイテンシ(PING -> PONG)
+    for (uint32_t i = 0; i < IPC_RTT_CNT; i++)
+    {
+        t0_cyc = rp2xxx_get_cycle_cnt();
+        drv_ipc_send(IPC_MSG_PING, &i, sizeof(i));
+        if (!drv_ipc_wait(IPC_CLIENT_TIMEOUT_US) || (drv_ipc_peek()->type != IPC_MSG_PONG)) {
+            printf("Error: No PONG from Core 0\n");
+            return false;
+        }
+        cyc = rp2xxx_get_cycle_cnt() - t0_cyc;
+        drv_ipc_pop();
+
+        cyc_sum += cyc;
+        cyc_min = (cyc < cyc_min) ? cyc : cyc_min;
+        cyc_max = (cyc > cyc_max) ? cyc : cyc_max;
+    }
+    cyc = (uint32_t)(cyc_sum / IPC_RTT_CNT);
+    printf("RTT        : min %u / avg %u / max %u cycles (avg %u.%02u us, %u pings)\n",
+            cyc_min, cyc, cyc_max, cyc / cyc_per_us, ((cyc % cyc_per_us) * 100u) / cyc_per_us, IPC_RTT_CNT);
+
+    if (!ipc_server_end(result)) {
+        printf("Error: No result from Core 0\n");
+        return false;
+    }
+    printf("Verify     : %s (recv:%u/%u, sum:0x%08X/0x%08X)\n",
+            ((result[0] == cnt) && (result[1] == sum)) ? "OK" : "NG", result[0], cnt, result[1], sum);
+
+    return (result[0] == cnt) && (result[1] == sum);
+}
+
+// テストのメッセージ長(xorshift32)
+static uint16_t ipc_test_len(uint32_t *p_seed)
+{
+    *p_seed ^= *p_seed << 13;
+    *p_seed ^= *p_seed >> 17;
+    *p_seed ^= *p_seed << 5;
+
+    return (uint16_t)(*p_seed % (IPC_MSG_MAX_LEN + 1));
+}
+
+/**
+ * @brief ランダム長のメッセージを往復させて検査する自己テスト(Core1から呼ぶ)
+ *
+ * 送信と受信を並行させてリングの折り返し/満杯を通す。
+ *
+ * @param cnt メッセージ数
+ * @return true 成功
+ * @return false 不一致 or 応答なし
+ */
+bool drv_ipc_self_test(uint32_t cnt)
+{
+    uint8_t buf[IPC_MSG_MAX_LEN];
+    uint32_t tx_seed = 0x1234ABCD;
+    uint32_t rx_seed = tx_seed;
+    uint32_t tx_cnt = 0, rx_cnt = 0, err = 0;
+    uint32_t result[3];
+    uint16_t len = ipc_test_len(&tx_seed);
+    uint16_t rx_len;
+    const ipc_msg_t *p_msg;
+    absolute_time_t timeout = make_timeout_time_us(IPC_CLIENT_TIMEOUT_US);
+    bool is_progress;
+
+    if (!ipc_server_start()) {
+        printf("Error: Message queue to Core %u is full\n", get_core_num() ^ 1u);
+        return false;
+    }
+
+    while (rx_cnt < cnt)
+    {
+        is_progress = false;
+
+        if (tx_cnt < cnt) {
+            for (uint32_t i = 0; i < len; i++)
+            {
+                buf[i] = (uint8_t)(len + i);
+            }
+            if (drv_ipc_send(IPC_MSG_TEST, buf, len)) {
+                tx_cnt++;
+                len = ipc_test_len(&tx_seed);
+                is_progress = true;
+            }
+        }
+
+        p_msg = drv_ipc_peek();
+        if (p_msg != NULL) {
+            rx_len = ipc_test_len(&rx_seed);
+            if ((p_msg->type != IPC_MSG_TEST) || (p_msg->len != rx_len)) {
+                err++;
+            } else {
+                for (uint32_t i = 0; i < rx_len; i++)
+                {
+                    if (p_msg->data[i] != (uint8_t)(rx_len + i)) {
+                        err++;
+                        break;
+                    }
+                }
+            }
+            drv_ipc_pop();
+            rx_cnt++;
+            is_progress = true;
+        }
+
+        if (ipc_is_stall(&timeout, is_progress)) {
+            printf("Error: No response from Core 0 (tx:%u, rx:%u)\n", tx_cnt, rx_cnt);
+            return false;
+        }
+    }
+
+    if (!ipc_server_end(result)) {
+        printf("Error: No result from Core 0\n");
+        return false;
+    }
+    printf("[IPC Test] %u msgs (0..%u bytes) : %s (Core %u recv:%u err:%u, Core %u err:%u)\n",
+            cnt, IPC_MSG_MAX_LEN, ((err == 0) && (result[0] == cnt) && (result[2] == 0)) ? "OK" : "NG",
+            get_core_num() ^ 1u, result[0], result[2], get_core_num(), err);
+
+    return (err == 0) && (result[0] == cnt) && (result[2] == 0);
+}
@@ -0,0 +1,70 @@
+/**
+ * @file drv_ipc.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief コア間メッセージキュー(共有SRAMのSPSCリング)ドライバのヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026 Chimipupu All Rights Reserved.
+ *
+ */
+#ifndef DRV_IPC_H
+#define DRV_IPC_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "pico/stdlib.h"
+
+#define IPC_RING_SIZE           4096    // 1方向あたりのリングサイズ(Byte) ※2のべき乗
+#define IPC_MSG_MAX_LEN         256     // メッセージのペイロードの最大長(Byte)
+#define IPC_MSG_HDR_SIZE        4       // メッセージヘッダのサイズ(Byte)
+
+// メッセージの種類
+typedef enum {
+    IPC_MSG_WRAP = 0,       // (内部用)リング末尾の読み飛ばし
+    IPC_MSG_CODE,           // 32bitの処理コード(FIFOコード互換)
+    IPC_MSG_PING,           // 往復レイテンシ測定の要求
+    IPC_MSG_PONG,           // 往復レイテンシ測定の応答(PINGのペイロードをそのまま返す)
+    IPC_MSG_BENCH,          // スループット測定のデータ
+    IPC_MSG_TEST,           // 自己テストのデータ(受信側が検査して送り返す)
+    IPC_MSG_END,            // ベンチ/テストの終了要求
+    IPC_MSG_RESULT,         // ベンチ/テストの結果
+    IPC_MSG_USER,           // ここからアプリ定義
+} ipc_msg_type_t;
+
+// メッセージ(ヘッダ + 4Byte境界に切り上げたペイロード)
+typedef struct {
+    uint16_t type;          // ipc_msg_type_t
+    uint16_t len;           // ペイロード長(Byte)
+    uint8_t data[];         // ペイロード
+} ipc_msg_t;
+
+// 1方向の統計
+typedef struct {
+    uint32_t send_cnt;      // 送信数
+    uint32_t send_bytes;    // 送信ペイロードの総Byte数
+    uint32_t full_cnt;      // 満杯で送信できなかった回数
+    uint32_t bell_cnt;      // 相手コアを起こした回数
+    uint32_t recv_cnt;      // 受信数
+} ipc_stat_t;
+
+// 受信時のコールバック(Doorbell割り込みの中から呼ばれる)
+typedef void (*ipc_rx_callback_t)(void);
+
+// 関数プロトタイプ
+void drv_ipc_init(void);
+void drv_ipc_core_init(ipc_rx_callback_t p_callback);
+bool drv_ipc_send(uint16_t type, const void *p_data, uint16_t len);
+bool drv_ipc_send_code(uint32_t code);
+const ipc_msg_t *drv_ipc_peek(void);
+void drv_ipc_pop(void);
+bool drv_ipc_wait(uint32_t timeout_us);
+void drv_ipc_get_stat(uint32_t core, ipc_stat_t *p_stat);
+void drv_ipc_server(void);
+bool drv_ipc_bench(uint32_t cnt, uint16_t size);
+bool drv_ipc_self_test(uint32_t cnt);
+
+#endif // DRV_IPC_H
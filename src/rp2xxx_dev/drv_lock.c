@@ -0,0 +1,693 @@
+/**
+ * @file drv_lock.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief コア間のロック(チケット/リーダーライター/シーケンス)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026 Chimipupu All Rights Reserved.
+ *
+ * どのロックも内部状態の更新だけをH/Wスピンロック(SIO)で守り、待ちはその外でスピンする。
+ * (H/Wスピンロックを握ったまま待たないので、相手コアの割り込み禁止時間が延びない)
+ * RP2040(Cortex-M0+)はLDREX/STREXが無いので、アトミック命令は使わない。
+ * チケット/リーダーライターはスレッド文脈専用(同じコアのISRから取ると自己デッドロック)。
+ * シーケンスロックの書き込みは割り込み禁止で行うので、読み出しはISRからも可。
+ */
+#include "drv_lock.h"
+#include "muc_rpxxx_util.h"
+#include "drv_ipc.h"
+
+// ベンチマークの種類(Core1の操作 / Core0の競合相手の操作)
+typedef enum {
+    LOCK_BENCH_HW,          // H/Wスピンロック単体 / 同じ
+    LOCK_BENCH_TICKET,      // チケット / 同じ
+    LOCK_BENCH_RW_READ,     // RWの読み出し / RWの書き込み
+    LOCK_BENCH_RW_WRITE,    // RWの書き込み / RWの書き込み
+    LOCK_BENCH_SEQ_READ,    // シーケンスの読み出し / シーケンスの書き込み
+    LOCK_BENCH_SEQ_WRITE,   // シーケンスの書き込み / シーケンスの書き込み
+    LOCK_BENCH_KIND_NUM,
+} lock_bench_kind_t;
+
+// 相手コア(Core0)の負荷
+typedef enum {
+    LOCK_LOAD_NONE,         // 競合なし(Core0はイベントループで眠る)
+    LOCK_LOAD_LIGHT,        // 取得の間にLOCK_LIGHT_GAP_US空ける
+    LOCK_LOAD_HEAVY,        // 取得/解放を連続
+    LOCK_LOAD_TEST,         // 自己テスト(回数分の更新)
+    LOCK_LOAD_NUM,
+} lock_load_t;
+
+// Core0の競合相手/自己テストとの共有
+typedef struct {
+    volatile uint32_t kind;
+    volatile uint32_t load;
+    volatile uint32_t cnt;              // 自己テストの回数
+    volatile bool is_ready;
+    volatile bool is_stop;
+    volatile bool is_done;
+    volatile uint32_t op_cnt;           // Core0が取得した回数
+} lock_bench_t;
+
+static const char *s_p_type_str[] = {"ticket", "rw", "seq"};
+static const char *s_p_bench_str[] = {"hw", "ticket", "rw-rd", "rw-wr", "seq-rd", "seq-wr"};
+static const char *s_p_load_str[] = {"none", "light", "heavy"};
+
+static lock_hdr_t *s_p_lock_tbl[LOCK_MAX];
+static uint32_t s_lock_cnt = 0;
+
+// ベンチマーク/自己テスト用
+static lock_bench_t s_bench;
+static lock_ticket_t s_bench_ticket;
+static lock_rw_t s_bench_rw;
+static lock_seq_t s_bench_seq;
+static spin_lock_t *s_p_bench_hw = NULL;
+static bool s_is_bench_init = false;
+static volatile uint32_t s_bench_counter = 0;       // ロックで守る共有変数
+static volatile uint32_t s_bench_pair[2] = {0, 0};  // シーケンスロックで守る([1] == ~[0])
+
+static bool lock_hdr_init(lock_hdr_t *p_hdr, lock_type_t type, const char *p_name)
+{
+    int32_t hw = spin_lock_claim_unused(false);
+
+    if (hw < 0) {
+        printf("Error: No free H/W spinlock for '%s'\n", p_name);
+        return false;
+    }
+
+    memset(p_hdr, 0, sizeof(lock_hdr_t));
+    p_hdr->p_name = p_name;
+    p_hdr->type = type;
+    p_hdr->p_hw = spin_lock_instance((uint)hw);
+    if (s_lock_cnt < LOCK_MAX) {
+        s_p_lock_tbl[s_lock_cnt++] = p_hdr;
+    }
+
+    return true;
+}
+
+static inline lock_stat_t *lock_stat(lock_hdr_t *p_hdr, uint32_t rw)
+{
+    return &p_hdr->stat[get_core_num()][rw];
+}
+
+static inline void lock_stat_wait(lock_stat_t *p_stat, uint32_t wait_cyc)
+{
+    p_stat->contend_cnt++;
+    p_stat->wait_cyc += wait_cyc;
+    p_stat->wait_max_cyc = (wait_cyc > p_stat->wait_max_cyc) ? wait_cyc : p_stat->wait_max_cyc;
+}
+
+/**
+ * @brief チケットロックの初期化(使う前に1回だけ)
+ *
+ * @param p_lock ロック
+ * @param p_name 統計の表示名
+ * @return true 成功
+ * @return false H/Wスピンロック不足
+ */
+bool drv_lock_ticket_init(lock_ticket_t *p_lock, const char *p_name)
+{
+    p_lock->next = 0;
+    p_lock->owner = 0;
+
+    return lock_hdr_init(&p_lock->hdr, LOCK_TYPE_TICKET, p_name);
+}
+
+/**
+ * @brief チケットロックの取得(到着順)
+ *
+ * @param p_lock ロック
+ */
+void drv_lock_ticket_acquire(lock_ticket_t *p_lock)
+{
+    lock_stat_t *p_stat = lock_stat(&p_lock->hdr, 0);
+    uint32_t irq, ticket, t0_cyc;
+
+    irq = spin_lock_blocking(p_lock->hdr.p_hw);
+    ticket = p_lock->next;
+    p_lock->next = ticket + 1;
+    spin_unlock(p_lock->hdr.p_hw, irq);
+
+    if (p_lock->owner != ticket) {
+        t0_cyc = rp2xxx_get_cycle_cnt();
+        while (p_lock->owner != ticket) {
+            tight_loop_contents();
+        }
+        lock_stat_wait(p_stat, rp2xxx_get_cycle_cnt() - t0_cyc);
+    }
+    __mem_fence_acquire();
+    p_stat->acquire_cnt++;
+}
+
+/**
+ * @brief チケットロックの解放
+ *
+ * @param p_lock ロック
+ */
+void drv_lock_ticket_release(lock_ticket_t *p_lock)
+{
+    // ownerを書くのは所有者だけなのでH/Wスピンロックは不要
+    __mem_fence_release();
+    p_lock->owner = p_lock->owner + 1;
+    __sev();
+}
+
+/**
+ * @brief リーダーライターロックの初期化(使う前に1回だけ)
+ *
+ * @param p_lock ロック
+ * @param p_name 統計の表示名
+ * @return true 成功
+ * @return false H/Wスピンロック不足
+ */
+bool drv_lock_rw_init(lock_rw_t *p_lock, const char *p_name)
+{
+    p_lock->readers = 0;
+    p_lock->write_wait = 0;
+    p_lock->is_writer = false;
+
+    return lock_hdr_init(&p_lock->hdr, LOCK_TYPE_RW, p_name);
+}
+
+/**
+ * @brief 読み出しの取得(他の読み出しとは同時に持てる)
+ *
+ * @param p_lock ロック
+ */
+void drv_lock_rw_read_acquire(lock_rw_t *p_lock)
+{
+    lock_stat_t *p_stat = lock_stat(&p_lock->hdr, 0);
+    uint32_t irq, t0_cyc = 0;
+    bool is_wait = false;
+
+    while (1)
+    {
+        irq = spin_lock_blocking(p_lock->hdr.p_hw);
+        if (!p_lock->is_writer && (p_lock->write_wait == 0)) {
+            p_lock->readers++;
+            spin_unlock(p_lock->hdr.p_hw, irq);
+            break;
+        }
+        spin_unlock(p_lock->hdr.p_hw, irq);
+
+        if (!is_wait) {
+            is_wait = true;
+            t0_cyc = rp2xxx_get_cycle_cnt();
+        }
+        while (p_lock->is_writer || (p_lock->write_wait != 0)) {
+            tight_loop_contents();
+        }
+    }
+
+    if (is_wait) {
+        lock_stat_wait(p_stat, rp2xxx_get_cycle_cnt() - t0_cyc);
+    }
+    __mem_fence_acquire();
+    p_stat->acquire_cnt++;
+}
+
+/**
+ * @brief 読み出しの解放
+ *
+ * @param p_lock ロック
+ */
+void drv_lock_rw_read_release(lock_rw_t *p_lock)
+{
+    uint32_t irq;
+
+    __mem_fence_release();
+    irq = spin_lock_blocking(p_lock->hdr.p_hw);
+    p_lock->readers--;
+    spin_unlock(p_lock->hdr.p_hw, irq);
+}
+
+/**
+ * @brief 書き込みの取得(排他、待っている間は新しい読み出しを止める)
+ *
+ * @param p_lock ロック
+ */
+void drv_lock_rw_write_acquire(lock_rw_t *p_lock)
+{
+    lock_stat_t *p_stat = lock_stat(&p_lock->hdr, 1);
+    uint32_t irq, t0_cyc = 0;
+    bool is_wait = false;
+
+    irq = spin_lock_blocking(p_lock->hdr.p_hw);
+    p_lock->write_wait++;
+    while (p_lock->is_writer || (p_lock->readers != 0))
+    {
+        spin_unlock(p_lock->hdr.p_hw, irq);
+        if (!is_wait) {
+            is_wait = true;
+            t0_cyc = rp2xxx_get_cycle_cnt();
+        }
+        while (p_lock->is_writer || (p_lock->readers != 0)) {
+            tight_loop_contents();
+        }
+        irq = spin_lock_blocking(p_lock->hdr.p_hw);
+    }
+    p_lock->write_wait--;
+    p_lock->is_writer = true;
+    spin_unlock(p_lock->hdr.p_hw, irq);
+
+    if (is_wait) {
+        lock_stat_wait(p_stat, rp2xxx_get_cycle_cnt() - t0_cyc);
+    }
+    __mem_fence_acquire();
+    p_stat->acquire_cnt++;
+}
+
+/**
+ * @brief 書き込みの解放
+ *
+ * @param p_lock ロック
+ */
+void drv_lock_rw_write_release(lock_rw_t *p_lock)
+{
+    uint32_t irq;
+
+    __mem_fence_release();
+    irq = spin_lock_blocking(p_lock->hdr.p_hw);
+    p_lock->is_writer = false;
+    spin_unlock(p_lock->hdr.p_hw, irq);
+}
+
+/**
+ * @brief シーケンスロックの初期化(使う前に1回だけ)
+ *
+ * @param p_lock ロック
+ * @param p_name 統計の表示名
+ * @return true 成功
+ * @return false H/Wスピンロック不足
+ */
+bool drv_lock_seq_init(lock_seq_t *p_lock, const char *p_name)
+{
+    p_lock->seq = 0;
+
+    return lock_hdr_init(&p_lock->hdr, LOCK_TYPE_SEQ, p_name);
+}
+
+/**
+ * @brief 読み出しの開始(書き込み中なら終わるまで待つ)
+ * @note 使い方 ... do { seq = begin(); データをコピー; } while (retry(seq));
+ *
+ * @param p_lock ロック
+ * @return uint32_t drv_lock_seq_read_retry()に渡す番号
+ */
+uint32_t drv_lock_seq_read_begin(lock_seq_t *p_lock)
+{
+    uint32_t seq = p_lock->seq;
+
+    if (seq & 1u) {
+        uint32_t t0_cyc = rp2xxx_get_cycle_cnt();
+        while ((seq = p_lock->seq) & 1u) {
+            tight_loop_contents();
+        }
+        lock_stat_wait(lock_stat(&p_lock->hdr, 0), rp2xxx_get_cycle_cnt() - t0_cyc);
+    }
+    __dmb();
+
+    return seq;
+}
+
+/**
+ * @brief 読み出しの終了判定
+ *
+ * @param p_lock ロック
+ * @param seq drv_lock_seq_read_begin()の戻り値
+ * @return true 読み出し中に書き込みがあった(読み直す)
+ * @return false 読んだデータは一貫している
+ */
+bool drv_lock_seq_read_retry(lock_seq_t *p_lock, uint32_t seq)
+{
+    lock_stat_t *p_stat = lock_stat(&p_lock->hdr, 0);
+
+    __dmb();
+    if (p_lock->seq != seq) {
+        p_stat->contend_cnt++;
+        return true;
+    }
+    p_stat->acquire_cnt++;
+
+    return false;
+}
+
+/**
+ * @brief 書き込みの開始(書き込み同士はH/Wスピンロックで排他、割り込み禁止)
+ *
+ * @param p_lock ロック
+ * @return uint32_t drv_lock_seq_write_end()に渡す割り込み状態
+ */
+uint32_t drv_lock_seq_write_begin(lock_seq_t *p_lock)
+{
+    lock_stat_t *p_stat = lock_stat(&p_lock->hdr, 1);
+    uint32_t irq, t0_cyc;
+
+    if (is_spin_locked(p_lock->hdr.p_hw)) {
+        t0_cyc = rp2xxx_get_cycle_cnt();
+        irq = spin_lock_blocking(p_lock->hdr.p_hw);
+        lock_stat_wait(p_stat, rp2xxx_get_cycle_cnt() - t0_cyc);
+    } else {
+        irq = spin_lock_blocking(p_lock->hdr.p_hw);
+    }
+    p_lock->seq = p_lock->seq + 1;
+    __dmb();
+    p_stat->acquire_cnt++;
+
+    return irq;
+}
+
+/**
+ * @brief 書き込みの終了
+ *
+ * @param p_lock ロック
+ * @param irq drv_lock_seq_write_begin()の戻り値
+ */
+void drv_lock_seq_write_end(lock_seq_t *p_lock, uint32_t irq)
+{
+    __dmb();
+    p_lock->seq = p_lock->seq + 1;
+    spin_unlock(p_lock->hdr.p_hw, irq);
+}
+
+/**
+ * @brief 登録済みロックの統計表示
+ */
+void drv_lock_show_stat(void)
+{
+    printf("\n[Lock Stat] (contended = waited, seq read = retried)\n");
+    printf("Name           Type   Op  Core   Acquired  Contended  Wait avg(cyc)  Wait max(cyc)\n");
+    for (uint32_t i = 0; i < s_lock_cnt; i++)
+    {
+        const lock_hdr_t *p_hdr = s_p_lock_tbl[i];
+
+        for (uint32_t rw = 0; rw < 2; rw++)
+        {
+            for (uint32_t core = 0; core < NUM_CORES; core++)
+            {
+                const lock_stat_t *p_stat = &p_hdr->stat[core][rw];
+                uint32_t waits = p_stat->contend_cnt;
+
+                if ((p_stat->acquire_cnt == 0) && (waits == 0)) {
+                    continue;
+                }
+                printf("%-14s %-6s %-3s %4u %10u %10u %14u %14u\n",
+                        p_hdr->p_name, s_p_type_str[p_hdr->type],
+                        (p_hdr->type == LOCK_TYPE_TICKET) ? "-" : ((rw == 0) ? "rd" : "wr"),
+                        core, p_stat->acquire_cnt, waits,
+                        (waits != 0) ? (uint32_t)(p_stat->wait_cyc / waits) : 0, p_stat->wait_max_cyc);
+            }
+        }
+    }
+}
+
+/**
+ * @brief 登録済みロックの統計クリア
+ */
+void drv_lock_clear_stat(void)
+{
+    for (uint32_t i = 0; i < s_lock_cnt; i++)
+    {
+        memset(s_p_lock_tbl[i]->stat, 0, sizeof(s_p_lock_tbl[i]->stat));
+    }
+}
+
+static bool lock_bench_init(void)
+{
+    int32_t hw;
+
+    if (s_is_bench_init) {
+        return true;
+    }
+
+    hw = spin_lock_claim_unused(false);
+    if ((hw < 0) ||
+        !drv_lock_ticket_init(&s_bench_ticket, "bench-ticket") ||
+        !drv_lock_rw_init(&s_bench_rw, "bench-rw") ||
+        !drv_lock_seq_init(&s_bench_seq, "bench-seq")) {
+        printf("Error: No free H/W spinlock\n");
+        return false;
+    }
+    s_p_bench_hw = spin_lock_instance((uint)hw);
+    s_is_bench_init = true;
+
+    return true;
+}
+
+// 1回の取得 -> 共有変数の更新 -> 解放
+static inline void lock_bench_op(lock_bench_kind_t kind)
+{
+    uint32_t irq, seq, a, b;
+
+    switch (kind)
+    {
+        case LOCK_BENCH_HW:
+            irq = spin_lock_blocking(s_p_bench_hw);
+            s_bench_counter = s_bench_counter + 1;
+            spin_unlock(s_p_bench_hw, irq);
+            break;
+
+        case LOCK_BENCH_TICKET:
+            drv_lock_ticket_acquire(&s_bench_ticket);
+            s_bench_counter = s_bench_counter + 1;
+            drv_lock_ticket_release(&s_bench_ticket);
+            break;
+
+        case LOCK_BENCH_RW_READ:
+            drv_lock_rw_read_acquire(&s_bench_rw);
+            (void)s_bench_counter;
+            drv_lock_rw_read_release(&s_bench_rw);
+            break;
+
+        case LOCK_BENCH_RW_WRITE:
+            drv_lock_rw_write_acquire(&s_bench_rw);
+            s_bench_counter = s_bench_counter + 1;
+            drv_lock_rw_write_release(&s_bench_rw);
+            break;
+
+        case LOCK_BENCH_SEQ_READ:
+            do {
+                seq = drv_lock_seq_read_begin(&s_bench_seq);
+                a = s_bench_pair[0];
+                b = s_bench_pair[1];
+            } while (drv_lock_seq_read_retry(&s_bench_seq, seq));
+            (void)a;
+            (void)b;
+            break;
+
+        default:
+            irq = drv_lock_seq_write_begin(&s_bench_seq);
+            a = s_bench_pair[0] + 1;
+            s_bench_pair[0] = a;
+            s_bench_pair[1] = ~a;
+            drv_lock_seq_write_end(&s_bench_seq, irq);
+            break;
+    }
+}
+
+// Core1の操作に対するCore0の競合相手の操作
+static lock_bench_kind_t lock_bench_rival(lock_bench_kind_t kind)
+{
+    if (kind == LOCK_BENCH_RW_READ) {
+        return LOCK_BENCH_RW_WRITE;
+    } else if (kind == LOCK_BENCH_SEQ_READ) {
+        return LOCK_BENCH_SEQ_WRITE;
+    }
+
+    return kind;
+}
+
+/**
+ * @brief 競合相手/自己テストの相手(Core0がPROC_LOCK_SERVERで呼ぶ)
+ */
+void drv_lock_server(void)
+{
+    lock_bench_kind_t kind = lock_bench_rival((lock_bench_kind_t)s_bench.kind);
+    lock_load_t load = (lock_load_t)s_bench.load;
+    uint32_t op_cnt = 0;
+
+    __mem_fence_release();
+    s_bench.is_ready = true;
+
+    if (load == LOCK_LOAD_TEST) {
+        // チケット/RWの書き込みで共有変数を増やし、シーケンスは対の値を書く
+        for (uint32_t i = 0; i < s_bench.cnt; i++)
+        {
+            lock_bench_op(LOCK_BENCH_TICKET);
+            lock_bench_op(LOCK_BENCH_RW_WRITE);
+            lock_bench_op(LOCK_BENCH_SEQ_WRITE);
+            op_cnt++;
+        }
+    } else {
+        while (!s_bench.is_stop)
+        {
+            lock_bench_op(kind);
+            op_cnt++;
+            if (load == LOCK_LOAD_LIGHT) {
+                busy_wait_us_32(LOCK_LIGHT_GAP_US);
+            }
+        }
+    }
+
+    s_bench.op_cnt = op_cnt;
+    __mem_fence_release();
+    s_bench.is_done = true;
+}
+
+// 競合相手をCore0で起動
+static bool lock_server_start(lock_bench_kind_t kind, lock_load_t load, uint32_t cnt)
+{
+    uint64_t end_us;
+
+    s_bench.kind = (uint32_t)kind;
+    s_bench.load = (uint32_t)load;
+    s_bench.cnt = cnt;
+    s_bench.is_ready = false;
+    s_bench.is_stop = false;
+    s_bench.is_done = false;
+    s_bench.op_cnt = 0;
+    __mem_fence_release();
+
+    if (!drv_ipc_send_code(PROC_LOCK_SERVER)) {
+        printf("Error: Failed to start Core 0 (queue full)\n");
+        return false;
+    }
+
+    end_us = time_us_64() + 1000000;
+    while (!s_bench.is_ready) {
+        if (time_us_64() > end_us) {
+            printf("Error: Core 0 did not respond\n");
+            return false;
+        }
+        tight_loop_contents();
+    }
+
+    return true;
+}
+
+// 競合相手の終了待ち
+static bool lock_server_end(void)
+{
+    uint64_t end_us = time_us_64() + 5000000;
+
+    s_bench.is_stop = true;
+    while (!s_bench.is_done) {
+        if (time_us_64() > end_us) {
+            printf("Error: Core 0 did not finish\n");
+            return false;
+        }
+        tight_loop_contents();
+    }
+    __mem_fence_acquire();
+
+    return true;
+}
+
+/**
+ * @brief 取得 + 解放のコストを競合なし/軽い/重いで計測
+ *
+ * @param cnt 種類/負荷ごとの回数
+ */
+void drv_lock_bench(uint32_t cnt)
+{
+    uint32_t cyc_per_us = clock_get_hz(clk_sys) / 1000000;
+
+    if (!lock_bench_init()) {
+        return;
+    }
+
+    printf("\n[Lock Bench] %u acquire+release on Core 1, %u MHz : avg/max cycles (Core 0 ops)\n",
+            cnt, cyc_per_us);
+    printf("Lock    ");
+    for (uint32_t load = 0; load < LOCK_LOAD_TEST; load++)
+    {
+        printf(" %-24s", s_p_load_str[load]);
+    }
+    printf("\n");
+
+    for (uint32_t kind = 0; kind < LOCK_BENCH_KIND_NUM; kind++)
+    {
+        printf("%-8s", s_p_bench_str[kind]);
+        for (uint32_t load = 0; load < LOCK_LOAD_TEST; load++)
+        {
+            uint64_t sum = 0;
+            uint32_t max = 0, t0_cyc, cyc;
+            char cell[32];
+
+            if ((load != LOCK_LOAD_NONE) && !lock_server_start((lock_bench_kind_t)kind, (lock_load_t)load, 0)) {
+                return;
+            }
+            for (uint32_t i = 0; i < cnt; i++)
+            {
+                t0_cyc = rp2xxx_get_cycle_cnt();
+                lock_bench_op((lock_bench_kind_t)kind);
+                cyc = rp2xxx_get_cycle_cnt() - t0_cyc;
+                sum += cyc;
+                max = (cyc > max) ? cyc : max;
+            }
+            if ((load != LOCK_LOAD_NONE) && !lock_server_end()) {
+                return;
+            }
+
+            snprintf(cell, sizeof(cell), "%u/%u (%u)", (uint32_t)(sum / cnt), max,
+                    (load != LOCK_LOAD_NONE) ? s_bench.op_cnt : 0);
+            printf(" %-24s", cell);
+        }
+        printf("\n");
+    }
+    printf("Contention details: lock stat\n");
+}
+
+/**
+ * @brief 両コアから同時に使って排他/一貫性を検査
+ *
+ * @param cnt 各コアの操作回数
+ * @return true OK
+ */
+bool drv_lock_self_test(uint32_t cnt)
+{
+    uint32_t err = 0, seq, a, b, reads = 0;
+    uint32_t irq;
+
+    if (!lock_bench_init()) {
+        return false;
+    }
+
+    irq = drv_lock_seq_write_begin(&s_bench_seq);
+    s_bench_pair[0] = 0;
+    s_bench_pair[1] = ~0u;
+    drv_lock_seq_write_end(&s_bench_seq, irq);
+    s_bench_counter = 0;
+    if (!lock_server_start(LOCK_BENCH_TICKET, LOCK_LOAD_TEST, cnt)) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < cnt; i++)
+    {
+        lock_bench_op(LOCK_BENCH_TICKET);
+        lock_bench_op(LOCK_BENCH_RW_WRITE);
+
+        // 読み出し中に書き込まれても、読み直した結果は対になっている
+        do {
+            seq = drv_lock_seq_read_begin(&s_bench_seq);
+            a = s_bench_pair[0];
+            b = s_bench_pair[1];
+        } while (drv_lock_seq_read_retry(&s_bench_seq, seq));
+        err += (b != ~a) ? 1 : 0;
+        reads++;
+    }
+
+    // 全件終わるまで待つ(is_stopはテストでは見ない)
+    if (!lock_server_end()) {
+        return false;
+    }
+
+    // チケット + RWの書き込みで各コアcnt x 2回増える
+    err += (s_bench_counter != (cnt * 4u)) ? 1 : 0;
+    err += (s_bench_pair[0] != cnt) ? 1 : 0;
+
+    printf("[Lock Test] %u ops x 2 cores : %s (counter %u/%u, seq reads %u, err %u)\n",
+            cnt, (err == 0) ? "OK" : "NG", s_bench_counter, cnt * 4u, reads, err);
+
+    return (err == 0);
+}
@@ -0,0 +1,89 @@
+/**
+ * @file drv_lock.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief コア間のロック(チケット/リーダーライター/シーケンス)のヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026 Chimipupu All Rights Reserved.
+ *
+ */
+#ifndef DRV_LOCK_H
+#define DRV_LOCK_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+
+#define LOCK_MAX                16      // 統計を表示するロックの最大数
+#define LOCK_LIGHT_GAP_US       5       // 軽い競合 ... 相手コアが取得と取得の間に空ける時間
+
+// ロックの種類
+typedef enum {
+    LOCK_TYPE_TICKET,       // チケットロック(到着順)
+    LOCK_TYPE_RW,           // リーダーライターロック(ライター優先)
+    LOCK_TYPE_SEQ,          // シーケンスロック(読み出しは取得せず、書き込みと重なったら読み直す)
+} lock_type_t;
+
+// 統計(コアごと、読み出し/書き込みごと)
+typedef struct {
+    uint32_t acquire_cnt;   // 取得回数
+    uint32_t contend_cnt;   // 待たされた回数(シーケンスロックの読み出しは読み直し回数)
+    uint64_t wait_cyc;      // 待ちの合計サイクル
+    uint32_t wait_max_cyc;  // 待ちの最大サイクル
+} lock_stat_t;
+
+// 共通部
+typedef struct {
+    const char *p_name;
+    lock_type_t type;
+    spin_lock_t *p_hw;                  // 内部状態の更新に使うH/Wスピンロック
+    lock_stat_t stat[NUM_CORES][2];     // [コア][0 ... 取得/読み出し, 1 ... 書き込み]
+} lock_hdr_t;
+
+// チケットロック ... 番号の発行だけH/Wスピンロックで行い、待ちはロック外でスピン
+typedef struct {
+    lock_hdr_t hdr;
+    volatile uint32_t next;             // 次に発行する番号
+    volatile uint32_t owner;            // 現在の所有者の番号
+} lock_ticket_t;
+
+// リーダーライターロック
+typedef struct {
+    lock_hdr_t hdr;
+    volatile uint32_t readers;          // 読み出し中の数
+    volatile uint32_t write_wait;       // 書き込み待ちの数(いれば新しい読み出しを待たせる)
+    volatile bool is_writer;            // 書き込み中
+} lock_rw_t;
+
+// シーケンスロック ... 奇数の間は書き込み中
+typedef struct {
+    lock_hdr_t hdr;
+    volatile uint32_t seq;
+} lock_seq_t;
+
+// 関数プロトタイプ
+bool drv_lock_ticket_init(lock_ticket_t *p_lock, const char *p_name);
+void drv_lock_ticket_acquire(lock_ticket_t *p_lock);
+void drv_lock_ticket_release(lock_ticket_t *p_lock);
+bool drv_lock_rw_init(lock_rw_t *p_lock, const char *p_name);
+void drv_lock_rw_read_acquire(lock_rw_t *p_lock);
+void drv_lock_rw_read_release(lock_rw_t *p_lock);
+void drv_lock_rw_write_acquire(lock_rw_t *p_lock);
+void drv_lock_rw_write_release(lock_rw_t *p_lock);
+bool drv_lock_seq_init(lock_seq_t *p_lock, const char *p_name);
+uint32_t drv_lock_seq_read_begin(lock_seq_t *p_lock);
+bool drv_lock_seq_read_retry(lock_seq_t *p_lock, uint32_t seq);
+uint32_t drv_lock_seq_write_begin(lock_seq_t *p_lock);
+void drv_lock_seq_write_end(lock_seq_t *p_lock, uint32_t irq);
+void drv_lock_show_stat(void);
+void drv_lock_clear_stat(void);
+void drv_lock_server(void);
+void drv_lock_bench(uint32_t cnt);
+bool drv_lock_self_test(uint32_t cnt);
+
+#endif // DRV_LOCK_H
@@ -9,52 +9,324 @@
  * 
  */
 #include "drv_neopixel.h"
+#include "drv_lock.h"
+#include "muc_rpxxx_util.h"
+#include "hardware/irq.h"
 
 static void pio_neopixel_begin(neopixel_t *p_neopixel, PIO pio, uint sm, uint offset,  uint pin);
-static void set_pio_neopixel_show(neopixel_t *p_neopixel);
+static bool neopixel_commit(neopixel_t *p_neopixel, bool is_force);
+static bool neopixel_commit_dirty(neopixel_t *p_neopixel);
+static void neopixel_set_pixel_rgb(neopixel_t *p_neopixel, uint16_t led, uint8_t red, uint8_t green, uint8_t blue);
+static void neopixel_clear(neopixel_t *p_neopixel);
+static int64_t neopixel_latch_callback(alarm_id_t id, void *p_user_data);
+static void neopixel_tx_arm(void);
 
 neopixel_t *s_p_neopixel;
 static PIO s_pio = pio1;
 static uint s_sm = 0;
 static uint s_offset = 0;
 
+// Core1(シェル)とCore0(フェード)が同じバッファ/PIOを触るので、公開関数はこのロックで排他
+static lock_ticket_t s_neopixel_lock;
+static bool s_is_lock_init = false;
+
+// DMA送信(ダブルバッファ)
+// 送信中でない方のフレームに書いて、送信中なら「保留」にしてラッチ期間の後にアラームから送る。
+// 送信状態はアラーム/DMA割り込みとスレッドの両方が触るのでH/Wスピンロック(割り込み禁止)で守る。
+// フレームはGRBを詰めたバイト列(1LED = 3バイト)で、本数に合わせてヒープに確保する。
+// PIOは自動プル8bitで、DMAの1バイト書き込み(FIFOの全バイトレーンに複製される)の上位8bitから送る。
+// 1フレームはセグメント(区間)の並びで、DMA完了割り込みで次のセグメントを送る(FIFOの8バイト = 80us以内)。
+// コミットは自分のフレーム1区間、ストリームはFlash/PSRAMなどから直接送る区間の並び。
+static uint8_t *s_p_frame[2] = {NULL, NULL};        // PIOへ送るバイト列(GRB)
+static uint32_t s_frame_cap = 0;                    // 確保済みのLED数
+static neopixel_segment_t s_seg[2][NEOPIXEL_SEGMENT_MAX];
+static uint32_t s_seg_cnt[2] = {0, 0};
+static uint32_t s_len[2] = {0, 0};                  // フレームのLED数(全セグメントの合計)
+static volatile uint32_t s_seg_next = 0;            // 送信中のフレームで次に送るセグメント
+static uint32_t s_frame_len = 0;                    // 送信中のフレームのLED数
+static int32_t s_dma_ch = -1;
+static spin_lock_t *s_p_tx_lock = NULL;
+static volatile uint8_t s_tx_idx = 1;               // 最後に送り始めたフレーム
+static volatile bool s_is_tx_busy = false;          // 送信中 or ラッチ期間中
+static volatile bool s_is_tx_pending = false;       // 送信待ちのフレームあり
+static volatile uint32_t s_tx_frame_cnt = 0;        // 送信完了したフレーム数
+static volatile uint32_t s_tx_merge_cnt = 0;        // 送る前に新しいフレームで上書きされた数
+static bool s_is_tx_valid = false;                  // 最後に送ったのがコミットのフレーム(比較できる)
+
+// コミットの統計
+static uint32_t s_commit_cnt = 0;                   // drv_neopixel_commit()の呼び出し数
+static uint32_t s_clean_cnt = 0;                    // 変更が無く送らなかった数
+static uint32_t s_same_cnt = 0;                     // 書いたが最後のフレームと同じで送らなかった数
+static neopixel_done_cb_t s_p_done_cb = NULL;
+
+#define NEOPIXEL_BENCH_SET_MAX  64      // ベンチマークでセッターごとに送るのを測るLEDの数
+#define NEOPIXEL_SCALE_PATTERN  256     // スケール計測でFlashから送る模様のLED数(区間の長さ)
+
+// スケール計測の模様(const = XIPのFlashに置かれ、DMAがFlashから直接読む)
+static const grb24_t s_scale_pattern[NEOPIXEL_SCALE_PATTERN] = {
+    {0, 2, 0}, {0, 0, 2}, {2, 0, 0}, {0, 0, 0},
+};
+
 static void pio_neopixel_begin(neopixel_t *p_neopixel, PIO pio, uint sm, uint offset,  uint pin)
 {
-    pio_neopixel_init(pio, sm, offset, pin, 800000, false);
+    pio_neopixel_packed_init(pio, sm, offset, pin, 800000);
+}
+
+// フレームのDMA送信を開始(s_p_tx_lockを持って呼ぶ)
+static void neopixel_tx_start(uint8_t idx)
+{
+    s_tx_idx = idx;
+    s_is_tx_busy = true;
+    s_is_tx_pending = false;
+    s_frame_len = s_len[idx];
+    s_seg_next = 1;
+    dma_channel_transfer_from_buffer_now((uint)s_dma_ch, s_seg[idx][0].p_grb,
+                                         (uint32_t)s_seg[idx][0].led_cnt * NEOPIXEL_BYTE_PER_LED);
+}
+
+// セグメントの送信完了(DMA割り込み) ... 次のセグメントを続けて送る
+static void neopixel_dma_irq_handler(void)
+{
+    const neopixel_segment_t *p_seg;
+    uint32_t irq;
+
+    if (!dma_channel_get_irq0_status((uint)s_dma_ch)) {
+        return;
+    }
+    dma_channel_acknowledge_irq0((uint)s_dma_ch);
+
+    irq = spin_lock_blocking(s_p_tx_lock);
+    if (s_is_tx_busy && (s_seg_next < s_seg_cnt[s_tx_idx])) {
+        p_seg = &s_seg[s_tx_idx][s_seg_next++];
+        dma_channel_transfer_from_buffer_now((uint)s_dma_ch, p_seg->p_grb,
+                                             (uint32_t)p_seg->led_cnt * NEOPIXEL_BYTE_PER_LED);
+    }
+    spin_unlock(s_p_tx_lock, irq);
+}
+
+// 保留中のフレームを取り消して書き込むフレームの番号を返す(s_p_tx_lockを持って呼ぶ)
+static uint8_t neopixel_tx_back(void)
+{
+    if (s_is_tx_pending) {
+        s_is_tx_pending = false;
+        s_tx_merge_cnt++;
+    }
+
+    return s_tx_idx ^ 1u;
+}
+
+// 書いたフレームを送信開始 or 保留
+static void neopixel_tx_submit(uint8_t back)
+{
+    uint32_t irq;
+    bool is_start;
+
+    irq = spin_lock_blocking(s_p_tx_lock);
+    is_start = !s_is_tx_busy;
+    if (is_start) {
+        neopixel_tx_start(back);
+    } else {
+        s_is_tx_pending = true;
+    }
+    spin_unlock(s_p_tx_lock, irq);
+
+    if (is_start) {
+        neopixel_tx_arm();
+    }
+}
+
+// フレームのバッファをLED数に合わせて確保し直す(送信の完了を待ってから)
+static bool neopixel_frame_alloc(uint32_t led_cnt)
+{
+    uint8_t *p_buf;
+
+    if (led_cnt == s_frame_cap) {
+        return true;
+    }
+    drv_neopixel_wait();
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        p_buf = realloc(s_p_frame[i], led_cnt * NEOPIXEL_BYTE_PER_LED);
+        if (p_buf == NULL) {
+            printf("Error: Failed to allocate NeoPixel frame (%u LEDs)\n", led_cnt);
+            return false;
+        }
+        s_p_frame[i] = p_buf;
+    }
+    s_frame_cap = led_cnt;
+    s_is_tx_valid = false;
+
+    return true;
+}
+
+// ワイヤ上の送信時間 + ラッチ期間の後にアラームを仕掛ける
+static void neopixel_tx_arm(void)
+{
+    if (add_alarm_in_us((uint64_t)s_frame_len * NEOPIXEL_WORD_US + NEOPIXEL_LATCH_US,
+                        neopixel_latch_callback, NULL, true) < 0) {
+        // アラーム不足 ... 次のshow()で送れるように送信状態を戻す
+        uint32_t irq = spin_lock_blocking(s_p_tx_lock);
+        s_is_tx_busy = false;
+        spin_unlock(s_p_tx_lock, irq);
+    }
+}
+
+// ラッチ期間の終わり(アラーム割り込み) ... 完了通知と保留フレームの送信
+static int64_t neopixel_latch_callback(alarm_id_t id, void *p_user_data)
+{
+    uint32_t irq, level, frame_cnt, rest_cnt = 0;
+    bool is_next;
+
+    (void)id;
+    (void)p_user_data;
+
+    // DMA/FIFO/セグメントがまだ残っていたら(他のDMAと帯域を取り合った等)、残り + ラッチ期間で再設定
+    level = pio_sm_get_tx_fifo_level(s_pio, s_sm);
+    for (uint32_t i = s_seg_next; i < s_seg_cnt[s_tx_idx]; i++)
+    {
+        rest_cnt += s_seg[s_tx_idx][i].led_cnt;
+    }
+    if (dma_channel_is_busy((uint)s_dma_ch) || (level != 0) || (rest_cnt != 0)) {
+        return (int64_t)(rest_cnt + 1) * NEOPIXEL_WORD_US + (int64_t)level * (NEOPIXEL_WORD_US / NEOPIXEL_BYTE_PER_LED) +
+               NEOPIXEL_LATCH_US;
+    }
+
+    irq = spin_lock_blocking(s_p_tx_lock);
+    frame_cnt = ++s_tx_frame_cnt;
+    is_next = s_is_tx_pending;
+    if (is_next) {
+        neopixel_tx_start(s_tx_idx ^ 1u);
+    } else {
+        s_is_tx_busy = false;
+    }
+    spin_unlock(s_p_tx_lock, irq);
+
+    if (s_p_done_cb != NULL) {
+        s_p_done_cb(frame_cnt);
+    }
+
+    return is_next ? ((int64_t)s_frame_len * NEOPIXEL_WORD_US + NEOPIXEL_LATCH_US) : 0;
+}
+
+// 画素バッファをフレームにして送信(ブロックしない、送信中なら次のフレームとして保留)
+// 戻り値 ... false = 最後に送ったフレームと同じなので送らなかった(is_forceなら必ず送る)
+static bool neopixel_commit(neopixel_t *p_neopixel, bool is_force)
+{
+    uint32_t irq, len, cur_len;
+    uint8_t back;
+    bool is_same;
+
+    len = (p_neopixel->led_cnt < s_frame_cap) ? p_neopixel->led_cnt : s_frame_cap;
+
+    // 送信中でない方に書く(書いている間に古い保留が送られないよう保留を取り消す)
+    irq = spin_lock_blocking(s_p_tx_lock);
+    back = neopixel_tx_back();
+    cur_len = s_frame_len;
+    spin_unlock(s_p_tx_lock, irq);
+
+    // 画素バッファはワイヤの順に詰めてあるのでコピーだけ
+    memcpy(s_p_frame[back], p_neopixel->p_pixel_buf, len * NEOPIXEL_BYTE_PER_LED);
+
+    // 送信中(or 最後に送った)フレームと同じなら送らない(取り消した保留も同じ表示になる)
+    is_same = !is_force && s_is_tx_valid && (len == cur_len) &&
+              (memcmp(s_p_frame[back], s_p_frame[back ^ 1u], len * NEOPIXEL_BYTE_PER_LED) == 0);
+    if (is_same) {
+        s_same_cnt++;
+        return false;
+    }
+
+    s_seg[back][0].p_grb = (const grb24_t *)s_p_frame[back];
+    s_seg[back][0].led_cnt = (uint16_t)len;
+    s_seg_cnt[back] = 1;
+    s_len[back] = len;
+    s_is_tx_valid = true;
+    neopixel_tx_submit(back);
+
+    return true;
+}
+
+// 変更があればコミット(ロックを取った状態で呼ぶ)
+static bool neopixel_commit_dirty(neopixel_t *p_neopixel)
+{
+    s_commit_cnt++;
+    if (!p_neopixel->is_dirty) {
+        s_clean_cnt++;
+        return false;
+    }
+    p_neopixel->is_dirty = false;
+
+    return neopixel_commit(p_neopixel, false);
 }
 
-static void set_pio_neopixel_show(neopixel_t *p_neopixel)
+// 従来の送信(CPUが1バイトずつFIFOに積む) ※ベンチマークの比較用
+static void neopixel_put_blocking(neopixel_t *p_neopixel)
 {
-    uint8_t i;
+    const uint8_t *p_byte = (const uint8_t *)p_neopixel->p_pixel_buf;
 
-    for ( i = 0; i < p_neopixel->led_cnt; i++)
+    for (uint32_t i = 0; i < (uint32_t)p_neopixel->led_cnt * NEOPIXEL_BYTE_PER_LED; i++)
     {
-        pio_sm_put_blocking(s_pio, s_sm, p_neopixel->p_pixel_grb_buf[i].grb_color.u32_grb << 8u);
+        pio_sm_put_blocking(s_pio, s_sm, (uint32_t)p_byte[i] << 24u);
     }
 }
 
 void drv_neopixel_init(neopixel_t *p_neopixel)
 {
     bool ret = false;
+    dma_channel_config c;
 
+    if (!s_is_lock_init) {
+        s_is_lock_init = drv_lock_ticket_init(&s_neopixel_lock, "neopixel");
+        hard_assert(s_is_lock_init);
+        s_p_tx_lock = spin_lock_instance((uint)spin_lock_claim_unused(true));
+        s_dma_ch = dma_claim_unused_channel(true);
+    }
+
+    drv_lock_ticket_acquire(&s_neopixel_lock);
+    hard_assert(p_neopixel->led_cnt <= NEOPIXEL_LED_MAX);
+    if (p_neopixel->p_pixel_buf == NULL) {
+        p_neopixel->p_pixel_buf = calloc(p_neopixel->led_cnt, sizeof(grb24_t));
+        hard_assert(p_neopixel->p_pixel_buf != NULL);
+    }
+    ret = neopixel_frame_alloc(p_neopixel->led_cnt);
+    hard_assert(ret);
     s_p_neopixel = p_neopixel;
     s_offset = pio_add_program(s_pio, &neopixel_program);
     ret = pio_claim_free_sm_and_add_program_for_gpio_range(&neopixel_program, &s_pio, &s_sm, &s_offset, p_neopixel->data_pin, 1, true);
     hard_assert(ret);
     pio_neopixel_begin(p_neopixel, s_pio, s_sm, s_offset, p_neopixel->data_pin);
-    drv_neopixel_clear(p_neopixel);
+
+    // DMA ... 8bit、読み出し側だけインクリメント、PIOのTX FIFOの空きで転送、セグメントの完了で割り込み
+    c = dma_channel_get_default_config((uint)s_dma_ch);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, pio_get_dreq(s_pio, s_sm, true));
+    dma_channel_configure((uint)s_dma_ch, &c, &s_pio->txf[s_sm], s_p_frame[0], 0, false);
+    dma_channel_set_irq0_enabled((uint)s_dma_ch, true);
+    irq_set_exclusive_handler(DMA_IRQ_0, neopixel_dma_irq_handler);
+    irq_set_enabled(DMA_IRQ_0, true);
+
+    neopixel_clear(p_neopixel);
+    neopixel_commit(p_neopixel, true);
+    drv_lock_ticket_release(&s_neopixel_lock);
 }
 
-void drv_neopixel_set_pixel_rgb(neopixel_t *p_neopixel, uint8_t led, uint8_t red, uint8_t green, uint8_t blue)
+static void neopixel_set_pixel_rgb(neopixel_t *p_neopixel, uint16_t led, uint8_t red, uint8_t green, uint8_t blue)
 {
-    p_neopixel->p_pixel_grb_buf[led].grb_color.grb_bit.reserved = 0;
-    p_neopixel->p_pixel_grb_buf[led].grb_color.grb_bit.blue = blue;
-    p_neopixel->p_pixel_grb_buf[led].grb_color.grb_bit.red = red;
-    p_neopixel->p_pixel_grb_buf[led].grb_color.grb_bit.green = green;
-    set_pio_neopixel_show(p_neopixel);
+    p_neopixel->p_pixel_buf[led].green = green;
+    p_neopixel->p_pixel_buf[led].red = red;
+    p_neopixel->p_pixel_buf[led].blue = blue;
+    p_neopixel->is_dirty = true;
 }
 
-void drv_neopixel_set_pixel_color(neopixel_t *p_neopixel, uint8_t led, uint8_t color)
+void drv_neopixel_set_pixel_rgb(neopixel_t *p_neopixel, uint16_t led, uint8_t red, uint8_t green, uint8_t blue)
+{
+    drv_lock_ticket_acquire(&s_neopixel_lock);
+    neopixel_set_pixel_rgb(p_neopixel, led, red, green, blue);
+    drv_lock_ticket_release(&s_neopixel_lock);
+}
+
+void drv_neopixel_set_pixel_color(neopixel_t *p_neopixel, uint16_t led, uint8_t color)
 {
     // 色指定の状態遷移
     switch (color) {
@@ -103,138 +375,466 @@ void drv_neopixel_set_pixel_color(neopixel_t *p_neopixel, uint8_t led, uint8_t c
     }
 }
 
-void drv_neopixel_get_pixel_color(neopixel_t *p_neopixel, uint8_t led, uint8_t color)
+void drv_neopixel_get_pixel_color(neopixel_t *p_neopixel, uint16_t led, uint8_t color)
 {
+    drv_lock_ticket_acquire(&s_neopixel_lock);
+
     // 色指定の状態遷移
     switch (color) {
         case NEOPIXEL_COLOR_RED:
-            p_neopixel->p_pixel_grb_buf[led].grb_color.grb_bit.red = 0xFF;
-            p_neopixel->p_pixel_grb_buf[led].grb_color.grb_bit.green = 0;
-            p_neopixel->p_pixel_grb_buf[led].grb_color.grb_bit.blue = 0;
+            p_neopixel->p_pixel_buf[led].red = 0xFF;
+            p_neopixel->p_pixel_buf[led].green = 0;
+            p_neopixel->p_pixel_buf[led].blue = 0;
             break;
         case NEOPIXEL_COLOR_GREEN:
-            p_neopixel->p_pixel_grb_buf[led].grb_color.grb_bit.red = 0;
-            p_neopixel->p_pixel_grb_buf[led].grb_color.grb_bit.green = 0xFF;
-            p_neopixel->p_pixel_grb_buf[led].grb_color.grb_bit.blue = 0;
+            p_neopixel->p_pixel_buf[led].red = 0;
+            p_neopixel->p_pixel_buf[led].green = 0xFF;
+            p_neopixel->p_pixel_buf[led].blue = 0;
             break;
 
         case NEOPIXEL_COLOR_BLUE:
-            p_neopixel->p_pixel_grb_buf[led].grb_color.grb_bit.red = 0;
-            p_neopixel->p_pixel_grb_buf[led].grb_color.grb_bit.green = 0;
-            p_neopixel->p_pixel_grb_buf[led].grb_color.grb_bit.blue = 0xFF;
+            p_neopixel->p_pixel_buf[led].red = 0;
+            p_neopixel->p_pixel_buf[led].green = 0;
+            p_neopixel->p_pixel_buf[led].blue = 0xFF;
             break;
 
         case NEOPIXEL_COLOR_YELLOW:
-            p_neopixel->p_pixel_grb_buf[led].grb_color.grb_bit.red = 0xFF;
-            p_neopixel->p_pixel_grb_buf[led].grb_color.grb_bit.green = 0xFF;
-            p_neopixel->p_pixel_grb_buf[led].grb_color.grb_bit.blue = 0;
+            p_neopixel->p_pixel_buf[led].red = 0xFF;
+            p_neopixel->p_pixel_buf[led].green = 0xFF;
+            p_neopixel->p_pixel_buf[led].blue = 0;
             break;
 
         case NEOPIXEL_COLOR_CYAN:
-            p_neopixel->p_pixel_grb_buf[led].grb_color.grb_bit.red = 0;
-            p_neopixel->p_pixel_grb_buf[led].grb_color.grb_bit.green = 0xFF;
-            p_neopixel->p_pixel_grb_buf[led].grb_color.grb_bit.blue = 0xFF;
+            p_neopixel->p_pixel_buf[led].red = 0;
+            p_neopixel->p_pixel_buf[led].green = 0xFF;
+            p_neopixel->p_pixel_buf[led].blue = 0xFF;
             break;
 
         case NEOPIXEL_COLOR_MAGENTA:
-            p_neopixel->p_pixel_grb_buf[led].grb_color.grb_bit.red = 0xFF;
-            p_neopixel->p_pixel_grb_buf[led].grb_color.grb_bit.green = 0;
-            p_neopixel->p_pixel_grb_buf[led].grb_color.grb_bit.blue = 0xFF;
+            p_neopixel->p_pixel_buf[led].red = 0xFF;
+            p_neopixel->p_pixel_buf[led].green = 0;
+            p_neopixel->p_pixel_buf[led].blue = 0xFF;
             break;
 
         case NEOPIXEL_COLOR_ORANGE:
-            p_neopixel->p_pixel_grb_buf[led].grb_color.grb_bit.red = 0xFF;
-            p_neopixel->p_pixel_grb_buf[led].grb_color.grb_bit.green = 0xA5;
-            p_neopixel->p_pixel_grb_buf[led].grb_color.grb_bit.blue = 0;
+            p_neopixel->p_pixel_buf[led].red = 0xFF;
+            p_neopixel->p_pixel_buf[led].green = 0xA5;
+            p_neopixel->p_pixel_buf[led].blue = 0;
             break;
 
         case NEOPIXEL_COLOR_PURPLE:
-            p_neopixel->p_pixel_grb_buf[led].grb_color.grb_bit.red = 0x80;
-            p_neopixel->p_pixel_grb_buf[led].grb_color.grb_bit.green = 0xA5;
-            p_neopixel->p_pixel_grb_buf[led].grb_color.grb_bit.blue = 0x80;
+            p_neopixel->p_pixel_buf[led].red = 0x80;
+            p_neopixel->p_pixel_buf[led].green = 0xA5;
+            p_neopixel->p_pixel_buf[led].blue = 0x80;
             break;
 
         case NEOPIXEL_COLOR_PINK:
-            p_neopixel->p_pixel_grb_buf[led].grb_color.grb_bit.red = 0xFF;
-            p_neopixel->p_pixel_grb_buf[led].grb_color.grb_bit.green = 0xC0;
-            p_neopixel->p_pixel_grb_buf[led].grb_color.grb_bit.blue = 0xCB;
+            p_neopixel->p_pixel_buf[led].red = 0xFF;
+            p_neopixel->p_pixel_buf[led].green = 0xC0;
+            p_neopixel->p_pixel_buf[led].blue = 0xCB;
             break;
 
         case NEOPIXEL_COLOR_WHITE:
-            p_neopixel->p_pixel_grb_buf[led].grb_color.grb_bit.red = 0xFF;
-            p_neopixel->p_pixel_grb_buf[led].grb_color.grb_bit.green = 0xFF;
-            p_neopixel->p_pixel_grb_buf[led].grb_color.grb_bit.blue = 0xFF;
+            p_neopixel->p_pixel_buf[led].red = 0xFF;
+            p_neopixel->p_pixel_buf[led].green = 0xFF;
+            p_neopixel->p_pixel_buf[led].blue = 0xFF;
             break;
 
         default:
-            p_neopixel->p_pixel_grb_buf[led].grb_color.grb_bit.red = 0;
-            p_neopixel->p_pixel_grb_buf[led].grb_color.grb_bit.green = 0;
-            p_neopixel->p_pixel_grb_buf[led].grb_color.grb_bit.blue = 0;
+            p_neopixel->p_pixel_buf[led].red = 0;
+            p_neopixel->p_pixel_buf[led].green = 0;
+            p_neopixel->p_pixel_buf[led].blue = 0;
             break;
     }
+    p_neopixel->is_dirty = true;
+
+    drv_lock_ticket_release(&s_neopixel_lock);
+}
+
+static void neopixel_clear(neopixel_t *p_neopixel)
+{
+    memset(p_neopixel->p_pixel_buf, 0, (uint32_t)p_neopixel->led_cnt * sizeof(grb24_t));
+    p_neopixel->is_dirty = true;
 }
 
 void drv_neopixel_clear(neopixel_t *p_neopixel)
 {
-    for (uint8_t i = 0; i < p_neopixel->led_cnt; i++)
-    {
-        p_neopixel->p_pixel_grb_buf[i].grb_color.grb_bit.reserved = 0;
-        p_neopixel->p_pixel_grb_buf[i].grb_color.grb_bit.blue = 0;
-        p_neopixel->p_pixel_grb_buf[i].grb_color.grb_bit.red = 0;
-        p_neopixel->p_pixel_grb_buf[i].grb_color.grb_bit.green = 0;
-        set_pio_neopixel_show(p_neopixel);
-    }
+    drv_lock_ticket_acquire(&s_neopixel_lock);
+    neopixel_clear(p_neopixel);
+    drv_lock_ticket_release(&s_neopixel_lock);
 }
 
+/**
+ * @brief 画素バッファを1フレーム送信(変更の有無に関係なく送る ※ラッチし直し等)
+ *
+ * @param p_neopixel NeoPixel
+ */
 void drv_neopixel_show(neopixel_t *p_neopixel)
 {
-    set_pio_neopixel_show(p_neopixel);
+    drv_lock_ticket_acquire(&s_neopixel_lock);
+    p_neopixel->is_dirty = false;
+    neopixel_commit(p_neopixel, true);
+    drv_lock_ticket_release(&s_neopixel_lock);
+}
+
+/**
+ * @brief 変更があれば1フレーム送信(セッターはバッファを書くだけなので、まとめて書いてから呼ぶ)
+ *
+ * @param p_neopixel NeoPixel
+ * @return true 送信した(or 送信中のフレームの次に保留した)
+ * @return false 変更が無い or 最後に送ったフレームと同じ
+ */
+bool drv_neopixel_commit(neopixel_t *p_neopixel)
+{
+    bool is_sent;
+
+    drv_lock_ticket_acquire(&s_neopixel_lock);
+    is_sent = neopixel_commit_dirty(p_neopixel);
+    drv_lock_ticket_release(&s_neopixel_lock);
+
+    return is_sent;
 }
 
 void drv_neopixel_set_all_led_color(neopixel_t *p_neopixel, uint8_t red, uint8_t green, uint8_t blue)
 {
-    for (uint8_t i = 0; i < p_neopixel->led_cnt; i++)
+    drv_lock_ticket_acquire(&s_neopixel_lock);
+    for (uint32_t i = 0; i < p_neopixel->led_cnt; i++)
     {
-        p_neopixel->p_pixel_grb_buf[i].grb_color.grb_bit.reserved = 0;
-        p_neopixel->p_pixel_grb_buf[i].grb_color.grb_bit.blue = blue;
-        p_neopixel->p_pixel_grb_buf[i].grb_color.grb_bit.red = red;
-        p_neopixel->p_pixel_grb_buf[i].grb_color.grb_bit.green = green;
-        set_pio_neopixel_show(p_neopixel);
+        p_neopixel->p_pixel_buf[i].green = green;
+        p_neopixel->p_pixel_buf[i].red = red;
+        p_neopixel->p_pixel_buf[i].blue = blue;
     }
+    p_neopixel->is_dirty = true;
+    drv_lock_ticket_release(&s_neopixel_lock);
 }
 
-uint32_t drv_neopixel_get_color(neopixel_t *p_neopixel, uint8_t led)
+uint32_t drv_neopixel_get_color(neopixel_t *p_neopixel, uint16_t led)
 {
     uint32_t color = 0;
-    color = p_neopixel->p_pixel_grb_buf->grb_color.u32_grb;
+
+    drv_lock_ticket_acquire(&s_neopixel_lock);
+    color = RGB_TO_GRB((uint32_t)p_neopixel->p_pixel_buf[led].red, (uint32_t)p_neopixel->p_pixel_buf[led].green,
+                       (uint32_t)p_neopixel->p_pixel_buf[led].blue);
+    drv_lock_ticket_release(&s_neopixel_lock);
+
     return color;
 }
 
-void drv_neopixel_pixel_color_fade(void)
+/**
+ * @brief 画素バッファへまとめて書き込み(バッファだけ、送信はdrv_neopixel_commit())
+ *
+ * @param p_neopixel NeoPixel
+ * @param p_grb 書き込む画素(GRB)
+ * @param led_cnt 画素数(led_cnt以上は捨てる)
+ */
+void drv_neopixel_write(neopixel_t *p_neopixel, const rgb_color_t *p_grb, uint32_t led_cnt)
 {
-    static uint8_t s_idx = 0, s_r = 0, s_g = 0, s_b = 0;
+    led_cnt = (led_cnt < p_neopixel->led_cnt) ? led_cnt : p_neopixel->led_cnt;
 
-    if (s_r < 0xFF) {
-        s_r++;
-    } else if (s_g < 0xFF) {
-        s_g++;
-    } else if (s_b < 0xFF) {
-        s_b++;
-    } else {
-        s_r = 0;
-        s_g = 0;
-        s_b = 0;
-
-        if (s_idx >= (s_p_neopixel->led_cnt - 1)) {
-            s_idx = 0;
-            drv_neopixel_clear(s_p_neopixel);
-        } else {
-            s_idx++;
+    drv_lock_ticket_acquire(&s_neopixel_lock);
+    for (uint32_t i = 0; i < led_cnt; i++)
+    {
+        p_neopixel->p_pixel_buf[i].green = p_grb[i].grb_color.grb_bit.green;
+        p_neopixel->p_pixel_buf[i].red = p_grb[i].grb_color.grb_bit.red;
+        p_neopixel->p_pixel_buf[i].blue = p_grb[i].grb_color.grb_bit.blue;
+    }
+    p_neopixel->is_dirty = true;
+    drv_lock_ticket_release(&s_neopixel_lock);
+}
+
+/**
+ * @brief メモリにマップされた詰めたGRB(SRAM/XIPのFlash/PSRAM)を区間の並びとしてそのまま1フレーム送信
+ * @note SRAMへコピーしないので、送信が終わる(drv_neopixel_is_busy()がfalse)まで区間の中身を保つこと
+ *
+ * @param p_seg 区間の並び(ストリップの先頭から順)
+ * @param seg_cnt 区間の数(1～NEOPIXEL_SEGMENT_MAX)
+ * @return true 送信した(or 送信中のフレームの次に保留した)
+ * @return false 区間の数かLEDの数が範囲外
+ */
+bool drv_neopixel_stream(const neopixel_segment_t *p_seg, uint32_t seg_cnt)
+{
+    uint32_t irq, len = 0, cnt = 0;
+    uint8_t back;
+
+    if ((seg_cnt == 0) || (seg_cnt > NEOPIXEL_SEGMENT_MAX)) {
+        printf("Error: Segment count must be 1-%d\n", NEOPIXEL_SEGMENT_MAX);
+        return false;
+    }
+    for (uint32_t i = 0; i < seg_cnt; i++)
+    {
+        len += p_seg[i].led_cnt;
+    }
+    if ((len == 0) || (len > NEOPIXEL_LED_MAX)) {
+        printf("Error: Stream length must be 1-%d LEDs\n", NEOPIXEL_LED_MAX);
+        return false;
+    }
+
+    drv_lock_ticket_acquire(&s_neopixel_lock);
+    irq = spin_lock_blocking(s_p_tx_lock);
+    back = neopixel_tx_back();
+    spin_unlock(s_p_tx_lock, irq);
+
+    // 空の区間は飛ばす(DMAの転送数0は割り込みだけ起きる)
+    for (uint32_t i = 0; i < seg_cnt; i++)
+    {
+        if (p_seg[i].led_cnt != 0) {
+            s_seg[back][cnt++] = p_seg[i];
+        }
+    }
+    s_seg_cnt[back] = cnt;
+    s_len[back] = len;
+    s_is_tx_valid = false;
+    neopixel_tx_submit(back);
+    drv_lock_ticket_release(&s_neopixel_lock);
+
+    return true;
+}
+
+/**
+ * @brief フレーム送信完了(ラッチ期間の終わり)のコールバックを設定
+ * @note アラーム割り込みから呼ばれるので短く(NULLで解除)
+ *
+ * @param p_cb コールバック
+ */
+void drv_neopixel_set_done_callback(neopixel_done_cb_t p_cb)
+{
+    s_p_done_cb = p_cb;
+}
+
+/**
+ * @brief 送信中(ラッチ期間と保留フレームを含む)か
+ *
+ * @return true 送信中
+ */
+bool drv_neopixel_is_busy(void)
+{
+    return s_is_tx_busy;
+}
+
+/**
+ * @brief 送信中のフレームと保留フレームの完了待ち
+ */
+void drv_neopixel_wait(void)
+{
+    while (s_is_tx_busy) {
+        tight_loop_contents();
+    }
+}
+
+/**
+ * @brief 従来のブロッキング送信とDMA送信のCPU時間、最大フレームレート、全LED更新のコミット1回化の効果を計測
+ * @note 実際の本数より長いフレームは末尾のLEDを素通りするだけなので、任意の長さで測れる
+ *
+ * @param led_cnt 計測するLEDの数(1～NEOPIXEL_LED_MAX、計測の間だけフレームをこの長さで確保)
+ * @param frame_cnt 計測するフレーム数
+ */
+void drv_neopixel_bench(uint32_t led_cnt, uint32_t frame_cnt)
+{
+    uint32_t cyc_per_us = clock_get_hz(clk_sys) / 1000000;
+    uint32_t t0_cyc, cyc, blk_max = 0, dma_max = 0;
+    uint64_t blk_sum = 0, dma_sum = 0, t0_us, dma_us;
+    uint32_t done0, merge0, frame_us, dma_frame_cnt, set_cnt, set_frame_cnt, commit_frame_cnt, same_cnt;
+    uint64_t set_us, commit_us;
+    neopixel_t bench = {
+        .data_pin = s_p_neopixel->data_pin,
+        .led_cnt = (uint16_t)((led_cnt < NEOPIXEL_LED_MAX) ? led_cnt : NEOPIXEL_LED_MAX),
+        .p_pixel_buf = NULL,
+    };
+    neopixel_t *p_neopixel = &bench;
+
+    p_neopixel->p_pixel_buf = calloc(p_neopixel->led_cnt, sizeof(grb24_t));
+    if (p_neopixel->p_pixel_buf == NULL) {
+        printf("Error: Failed to allocate %u LEDs for the bench\n", p_neopixel->led_cnt);
+        return;
+    }
+
+    // 暗い縞模様
+    for (uint32_t i = 0; i < p_neopixel->led_cnt; i++)
+    {
+        p_neopixel->p_pixel_buf[i].red = (i & 1u) ? 0 : 4;
+        p_neopixel->p_pixel_buf[i].blue = (i & 1u) ? 4 : 0;
+    }
+
+    // ロックは1フレームごとに取り直す(間にCore0のエフェクトのコミットが入ってよい、
+    // コミットは確保済みの長さで切り詰めるので、計測中の長さのままでも溢れない)
+    drv_lock_ticket_acquire(&s_neopixel_lock);
+    drv_neopixel_wait();
+    if (!neopixel_frame_alloc(p_neopixel->led_cnt)) {
+        drv_lock_ticket_release(&s_neopixel_lock);
+        free(p_neopixel->p_pixel_buf);
+        return;
+    }
+    drv_lock_ticket_release(&s_neopixel_lock);
+
+    // 従来 ... CPUがFIFOの空きを待ちながら積む(最後の数語はFIFOに残ったまま戻る)
+    for (uint32_t i = 0; i < frame_cnt; i++)
+    {
+        drv_lock_ticket_acquire(&s_neopixel_lock);
+        drv_neopixel_wait();
+        t0_cyc = rp2xxx_get_cycle_cnt();
+        neopixel_put_blocking(p_neopixel);
+        cyc = rp2xxx_get_cycle_cnt() - t0_cyc;
+        busy_wait_us_32(NEOPIXEL_LATCH_US + (NEOPIXEL_WORD_US * 9u));
+        drv_lock_ticket_release(&s_neopixel_lock);
+        blk_sum += cyc;
+        blk_max = (cyc > blk_max) ? cyc : blk_max;
+    }
+
+    // DMA ... show()の呼び出しだけがCPU時間、完了を待って次を送る
+    done0 = s_tx_frame_cnt;
+    merge0 = s_tx_merge_cnt;
+    t0_us = time_us_64();
+    for (uint32_t i = 0; i < frame_cnt; i++)
+    {
+        drv_lock_ticket_acquire(&s_neopixel_lock);
+        t0_cyc = rp2xxx_get_cycle_cnt();
+        neopixel_commit(p_neopixel, true);
+        cyc = rp2xxx_get_cycle_cnt() - t0_cyc;
+        drv_lock_ticket_release(&s_neopixel_lock);
+        dma_sum += cyc;
+        dma_max = (cyc > dma_max) ? cyc : dma_max;
+        drv_neopixel_wait();
+    }
+    dma_us = time_us_64() - t0_us;
+    dma_frame_cnt = s_tx_frame_cnt - done0;
+    merge0 = s_tx_merge_cnt - merge0;
+
+    // 全LEDの更新 ... 従来(セッターごとに1フレーム) vs バッファを書いてからコミット1回
+    // セッターごとは長いストリップだと終わらないので先頭NEOPIXEL_BENCH_SET_MAX個だけ測って全LED分に換算
+    set_cnt = (p_neopixel->led_cnt < NEOPIXEL_BENCH_SET_MAX) ? p_neopixel->led_cnt : NEOPIXEL_BENCH_SET_MAX;
+    done0 = s_tx_frame_cnt;
+    t0_us = time_us_64();
+    for (uint32_t i = 0; i < set_cnt; i++)
+    {
+        neopixel_set_pixel_rgb(p_neopixel, (uint16_t)i, 0, (uint8_t)(i & 7u), 0);
+        drv_lock_ticket_acquire(&s_neopixel_lock);
+        neopixel_commit(p_neopixel, true);
+        drv_lock_ticket_release(&s_neopixel_lock);
+        drv_neopixel_wait();
+    }
+    set_us = ((time_us_64() - t0_us) * p_neopixel->led_cnt) / set_cnt;
+    set_frame_cnt = ((s_tx_frame_cnt - done0) * p_neopixel->led_cnt) / set_cnt;
+
+    done0 = s_tx_frame_cnt;
+    same_cnt = s_same_cnt;
+    t0_us = time_us_64();
+    for (uint32_t i = 0; i < p_neopixel->led_cnt; i++)
+    {
+        neopixel_set_pixel_rgb(p_neopixel, (uint16_t)i, (uint8_t)(i & 7u), 0, 0);
+    }
+    drv_lock_ticket_acquire(&s_neopixel_lock);
+    neopixel_commit_dirty(p_neopixel);
+    drv_lock_ticket_release(&s_neopixel_lock);
+    drv_neopixel_wait();
+    commit_us = time_us_64() - t0_us;
+
+    // 変化なし(同じ値を書き直しただけ)のコミットは送らない
+    for (uint32_t i = 0; i < p_neopixel->led_cnt; i++)
+    {
+        neopixel_set_pixel_rgb(p_neopixel, (uint16_t)i, (uint8_t)(i & 7u), 0, 0);
+    }
+    drv_lock_ticket_acquire(&s_neopixel_lock);
+    neopixel_commit_dirty(p_neopixel);
+    neopixel_commit_dirty(p_neopixel);
+    drv_lock_ticket_release(&s_neopixel_lock);
+    drv_neopixel_wait();
+    commit_frame_cnt = s_tx_frame_cnt - done0;
+    same_cnt = s_same_cnt - same_cnt;
+
+    // 元の長さと表示に戻す
+    drv_lock_ticket_acquire(&s_neopixel_lock);
+    (void)neopixel_frame_alloc(s_p_neopixel->led_cnt);
+    neopixel_commit(s_p_neopixel, true);
+    drv_lock_ticket_release(&s_neopixel_lock);
+    free(p_neopixel->p_pixel_buf);
+
+    frame_us = (p_neopixel->led_cnt * NEOPIXEL_WORD_US) + NEOPIXEL_LATCH_US;
+    printf("\n[NeoPixel Bench] %u LEDs x %u frames, %u MHz\n", p_neopixel->led_cnt, frame_cnt, cyc_per_us);
+    printf("Blocking put : CPU %u us/frame (max %u us)\n",
+            (uint32_t)(blk_sum / frame_cnt) / cyc_per_us, blk_max / cyc_per_us);
+    printf("DMA show()   : CPU %u cyc/frame = %u.%02u us (max %u cyc), frames %u, merged %u\n",
+            (uint32_t)(dma_sum / frame_cnt), (uint32_t)(dma_sum / frame_cnt) / cyc_per_us,
+            (((uint32_t)(dma_sum / frame_cnt) % cyc_per_us) * 100u) / cyc_per_us, dma_max,
+            dma_frame_cnt, merge0);
+    printf("Frame rate   : measured %u fps, wire + latch %u us = %u fps max\n",
+            (dma_us != 0) ? (uint32_t)(((uint64_t)frame_cnt * 1000000u) / dma_us) : 0,
+            frame_us, 1000000u / frame_us);
+    printf("Full update  : per-set %u frames %u us%s, commit %u frame %u us (x%u less wire time), "
+           "unchanged commit skipped %u\n",
+            set_frame_cnt, (uint32_t)set_us, (set_cnt < p_neopixel->led_cnt) ? " (est)" : "", commit_frame_cnt, (uint32_t)commit_us,
+            (commit_us != 0) ? (uint32_t)(set_us / commit_us) : 0, same_cnt);
+}
+
+/**
+ * @brief 送信とコミットの統計を表示
+ */
+void drv_neopixel_show_stat(void)
+{
+    printf("\n[NeoPixel Stat]\n");
+    printf("Frames sent      : %u (merged before send %u)\n", s_tx_frame_cnt, s_tx_merge_cnt);
+    printf("Commits          : %u\n", s_commit_cnt);
+    printf("Skipped (clean)  : %u\n", s_clean_cnt);
+    printf("Skipped (same)   : %u\n", s_same_cnt);
+    printf("Busy             : %s\n", s_is_tx_busy ? "yes" : "no");
+    printf("Memory           : pixel %u B + frames 2 x %u B (%u LEDs, %u B/LED)\n",
+            (uint32_t)s_p_neopixel->led_cnt * NEOPIXEL_BYTE_PER_LED, s_frame_cap * NEOPIXEL_BYTE_PER_LED,
+            s_p_neopixel->led_cnt, NEOPIXEL_BYTE_PER_LED);
+}
+
+/**
+ * @brief ストリップの長さに対するメモリとフレーム時間の伸び方を表示
+ * @note 各長さでFlashの模様を区間の並びとしてストリーム送信して実測する(実際の本数より後ろは素通り)
+ *       メモリ ... 従来(rgb_color_t + 32bit語のフレームx2) / 詰めたGRB(画素 + フレームx2) / Flashからストリーム(区間の表だけ)
+ */
+void drv_neopixel_scale(void)
+{
+    static const uint32_t s_len_tbl[] = {64, 256, 1024, 4096, NEOPIXEL_LED_MAX};
+    neopixel_segment_t seg[NEOPIXEL_SEGMENT_MAX];
+    uint32_t cyc_per_us = clock_get_hz(clk_sys) / 1000000;
+    uint32_t t0_cyc, commit_cyc, stream_cyc, seg_cnt, len, frame_us;
+    uint64_t t0_us;
+
+    // コミット(詰めたバッファのコピー + 最後のフレームとの比較)のCPUを実際の本数で測ってLED当たりにする
+    drv_lock_ticket_acquire(&s_neopixel_lock);
+    neopixel_commit(s_p_neopixel, true);
+    drv_neopixel_wait();
+    t0_cyc = rp2xxx_get_cycle_cnt();
+    neopixel_commit(s_p_neopixel, false);
+    commit_cyc = rp2xxx_get_cycle_cnt() - t0_cyc;
+    drv_lock_ticket_release(&s_neopixel_lock);
+
+    printf("\n[NeoPixel Scale] packed GRB %u B/LED, wire %u us/LED + latch %u us, %u MHz\n",
+            NEOPIXEL_BYTE_PER_LED, NEOPIXEL_WORD_US, NEOPIXEL_LATCH_US, cyc_per_us);
+    printf(" LEDs | SRAM (B) old / packed / stream | frame us (calc)  fps | stream CPU us | commit CPU us (est)\n");
+    for (uint32_t n = 0; n < (sizeof(s_len_tbl) / sizeof(s_len_tbl[0])); n++)
+    {
+        len = s_len_tbl[n];
+        seg_cnt = 0;
+        for (uint32_t pos = 0; pos < len; pos += NEOPIXEL_SCALE_PATTERN)
+        {
+            seg[seg_cnt].p_grb = s_scale_pattern;
+            seg[seg_cnt].led_cnt = (uint16_t)(((len - pos) < NEOPIXEL_SCALE_PATTERN) ? (len - pos) : NEOPIXEL_SCALE_PATTERN);
+            seg_cnt++;
         }
+
+        drv_neopixel_wait();
+        t0_us = time_us_64();
+        t0_cyc = rp2xxx_get_cycle_cnt();
+        if (!drv_neopixel_stream(seg, seg_cnt)) {
+            break;
+        }
+        stream_cyc = rp2xxx_get_cycle_cnt() - t0_cyc;
+        drv_neopixel_wait();
+        frame_us = (uint32_t)(time_us_64() - t0_us);
+
+        printf("%5u | %7u / %6u / %6u | %8u (%6u) %4u | %13u | %u\n", len,
+                len * (uint32_t)(sizeof(rgb_color_t) * 3u), len * (NEOPIXEL_BYTE_PER_LED * 3u),
+                seg_cnt * (uint32_t)sizeof(neopixel_segment_t),
+                frame_us, (len * NEOPIXEL_WORD_US) + NEOPIXEL_LATCH_US, 1000000u / frame_us,
+                stream_cyc / cyc_per_us,
+                (uint32_t)(((uint64_t)commit_cyc * len) / s_p_neopixel->led_cnt) / cyc_per_us);
     }
 
-    s_p_neopixel->p_pixel_grb_buf[s_idx].grb_color.grb_bit.red = s_r;
-    s_p_neopixel->p_pixel_grb_buf[s_idx].grb_color.grb_bit.green = s_g;
-    s_p_neopixel->p_pixel_grb_buf[s_idx].grb_color.grb_bit.blue = s_b;
-    drv_neopixel_set_pixel_rgb(s_p_neopixel, s_idx, s_r, s_g, s_b);
-}
\ No newline at end of file
+    // 元の表示に戻す
+    drv_neopixel_show(s_p_neopixel);
+}
@@ -36,6 +36,12 @@ typedef enum {
     NEOPIXEL_COLOR_WHITE    // 白
 } e_neopixel_color;
 
+#define NEOPIXEL_LED_MAX        8192    // 1本のLEDの最大数(バッファは本数に合わせて確保)
+#define NEOPIXEL_BYTE_PER_LED   3       // 1LEDのバイト数(GRBを詰めて格納)
+#define NEOPIXEL_SEGMENT_MAX    32      // 1フレームを組み立てるセグメントの最大数
+#define NEOPIXEL_WORD_US        30      // 1LED(24bit @800kHz)の送信時間
+#define NEOPIXEL_LATCH_US       300     // リセット(ラッチ)期間 ※WS2812Bの新しいロットは280us以上
+
 #define RGB_TO_GRB(r, g, b) ((uint32_t)((g << 16) | (r << 8) | b))
 #define GRB_TO_RGB(grb) ((uint32_t)(((grb & 0xFF0000) >> 8) | ((grb & 0xFF00) << 8) | (grb & 0xFF)))
 
@@ -51,20 +57,45 @@ typedef struct {
     } grb_color;
 } rgb_color_t;
 
+// 1LED(ワイヤに送る順にGRBを詰めた24bit) ※rgb_color_tより1バイト少ない
+typedef struct {
+    uint8_t green;
+    uint8_t red;
+    uint8_t blue;
+} grb24_t;
+
 typedef struct {
     uint8_t data_pin;
-    uint8_t led_cnt;
-    rgb_color_t *p_pixel_grb_buf;
+    uint16_t led_cnt;
+    grb24_t *p_pixel_buf;   // NULLならdrv_neopixel_init()がled_cnt分を確保
+    bool is_dirty;          // 最後のコミットからバッファを書き換えた
 } neopixel_t;
 
+// ストリーム送信の1区間(SRAM、XIPのFlash、PSRAMなどメモリにマップされた詰めたGRB)
+typedef struct {
+    const grb24_t *p_grb;
+    uint16_t led_cnt;
+} neopixel_segment_t;
+
+// フレーム送信完了(ラッチ期間の終わり)のコールバック ※アラーム割り込みから呼ばれる
+typedef void (*neopixel_done_cb_t)(uint32_t frame_cnt);
+
 void drv_neopixel_init(neopixel_t *p_neopixel);
-void drv_neopixel_set_pixel_rgb(neopixel_t *p_neopixel, uint8_t led, uint8_t red, uint8_t green, uint8_t blue);
-void drv_neopixel_set_pixel_color(neopixel_t *p_neopixel, uint8_t led, uint8_t color);
-void drv_neopixel_get_pixel_color(neopixel_t *p_neopixel, uint8_t led, uint8_t color);
+void drv_neopixel_set_pixel_rgb(neopixel_t *p_neopixel, uint16_t led, uint8_t red, uint8_t green, uint8_t blue);
+void drv_neopixel_set_pixel_color(neopixel_t *p_neopixel, uint16_t led, uint8_t color);
+void drv_neopixel_get_pixel_color(neopixel_t *p_neopixel, uint16_t led, uint8_t color);
 void drv_neopixel_clear(neopixel_t *p_neopixel);
 void drv_neopixel_show(neopixel_t *p_neopixel);
+bool drv_neopixel_commit(neopixel_t *p_neopixel);
 void drv_neopixel_set_all_led_color(neopixel_t *p_neopixel, uint8_t red, uint8_t green, uint8_t blue);
-uint32_t drv_neopixel_get_color(neopixel_t *p_neopixel, uint8_t led);
-void drv_neopixel_pixel_color_fade(void);
+uint32_t drv_neopixel_get_color(neopixel_t *p_neopixel, uint16_t led);
+void drv_neopixel_write(neopixel_t *p_neopixel, const rgb_color_t *p_grb, uint32_t led_cnt);
+bool drv_neopixel_stream(const neopixel_segment_t *p_seg, uint32_t seg_cnt);
+void drv_neopixel_set_done_callback(neopixel_done_cb_t p_cb);
+bool drv_neopixel_is_busy(void);
+void drv_neopixel_wait(void);
+void drv_neopixel_bench(uint32_t led_cnt, uint32_t frame_cnt);
+void drv_neopixel_show_stat(void);
+void drv_neopixel_scale(void);
 
 #endif // DRV_NEOPIXEL_H
\ No newline at end of file
@@ -0,0 +1,524 @@
+/**
+ * @file drv_neopixel_multi.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief NeoPixelの複数ストリップ並列ドライバ(PIO neopixel_parallel + DMA)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026 Chimipupu All Rights Reserved.
+ *
+ * neopixel_parallelは1語 = 1ビット期間(1.25us)で、語のビットkをpin_base + kへ同時に出す。
+ * 画素を「LEDごと・ビットごと」の語に並べ替え(転置)、DMAでTX FIFOへ送る。
+ * 1フレームの時間は一番長いストリップで決まり、ストリップの本数には依存しない。
+ *
+ * 並べ替え ... 8本 x 8bitを1ブロックとして、シフトとマスクの入れ替え3段で転置する(Hacker's Delight 7-3)。
+ * 8本ずつのブロックを語の各バイトに置くので32本(32x8)まで同じ処理で済む。
+ * 補間器(interp)はレーンごとのシフト/マスク/加算なのでビットの入れ替えには使えず、
+ * Cortex-M33のDSP拡張にもビットの転置命令は無いので、どちらも使わない。
+ * 次のフレームの並べ替えは、DMAが前のフレームを送っている間に裏のバッファへ行う。
+ */
+#include "drv_neopixel_multi.h"
+#include "drv_lock.h"
+#include "muc_rpxxx_util.h"
+
+#define MULTI_FRAME_WORDS   (NEOPIXEL_MULTI_LED_MAX * NEOPIXEL_MULTI_BIT_WORDS)
+
+static int64_t multi_latch_callback(alarm_id_t id, void *p_user_data);
+
+static neopixel_multi_t *s_p_multi = NULL;
+static PIO s_pio = pio1;
+static uint s_sm = 0;
+static uint s_offset = 0;
+static int32_t s_dma_ch = -1;
+static spin_lock_t *s_p_tx_lock = NULL;
+
+// DMA送信(ダブルバッファ) ※送信状態の扱いはdrv_neopixel.cと同じ
+static uint32_t s_frame[2][MULTI_FRAME_WORDS];
+static uint32_t s_frame_led = 0;                    // フレームのLED数(= 一番長いストリップ)
+static volatile uint8_t s_tx_idx = 1;
+static volatile bool s_is_tx_busy = false;
+static volatile bool s_is_tx_pending = false;
+static volatile uint32_t s_tx_frame_cnt = 0;
+
+// ベンチマーク/自己テスト用のストリップ
+static rgb_color_t s_bench_buf[NEOPIXEL_STRIP_MAX][NEOPIXEL_MULTI_LED_MAX];
+static neopixel_multi_t s_bench;
+
+// フレームのワイヤ上の時間 + ラッチ期間
+static inline int64_t multi_frame_us(uint32_t led)
+{
+    return (int64_t)led * NEOPIXEL_WORD_US + NEOPIXEL_LATCH_US;
+}
+
+// フレームのDMA送信を開始(s_p_tx_lockを持って呼ぶ)
+static void multi_tx_start(uint8_t idx)
+{
+    s_tx_idx = idx;
+    s_is_tx_busy = true;
+    s_is_tx_pending = false;
+    dma_channel_transfer_from_buffer_now((uint)s_dma_ch, s_frame[idx], s_frame_led * NEOPIXEL_MULTI_BIT_WORDS);
+}
+
+// ラッチ期間の終わり(アラーム割り込み) ... 保留フレームの送信
+static int64_t multi_latch_callback(alarm_id_t id, void *p_user_data)
+{
+    uint32_t irq;
+    bool is_next;
+
+    (void)id;
+    (void)p_user_data;
+
+    if (dma_channel_is_busy((uint)s_dma_ch) || !pio_sm_is_tx_fifo_empty(s_pio, s_sm)) {
+        return NEOPIXEL_WORD_US + NEOPIXEL_LATCH_US;
+    }
+
+    irq = spin_lock_blocking(s_p_tx_lock);
+    s_tx_frame_cnt++;
+    is_next = s_is_tx_pending;
+    if (is_next) {
+        multi_tx_start(s_tx_idx ^ 1u);
+    } else {
+        s_is_tx_busy = false;
+    }
+    spin_unlock(s_p_tx_lock, irq);
+
+    return is_next ? multi_frame_us(s_frame_led) : 0;
+}
+
+// 一番長いストリップのLED数
+static uint32_t multi_led_max(const neopixel_multi_t *p_multi)
+{
+    uint32_t led_max = 0;
+
+    for (uint32_t s = 0; s < p_multi->strip_cnt; s++)
+    {
+        led_max = (p_multi->strip[s].led_cnt > led_max) ? p_multi->strip[s].led_cnt : led_max;
+    }
+
+    return led_max;
+}
+
+// 8x8ビットの転置
+// 入力 ... lo = ストリップ0～3、hi = ストリップ4～7のバイト(ストリップ0がloの最下位バイト)
+// 出力 ... hi = ビット7～4、lo = ビット3～0の語(ビット7がhiの最上位バイト、バイトのビットs = ストリップs)
+static inline void multi_transpose8(uint32_t *p_hi, uint32_t *p_lo)
+{
+    uint32_t x = *p_hi;
+    uint32_t y = *p_lo;
+    uint32_t t;
+
+    t = (x ^ (x >> 7)) & 0x00AA00AAu;
+    x = x ^ t ^ (t << 7);
+    t = (y ^ (y >> 7)) & 0x00AA00AAu;
+    y = y ^ t ^ (t << 7);
+    t = (x ^ (x >> 14)) & 0x0000CCCCu;
+    x = x ^ t ^ (t << 14);
+    t = (y ^ (y >> 14)) & 0x0000CCCCu;
+    y = y ^ t ^ (t << 14);
+    t = (x & 0xF0F0F0F0u) | ((y >> 4) & 0x0F0F0F0Fu);
+    y = ((x << 4) & 0xF0F0F0F0u) | (y & 0x0F0F0F0Fu);
+
+    *p_hi = t;
+    *p_lo = y;
+}
+
+// 画素をビットごとの語に並べ替え(語のビットs = ストリップsの画素のビット、GRBのMSBから)
+// 短いストリップの残りは0(その先にLEDは無いので素通り)
+// LEDごとに8本ずつのブロックを転置する(32本 = 8x8を4ブロックで32x8)
+static uint32_t multi_transpose(const neopixel_multi_t *p_multi, uint32_t *p_dst)
+{
+    uint32_t led_max = multi_led_max(p_multi);
+    uint32_t block_cnt = (p_multi->strip_cnt + 7u) / 8u;
+    const uint32_t *p_src[NEOPIXEL_STRIP_MAX];
+    uint32_t len[NEOPIXEL_STRIP_MAX];
+
+    for (uint32_t s = 0; s < (block_cnt * 8u); s++)
+    {
+        bool is_strip = (s < p_multi->strip_cnt);
+        p_src[s] = is_strip ? &p_multi->strip[s].p_pixel_grb_buf[0].grb_color.u32_grb : NULL;
+        len[s] = is_strip ? p_multi->strip[s].led_cnt : 0;
+    }
+
+    for (uint32_t i = 0; i < led_max; i++)
+    {
+        uint32_t *p_word = &p_dst[i * NEOPIXEL_MULTI_BIT_WORDS];
+
+        for (uint32_t blk = 0; blk < block_cnt; blk++)
+        {
+            uint32_t px[8];
+            uint32_t sh = blk * 8u;
+
+            for (uint32_t k = 0; k < 8; k++)
+            {
+                uint32_t s = sh + k;
+                px[k] = (i < len[s]) ? p_src[s][i] : 0;
+            }
+
+            // G, R, Bの順に8本分のバイトを集めて転置
+            for (uint32_t c = 0; c < 3; c++)
+            {
+                uint32_t ch = 16u - (c * 8u);
+                uint32_t lo = ((px[0] >> ch) & 0xFFu) | (((px[1] >> ch) & 0xFFu) << 8) |
+                              (((px[2] >> ch) & 0xFFu) << 16) | (((px[3] >> ch) & 0xFFu) << 24);
+                uint32_t hi = ((px[4] >> ch) & 0xFFu) | (((px[5] >> ch) & 0xFFu) << 8) |
+                              (((px[6] >> ch) & 0xFFu) << 16) | (((px[7] >> ch) & 0xFFu) << 24);
+                uint32_t *p_out = &p_word[c * 8u];
+
+                multi_transpose8(&hi, &lo);
+                if (blk == 0) {
+                    p_out[0] = hi >> 24;
+                    p_out[1] = (hi >> 16) & 0xFFu;
+                    p_out[2] = (hi >> 8) & 0xFFu;
+                    p_out[3] = hi & 0xFFu;
+                    p_out[4] = lo >> 24;
+                    p_out[5] = (lo >> 16) & 0xFFu;
+                    p_out[6] = (lo >> 8) & 0xFFu;
+                    p_out[7] = lo & 0xFFu;
+                } else {
+                    p_out[0] |= (hi >> 24) << sh;
+                    p_out[1] |= ((hi >> 16) & 0xFFu) << sh;
+                    p_out[2] |= ((hi >> 8) & 0xFFu) << sh;
+                    p_out[3] |= (hi & 0xFFu) << sh;
+                    p_out[4] |= (lo >> 24) << sh;
+                    p_out[5] |= ((lo >> 16) & 0xFFu) << sh;
+                    p_out[6] |= ((lo >> 8) & 0xFFu) << sh;
+                    p_out[7] |= (lo & 0xFFu) << sh;
+                }
+            }
+        }
+    }
+
+    return led_max;
+}
+
+// 並べ替えの参照実装(1ビットずつ) ※自己テストとベンチマークの比較用
+static uint32_t multi_transpose_ref(const neopixel_multi_t *p_multi, uint32_t *p_dst)
+{
+    uint32_t led_max = multi_led_max(p_multi);
+
+    memset(p_dst, 0, led_max * NEOPIXEL_MULTI_BIT_WORDS * sizeof(uint32_t));
+    for (uint32_t s = 0; s < p_multi->strip_cnt; s++)
+    {
+        const neopixel_strip_t *p_strip = &p_multi->strip[s];
+
+        for (uint32_t i = 0; i < p_strip->led_cnt; i++)
+        {
+            uint32_t grb = p_strip->p_pixel_grb_buf[i].grb_color.u32_grb;
+            uint32_t *p_word = &p_dst[i * NEOPIXEL_MULTI_BIT_WORDS];
+
+            for (uint32_t b = 0; b < NEOPIXEL_MULTI_BIT_WORDS; b++)
+            {
+                p_word[b] |= ((grb >> (23u - b)) & 1u) << s;
+            }
+        }
+    }
+
+    return led_max;
+}
+
+// 裏のフレームに並べ替えて送信(送信中なら保留)
+static void multi_commit(const neopixel_multi_t *p_multi)
+{
+    uint32_t irq, led;
+    uint8_t back;
+    bool is_start;
+
+    irq = spin_lock_blocking(s_p_tx_lock);
+    back = s_tx_idx ^ 1u;
+    s_is_tx_pending = false;
+    spin_unlock(s_p_tx_lock, irq);
+
+    led = multi_transpose(p_multi, s_frame[back]);
+
+    irq = spin_lock_blocking(s_p_tx_lock);
+    s_frame_led = led;
+    is_start = !s_is_tx_busy;
+    if (is_start) {
+        multi_tx_start(back);
+    } else {
+        s_is_tx_pending = true;
+    }
+    spin_unlock(s_p_tx_lock, irq);
+
+    if (is_start && (add_alarm_in_us((uint64_t)multi_frame_us(led), multi_latch_callback, NULL, true) < 0)) {
+        irq = spin_lock_blocking(s_p_tx_lock);
+        s_is_tx_busy = false;
+        spin_unlock(s_p_tx_lock, irq);
+    }
+}
+
+/**
+ * @brief 複数ストリップの並列出力を初期化(pin_baseから連続したstrip_cnt本のピン)
+ *
+ * @param p_multi ストリップの設定と画素バッファ
+ * @return true 成功
+ * @return false 設定が範囲外 or PIOのステートマシンの空きが無い
+ */
+bool drv_neopixel_multi_init(neopixel_multi_t *p_multi)
+{
+    dma_channel_config c;
+
+    if ((p_multi->strip_cnt == 0) || (p_multi->strip_cnt > NEOPIXEL_STRIP_MAX)) {
+        printf("Error: Strip count must be 1-%d\n", NEOPIXEL_STRIP_MAX);
+        return false;
+    }
+    for (uint32_t s = 0; s < p_multi->strip_cnt; s++)
+    {
+        if ((p_multi->strip[s].led_cnt > NEOPIXEL_MULTI_LED_MAX) || (p_multi->strip[s].p_pixel_grb_buf == NULL)) {
+            printf("Error: Strip %u needs a buffer of up to %d LEDs\n", s, NEOPIXEL_MULTI_LED_MAX);
+            return false;
+        }
+    }
+
+    if (s_p_multi == NULL) {
+        if (!pio_claim_free_sm_and_add_program_for_gpio_range(&neopixel_parallel_program, &s_pio, &s_sm, &s_offset,
+                                                              p_multi->pin_base, p_multi->strip_cnt, true)) {
+            printf("Error: No free PIO state machine for parallel NeoPixel\n");
+            return false;
+        }
+        s_p_tx_lock = spin_lock_instance((uint)spin_lock_claim_unused(true));
+        s_dma_ch = dma_claim_unused_channel(true);
+        pio_neopixel_parallel_init(s_pio, s_sm, s_offset, p_multi->pin_base, p_multi->strip_cnt, 800000);
+
+        // DMA ... 32bit、読み出し側だけインクリメント、PIOのTX FIFOの空きで転送
+        c = dma_channel_get_default_config((uint)s_dma_ch);
+        channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+        channel_config_set_read_increment(&c, true);
+        channel_config_set_write_increment(&c, false);
+        channel_config_set_dreq(&c, pio_get_dreq(s_pio, s_sm, true));
+        dma_channel_configure((uint)s_dma_ch, &c, &s_pio->txf[s_sm], s_frame[0], 0, false);
+    }
+
+    s_p_multi = p_multi;
+    drv_neopixel_multi_clear(p_multi);
+    drv_neopixel_multi_commit(p_multi);
+
+    return true;
+}
+
+/**
+ * @brief 1画素の色を設定(バッファだけ、送信はdrv_neopixel_multi_commit())
+ */
+void drv_neopixel_multi_set_pixel_rgb(neopixel_multi_t *p_multi, uint8_t strip, uint8_t led,
+                                      uint8_t red, uint8_t green, uint8_t blue)
+{
+    if ((strip >= p_multi->strip_cnt) || (led >= p_multi->strip[strip].led_cnt)) {
+        return;
+    }
+    p_multi->strip[strip].p_pixel_grb_buf[led].grb_color.u32_grb = RGB_TO_GRB(red, green, blue);
+    p_multi->is_dirty = true;
+}
+
+/**
+ * @brief ストリップ全体の色を設定(バッファだけ)
+ */
+void drv_neopixel_multi_set_strip_rgb(neopixel_multi_t *p_multi, uint8_t strip, uint8_t red, uint8_t green, uint8_t blue)
+{
+    if (strip >= p_multi->strip_cnt) {
+        return;
+    }
+    for (uint32_t i = 0; i < p_multi->strip[strip].led_cnt; i++)
+    {
+        p_multi->strip[strip].p_pixel_grb_buf[i].grb_color.u32_grb = RGB_TO_GRB(red, green, blue);
+    }
+    p_multi->is_dirty = true;
+}
+
+/**
+ * @brief 全ストリップを消灯(バッファだけ)
+ */
+void drv_neopixel_multi_clear(neopixel_multi_t *p_multi)
+{
+    for (uint32_t s = 0; s < p_multi->strip_cnt; s++)
+    {
+        memset(p_multi->strip[s].p_pixel_grb_buf, 0, p_multi->strip[s].led_cnt * sizeof(rgb_color_t));
+    }
+    p_multi->is_dirty = true;
+}
+
+/**
+ * @brief 変更があれば全ストリップを1フレームで送信
+ *
+ * @return true 送信した(or 送信中のフレームの次に保留した)
+ */
+bool drv_neopixel_multi_commit(neopixel_multi_t *p_multi)
+{
+    if (!p_multi->is_dirty) {
+        return false;
+    }
+    p_multi->is_dirty = false;
+    multi_commit(p_multi);
+
+    return true;
+}
+
+/**
+ * @brief 送信中(ラッチ期間と保留フレームを含む)か
+ */
+bool drv_neopixel_multi_is_busy(void)
+{
+    return s_is_tx_busy;
+}
+
+/**
+ * @brief 送信中のフレームと保留フレームの完了待ち
+ */
+void drv_neopixel_multi_wait(void)
+{
+    while (s_is_tx_busy) {
+        tight_loop_contents();
+    }
+}
+
+// ベンチマーク用のストリップを設定
+static void multi_bench_setup(uint32_t strip_cnt, uint32_t led_cnt)
+{
+    s_bench.pin_base = (s_p_multi != NULL) ? s_p_multi->pin_base : 0;
+    s_bench.strip_cnt = (uint8_t)strip_cnt;
+    for (uint32_t s = 0; s < strip_cnt; s++)
+    {
+        s_bench.strip[s].led_cnt = (uint8_t)led_cnt;
+        s_bench.strip[s].p_pixel_grb_buf = s_bench_buf[s];
+    }
+}
+
+/**
+ * @brief ストリップの本数ごとに達成フレームレートと、同じLED数を1本で送った場合との比、
+ *        並べ替え(参照実装と8x8転置)のLEDあたりのサイクル数を計測
+ * @note 初期化した本数より多いストリップのビットはピンに出ないだけで、送信時間は同じ
+ *
+ * @param led_cnt 1ストリップのLEDの数(1～NEOPIXEL_MULTI_LED_MAX)
+ * @param frame_cnt ストリップの本数ごとのフレーム数
+ */
+void drv_neopixel_multi_bench(uint32_t led_cnt, uint32_t frame_cnt)
+{
+    static const uint8_t s_strip_tbl[] = {1, 2, 4, 8, 16, 32};
+    uint32_t cyc_per_us = clock_get_hz(clk_sys) / 1000000;
+
+    if (s_p_multi == NULL) {
+        printf("Error: Parallel NeoPixel is not initialized\n");
+        return;
+    }
+
+    // 暗い縞模様(ストリップごとに位相をずらす)
+    for (uint32_t s = 0; s < NEOPIXEL_STRIP_MAX; s++)
+    {
+        for (uint32_t i = 0; i < NEOPIXEL_MULTI_LED_MAX; i++)
+        {
+            s_bench_buf[s][i].grb_color.u32_grb = ((i + s) & 1u) ? RGB_TO_GRB(0, 0, 4) : RGB_TO_GRB(4, 0, 0);
+        }
+    }
+
+    printf("\n[NeoPixel Parallel Bench] %u LEDs/strip x %u frames, %u MHz, %u strip(s) wired at GPIO%u\n",
+            led_cnt, frame_cnt, cyc_per_us, s_p_multi->strip_cnt, s_p_multi->pin_base);
+    printf("Strips   LEDs  CPU us/frame   fps  serial fps  LED/s      speedup\n");
+
+    drv_neopixel_multi_wait();
+    for (uint32_t t = 0; t < count_of(s_strip_tbl); t++)
+    {
+        uint32_t strip_cnt = s_strip_tbl[t];
+        uint32_t t0_cyc, done0, fps, serial_fps, total_led;
+        uint64_t cpu_cyc = 0, t0_us, elapsed_us;
+
+        multi_bench_setup(strip_cnt, led_cnt);
+        done0 = s_tx_frame_cnt;
+        t0_us = time_us_64();
+        for (uint32_t f = 0; f < frame_cnt; f++)
+        {
+            t0_cyc = rp2xxx_get_cycle_cnt();
+            multi_commit(&s_bench);
+            cpu_cyc += rp2xxx_get_cycle_cnt() - t0_cyc;
+            drv_neopixel_multi_wait();
+        }
+        elapsed_us = time_us_64() - t0_us;
+
+        total_led = strip_cnt * led_cnt;
+        fps = (elapsed_us != 0) ? (uint32_t)(((uint64_t)(s_tx_frame_cnt - done0) * 1000000u) / elapsed_us) : 0;
+        serial_fps = (uint32_t)(1000000u / (uint64_t)multi_frame_us(total_led));
+        printf("%6u %6u %13u %5u %11u %8u   x%u.%02u\n",
+                strip_cnt, total_led, (uint32_t)(cpu_cyc / frame_cnt) / cyc_per_us, fps, serial_fps,
+                fps * total_led, (serial_fps != 0) ? fps / serial_fps : 0,
+                (serial_fps != 0) ? ((fps % serial_fps) * 100u) / serial_fps : 0);
+    }
+
+    // 並べ替えだけ(送信していない方のバッファへ)
+    printf("Transpose (cyc/LED)     ref    8x8  speedup\n");
+    for (uint32_t t = 3; t < count_of(s_strip_tbl); t++)
+    {
+        uint32_t strip_cnt = s_strip_tbl[t];
+        uint32_t *p_dst = s_frame[s_tx_idx ^ 1u];
+        uint32_t t0_cyc, ref_cyc, fast_cyc, pixel_cnt = strip_cnt * led_cnt;
+
+        multi_bench_setup(strip_cnt, led_cnt);
+        t0_cyc = rp2xxx_get_cycle_cnt();
+        multi_transpose_ref(&s_bench, p_dst);
+        ref_cyc = rp2xxx_get_cycle_cnt() - t0_cyc;
+        t0_cyc = rp2xxx_get_cycle_cnt();
+        multi_transpose(&s_bench, p_dst);
+        fast_cyc = rp2xxx_get_cycle_cnt() - t0_cyc;
+        printf("%2u strips %12u.%u %3u.%u   x%u.%u\n", strip_cnt,
+                ref_cyc / pixel_cnt, ((ref_cyc * 10u) / pixel_cnt) % 10u,
+                fast_cyc / pixel_cnt, ((fast_cyc * 10u) / pixel_cnt) % 10u,
+                (fast_cyc != 0) ? ref_cyc / fast_cyc : 0, (fast_cyc != 0) ? ((ref_cyc * 10u) / fast_cyc) % 10u : 0);
+    }
+
+    // 元の表示に戻す
+    multi_commit(s_p_multi);
+    drv_neopixel_multi_wait();
+}
+
+/**
+ * @brief 8x8転置の並べ替えを参照実装と比較する自己テスト(本数/長さ/画素を乱数で変える)
+ *
+ * @param loop_cnt テスト回数
+ * @return true 全て一致
+ */
+bool drv_neopixel_multi_test(uint32_t loop_cnt)
+{
+    uint32_t *p_ref = s_frame[0];
+    uint32_t *p_out = s_frame[1];
+
+    // 送信中のフレームを壊さないように両方のバッファが空くまで待つ
+    drv_neopixel_multi_wait();
+    for (uint32_t n = 0; n < loop_cnt; n++)
+    {
+        uint32_t strip_cnt = 1u + (get_rand_32() % NEOPIXEL_STRIP_MAX);
+        uint32_t led_ref, led_out;
+
+        s_bench.strip_cnt = (uint8_t)strip_cnt;
+        for (uint32_t s = 0; s < strip_cnt; s++)
+        {
+            s_bench.strip[s].led_cnt = (uint8_t)(get_rand_32() % (NEOPIXEL_MULTI_LED_MAX + 1u));
+            s_bench.strip[s].p_pixel_grb_buf = s_bench_buf[s];
+            for (uint32_t i = 0; i < s_bench.strip[s].led_cnt; i++)
+            {
+                s_bench_buf[s][i].grb_color.u32_grb = get_rand_32() & 0x00FFFFFFu;
+            }
+        }
+
+        led_ref = multi_transpose_ref(&s_bench, p_ref);
+        memset(p_out, 0xA5, led_ref * NEOPIXEL_MULTI_BIT_WORDS * sizeof(uint32_t));
+        led_out = multi_transpose(&s_bench, p_out);
+        if ((led_ref != led_out) ||
+            (memcmp(p_ref, p_out, led_ref * NEOPIXEL_MULTI_BIT_WORDS * sizeof(uint32_t)) != 0)) {
+            for (uint32_t w = 0; w < (led_ref * NEOPIXEL_MULTI_BIT_WORDS); w++)
+            {
+                if (p_ref[w] != p_out[w]) {
+                    printf("Error: Transpose mismatch (case %u, %u strips, LED %u, bit %u) ref 0x%08X != 0x%08X\n",
+                            n, strip_cnt, w / NEOPIXEL_MULTI_BIT_WORDS, w % NEOPIXEL_MULTI_BIT_WORDS, p_ref[w], p_out[w]);
+                    break;
+                }
+            }
+            return false;
+        }
+    }
+    printf("[NeoPixel Transpose Test] %u cases OK (1-%d strips, 0-%d LEDs)\n",
+            loop_cnt, NEOPIXEL_STRIP_MAX, NEOPIXEL_MULTI_LED_MAX);
+
+    // 壊したバッファを元の表示で作り直す
+    if (s_p_multi != NULL) {
+        multi_commit(s_p_multi);
+    }
+
+    return true;
+}
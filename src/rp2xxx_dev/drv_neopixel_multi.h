@@ -0,0 +1,45 @@
+/**
+ * @file drv_neopixel_multi.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief NeoPixelの複数ストリップ並列ドライバ(PIO neopixel_parallel + DMA)のヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026 Chimipupu All Rights Reserved.
+ *
+ */
+#ifndef DRV_NEOPIXEL_MULTI_H
+#define DRV_NEOPIXEL_MULTI_H
+
+#include "drv_neopixel.h"
+
+#define NEOPIXEL_STRIP_MAX          32      // 1つのステートマシンで駆動するストリップの最大数(連続したピン、8の倍数)
+#define NEOPIXEL_MULTI_LED_MAX      128     // 1ストリップのLEDの最大数
+#define NEOPIXEL_MULTI_BIT_WORDS    24      // 1LED分の語数(1語 = 全ストリップの同じビット)
+
+// 1本のストリップ(長さはストリップごとに違ってよい)
+typedef struct {
+    uint8_t led_cnt;
+    rgb_color_t *p_pixel_grb_buf;
+} neopixel_strip_t;
+
+typedef struct {
+    uint8_t pin_base;                               // ストリップ0のピン(以降のストリップは連続したピン)
+    uint8_t strip_cnt;
+    neopixel_strip_t strip[NEOPIXEL_STRIP_MAX];
+    bool is_dirty;                                  // 最後のコミットからバッファを書き換えた
+} neopixel_multi_t;
+
+// 関数プロトタイプ
+bool drv_neopixel_multi_init(neopixel_multi_t *p_multi);
+void drv_neopixel_multi_set_pixel_rgb(neopixel_multi_t *p_multi, uint8_t strip, uint8_t led,
+                                      uint8_t red, uint8_t green, uint8_t blue);
+void drv_neopixel_multi_set_strip_rgb(neopixel_multi_t *p_multi, uint8_t strip, uint8_t red, uint8_t green, uint8_t blue);
+void drv_neopixel_multi_clear(neopixel_multi_t *p_multi);
+bool drv_neopixel_multi_commit(neopixel_multi_t *p_multi);
+bool drv_neopixel_multi_is_busy(void);
+void drv_neopixel_multi_wait(void);
+void drv_neopixel_multi_bench(uint32_t led_cnt, uint32_t frame_cnt);
+bool drv_neopixel_multi_test(uint32_t loop_cnt);
+
+#endif // DRV_NEOPIXEL_MULTI_H
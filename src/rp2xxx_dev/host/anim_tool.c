@@ -0,0 +1,294 @@
+/**
+ * @file anim_tool.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief LEDアニメーション(差分 + RLE圧縮)のホスト用エンコーダ/ベンチマーク
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026 Chimipupu All Rights Reserved.
+ *
+ * F/Wと同じapp_anim_codec.cで圧縮し、圧縮率と展開の速さを測る。
+ * 出力ファイルはそのままFlashのアニメーション領域(ANIM_FLASH_OFFSET)に書けば px play で再生できる。
+ *   例) rp2xxx_anim_tool encode show.rgb 144 60 show.anm
+ *       picotool load -o 0x103BF000 show.anm   ※4MBのFlashの場合(XIP_BASE + ANIM_FLASH_OFFSET)
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "app_anim_codec.h"
+
+#define ANIM_TOOL_BENCH_LOOPS   100     // 展開のベンチマークの既定の回数
+
+static uint64_t tool_now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ull) + (uint64_t)ts.tv_nsec;
+}
+
+static void tool_usage(void)
+{
+    printf("Usage:\n");
+    printf("  rp2xxx_anim_tool encode <in.rgb> <leds> <fps> <out.anm>  raw RGB frames (3 B/LED) -> animation\n");
+    printf("  rp2xxx_anim_tool demo <leds> <frames> <fps> <out.anm>    demo clip (same as px play demo)\n");
+    printf("  rp2xxx_anim_tool bench <in.anm> [loops]                  decode speed\n");
+}
+
+// 圧縮データを全フレーム展開(p_ref != NULLなら元のフレームと比較)
+static int tool_decode_all(const anim_hdr_t *p_hdr, const uint8_t *p_data, const uint8_t *p_ref)
+{
+    uint32_t frame_len = p_hdr->led_cnt * ANIM_BYTE_PER_LED;
+    uint8_t *p_frame = calloc(1, frame_len);
+    uint32_t pos = 0, len;
+
+    for (uint32_t f = 0; f < p_hdr->frame_cnt; f++)
+    {
+        len = anim_decode_frame(&p_data[pos], p_hdr->data_len - pos, p_frame, p_hdr->led_cnt);
+        if ((len == 0) || ((p_ref != NULL) && (memcmp(p_frame, &p_ref[f * frame_len], frame_len) != 0))) {
+            fprintf(stderr, "Error: Frame %u does not decode back to the source\n", f);
+            free(p_frame);
+            return -1;
+        }
+        pos += len;
+    }
+    free(p_frame);
+
+    return (pos == p_hdr->data_len) ? 0 : -1;
+}
+
+// 展開の速さ
+static void tool_bench(const anim_hdr_t *p_hdr, const uint8_t *p_data, uint32_t loop_cnt)
+{
+    uint32_t frame_len = p_hdr->led_cnt * ANIM_BYTE_PER_LED;
+    uint8_t *p_frame = calloc(1, frame_len);
+    uint64_t t0_ns, ns, frame_total;
+    uint32_t pos;
+
+    t0_ns = tool_now_ns();
+    for (uint32_t n = 0; n < loop_cnt; n++)
+    {
+        memset(p_frame, 0, frame_len);
+        pos = 0;
+        for (uint32_t f = 0; f < p_hdr->frame_cnt; f++)
+        {
+            pos += anim_decode_frame(&p_data[pos], p_hdr->data_len - pos, p_frame, p_hdr->led_cnt);
+        }
+    }
+    ns = tool_now_ns() - t0_ns;
+    free(p_frame);
+
+    frame_total = (uint64_t)p_hdr->frame_cnt * loop_cnt;
+    ns = (ns != 0) ? ns : 1;
+    printf("Decode   : %u frames x %u loops in %.2f ms\n", p_hdr->frame_cnt, loop_cnt, (double)ns / 1e6);
+    printf("Speed    : %.1f ns/frame, %.2f ns/LED, %.1f MB/s compressed, %.1f MB/s raw, %.0f frames/s\n",
+            (double)ns / (double)frame_total, (double)ns / (double)(frame_total * p_hdr->led_cnt),
+            ((double)p_hdr->data_len * loop_cnt * 1e3) / (double)ns,
+            ((double)frame_total * frame_len * 1e3) / (double)ns, ((double)frame_total * 1e9) / (double)ns);
+}
+
+// フレームの並びを圧縮してファイルへ(確認の展開とベンチマーク付き)
+static int tool_encode(const uint8_t *p_frames, uint32_t led_cnt, uint32_t frame_cnt, uint32_t fps, const char *p_out)
+{
+    uint32_t frame_len = led_cnt * ANIM_BYTE_PER_LED;
+    uint8_t *p_img = malloc(sizeof(anim_hdr_t) + ((size_t)frame_cnt * ANIM_FRAME_BOUND(led_cnt)));
+    uint8_t *p_black = calloc(1, frame_len);
+    uint32_t len = sizeof(anim_hdr_t), key_max = 0, raw_len = frame_cnt * frame_len;
+    anim_hdr_t hdr;
+    uint64_t t0_ns, enc_ns;
+    FILE *p_fp;
+    int ret;
+
+    t0_ns = tool_now_ns();
+    for (uint32_t f = 0; f < frame_cnt; f++)
+    {
+        const uint8_t *p_prev = (f == 0) ? p_black : &p_frames[(f - 1) * frame_len];
+        uint32_t n = anim_encode_frame(&p_frames[f * frame_len], p_prev, led_cnt, &p_img[len]);
+        key_max = (n > key_max) ? n : key_max;
+        len += n;
+    }
+    enc_ns = tool_now_ns() - t0_ns;
+    free(p_black);
+
+    hdr.magic = ANIM_MAGIC;
+    hdr.led_cnt = (uint16_t)led_cnt;
+    hdr.fps = (uint16_t)fps;
+    hdr.frame_cnt = frame_cnt;
+    hdr.data_len = len - sizeof(anim_hdr_t);
+    memcpy(p_img, &hdr, sizeof(hdr));
+
+    ret = tool_decode_all(&hdr, &p_img[sizeof(hdr)], p_frames);
+    if (ret != 0) {
+        free(p_img);
+        return ret;
+    }
+
+    p_fp = fopen(p_out, "wb");
+    if ((p_fp == NULL) || (fwrite(p_img, 1, len, p_fp) != len)) {
+        fprintf(stderr, "Error: Failed to write %s\n", p_out);
+        if (p_fp != NULL) {
+            fclose(p_fp);
+        }
+        free(p_img);
+        return -1;
+    }
+    fclose(p_fp);
+
+    printf("\n[Anim] %s: %u LEDs x %u frames @ %u fps\n", p_out, led_cnt, frame_cnt, fps);
+    printf("Size     : %u B (raw %u B, ratio %.2fx), avg %u B/frame, max %u B/frame\n",
+            len, raw_len, (double)raw_len / (double)len, hdr.data_len / frame_cnt, key_max);
+    printf("Encode   : %.2f ms, round trip OK\n", (double)enc_ns / 1e6);
+    tool_bench(&hdr, &p_img[sizeof(hdr)], ANIM_TOOL_BENCH_LOOPS);
+    free(p_img);
+
+    return 0;
+}
+
+static int tool_cmd_encode(int argc, char **argv)
+{
+    uint32_t led_cnt, fps, frame_len, frame_cnt;
+    uint8_t *p_frames;
+    long size;
+    FILE *p_fp;
+    int ret;
+
+    if (argc != 6) {
+        tool_usage();
+        return 1;
+    }
+    led_cnt = (uint32_t)atoi(argv[3]);
+    fps = (uint32_t)atoi(argv[4]);
+    if ((led_cnt == 0) || (led_cnt > UINT16_MAX) || (fps == 0) || (fps > 1000)) {
+        fprintf(stderr, "Error: LEDs must be 1-%u and fps 1-1000\n", UINT16_MAX);
+        return 1;
+    }
+
+    p_fp = fopen(argv[2], "rb");
+    if (p_fp == NULL) {
+        fprintf(stderr, "Error: Failed to open %s\n", argv[2]);
+        return 1;
+    }
+    fseek(p_fp, 0, SEEK_END);
+    size = ftell(p_fp);
+    fseek(p_fp, 0, SEEK_SET);
+    frame_len = led_cnt * ANIM_BYTE_PER_LED;
+    frame_cnt = (uint32_t)(size / frame_len);
+    if (frame_cnt == 0) {
+        fprintf(stderr, "Error: %s is shorter than one frame (%u B)\n", argv[2], frame_len);
+        fclose(p_fp);
+        return 1;
+    }
+    p_frames = malloc((size_t)frame_cnt * frame_len);
+    if (fread(p_frames, 1, (size_t)frame_cnt * frame_len, p_fp) != ((size_t)frame_cnt * frame_len)) {
+        fprintf(stderr, "Error: Failed to read %s\n", argv[2]);
+        fclose(p_fp);
+        free(p_frames);
+        return 1;
+    }
+    fclose(p_fp);
+
+    // RGB -> GRB(ワイヤの順)
+    for (uint32_t i = 0; i < (frame_cnt * led_cnt); i++)
+    {
+        uint8_t red = p_frames[(i * ANIM_BYTE_PER_LED) + 0];
+        p_frames[(i * ANIM_BYTE_PER_LED) + 0] = p_frames[(i * ANIM_BYTE_PER_LED) + 1];
+        p_frames[(i * ANIM_BYTE_PER_LED) + 1] = red;
+    }
+
+    ret = tool_encode(p_frames, led_cnt, frame_cnt, fps, argv[5]);
+    free(p_frames);
+
+    return (ret == 0) ? 0 : 1;
+}
+
+static int tool_cmd_demo(int argc, char **argv)
+{
+    uint32_t led_cnt, frame_cnt, fps, frame_len;
+    uint8_t *p_frames;
+    int ret;
+
+    if (argc != 6) {
+        tool_usage();
+        return 1;
+    }
+    led_cnt = (uint32_t)atoi(argv[2]);
+    frame_cnt = (uint32_t)atoi(argv[3]);
+    fps = (uint32_t)atoi(argv[4]);
+    if ((led_cnt == 0) || (led_cnt > UINT16_MAX) || (frame_cnt == 0) || (fps == 0) || (fps > 1000)) {
+        fprintf(stderr, "Error: LEDs must be 1-%u, frames 1 or more and fps 1-1000\n", UINT16_MAX);
+        return 1;
+    }
+
+    frame_len = led_cnt * ANIM_BYTE_PER_LED;
+    p_frames = malloc((size_t)frame_cnt * frame_len);
+    for (uint32_t f = 0; f < frame_cnt; f++)
+    {
+        anim_render_demo(&p_frames[f * frame_len], led_cnt, f);
+    }
+    ret = tool_encode(p_frames, led_cnt, frame_cnt, fps, argv[5]);
+    free(p_frames);
+
+    return (ret == 0) ? 0 : 1;
+}
+
+static int tool_cmd_bench(int argc, char **argv)
+{
+    anim_hdr_t hdr;
+    uint8_t *p_data;
+    uint32_t loop_cnt = (argc >= 4) ? (uint32_t)atoi(argv[3]) : ANIM_TOOL_BENCH_LOOPS;
+    FILE *p_fp;
+
+    if ((argc < 3) || (loop_cnt == 0)) {
+        tool_usage();
+        return 1;
+    }
+    p_fp = fopen(argv[2], "rb");
+    if ((p_fp == NULL) || (fread(&hdr, 1, sizeof(hdr), p_fp) != sizeof(hdr)) || !anim_check_hdr(&hdr, UINT32_MAX)) {
+        fprintf(stderr, "Error: %s is not an animation\n", argv[2]);
+        if (p_fp != NULL) {
+            fclose(p_fp);
+        }
+        return 1;
+    }
+    p_data = malloc(hdr.data_len);
+    if (fread(p_data, 1, hdr.data_len, p_fp) != hdr.data_len) {
+        fprintf(stderr, "Error: %s is truncated\n", argv[2]);
+        fclose(p_fp);
+        free(p_data);
+        return 1;
+    }
+    fclose(p_fp);
+
+    printf("\n[Anim] %s: %u LEDs x %u frames @ %u fps, %u B (raw %u B, ratio %.2fx)\n", argv[2], hdr.led_cnt,
+            hdr.frame_cnt, hdr.fps, hdr.data_len + (uint32_t)sizeof(hdr),
+            hdr.frame_cnt * hdr.led_cnt * ANIM_BYTE_PER_LED,
+            (double)(hdr.frame_cnt * hdr.led_cnt * ANIM_BYTE_PER_LED) / (double)(hdr.data_len + sizeof(hdr)));
+    if (tool_decode_all(&hdr, p_data, NULL) != 0) {
+        fprintf(stderr, "Error: %s is corrupted\n", argv[2]);
+        free(p_data);
+        return 1;
+    }
+    tool_bench(&hdr, p_data, loop_cnt);
+    free(p_data);
+
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc >= 2) {
+        if (strcmp(argv[1], "encode") == 0) {
+            return tool_cmd_encode(argc, argv);
+        } else if (strcmp(argv[1], "demo") == 0) {
+            return tool_cmd_demo(argc, argv);
+        } else if (strcmp(argv[1], "bench") == 0) {
+            return tool_cmd_bench(argc, argv);
+        }
+    }
+    tool_usage();
+
+    return 1;
+}
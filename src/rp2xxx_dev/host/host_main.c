@@ -0,0 +1,41 @@
+/**
+ * @file host_main.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief ホスト(Linux)ビルド用のmain() ※hw_init.cの代わり
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026 Chimipupu All Rights Reserved.
+ *
+ * 標準入力をシリアルモニタのキー入力として扱う。
+ * パイプで流し込めばコマンドを順に実行し、入力が尽きたら終了する。
+ *   例) printf 'help\nmemd #20000000 #40\n' | ./rp2xxx_dev_host
+ */
+#include "muc_rpxxx_util.h"
+#include "app_main.h"
+#include "app_load.h"
+
+#include "pico/multicore.h"
+
+int main(void)
+{
+    // 疑似メモリマップ/端末の初期化
+    host_sdk_init();
+
+    // Pico SDKの初期化
+    stdio_init_all();
+
+    printf("System Clock Frequency is %d Hz\n", clock_get_hz(clk_sys));
+    printf("USB Clock Frequency is %d Hz\n", clock_get_hz(clk_usb));
+
+    // スタックを塗って負荷のサンプリング開始(Core1の起動前)
+    app_load_init();
+
+    // CPU Core1を起動
+    multicore_launch_core1(core_1_main);
+
+    // CPU Core0 アプリメイン
+    core_0_main();
+
+    return 0;
+}
@@ -0,0 +1,478 @@
+/**
+ * @file host_pio_emu.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief ホスト(Linux)ビルド用 PIOステートマシンのサイクル精度エミュレータ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026 Chimipupu All Rights Reserved.
+ *
+ * - 対応命令 ... JMP(PIN以外), OUT(pins/x/y/null/pindirs/pc), PULL, MOV(pins/x/y/osr/pc, 反転/ビット反転), SET, NOP
+ *   IN/PUSH/WAIT/IRQ等はエラー(is_err)で止まる
+ * - サイドセット(オプション有無)、ディレイ、wrap、TX FIFOと自動プル(しきい値/シフト方向)
+ * - クロック分周 ... 8.8固定小数点。tick番目のSMクロックはstart + floor(tick * div)サイクル(小数分周のジッタも再現)
+ * - 出力ピンが変化したサイクルをエッジとして記録し、NeoPixel(WS2812)のビットに復号/VCDに出力できる
+ */
+#define HOST_SDK_IMPL
+#include "host_pio_emu.h"
+
+// WS2812Bの規格(データシート ±150ns)
+#define WAVE_T0H_MIN_NS         250
+#define WAVE_T0H_MAX_NS         550
+#define WAVE_T1H_MIN_NS         650
+#define WAVE_T1H_MAX_NS         950
+#define WAVE_T0L_MIN_NS         700
+#define WAVE_T0L_MAX_NS         1000
+#define WAVE_T1L_MIN_NS         300
+#define WAVE_T1L_MAX_NS         600
+#define WAVE_BIT_THRESH_NS      625     // Highがこれより長ければ1
+
+static uint32_t emu_div_x256(const host_pio_emu_t *p_emu)
+{
+    // 分周0は65536分周
+    return (p_emu->config.clkdiv_x256 == 0) ? (65536u * 256u) : p_emu->config.clkdiv_x256;
+}
+
+// cycle以降で最初のSMクロックのtick
+static uint64_t emu_tick_at(const host_pio_emu_t *p_emu, uint64_t cycle)
+{
+    uint64_t div = emu_div_x256(p_emu);
+
+    if (cycle <= p_emu->start_cycle) {
+        return 0;
+    }
+    return (((cycle - p_emu->start_cycle) * 256u) + div - 1) / div;
+}
+
+static void emu_write_pins(host_pio_emu_t *p_emu, uint32_t base, uint32_t cnt, uint32_t val)
+{
+    uint32_t pins = p_emu->pins;
+
+    for (uint32_t i = 0; i < cnt; i++)
+    {
+        uint32_t bit = 1u << ((base + i) % 32u);
+        pins = ((val >> i) & 1u) ? (pins | bit) : (pins & ~bit);
+    }
+    if (pins == p_emu->pins) {
+        return;
+    }
+    p_emu->pins = pins;
+
+    if ((p_emu->p_edge != NULL) && (p_emu->edge_cnt < p_emu->edge_max)) {
+        p_emu->p_edge[p_emu->edge_cnt].cycle = host_pio_emu_cycle(p_emu, p_emu->tick);
+        p_emu->p_edge[p_emu->edge_cnt].pins = pins;
+        p_emu->edge_cnt++;
+    }
+}
+
+static bool emu_fifo_pop(host_pio_emu_t *p_emu, uint32_t *p_data)
+{
+    if (p_emu->fifo_level == 0) {
+        return false;
+    }
+    *p_data = p_emu->fifo[p_emu->fifo_rd];
+    p_emu->fifo_rd = (p_emu->fifo_rd + 1) % p_emu->fifo_depth;
+    p_emu->fifo_level--;
+
+    return true;
+}
+
+static uint32_t emu_bit_reverse(uint32_t val)
+{
+    uint32_t ret = 0;
+
+    for (uint32_t i = 0; i < 32; i++)
+    {
+        ret = (ret << 1) | ((val >> i) & 1u);
+    }
+    return ret;
+}
+
+// サイドセット(命令の実行サイクルで反映、ストール中も出る)とディレイ
+static uint32_t emu_side_set(host_pio_emu_t *p_emu, uint16_t instr)
+{
+    const pio_sm_config *c = &p_emu->config;
+    uint32_t field = (instr >> 8) & 0x1fu;
+    uint32_t delay_bits = 5u - c->sideset_count;
+    uint32_t val_bits = c->sideset_optional ? (c->sideset_count - 1u) : c->sideset_count;
+
+    if ((c->sideset_count != 0) && (!c->sideset_optional || (field & 0x10u)) && !c->sideset_pindirs) {
+        emu_write_pins(p_emu, c->sideset_base, val_bits, (field >> delay_bits) & ((1u << val_bits) - 1u));
+    }
+
+    return field & ((1u << delay_bits) - 1u);
+}
+
+/**
+ * @brief 1命令の実行
+ *
+ * @return true 完了(pcとtickを進めた)
+ * @return false FIFOが空でストール or 非対応の命令
+ */
+static bool emu_exec(host_pio_emu_t *p_emu)
+{
+    const pio_sm_config *c = &p_emu->config;
+    uint16_t instr = p_emu->instr[p_emu->pc];
+    uint32_t dst = (instr >> 5) & 0x7u;
+    uint32_t delay = emu_side_set(p_emu, instr);
+    uint32_t next = (p_emu->pc == c->wrap) ? c->wrap_target : ((p_emu->pc + 1u) % PIO_INSTRUCTION_COUNT);
+    uint32_t val = 0, cnt;
+    bool is_jmp = false;
+
+    switch (instr >> 13)
+    {
+        case 0x0: // JMP
+            switch (dst)
+            {
+                case 0: is_jmp = true; break;
+                case 1: is_jmp = (p_emu->x == 0); break;
+                case 2: is_jmp = (p_emu->x != 0); p_emu->x--; break;
+                case 3: is_jmp = (p_emu->y == 0); break;
+                case 4: is_jmp = (p_emu->y != 0); p_emu->y--; break;
+                case 5: is_jmp = (p_emu->x != p_emu->y); break;
+                case 7: is_jmp = (p_emu->osr_cnt < c->pull_threshold); break;
+                default: p_emu->is_err = true; return false;
+            }
+            if (is_jmp) {
+                next = instr & 0x1fu;
+            }
+            break;
+
+        case 0x3: // OUT
+            cnt = ((instr & 0x1fu) == 0) ? 32u : (instr & 0x1fu);
+            if (c->autopull && (p_emu->osr_cnt >= c->pull_threshold)) {
+                if (!emu_fifo_pop(p_emu, &p_emu->osr)) {
+                    return false;
+                }
+                p_emu->osr_cnt = 0;
+            }
+            if (c->out_shift_right) {
+                val = (cnt == 32u) ? p_emu->osr : (p_emu->osr & ((1u << cnt) - 1u));
+                p_emu->osr = (cnt == 32u) ? 0 : (p_emu->osr >> cnt);
+            } else {
+                val = p_emu->osr >> (32u - cnt);
+                p_emu->osr = (cnt == 32u) ? 0 : (p_emu->osr << cnt);
+            }
+            p_emu->osr_cnt = ((p_emu->osr_cnt + cnt) > 32u) ? 32u : (p_emu->osr_cnt + cnt);
+            switch (dst)
+            {
+                case 0: emu_write_pins(p_emu, c->out_base, c->out_count, val); break;
+                case 1: p_emu->x = val; break;
+                case 2: p_emu->y = val; break;
+                case 3: break;
+                case 4: break;  // pindirs(出力方向は常に出力として扱う)
+                case 5: is_jmp = true; next = val & 0x1fu; break;
+                default: p_emu->is_err = true; return false;
+            }
+            break;
+
+        case 0x4: // PULL(PUSHは非対応)
+            if ((instr & 0x80u) == 0) {
+                p_emu->is_err = true;
+                return false;
+            }
+            if ((instr & 0x40u) && (p_emu->osr_cnt < c->pull_threshold)) {
+                break;  // IfEmpty
+            }
+            if (!emu_fifo_pop(p_emu, &p_emu->osr)) {
+                if (instr & 0x20u) {
+                    return false;   // Block
+                }
+                p_emu->osr = p_emu->x;
+            }
+            p_emu->osr_cnt = 0;
+            break;
+
+        case 0x5: // MOV
+            switch (instr & 0x7u)
+            {
+                case 1: val = p_emu->x; break;
+                case 2: val = p_emu->y; break;
+                case 3: val = 0; break;
+                case 7: val = p_emu->osr; break;
+                default: p_emu->is_err = true; return false;
+            }
+            switch ((instr >> 3) & 0x3u)
+            {
+                case 1: val = ~val; break;
+                case 2: val = emu_bit_reverse(val); break;
+                default: break;
+            }
+            switch (dst)
+            {
+                case 0: emu_write_pins(p_emu, c->out_base, c->out_count, val); break;
+                case 1: p_emu->x = val; break;
+                case 2: p_emu->y = val; break;
+                case 5: is_jmp = true; next = val & 0x1fu; break;
+                case 7: p_emu->osr = val; p_emu->osr_cnt = 0; break;
+                default: p_emu->is_err = true; return false;
+            }
+            break;
+
+        case 0x7: // SET
+            val = instr & 0x1fu;
+            switch (dst)
+            {
+                case 0: emu_write_pins(p_emu, c->set_base, c->set_count, val); break;
+                case 1: p_emu->x = val; break;
+                case 2: p_emu->y = val; break;
+                case 4: break;
+                default: p_emu->is_err = true; return false;
+            }
+            break;
+
+        default: // WAIT/IN/IRQ
+            p_emu->is_err = true;
+            return false;
+    }
+
+    p_emu->pc = next;
+    p_emu->tick += 1u + delay;
+    p_emu->instr_cnt++;
+
+    return true;
+}
+
+/**
+ * @brief エミュレータの初期化
+ *
+ * @param p_emu エミュレータ
+ * @param p_instr 命令メモリ(32命令、ロード位置に再配置済み)
+ * @param p_config ステートマシンの設定
+ * @param initial_pc 開始アドレス
+ * @param start_cycle SMを有効にしたシステムクロックのサイクル
+ */
+void host_pio_emu_init(host_pio_emu_t *p_emu, const uint16_t *p_instr, const pio_sm_config *p_config,
+                        uint32_t initial_pc, uint64_t start_cycle)
+{
+    host_pio_edge_t *p_edge = p_emu->p_edge;
+    uint32_t edge_max = p_emu->edge_max;
+
+    memset(p_emu, 0, sizeof(host_pio_emu_t));
+    memcpy(p_emu->instr, p_instr, sizeof(p_emu->instr));
+    p_emu->config = *p_config;
+    p_emu->pc = initial_pc % PIO_INSTRUCTION_COUNT;
+    p_emu->osr_cnt = 32;    // OSRは空から始まる
+    p_emu->start_cycle = start_cycle;
+    p_emu->fifo_depth = (p_config->fifo_join == PIO_FIFO_JOIN_TX) ? HOST_PIO_EMU_FIFO_MAX : 4;
+    p_emu->p_edge = p_edge;
+    p_emu->edge_max = edge_max;
+}
+
+/**
+ * @brief tick番目のSMクロックのシステムクロックのサイクル
+ */
+uint64_t host_pio_emu_cycle(const host_pio_emu_t *p_emu, uint64_t tick)
+{
+    return p_emu->start_cycle + ((tick * emu_div_x256(p_emu)) >> 8);
+}
+
+/**
+ * @brief TX FIFOに1語積む
+ *
+ * @return true 積んだ
+ * @return false FIFOが満杯
+ */
+bool host_pio_emu_push(host_pio_emu_t *p_emu, uint32_t data)
+{
+    if (p_emu->fifo_level >= p_emu->fifo_depth) {
+        return false;
+    }
+    p_emu->fifo[(p_emu->fifo_rd + p_emu->fifo_level) % p_emu->fifo_depth] = data;
+    p_emu->fifo_level++;
+
+    return true;
+}
+
+/**
+ * @brief until_cycleより前のSMクロックの命令を実行
+ *
+ * FIFOが空でストールしたら、その命令のtickのまま戻る。
+ * 次の語を積んだら、積んだサイクル以降の最初のSMクロックから再実行する(呼び出し側がuntil_cycleで進める)。
+ *
+ * @param p_emu エミュレータ
+ * @param until_cycle ここまで(このサイクルは含まない)
+ * @return uint64_t 次の命令を実行するサイクル(ストール中/エラーはHOST_PIO_EMU_CYCLE_NEVER)
+ */
+uint64_t host_pio_emu_run(host_pio_emu_t *p_emu, uint64_t until_cycle)
+{
+    uint64_t cycle;
+
+    while (!p_emu->is_err)
+    {
+        cycle = host_pio_emu_cycle(p_emu, p_emu->tick);
+        if (cycle >= until_cycle) {
+            return cycle;
+        }
+        if (!emu_exec(p_emu)) {
+            if (!p_emu->is_err) {
+                p_emu->stall_cnt++;
+            }
+            return HOST_PIO_EMU_CYCLE_NEVER;
+        }
+    }
+    return HOST_PIO_EMU_CYCLE_NEVER;
+}
+
+/**
+ * @brief ストール中のSMを、cycle以降の最初のSMクロックから再開させる
+ */
+void host_pio_emu_resume(host_pio_emu_t *p_emu, uint64_t cycle)
+{
+    uint64_t tick = emu_tick_at(p_emu, cycle);
+
+    p_emu->tick = (tick > p_emu->tick) ? tick : p_emu->tick;
+}
+
+static void wave_minmax(uint32_t val, uint32_t *p_min, uint32_t *p_max)
+{
+    *p_min = (val < *p_min) ? val : *p_min;
+    *p_max = (val > *p_max) ? val : *p_max;
+}
+
+/**
+ * @brief 1本のピンの波形をNeoPixel(WS2812)のビットに復号して時間を測る
+ *
+ * @param p_edge エッジ(ピンは全て0から始まる)
+ * @param edge_cnt エッジの数
+ * @param pin GPIO番号
+ * @param clk_hz システムクロック
+ * @param p_bits 復号したビット(1ビット1バイト、NULLなら出力しない)
+ * @param bit_max p_bitsの大きさ
+ * @param p_stat 解析結果
+ * @return uint32_t 復号したビット数
+ */
+uint32_t host_pio_wave_decode(const host_pio_edge_t *p_edge, uint32_t edge_cnt, uint32_t pin,
+                                uint64_t clk_hz, uint8_t *p_bits, uint32_t bit_max, host_pio_wave_stat_t *p_stat)
+{
+    uint64_t base = (edge_cnt != 0) ? p_edge[0].cycle : 0;
+    uint64_t rise = 0, fall = 0, first_rise = 0;
+    bool level = false, has_bit = false;
+    uint32_t high_ns = 0, low_ns, bit_ns;
+    uint8_t bit = 0;
+
+    memset(p_stat, 0, sizeof(host_pio_wave_stat_t));
+    p_stat->t0h_min = p_stat->t1h_min = p_stat->t0l_min = p_stat->t1l_min = p_stat->bit_min = UINT32_MAX;
+
+    for (uint32_t i = 0; i < edge_cnt; i++)
+    {
+        bool now = ((p_edge[i].pins >> pin) & 1u) != 0;
+        uint64_t t_ns = ((p_edge[i].cycle - base) * 1000000000ull) / clk_hz;
+
+        if (now == level) {
+            continue;
+        }
+        level = now;
+
+        if (now) {
+            // 立ち上がり ... 前のビットのLowとビット周期が決まる
+            if (has_bit) {
+                low_ns = (uint32_t)(t_ns - fall);
+                bit_ns = (uint32_t)(t_ns - rise);
+                if (low_ns > (bit ? WAVE_T1L_MAX_NS : WAVE_T0L_MAX_NS)) {
+                    p_stat->gap_cnt++;
+                    p_stat->gap_max = (low_ns > p_stat->gap_max) ? low_ns : p_stat->gap_max;
+                } else {
+                    if (bit) {
+                        wave_minmax(low_ns, &p_stat->t1l_min, &p_stat->t1l_max);
+                        p_stat->bad_cnt += (low_ns < WAVE_T1L_MIN_NS) ? 1u : 0u;
+                    } else {
+                        wave_minmax(low_ns, &p_stat->t0l_min, &p_stat->t0l_max);
+                        p_stat->bad_cnt += (low_ns < WAVE_T0L_MIN_NS) ? 1u : 0u;
+                    }
+                    wave_minmax(bit_ns, &p_stat->bit_min, &p_stat->bit_max);
+                }
+            } else {
+                first_rise = t_ns;
+            }
+            rise = t_ns;
+        } else {
+            // 立ち下がり ... Highの時間でビットが決まる
+            fall = t_ns;
+            high_ns = (uint32_t)(fall - rise);
+            bit = (high_ns > WAVE_BIT_THRESH_NS) ? 1u : 0u;
+            if (bit) {
+                wave_minmax(high_ns, &p_stat->t1h_min, &p_stat->t1h_max);
+                p_stat->bad_cnt += ((high_ns < WAVE_T1H_MIN_NS) || (high_ns > WAVE_T1H_MAX_NS)) ? 1u : 0u;
+                p_stat->one_cnt++;
+            } else {
+                wave_minmax(high_ns, &p_stat->t0h_min, &p_stat->t0h_max);
+                p_stat->bad_cnt += ((high_ns < WAVE_T0H_MIN_NS) || (high_ns > WAVE_T0H_MAX_NS)) ? 1u : 0u;
+            }
+            if ((p_bits != NULL) && (p_stat->bit_cnt < bit_max)) {
+                p_bits[p_stat->bit_cnt] = bit;
+            }
+            p_stat->bit_cnt++;
+            p_stat->frame_ns = fall - first_rise;
+            has_bit = true;
+        }
+    }
+
+    // 1度も出てこなかった区分は0にする
+    p_stat->t0h_min = (p_stat->t0h_min == UINT32_MAX) ? 0 : p_stat->t0h_min;
+    p_stat->t1h_min = (p_stat->t1h_min == UINT32_MAX) ? 0 : p_stat->t1h_min;
+    p_stat->t0l_min = (p_stat->t0l_min == UINT32_MAX) ? 0 : p_stat->t0l_min;
+    p_stat->t1l_min = (p_stat->t1l_min == UINT32_MAX) ? 0 : p_stat->t1l_min;
+    p_stat->bit_min = (p_stat->bit_min == UINT32_MAX) ? 0 : p_stat->bit_min;
+
+    return p_stat->bit_cnt;
+}
+
+/**
+ * @brief 波形をVCD(GTKWave等で表示)に書き出す
+ *
+ * @param p_path 出力ファイル
+ * @param p_edge エッジ
+ * @param edge_cnt エッジの数
+ * @param pin_mask 書き出すピン(GPIO0～31のビット)
+ * @param clk_hz システムクロック
+ * @return true 書き出した
+ */
+bool host_pio_wave_write_vcd(const char *p_path, const host_pio_edge_t *p_edge, uint32_t edge_cnt,
+                                uint32_t pin_mask, uint64_t clk_hz)
+{
+    FILE *p_fp = fopen(p_path, "w");
+    uint64_t lead = clk_hz / 1000000u;  // 最初のエッジの前に1us空ける
+    uint64_t base = ((edge_cnt != 0) && (p_edge[0].cycle > lead)) ? (p_edge[0].cycle - lead) : 0;
+    uint32_t pins = 0;
+
+    if (p_fp == NULL) {
+        return false;
+    }
+
+    fprintf(p_fp, "$timescale 1ns $end\n$scope module pio $end\n");
+    for (uint32_t pin = 0; pin < 32; pin++)
+    {
+        if (pin_mask & (1u << pin)) {
+            fprintf(p_fp, "$var wire 1 %c gpio%u $end\n", (char)('!' + pin), pin);
+        }
+    }
+    fprintf(p_fp, "$upscope $end\n$enddefinitions $end\n#0\n$dumpvars\n");
+    for (uint32_t pin = 0; pin < 32; pin++)
+    {
+        if (pin_mask & (1u << pin)) {
+            fprintf(p_fp, "0%c\n", (char)('!' + pin));
+        }
+    }
+    fprintf(p_fp, "$end\n");
+
+    for (uint32_t i = 0; i < edge_cnt; i++)
+    {
+        uint32_t diff = (p_edge[i].pins ^ pins) & pin_mask;
+
+        pins = p_edge[i].pins;
+        if (diff == 0) {
+            continue;
+        }
+        fprintf(p_fp, "#%llu\n", (unsigned long long)(((p_edge[i].cycle - base) * 1000000000ull) / clk_hz));
+        for (uint32_t pin = 0; pin < 32; pin++)
+        {
+            if (diff & (1u << pin)) {
+                fprintf(p_fp, "%c%c\n", ((pins >> pin) & 1u) ? '1' : '0', (char)('!' + pin));
+            }
+        }
+    }
+    fclose(p_fp);
+
+    return true;
+}
@@ -0,0 +1,84 @@
+/**
+ * @file host_pio_emu.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief ホスト(Linux)ビルド用 PIOステートマシンのサイクル精度エミュレータのヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026 Chimipupu All Rights Reserved.
+ *
+ */
+#ifndef HOST_PIO_EMU_H
+#define HOST_PIO_EMU_H
+
+#include "host_sdk.h"
+
+#define HOST_PIO_EMU_FIFO_MAX       8       // TX FIFOの最大段数(TX結合時)
+#define HOST_PIO_EMU_CYCLE_NEVER    UINT64_MAX
+
+// 出力ピンの変化(エッジ)の記録
+typedef struct {
+    uint64_t cycle;     // 変化したシステムクロックのサイクル
+    uint32_t pins;      // 変化後の全ピン(GPIO0～31)
+} host_pio_edge_t;
+
+typedef struct {
+    // プログラムと設定
+    uint16_t instr[PIO_INSTRUCTION_COUNT];
+    pio_sm_config config;
+
+    // ステートマシン
+    uint32_t pc;
+    uint32_t x;
+    uint32_t y;
+    uint32_t osr;
+    uint32_t osr_cnt;           // OSRからシフトアウトしたビット数
+    uint32_t pins;
+    uint64_t tick;              // SMのクロック(分周後)の通し番号
+    uint64_t start_cycle;       // tick = 0のシステムクロックのサイクル
+    bool is_err;                // 対応していない命令を実行した
+
+    // TX FIFO
+    uint32_t fifo[HOST_PIO_EMU_FIFO_MAX];
+    uint32_t fifo_depth;
+    uint32_t fifo_level;
+    uint32_t fifo_rd;
+
+    // 統計
+    uint64_t instr_cnt;
+    uint64_t stall_cnt;         // FIFOが空でストールした回数
+
+    // エッジの記録(NULLなら記録しない)
+    host_pio_edge_t *p_edge;
+    uint32_t edge_cnt;
+    uint32_t edge_max;
+} host_pio_emu_t;
+
+// NeoPixelの波形の解析結果(時間は全てns)
+typedef struct {
+    uint32_t bit_cnt;
+    uint32_t one_cnt;
+    uint32_t t0h_min, t0h_max;
+    uint32_t t1h_min, t1h_max;
+    uint32_t t0l_min, t0l_max;  // 次のビットまでのLow(フレーム最後のビットは除く)
+    uint32_t t1l_min, t1l_max;
+    uint32_t bit_min, bit_max;  // ビット周期
+    uint32_t gap_cnt;           // ビット周期の上限を超えたLow(FIFOのアンダーラン)
+    uint32_t gap_max;
+    uint32_t bad_cnt;           // High/Lowの時間がWS2812の規格外のビット
+    uint64_t frame_ns;          // 最初の立ち上がり～最後の立ち下がり
+} host_pio_wave_stat_t;
+
+// 関数プロトタイプ
+void host_pio_emu_init(host_pio_emu_t *p_emu, const uint16_t *p_instr, const pio_sm_config *p_config,
+                        uint32_t initial_pc, uint64_t start_cycle);
+uint64_t host_pio_emu_cycle(const host_pio_emu_t *p_emu, uint64_t tick);
+bool host_pio_emu_push(host_pio_emu_t *p_emu, uint32_t data);
+uint64_t host_pio_emu_run(host_pio_emu_t *p_emu, uint64_t until_cycle);
+void host_pio_emu_resume(host_pio_emu_t *p_emu, uint64_t cycle);
+uint32_t host_pio_wave_decode(const host_pio_edge_t *p_edge, uint32_t edge_cnt, uint32_t pin,
+                                uint64_t clk_hz, uint8_t *p_bits, uint32_t bit_max, host_pio_wave_stat_t *p_stat);
+bool host_pio_wave_write_vcd(const char *p_path, const host_pio_edge_t *p_edge, uint32_t edge_cnt,
+                                uint32_t pin_mask, uint64_t clk_hz);
+
+#endif // HOST_PIO_EMU_H
@@ -0,0 +1,2377 @@
+/**
+ * @file host_sdk.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief ホスト(Linux)ビルド用 Pico SDKスタンドイン
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026 Chimipupu All Rights Reserved.
+ *
+ * - コア0/1 ... pthread(スレッドローカルでコア番号を持つ)
+ * - タイマー ... clock_gettime(CLOCK_MONOTONIC)、アラームは専用スレッドで発火
+ * - FIFO ... 実機と同じ深さのコア間キュー
+ * - PIO ... TX FIFOの深さとワード当たりのサイクル数で排出時刻をモデル化
+ *          環境変数RP2XXX_PIO_TRACEを設定すると、FIFOに積んだ語をフレーム毎にエミュレータ(host_pio_emu.c)で
+ *          実行し、出力ピンの波形のビットタイミング/フレーム時間/データを検証して標準エラーに出す
+ *          (RP2XXX_PIO_VCD=<接頭辞>で最初のフレームの波形を<接頭辞>_pioN_smM.vcdに書き出す)
+ * - SHA-256/TRNG ... ソフトウェアで再現
+ * - メモリマップ ... Flash/SRAM/SYSINFO/SIO/PPBを実機と同じアドレスにmmap
+ */
+#define _GNU_SOURCE
+#define HOST_SDK_IMPL
+#include "host_sdk.h"
+#include "host_pio_emu.h"
+
+#include <stdarg.h>
+#include <pthread.h>
+#include <poll.h>
+#include <unistd.h>
+#include <errno.h>
+#include <termios.h>
+#include <sys/mman.h>
+#include <sys/random.h>
+
+#define HOST_CLK_SYS_HZ         150000000u
+#define HOST_CLK_USB_HZ         48000000u
+#define HOST_CLK_REF_HZ         12000000u
+#define HOST_SIO_FIFO_DEPTH     4
+#define HOST_ALARM_MAX          64
+#define HOST_WFE_TIMEOUT_US     1000
+#define HOST_STDIO_BUF_SIZE     1024
+
+// -------------------------------------------------------------------------
+// [メモリマップ]
+// -------------------------------------------------------------------------
+#define HOST_SRAM_SIZE          (SRAM_END - SRAM_BASE)
+#define HOST_SYSINFO_MAP_SIZE   0x00100000u
+#define HOST_SIO_MAP_SIZE       0x00001000u
+#define HOST_PPB_MAP_SIZE       0x00010000u
+
+#define HOST_SYSINFO_CHIP_ID    0x20004927u // RP2350 A2
+#define HOST_SYSINFO_PACKAGE    0x00000001u // QFN-60(RP2350A)
+#define HOST_M33_CPUID          0x411FD210u // Cortex-M33 r1p0
+
+static __thread uint s_core_num = 0;
+static void host_pio_trace_init(void);
+static struct termios s_saved_termios;
+static bool s_termios_saved = false;
+
+static void *host_map_fixed(uint32_t addr, size_t size, int fd)
+{
+    int flags = MAP_FIXED_NOREPLACE | ((fd < 0) ? (MAP_PRIVATE | MAP_ANONYMOUS) : MAP_SHARED);
+    void *p = mmap((void *)(uintptr_t)addr, size, PROT_READ | PROT_WRITE, flags, fd, 0);
+
+    if (p == MAP_FAILED || p != (void *)(uintptr_t)addr) {
+        fprintf(stderr, "[HOST] mmap failed @0x%08X (%s)\n", addr, strerror(errno));
+        exit(1);
+    }
+    return p;
+}
+
+static void host_restore_termios(void)
+{
+    if (s_termios_saved) {
+        tcsetattr(STDIN_FILENO, TCSANOW, &s_saved_termios);
+    }
+}
+
+/**
+ * @brief スタンドインの初期化(main()の先頭で呼ぶ)
+ */
+void host_sdk_init(void)
+{
+    struct termios raw;
+    int flash_fd;
+
+    // FlashはXIPのキャッシュ有り/無しの両方のアドレスから見えるようにする
+    flash_fd = memfd_create("host_flash", 0);
+    if ((flash_fd < 0) || (ftruncate(flash_fd, PICO_FLASH_SIZE_BYTES) != 0)) {
+        fprintf(stderr, "[HOST] flash memfd failed\n");
+        exit(1);
+    }
+    memset(host_map_fixed(XIP_BASE, PICO_FLASH_SIZE_BYTES, flash_fd), 0xFF, PICO_FLASH_SIZE_BYTES);
+    host_map_fixed(XIP_NOCACHE_NOALLOC_BASE, PICO_FLASH_SIZE_BYTES, flash_fd);
+
+    host_map_fixed(SRAM_BASE, HOST_SRAM_SIZE, -1);
+    host_map_fixed(SYSINFO_BASE, HOST_SYSINFO_MAP_SIZE, -1);
+    host_map_fixed(SIO_BASE, HOST_SIO_MAP_SIZE, -1);
+    host_map_fixed(PPB_BASE, HOST_PPB_MAP_SIZE, -1);
+
+    *(volatile uint32_t *)(uintptr_t)(SYSINFO_BASE + 0x0) = HOST_SYSINFO_CHIP_ID;
+    *(volatile uint32_t *)(uintptr_t)(SYSINFO_BASE + 0x4) = HOST_SYSINFO_PACKAGE;
+    *(volatile uint32_t *)(uintptr_t)(PPB_BASE + 0xED00) = HOST_M33_CPUID;
+
+    // 端末ならエコー無し/非カノニカルにしてシリアル端末と同じ挙動にする
+    if (isatty(STDIN_FILENO) && (tcgetattr(STDIN_FILENO, &s_saved_termios) == 0)) {
+        s_termios_saved = true;
+        raw = s_saved_termios;
+        raw.c_lflag &= ~(ICANON | ECHO);
+        raw.c_cc[VMIN] = 1;
+        raw.c_cc[VTIME] = 0;
+        tcsetattr(STDIN_FILENO, TCSANOW, &raw);
+        atexit(host_restore_termios);
+    }
+
+    host_pio_trace_init();
+}
+
+// -------------------------------------------------------------------------
+// [時間]
+// -------------------------------------------------------------------------
+static uint64_t host_monotonic_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static uint64_t s_boot_ns = 0;
+
+uint64_t time_us_64(void)
+{
+    if (s_boot_ns == 0) {
+        s_boot_ns = host_monotonic_ns();
+    }
+    return (host_monotonic_ns() - s_boot_ns) / 1000u;
+}
+
+uint32_t time_us_32(void)
+{
+    return (uint32_t)time_us_64();
+}
+
+absolute_time_t get_absolute_time(void)
+{
+    return time_us_64();
+}
+
+static void host_sleep_until_us(uint64_t t_us)
+{
+    uint64_t now = time_us_64();
+
+    if (t_us > now) {
+        struct timespec ts = {
+            .tv_sec = (time_t)((t_us - now) / 1000000u),
+            .tv_nsec = (long)(((t_us - now) % 1000000u) * 1000u),
+        };
+        while (nanosleep(&ts, &ts) != 0 && errno == EINTR)
+        {
+            ;
+        }
+    }
+}
+
+void sleep_us(uint64_t us)
+{
+    host_sleep_until_us(time_us_64() + us);
+}
+
+void sleep_ms(uint32_t ms)
+{
+    sleep_us((uint64_t)ms * 1000u);
+}
+
+void busy_wait_us(uint64_t us)
+{
+    uint64_t end = time_us_64() + us;
+
+    while (time_us_64() < end)
+    {
+        ;
+    }
+}
+
+void busy_wait_us_32(uint32_t us)
+{
+    busy_wait_us(us);
+}
+
+void busy_wait_ms(uint32_t ms)
+{
+    busy_wait_us((uint64_t)ms * 1000u);
+}
+
+// -------------------------------------------------------------------------
+// [コア/割り込み/WFE]
+// -------------------------------------------------------------------------
+static pthread_mutex_t s_irq_mutex[2];
+static pthread_once_t s_irq_once = PTHREAD_ONCE_INIT;
+static pthread_mutex_t s_evt_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t s_evt_cond = PTHREAD_COND_INITIALIZER;
+static bool s_evt_flag[2] = {false, false};
+
+static void host_irq_mutex_init(void)
+{
+    pthread_mutexattr_t attr;
+
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&s_irq_mutex[0], &attr);
+    pthread_mutex_init(&s_irq_mutex[1], &attr);
+}
+
+uint get_core_num(void)
+{
+    return s_core_num;
+}
+
+// 割り込み禁止 = そのコアのIRQ(アラーム/GPIO/DMA)コールバックと排他
+uint32_t save_and_disable_interrupts(void)
+{
+    pthread_once(&s_irq_once, host_irq_mutex_init);
+    pthread_mutex_lock(&s_irq_mutex[s_core_num]);
+    return 0;
+}
+
+void restore_interrupts(uint32_t status)
+{
+    (void)status;
+    pthread_mutex_unlock(&s_irq_mutex[s_core_num]);
+}
+
+void restore_interrupts_from_disabled(uint32_t status)
+{
+    restore_interrupts(status);
+}
+
+// IRQコールバックを指定コアの割り込みコンテキストとして実行
+static void host_run_irq(uint core, void (*fn)(void *), void *arg)
+{
+    uint saved = s_core_num;
+
+    pthread_once(&s_irq_once, host_irq_mutex_init);
+    s_core_num = core;
+    pthread_mutex_lock(&s_irq_mutex[core]);
+    fn(arg);
+    pthread_mutex_unlock(&s_irq_mutex[core]);
+    s_core_num = saved;
+    __sev();
+}
+
+void host_hard_assert_fail(const char *p_expr, const char *p_file, int line)
+{
+    fprintf(stderr, "hard_assert failed: %s (%s:%d)\n", p_expr, p_file, line);
+    abort();
+}
+
+void __sev(void)
+{
+    pthread_mutex_lock(&s_evt_mutex);
+    s_evt_flag[0] = true;
+    s_evt_flag[1] = true;
+    pthread_cond_broadcast(&s_evt_cond);
+    pthread_mutex_unlock(&s_evt_mutex);
+}
+
+void __wfe(void)
+{
+    struct timespec ts;
+
+    pthread_mutex_lock(&s_evt_mutex);
+    if (!s_evt_flag[s_core_num]) {
+        clock_gettime(CLOCK_REALTIME, &ts);
+        ts.tv_nsec += HOST_WFE_TIMEOUT_US * 1000;
+        if (ts.tv_nsec >= 1000000000) {
+            ts.tv_sec++;
+            ts.tv_nsec -= 1000000000;
+        }
+        pthread_cond_timedwait(&s_evt_cond, &s_evt_mutex, &ts);
+    }
+    s_evt_flag[s_core_num] = false;
+    pthread_mutex_unlock(&s_evt_mutex);
+}
+
+void __wfi(void)
+{
+    __wfe();
+}
+
+// -------------------------------------------------------------------------
+// [アラーム]
+// -------------------------------------------------------------------------
+typedef struct {
+    bool is_used;
+    alarm_id_t id;
+    uint core;
+    uint64_t target_us;
+    alarm_callback_t callback;
+    void *user_data;
+} host_alarm_t;
+
+static host_alarm_t s_alarm[HOST_ALARM_MAX];
+static alarm_id_t s_alarm_next_id = 1;
+static pthread_mutex_t s_alarm_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t s_alarm_cond = PTHREAD_COND_INITIALIZER;
+static pthread_t s_alarm_thread;
+static bool s_alarm_thread_run = false;
+
+typedef struct {
+    host_alarm_t alarm;
+    int64_t ret;
+} host_alarm_call_t;
+
+static void host_alarm_call(void *arg)
+{
+    host_alarm_call_t *p_call = (host_alarm_call_t *)arg;
+    p_call->ret = p_call->alarm.callback(p_call->alarm.id, p_call->alarm.user_data);
+}
+
+static void *host_alarm_thread(void *arg)
+{
+    (void)arg;
+    pthread_mutex_lock(&s_alarm_mutex);
+    while (1)
+    {
+        int32_t next = -1;
+        uint64_t now = time_us_64();
+
+        for (int32_t i = 0; i < HOST_ALARM_MAX; i++)
+        {
+            if (s_alarm[i].is_used && ((next < 0) || (s_alarm[i].target_us < s_alarm[next].target_us))) {
+                next = i;
+            }
+        }
+
+        if ((next >= 0) && (s_alarm[next].target_us <= now)) {
+            host_alarm_call_t call = { .alarm = s_alarm[next], .ret = 0 };
+
+            s_alarm[next].is_used = false;
+            pthread_mutex_unlock(&s_alarm_mutex);
+            host_run_irq(call.alarm.core, host_alarm_call, &call);
+            pthread_mutex_lock(&s_alarm_mutex);
+
+            // 戻り値>0 ... 今から再設定, <0 ... 前回の予定時刻から再設定
+            // (コールバック中に他のスレッドが空いたスロットを使うことがあるので空きを探し直す)
+            if (call.ret != 0) {
+                for (int32_t i = 0; i < HOST_ALARM_MAX; i++)
+                {
+                    host_alarm_t *p_alarm = &s_alarm[(next + i) % HOST_ALARM_MAX];
+                    if (!p_alarm->is_used) {
+                        *p_alarm = call.alarm;
+                        p_alarm->is_used = true;
+                        p_alarm->target_us = (call.ret > 0) ? (time_us_64() + (uint64_t)call.ret)
+                                                            : (call.alarm.target_us + (uint64_t)(-call.ret));
+                        break;
+                    }
+                }
+            }
+            continue;
+        }
+
+        if (next < 0) {
+            pthread_cond_wait(&s_alarm_cond, &s_alarm_mutex);
+        } else {
+            uint64_t wait_ns = (s_alarm[next].target_us - now) * 1000u;
+            struct timespec ts;
+            clock_gettime(CLOCK_REALTIME, &ts);
+            ts.tv_sec += (time_t)(wait_ns / 1000000000u);
+            ts.tv_nsec += (long)(wait_ns % 1000000000u);
+            if (ts.tv_nsec >= 1000000000) {
+                ts.tv_sec++;
+                ts.tv_nsec -= 1000000000;
+            }
+            pthread_cond_timedwait(&s_alarm_cond, &s_alarm_mutex, &ts);
+        }
+    }
+    return NULL;
+}
+
+alarm_id_t add_alarm_at(absolute_time_t time, alarm_callback_t callback, void *user_data, bool fire_if_past)
+{
+    alarm_id_t id = -1;
+
+    (void)fire_if_past;
+    pthread_mutex_lock(&s_alarm_mutex);
+    if (!s_alarm_thread_run) {
+        s_alarm_thread_run = true;
+        pthread_create(&s_alarm_thread, NULL, host_alarm_thread, NULL);
+    }
+    for (int32_t i = 0; i < HOST_ALARM_MAX; i++)
+    {
+        if (!s_alarm[i].is_used) {
+            id = s_alarm_next_id++;
+            if (s_alarm_next_id <= 0) {
+                s_alarm_next_id = 1;
+            }
+            s_alarm[i] = (host_alarm_t) {
+                .is_used = true,
+                .id = id,
+                .core = s_core_num,
+                .target_us = time,
+                .callback = callback,
+                .user_data = user_data,
+            };
+            pthread_cond_signal(&s_alarm_cond);
+            break;
+        }
+    }
+    pthread_mutex_unlock(&s_alarm_mutex);
+
+    return id;
+}
+
+alarm_id_t add_alarm_in_us(uint64_t us, alarm_callback_t callback, void *user_data, bool fire_if_past)
+{
+    return add_alarm_at(time_us_64() + us, callback, user_data, fire_if_past);
+}
+
+alarm_id_t add_alarm_in_ms(uint32_t ms, alarm_callback_t callback, void *user_data, bool fire_if_past)
+{
+    return add_alarm_in_us((uint64_t)ms * 1000u, callback, user_data, fire_if_past);
+}
+
+bool cancel_alarm(alarm_id_t alarm_id)
+{
+    bool ret = false;
+
+    pthread_mutex_lock(&s_alarm_mutex);
+    for (int32_t i = 0; i < HOST_ALARM_MAX; i++)
+    {
+        if (s_alarm[i].is_used && (s_alarm[i].id == alarm_id)) {
+            s_alarm[i].is_used = false;
+            ret = true;
+        }
+    }
+    pthread_mutex_unlock(&s_alarm_mutex);
+
+    return ret;
+}
+
+static int64_t host_repeating_timer_cb(alarm_id_t id, void *user_data)
+{
+    repeating_timer_t *p_rt = (repeating_timer_t *)user_data;
+
+    (void)id;
+    if (!p_rt->callback(p_rt)) {
+        p_rt->alarm_id = 0;
+        return 0;
+    }
+    return p_rt->delay_us;
+}
+
+bool add_repeating_timer_us(int64_t delay_us, repeating_timer_callback_t callback, void *user_data, repeating_timer_t *out)
+{
+    uint64_t first_us = (uint64_t)((delay_us < 0) ? -delay_us : delay_us);
+
+    out->delay_us = delay_us;
+    out->pool = NULL;
+    out->callback = callback;
+    out->user_data = user_data;
+    out->alarm_id = add_alarm_in_us(first_us, host_repeating_timer_cb, out, true);
+
+    return (out->alarm_id > 0);
+}
+
+bool add_repeating_timer_ms(int32_t delay_ms, repeating_timer_callback_t callback, void *user_data, repeating_timer_t *out)
+{
+    return add_repeating_timer_us((int64_t)delay_ms * 1000, callback, user_data, out);
+}
+
+bool cancel_repeating_timer(repeating_timer_t *timer)
+{
+    bool ret = false;
+
+    if (timer->alarm_id > 0) {
+        ret = cancel_alarm(timer->alarm_id);
+        timer->alarm_id = 0;
+    }
+    return ret;
+}
+
+// AONタイマー(ホストの実時刻からのオフセットで保持)
+static int64_t s_aon_offset_sec = 0;
+
+bool aon_timer_start(const struct timespec *ts)
+{
+    (void)ts;
+    return true;
+}
+
+bool aon_timer_set_time(const struct timespec *ts)
+{
+    s_aon_offset_sec = (int64_t)ts->tv_sec - (int64_t)time(NULL);
+    return true;
+}
+
+bool aon_timer_get_time(struct timespec *ts)
+{
+    ts->tv_sec = (time_t)((int64_t)time(NULL) + s_aon_offset_sec);
+    ts->tv_nsec = 0;
+    return true;
+}
+
+// -------------------------------------------------------------------------
+// [マルチコア]
+// -------------------------------------------------------------------------
+typedef struct {
+    uint32_t buf[HOST_SIO_FIFO_DEPTH];
+    uint32_t rd;
+    uint32_t cnt;
+} host_fifo_t;
+
+static host_fifo_t s_fifo[2];   // [送信元コア]
+static pthread_mutex_t s_fifo_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t s_fifo_cond = PTHREAD_COND_INITIALIZER;
+static pthread_t s_core1_thread;
+
+static void *host_core1_entry(void *arg)
+{
+    s_core_num = 1;
+    ((void (*)(void))arg)();
+    return NULL;
+}
+
+void multicore_launch_core1(void (*entry)(void))
+{
+    pthread_create(&s_core1_thread, NULL, host_core1_entry, (void *)entry);
+}
+
+void multicore_reset_core1(void)
+{
+    // ホストではスレッドを止められないので何もしない
+}
+
+static bool host_fifo_wait(bool (*p_cond)(void), uint64_t timeout_us, bool is_timeout)
+{
+    uint64_t end = time_us_64() + timeout_us;
+
+    while (!p_cond())
+    {
+        if (is_timeout) {
+            uint64_t now = time_us_64();
+            if (now >= end) {
+                return false;
+            }
+            struct timespec ts;
+            uint64_t wait_ns = (end - now) * 1000u;
+            clock_gettime(CLOCK_REALTIME, &ts);
+            ts.tv_sec += (time_t)(wait_ns / 1000000000u);
+            ts.tv_nsec += (long)(wait_ns % 1000000000u);
+            if (ts.tv_nsec >= 1000000000) {
+                ts.tv_sec++;
+                ts.tv_nsec -= 1000000000;
+            }
+            pthread_cond_timedwait(&s_fifo_cond, &s_fifo_mutex, &ts);
+        } else {
+            pthread_cond_wait(&s_fifo_cond, &s_fifo_mutex);
+        }
+    }
+    return true;
+}
+
+static bool host_fifo_can_push(void)
+{
+    return s_fifo[s_core_num].cnt < HOST_SIO_FIFO_DEPTH;
+}
+
+static bool host_fifo_can_pop(void)
+{
+    return s_fifo[s_core_num ^ 1u].cnt > 0;
+}
+
+bool multicore_fifo_push_timeout_us(uint32_t data, uint64_t timeout_us)
+{
+    host_fifo_t *p_fifo = &s_fifo[s_core_num];
+
+    pthread_mutex_lock(&s_fifo_mutex);
+    if (!host_fifo_wait(host_fifo_can_push, timeout_us, true)) {
+        pthread_mutex_unlock(&s_fifo_mutex);
+        return false;
+    }
+    p_fifo->buf[(p_fifo->rd + p_fifo->cnt) % HOST_SIO_FIFO_DEPTH] = data;
+    p_fifo->cnt++;
+    pthread_cond_broadcast(&s_fifo_cond);
+    pthread_mutex_unlock(&s_fifo_mutex);
+    __sev();
+
+    return true;
+}
+
+void multicore_fifo_push_blocking(uint32_t data)
+{
+    host_fifo_t *p_fifo = &s_fifo[s_core_num];
+
+    pthread_mutex_lock(&s_fifo_mutex);
+    host_fifo_wait(host_fifo_can_push, 0, false);
+    p_fifo->buf[(p_fifo->rd + p_fifo->cnt) % HOST_SIO_FIFO_DEPTH] = data;
+    p_fifo->cnt++;
+    pthread_cond_broadcast(&s_fifo_cond);
+    pthread_mutex_unlock(&s_fifo_mutex);
+    __sev();
+}
+
+static uint32_t host_fifo_pop_locked(void)
+{
+    host_fifo_t *p_fifo = &s_fifo[s_core_num ^ 1u];
+    uint32_t data = p_fifo->buf[p_fifo->rd];
+
+    p_fifo->rd = (p_fifo->rd + 1) % HOST_SIO_FIFO_DEPTH;
+    p_fifo->cnt--;
+    pthread_cond_broadcast(&s_fifo_cond);
+
+    return data;
+}
+
+bool multicore_fifo_pop_timeout_us(uint64_t timeout_us, uint32_t *out)
+{
+    pthread_mutex_lock(&s_fifo_mutex);
+    if (!host_fifo_wait(host_fifo_can_pop, timeout_us, true)) {
+        pthread_mutex_unlock(&s_fifo_mutex);
+        return false;
+    }
+    *out = host_fifo_pop_locked();
+    pthread_mutex_unlock(&s_fifo_mutex);
+
+    return true;
+}
+
+uint32_t multicore_fifo_pop_blocking(void)
+{
+    uint32_t data;
+
+    pthread_mutex_lock(&s_fifo_mutex);
+    host_fifo_wait(host_fifo_can_pop, 0, false);
+    data = host_fifo_pop_locked();
+    pthread_mutex_unlock(&s_fifo_mutex);
+
+    return data;
+}
+
+bool multicore_fifo_rvalid(void)
+{
+    bool ret;
+
+    pthread_mutex_lock(&s_fifo_mutex);
+    ret = host_fifo_can_pop();
+    pthread_mutex_unlock(&s_fifo_mutex);
+
+    return ret;
+}
+
+bool multicore_fifo_wready(void)
+{
+    bool ret;
+
+    pthread_mutex_lock(&s_fifo_mutex);
+    ret = host_fifo_can_push();
+    pthread_mutex_unlock(&s_fifo_mutex);
+
+    return ret;
+}
+
+void multicore_fifo_drain(void)
+{
+    pthread_mutex_lock(&s_fifo_mutex);
+    while (host_fifo_can_pop())
+    {
+        (void)host_fifo_pop_locked();
+    }
+    pthread_mutex_unlock(&s_fifo_mutex);
+}
+
+static bool s_lockout_victim[2] = {false, false};
+
+void multicore_lockout_victim_init(void)
+{
+    s_lockout_victim[s_core_num] = true;
+}
+
+bool multicore_lockout_victim_is_initialized(uint core_num)
+{
+    return s_lockout_victim[core_num & 1u];
+}
+
+// -------------------------------------------------------------------------
+// [stdio]
+// -------------------------------------------------------------------------
+static bool s_stdin_eof = false;
+static pthread_mutex_t s_stdio_mutex = PTHREAD_MUTEX_INITIALIZER;
+static stdio_driver_t *s_drivers = NULL;
+static stdio_driver_t *s_filter = NULL;
+
+static void host_usb_out_chars(const char *buf, int len)
+{
+    fwrite(buf, 1, (size_t)len, stdout);
+}
+
+static void host_usb_out_flush(void)
+{
+    fflush(stdout);
+}
+
+static int host_usb_in_chars(char *buf, int len)
+{
+    struct pollfd pfd = { .fd = STDIN_FILENO, .events = POLLIN };
+    ssize_t n;
+
+    if (s_stdin_eof || (poll(&pfd, 1, 1) <= 0)) {
+        return PICO_ERROR_NO_DATA;
+    }
+    n = read(STDIN_FILENO, buf, (size_t)len);
+    if (n <= 0) {
+        s_stdin_eof = true;
+        return PICO_ERROR_NO_DATA;
+    }
+    return (int)n;
+}
+
+stdio_driver_t stdio_usb = {
+    .out_chars = host_usb_out_chars,
+    .out_flush = host_usb_out_flush,
+    .in_chars = host_usb_in_chars,
+};
+
+bool stdio_init_all(void)
+{
+    stdio_set_driver_enabled(&stdio_usb, true);
+    return true;
+}
+
+void stdio_set_driver_enabled(stdio_driver_t *driver, bool enabled)
+{
+    stdio_driver_t **pp = &s_drivers;
+
+    pthread_mutex_lock(&s_stdio_mutex);
+    while (*pp != NULL)
+    {
+        if (*pp == driver) {
+            if (!enabled) {
+                *pp = driver->next;
+                driver->next = NULL;
+            }
+            pthread_mutex_unlock(&s_stdio_mutex);
+            return;
+        }
+        pp = &(*pp)->next;
+    }
+    if (enabled) {
+        driver->next = NULL;
+        *pp = driver;
+    }
+    pthread_mutex_unlock(&s_stdio_mutex);
+}
+
+void stdio_filter_driver(stdio_driver_t *driver)
+{
+    s_filter = driver;
+}
+
+// 端末側(OPOST)で改行変換しているので設定だけ保持する
+void stdio_set_translate_crlf(stdio_driver_t *driver, bool translate)
+{
+    driver->crlf_enabled = translate;
+}
+
+static void host_stdio_out(const char *buf, int len)
+{
+    pthread_mutex_lock(&s_stdio_mutex);
+    for (stdio_driver_t *d = s_drivers; d != NULL; d = d->next)
+    {
+        if ((s_filter == NULL) || (s_filter == d)) {
+            d->out_chars(buf, len);
+            if (d->out_flush != NULL) {
+                d->out_flush();
+            }
+        }
+    }
+    pthread_mutex_unlock(&s_stdio_mutex);
+}
+
+int stdio_getchar_timeout_us(uint32_t timeout_us)
+{
+    uint64_t end = time_us_64() + timeout_us;
+    char c;
+
+    do
+    {
+        for (stdio_driver_t *d = s_drivers; d != NULL; d = d->next)
+        {
+            if (((s_filter == NULL) || (s_filter == d)) && (d->in_chars != NULL)) {
+                if (d->in_chars(&c, 1) > 0) {
+                    return (int)(uint8_t)c;
+                }
+            }
+        }
+        if (s_stdin_eof) {
+            break;
+        }
+    } while (time_us_64() < end);
+
+    return PICO_ERROR_TIMEOUT;
+}
+
+int getchar_timeout_us(uint32_t timeout_us)
+{
+    return stdio_getchar_timeout_us(timeout_us);
+}
+
+void stdio_flush(void)
+{
+    fflush(stdout);
+}
+
+int host_printf(const char *fmt, ...)
+{
+    char buf[HOST_STDIO_BUF_SIZE];
+    va_list ap;
+    int len;
+
+    va_start(ap, fmt);
+    len = vsnprintf(buf, sizeof(buf), fmt, ap);
+    va_end(ap);
+
+    if (len >= (int)sizeof(buf)) {
+        char *p_big = malloc((size_t)len + 1);
+        va_start(ap, fmt);
+        vsnprintf(p_big, (size_t)len + 1, fmt, ap);
+        va_end(ap);
+        host_stdio_out(p_big, len);
+        free(p_big);
+    } else if (len > 0) {
+        host_stdio_out(buf, len);
+    }
+
+    return len;
+}
+
+int host_putchar(int c)
+{
+    char ch = (char)c;
+    host_stdio_out(&ch, 1);
+    return c;
+}
+
+int host_puts(const char *s)
+{
+    host_stdio_out(s, (int)strlen(s));
+    host_stdio_out("\n", 1);
+    return 1;
+}
+
+size_t host_fwrite(const void *ptr, size_t size, size_t nmemb, FILE *fp)
+{
+    if ((fp == stdout) || (fp == stderr)) {
+        host_stdio_out((const char *)ptr, (int)(size * nmemb));
+        return nmemb;
+    }
+    return fwrite(ptr, size, nmemb, fp);
+}
+
+int host_fflush(FILE *fp)
+{
+    return fflush(fp);
+}
+
+// 入力が尽きたら(パイプ実行時)ホストのプロセスを終了する
+int host_getchar(void)
+{
+    int c;
+
+    while (1)
+    {
+        c = stdio_getchar_timeout_us(100000);
+        if (c >= 0) {
+            return c;
+        }
+        if (s_stdin_eof) {
+            fflush(stdout);
+            exit(0);
+        }
+    }
+}
+
+// -------------------------------------------------------------------------
+// [クロック/WDT]
+// -------------------------------------------------------------------------
+uint32_t clock_get_hz(enum clock_index clk_index)
+{
+    switch (clk_index)
+    {
+        case clk_ref:
+            return HOST_CLK_REF_HZ;
+        case clk_sys:
+        case clk_peri:
+        case clk_hstx:
+            return HOST_CLK_SYS_HZ;
+        case clk_usb:
+        case clk_adc:
+            return HOST_CLK_USB_HZ;
+        default:
+            return 0;
+    }
+}
+
+void watchdog_enable(uint32_t delay_ms, bool pause_on_debug)
+{
+    (void)delay_ms;
+    (void)pause_on_debug;
+}
+
+void watchdog_update(void)
+{
+}
+
+void watchdog_reboot(uint32_t pc, uint32_t sp, uint32_t delay_ms)
+{
+    (void)pc;
+    (void)sp;
+    (void)delay_ms;
+    fflush(stdout);
+    exit(0);
+}
+
+bool watchdog_caused_reboot(void)
+{
+    return false;
+}
+
+// -------------------------------------------------------------------------
+// [GPIO]
+// -------------------------------------------------------------------------
+static bool s_gpio_val[NUM_BANK0_GPIOS];
+static bool s_gpio_out[NUM_BANK0_GPIOS];
+static uint32_t s_gpio_irq_mask[NUM_BANK0_GPIOS];
+static gpio_irq_callback_t s_gpio_irq_cb = NULL;
+static uint s_gpio_irq_core = 0;
+
+void gpio_init(uint gpio)
+{
+    s_gpio_out[gpio % NUM_BANK0_GPIOS] = false;
+    s_gpio_val[gpio % NUM_BANK0_GPIOS] = false;
+}
+
+void gpio_set_dir(uint gpio, bool out)
+{
+    s_gpio_out[gpio % NUM_BANK0_GPIOS] = out;
+}
+
+void gpio_put(uint gpio, bool value)
+{
+    s_gpio_val[gpio % NUM_BANK0_GPIOS] = value;
+}
+
+bool gpio_get(uint gpio)
+{
+    return s_gpio_val[gpio % NUM_BANK0_GPIOS];
+}
+
+void gpio_set_function(uint gpio, enum gpio_function fn)
+{
+    (void)gpio;
+    (void)fn;
+}
+
+// 未接続の入力ピンとして扱う(プルでレベルが変わり、エッジ割り込みも出る)
+void gpio_pull_up(uint gpio)
+{
+    if (!s_gpio_out[gpio % NUM_BANK0_GPIOS]) {
+        host_gpio_drive_input(gpio, true);
+    }
+}
+
+void gpio_pull_down(uint gpio)
+{
+    if (!s_gpio_out[gpio % NUM_BANK0_GPIOS]) {
+        host_gpio_drive_input(gpio, false);
+    }
+}
+
+void gpio_set_irq_enabled(uint gpio, uint32_t event_mask, bool enabled)
+{
+    if (enabled) {
+        s_gpio_irq_mask[gpio % NUM_BANK0_GPIOS] |= event_mask;
+    } else {
+        s_gpio_irq_mask[gpio % NUM_BANK0_GPIOS] &= ~event_mask;
+    }
+}
+
+void gpio_set_irq_enabled_with_callback(uint gpio, uint32_t event_mask, bool enabled, gpio_irq_callback_t callback)
+{
+    s_gpio_irq_cb = callback;
+    s_gpio_irq_core = s_core_num;
+    gpio_set_irq_enabled(gpio, event_mask, enabled);
+}
+
+typedef struct {
+    uint gpio;
+    uint32_t events;
+} host_gpio_irq_t;
+
+static void host_gpio_irq_call(void *arg)
+{
+    host_gpio_irq_t *p_irq = (host_gpio_irq_t *)arg;
+    s_gpio_irq_cb(p_irq->gpio, p_irq->events);
+}
+
+/**
+ * @brief 入力ピンのレベルを外部から変化させる(エッジ割り込みを発生)
+ */
+void host_gpio_drive_input(uint gpio, bool value)
+{
+    uint idx = gpio % NUM_BANK0_GPIOS;
+    bool old = s_gpio_val[idx];
+    host_gpio_irq_t irq = { .gpio = gpio, .events = 0 };
+
+    s_gpio_val[idx] = value;
+    if (old != value) {
+        irq.events = value ? GPIO_IRQ_EDGE_RISE : GPIO_IRQ_EDGE_FALL;
+        irq.events &= s_gpio_irq_mask[idx];
+        if ((irq.events != 0) && (s_gpio_irq_cb != NULL)) {
+            host_run_irq(s_gpio_irq_core, host_gpio_irq_call, &irq);
+        }
+    }
+}
+
+// -------------------------------------------------------------------------
+// [I2C/SPI/UART/ADC]
+// -------------------------------------------------------------------------
+i2c_inst_t g_host_i2c[2];
+spi_inst_t g_host_spi[2];
+uart_inst_t g_host_uart[2];
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate)
+{
+    i2c->baudrate = baudrate;
+    return baudrate;
+}
+
+// スレーブは居ないのでNACK
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop)
+{
+    (void)i2c;
+    (void)addr;
+    (void)src;
+    (void)len;
+    (void)nostop;
+    return PICO_ERROR_GENERIC;
+}
+
+uint spi_init(spi_inst_t *spi, uint baudrate)
+{
+    spi->baudrate = baudrate;
+    return baudrate;
+}
+
+uint uart_init(uart_inst_t *uart, uint baudrate)
+{
+    uart->baudrate = baudrate;
+    return baudrate;
+}
+
+void uart_puts(uart_inst_t *uart, const char *s)
+{
+    (void)uart;
+    (void)s;
+}
+
+void adc_init(void)
+{
+}
+
+void adc_select_input(uint input)
+{
+    (void)input;
+}
+
+void adc_set_temp_sensor_enabled(bool enable)
+{
+    (void)enable;
+}
+
+// 温度センサ 27℃相当(0.706V @ VREF 3.3V)
+uint16_t adc_read(void)
+{
+    return 876;
+}
+
+// -------------------------------------------------------------------------
+// [TRNG]
+// -------------------------------------------------------------------------
+uint32_t get_rand_32(void)
+{
+    uint32_t val = 0;
+    while (getrandom(&val, sizeof(val), 0) != (ssize_t)sizeof(val))
+    {
+        ;
+    }
+    return val;
+}
+
+uint64_t get_rand_64(void)
+{
+    return ((uint64_t)get_rand_32() << 32) | get_rand_32();
+}
+
+// -------------------------------------------------------------------------
+// [XIPストリーム]
+// -------------------------------------------------------------------------
+// DMAの転送は即時なのでFIFOは常に空
+xip_ctrl_hw_t g_host_xip_ctrl_hw = { .stat = XIP_STAT_FIFO_EMPTY_BITS };
+
+// ストリームFIFOから1語(カウンタが0なら実機ではDMAが止まるので0を返す)
+static uint32_t host_xip_stream_pop(void)
+{
+    uint32_t word = 0;
+
+    if (g_host_xip_ctrl_hw.stream_ctr != 0) {
+        memcpy(&word, (const void *)(uintptr_t)g_host_xip_ctrl_hw.stream_addr, sizeof(word));
+        g_host_xip_ctrl_hw.stream_addr += 4;
+        g_host_xip_ctrl_hw.stream_ctr--;
+    }
+
+    return word;
+}
+
+// -------------------------------------------------------------------------
+// [SHA-256アクセラレータ]
+// -------------------------------------------------------------------------
+sha256_hw_t g_host_sha256_hw;
+
+static uint32_t s_sha_h[8];
+static uint8_t s_sha_block[64];
+static uint32_t s_sha_block_len = 0;
+static bool s_sha_bswap = false;
+static bool s_sha_wdata_pending = false;
+
+static const uint32_t s_sha_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+#define HOST_ROR(x, n)  (((x) >> (n)) | ((x) << (32 - (n))))
+
+static void host_sha_compress(void)
+{
+    uint32_t w[64];
+    uint32_t a, b, c, d, e, f, g, h;
+
+    for (uint32_t i = 0; i < 16; i++)
+    {
+        w[i] = ((uint32_t)s_sha_block[i * 4] << 24) | ((uint32_t)s_sha_block[i * 4 + 1] << 16) |
+                ((uint32_t)s_sha_block[i * 4 + 2] << 8) | (uint32_t)s_sha_block[i * 4 + 3];
+    }
+    for (uint32_t i = 16; i < 64; i++)
+    {
+        uint32_t s0 = HOST_ROR(w[i - 15], 7) ^ HOST_ROR(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        uint32_t s1 = HOST_ROR(w[i - 2], 17) ^ HOST_ROR(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    a = s_sha_h[0]; b = s_sha_h[1]; c = s_sha_h[2]; d = s_sha_h[3];
+    e = s_sha_h[4]; f = s_sha_h[5]; g = s_sha_h[6]; h = s_sha_h[7];
+    for (uint32_t i = 0; i < 64; i++)
+    {
+        uint32_t t1 = h + (HOST_ROR(e, 6) ^ HOST_ROR(e, 11) ^ HOST_ROR(e, 25)) + ((e & f) ^ (~e & g)) + s_sha_k[i] + w[i];
+        uint32_t t2 = (HOST_ROR(a, 2) ^ HOST_ROR(a, 13) ^ HOST_ROR(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+        h = g; g = f; f = e; e = d + t1;
+        d = c; c = b; b = a; a = t1 + t2;
+    }
+    s_sha_h[0] += a; s_sha_h[1] += b; s_sha_h[2] += c; s_sha_h[3] += d;
+    s_sha_h[4] += e; s_sha_h[5] += f; s_sha_h[6] += g; s_sha_h[7] += h;
+}
+
+static void host_sha_feed_byte(uint8_t b)
+{
+    s_sha_block[s_sha_block_len++] = b;
+    if (s_sha_block_len >= 64) {
+        host_sha_compress();
+        s_sha_block_len = 0;
+    }
+}
+
+static void host_sha_feed_word(uint32_t word)
+{
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        // bswap有効 ... メモリ上のバイト順(LE)がそのままメッセージ順
+        host_sha_feed_byte(s_sha_bswap ? (uint8_t)(word >> (8 * i)) : (uint8_t)(word >> (24 - 8 * i)));
+    }
+}
+
+static void host_sha_flush_wdata(void)
+{
+    if (s_sha_wdata_pending) {
+        s_sha_wdata_pending = false;
+        host_sha_feed_word(g_host_sha256_hw.wdata);
+    }
+}
+
+void sha256_set_dma_size(uint size_in_bytes)
+{
+    (void)size_in_bytes;
+}
+
+void sha256_set_bswap(bool swap)
+{
+    s_sha_bswap = swap;
+}
+
+void sha256_start(void)
+{
+    static const uint32_t s_iv[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+    };
+    memcpy(s_sha_h, s_iv, sizeof(s_sha_h));
+    s_sha_block_len = 0;
+    s_sha_wdata_pending = false;
+}
+
+bool sha256_is_sum_valid(void)
+{
+    host_sha_flush_wdata();
+    return (s_sha_block_len == 0);
+}
+
+bool sha256_is_ready(void)
+{
+    host_sha_flush_wdata();
+    return true;
+}
+
+void sha256_wait_ready_blocking(void)
+{
+    host_sha_flush_wdata();
+}
+
+void sha256_wait_valid_blocking(void)
+{
+    host_sha_flush_wdata();
+}
+
+void sha256_put_word(uint32_t word)
+{
+    host_sha_flush_wdata();
+    host_sha_feed_word(word);
+}
+
+void sha256_put_byte(uint8_t b)
+{
+    host_sha_flush_wdata();
+    host_sha_feed_byte(b);
+}
+
+void sha256_get_result(sha256_result_t *out, enum sha256_endianness endianness)
+{
+    host_sha_flush_wdata();
+    for (uint32_t i = 0; i < 8; i++)
+    {
+        if (endianness == SHA256_BIG_ENDIAN) {
+            out->bytes[i * 4 + 0] = (uint8_t)(s_sha_h[i] >> 24);
+            out->bytes[i * 4 + 1] = (uint8_t)(s_sha_h[i] >> 16);
+            out->bytes[i * 4 + 2] = (uint8_t)(s_sha_h[i] >> 8);
+            out->bytes[i * 4 + 3] = (uint8_t)(s_sha_h[i]);
+        } else {
+            out->words[i] = s_sha_h[i];
+        }
+    }
+}
+
+// CPUからの書き込みは次のSHA API呼び出し時に取り込む
+volatile void *sha256_get_write_addr(void)
+{
+    host_sha_flush_wdata();
+    s_sha_wdata_pending = true;
+    return &g_host_sha256_hw.wdata;
+}
+
+// -------------------------------------------------------------------------
+// [PIO]
+// -------------------------------------------------------------------------
+pio_hw_t g_host_pio[NUM_PIOS];
+
+#define HOST_PIO_TRACE_WORD_MAX     65536       // 1フレームで記録する最大語数
+#define HOST_PIO_TRACE_EDGE_MAX     (4u * 1024u * 1024u)
+#define HOST_PIO_TRACE_IDLE_NS      50000ull    // SMがこれ以上空いたらフレームの区切り(WS2812のリセット時間)
+
+typedef struct {
+    bool is_claimed;
+    bool is_enabled;
+    pio_sm_config config;
+    uint32_t pio_idx;
+    uint32_t sm_idx;
+    uint32_t initial_pc;
+    uint32_t fifo_depth;
+    uint64_t pull_time_ns[8];   // 直近fifo_depth語のOSRへの取り込み時刻
+    uint32_t put_cnt;
+    uint64_t busy_until_ns;     // 最後の語を出力し終わる時刻
+    uint64_t word_ns;           // 1語を出力するのにかかる時間
+
+    // 波形トレース(1フレーム分の語と積んだ時刻)
+    uint32_t *p_trace_word;
+    uint64_t *p_trace_ns;
+    uint32_t trace_cnt;
+    bool is_trace_over;
+    uint64_t trace_pull_ns;     // モデルで最初の語をOSRに取り込んだ時刻
+    uint64_t trace_end_ns;      // モデルで最後の語を出力し終わる時刻
+    uint32_t frame_cnt;
+    uint32_t frame_ng_cnt;
+    uint32_t last_bit_cnt;
+    uint32_t gap_max_ns;
+    bool is_vcd_done;
+} host_pio_sm_t;
+
+typedef struct {
+    uint16_t instr[PIO_INSTRUCTION_COUNT];
+    uint32_t used_mask;
+    host_pio_sm_t sm[NUM_PIO_STATE_MACHINES];
+} host_pio_t;
+
+static host_pio_t s_pio[NUM_PIOS];
+static pthread_mutex_t s_pio_mutex = PTHREAD_MUTEX_INITIALIZER;
+static bool s_pio_trace = false;
+static const char *s_p_pio_vcd = NULL;
+
+static void host_pio_trace_frame(host_pio_sm_t *p_sm);
+
+uint pio_get_index(PIO pio)
+{
+    return (uint)(pio - &g_host_pio[0]);
+}
+
+uint pio_get_dreq(PIO pio, uint sm, bool is_tx)
+{
+    return (pio_get_index(pio) * 8u) + sm + (is_tx ? 0u : 4u);
+}
+
+static int host_pio_find_space(host_pio_t *p_pio, const pio_program_t *program)
+{
+    uint32_t mask = (1u << program->length) - 1u;
+
+    if (program->origin >= 0) {
+        return ((p_pio->used_mask & (mask << program->origin)) == 0) ? program->origin : -1;
+    }
+    for (int32_t off = PIO_INSTRUCTION_COUNT - program->length; off >= 0; off--)
+    {
+        if ((p_pio->used_mask & (mask << off)) == 0) {
+            return off;
+        }
+    }
+    return -1;
+}
+
+bool pio_can_add_program(PIO pio, const pio_program_t *program)
+{
+    return host_pio_find_space(&s_pio[pio_get_index(pio)], program) >= 0;
+}
+
+uint pio_add_program(PIO pio, const pio_program_t *program)
+{
+    host_pio_t *p_pio = &s_pio[pio_get_index(pio)];
+    int off = host_pio_find_space(p_pio, program);
+
+    hard_assert(off >= 0);
+    for (uint32_t i = 0; i < program->length; i++)
+    {
+        // JMPのアドレスはロード位置に合わせて再配置
+        uint16_t instr = program->instructions[i];
+        p_pio->instr[off + i] = ((instr >> 13) == 0) ? (uint16_t)(instr + off) : instr;
+    }
+    p_pio->used_mask |= ((1u << program->length) - 1u) << off;
+
+    return (uint)off;
+}
+
+void pio_remove_program(PIO pio, const pio_program_t *program, uint loaded_offset)
+{
+    s_pio[pio_get_index(pio)].used_mask &= ~(((1u << program->length) - 1u) << loaded_offset);
+}
+
+int pio_claim_unused_sm(PIO pio, bool required)
+{
+    host_pio_t *p_pio = &s_pio[pio_get_index(pio)];
+
+    for (uint32_t sm = 0; sm < NUM_PIO_STATE_MACHINES; sm++)
+    {
+        if (!p_pio->sm[sm].is_claimed) {
+            p_pio->sm[sm].is_claimed = true;
+            return (int)sm;
+        }
+    }
+    hard_assert(!required);
+    return -1;
+}
+
+void pio_sm_claim(PIO pio, uint sm)
+{
+    s_pio[pio_get_index(pio)].sm[sm].is_claimed = true;
+}
+
+void pio_sm_unclaim(PIO pio, uint sm)
+{
+    s_pio[pio_get_index(pio)].sm[sm].is_claimed = false;
+}
+
+bool pio_claim_free_sm_and_add_program_for_gpio_range(const pio_program_t *program, PIO *pio, uint *sm,
+                                                        uint *offset, uint gpio_base, uint gpio_count, bool set_gpio_base)
+{
+    (void)gpio_base;
+    (void)gpio_count;
+    (void)set_gpio_base;
+
+    for (uint32_t p = 0; p < NUM_PIOS; p++)
+    {
+        PIO cand = &g_host_pio[p];
+        if (!pio_can_add_program(cand, program)) {
+            continue;
+        }
+        int s = pio_claim_unused_sm(cand, false);
+        if (s >= 0) {
+            *pio = cand;
+            *sm = (uint)s;
+            *offset = pio_add_program(cand, program);
+            return true;
+        }
+    }
+    return false;
+}
+
+void pio_remove_program_and_unclaim_sm(const pio_program_t *program, PIO pio, uint sm, uint offset)
+{
+    pio_remove_program(pio, program, offset);
+    pio_sm_unclaim(pio, sm);
+}
+
+void pio_gpio_init(PIO pio, uint pin)
+{
+    (void)pio;
+    (void)pin;
+}
+
+int pio_sm_set_consecutive_pindirs(PIO pio, uint sm, uint pin_base, uint pin_count, bool is_out)
+{
+    (void)pio;
+    (void)sm;
+    (void)pin_base;
+    (void)pin_count;
+    (void)is_out;
+    return PICO_OK;
+}
+
+pio_sm_config pio_get_default_sm_config(void)
+{
+    pio_sm_config c;
+
+    memset(&c, 0, sizeof(c));
+    c.clkdiv_x256 = 256;
+    c.wrap = PIO_INSTRUCTION_COUNT - 1;
+    c.out_shift_right = true;
+    c.pull_threshold = 32;
+
+    return c;
+}
+
+void sm_config_set_wrap(pio_sm_config *c, uint wrap_target, uint wrap)
+{
+    c->wrap_target = wrap_target;
+    c->wrap = wrap;
+}
+
+void sm_config_set_sideset(pio_sm_config *c, uint bit_count, bool optional, bool pindirs)
+{
+    c->sideset_count = bit_count;
+    c->sideset_optional = optional;
+    c->sideset_pindirs = pindirs;
+}
+
+void sm_config_set_sideset_pins(pio_sm_config *c, uint sideset_base)
+{
+    c->sideset_base = sideset_base;
+}
+
+void sm_config_set_out_pins(pio_sm_config *c, uint out_base, uint out_count)
+{
+    c->out_base = out_base;
+    c->out_count = out_count;
+}
+
+void sm_config_set_set_pins(pio_sm_config *c, uint set_base, uint set_count)
+{
+    c->set_base = set_base;
+    c->set_count = set_count;
+}
+
+void sm_config_set_out_shift(pio_sm_config *c, bool shift_right, bool autopull, uint pull_threshold)
+{
+    c->out_shift_right = shift_right;
+    c->autopull = autopull;
+    c->pull_threshold = (pull_threshold == 0) ? 32 : pull_threshold;
+}
+
+void sm_config_set_fifo_join(pio_sm_config *c, enum pio_fifo_join join)
+{
+    c->fifo_join = (uint32_t)join;
+}
+
+void sm_config_set_clkdiv(pio_sm_config *c, float div)
+{
+    c->clkdiv_x256 = (uint32_t)(div * 256.0f);
+}
+
+/**
+ * @brief wrap_target → wrapを1周する間のサイクル数とOUTのビット数を求める
+ *
+ * 条件付きJMPは不成立、無条件JMPは成立として1周を辿る。
+ * NeoPixelのプログラムはどちらの分岐でも同じサイクル数になる。
+ */
+static uint64_t host_pio_calc_word_cycles(const host_pio_t *p_pio, const pio_sm_config *c)
+{
+    uint32_t pc = c->wrap_target;
+    uint32_t cycles = 0;
+    uint32_t out_bits = 0;
+    uint32_t delay_mask = (1u << (5 - c->sideset_count)) - 1u;
+
+    for (uint32_t step = 0; step < 64; step++)
+    {
+        uint16_t instr = p_pio->instr[pc];
+        uint32_t opcode = instr >> 13;
+        uint32_t next = (pc == c->wrap) ? c->wrap_target : (pc + 1) % PIO_INSTRUCTION_COUNT;
+
+        cycles += 1 + (((uint32_t)instr >> 8) & delay_mask);
+        if (opcode == 0x3) {
+            uint32_t cnt = instr & 0x1f;
+            out_bits += (cnt == 0) ? 32 : cnt;
+        } else if ((opcode == 0x0) && (((instr >> 5) & 0x7) == 0)) {
+            next = instr & 0x1f;
+        }
+        pc = next;
+        if (pc == c->wrap_target) {
+            break;
+        }
+    }
+
+    if (out_bits == 0) {
+        return 32;
+    }
+    return (uint64_t)cycles * ((c->pull_threshold + out_bits - 1) / out_bits);
+}
+
+int pio_sm_init(PIO pio, uint sm, uint initial_pc, const pio_sm_config *config)
+{
+    host_pio_t *p_pio = &s_pio[pio_get_index(pio)];
+    host_pio_sm_t *p_sm = &p_pio->sm[sm];
+    uint64_t word_cycles;
+
+    // 前の設定で積んだフレームを先に検証
+    pthread_mutex_lock(&s_pio_mutex);
+    if (p_sm->trace_cnt != 0) {
+        host_pio_trace_frame(p_sm);
+    }
+    pthread_mutex_unlock(&s_pio_mutex);
+
+    memset(p_sm->pull_time_ns, 0, sizeof(p_sm->pull_time_ns));
+    p_sm->config = *config;
+    p_sm->pio_idx = pio_get_index(pio);
+    p_sm->sm_idx = sm;
+    p_sm->initial_pc = initial_pc;
+    p_sm->fifo_depth = (config->fifo_join == PIO_FIFO_JOIN_TX) ? 8 : 4;
+    p_sm->put_cnt = 0;
+    p_sm->busy_until_ns = 0;
+    word_cycles = host_pio_calc_word_cycles(p_pio, config);
+    p_sm->word_ns = (word_cycles * config->clkdiv_x256 * 1000000000ull) / (256ull * HOST_CLK_SYS_HZ);
+
+    return PICO_OK;
+}
+
+void pio_sm_set_enabled(PIO pio, uint sm, bool enabled)
+{
+    s_pio[pio_get_index(pio)].sm[sm].is_enabled = enabled;
+}
+
+/**
+ * @brief TX FIFOに1語積む時刻と、その語がOSRに取り込まれる時刻を計算
+ *
+ * @return uint64_t 積める時刻(FIFOに空きができる時刻)[ns]
+ */
+static void host_pio_trace_word(host_pio_sm_t *p_sm, uint32_t data, uint64_t issue_ns, uint64_t pull_ns);
+
+static uint64_t host_pio_push_word(host_pio_sm_t *p_sm, uint32_t data, uint64_t now_ns)
+{
+    uint32_t slot = p_sm->put_cnt % p_sm->fifo_depth;
+    uint64_t issue_ns = now_ns;
+    uint64_t pull_ns;
+
+    // fifo_depth語前の語がOSRへ取り込まれるまでFIFOは空かない
+    if ((p_sm->put_cnt >= p_sm->fifo_depth) && (p_sm->pull_time_ns[slot] > issue_ns)) {
+        issue_ns = p_sm->pull_time_ns[slot];
+    }
+    pull_ns = (p_sm->busy_until_ns > issue_ns) ? p_sm->busy_until_ns : issue_ns;
+    p_sm->pull_time_ns[slot] = pull_ns;
+    p_sm->busy_until_ns = pull_ns + p_sm->word_ns;
+    p_sm->put_cnt++;
+
+    if (s_pio_trace && p_sm->is_enabled) {
+        host_pio_trace_word(p_sm, data, issue_ns, pull_ns);
+    }
+
+    return issue_ns;
+}
+
+static uint64_t host_now_ns(void)
+{
+    if (s_boot_ns == 0) {
+        s_boot_ns = host_monotonic_ns();
+    }
+    return host_monotonic_ns() - s_boot_ns;
+}
+
+void pio_sm_put(PIO pio, uint sm, uint32_t data)
+{
+    pthread_mutex_lock(&s_pio_mutex);
+    pio->txf[sm] = data;
+    (void)host_pio_push_word(&s_pio[pio_get_index(pio)].sm[sm], data, host_now_ns());
+    pthread_mutex_unlock(&s_pio_mutex);
+}
+
+void pio_sm_put_blocking(PIO pio, uint sm, uint32_t data)
+{
+    uint64_t issue_ns;
+
+    pthread_mutex_lock(&s_pio_mutex);
+    pio->txf[sm] = data;
+    issue_ns = host_pio_push_word(&s_pio[pio_get_index(pio)].sm[sm], data, host_now_ns());
+    pthread_mutex_unlock(&s_pio_mutex);
+
+    // FIFOが満杯の間はCPUがストールする
+    host_sleep_until_us(issue_ns / 1000u);
+}
+
+uint pio_sm_get_tx_fifo_level(PIO pio, uint sm)
+{
+    host_pio_sm_t *p_sm = &s_pio[pio_get_index(pio)].sm[sm];
+    uint64_t now_ns = host_now_ns();
+    uint level = 0;
+
+    pthread_mutex_lock(&s_pio_mutex);
+    for (uint32_t i = 0; (i < p_sm->fifo_depth) && (i < p_sm->put_cnt); i++)
+    {
+        if (p_sm->pull_time_ns[i] > now_ns) {
+            level++;
+        }
+    }
+    pthread_mutex_unlock(&s_pio_mutex);
+
+    return level;
+}
+
+bool pio_sm_is_tx_fifo_full(PIO pio, uint sm)
+{
+    return pio_sm_get_tx_fifo_level(pio, sm) >= s_pio[pio_get_index(pio)].sm[sm].fifo_depth;
+}
+
+bool pio_sm_is_tx_fifo_empty(PIO pio, uint sm)
+{
+    return pio_sm_get_tx_fifo_level(pio, sm) == 0;
+}
+
+void pio_sm_clear_fifos(PIO pio, uint sm)
+{
+    host_pio_sm_t *p_sm = &s_pio[pio_get_index(pio)].sm[sm];
+
+    pthread_mutex_lock(&s_pio_mutex);
+    memset(p_sm->pull_time_ns, 0, sizeof(p_sm->pull_time_ns));
+    p_sm->put_cnt = 0;
+    pthread_mutex_unlock(&s_pio_mutex);
+}
+
+// -------------------------------------------------------------------------
+// [PIO 波形トレース] ... RP2XXX_PIO_TRACE
+// -------------------------------------------------------------------------
+static uint64_t host_ns_to_cycle(uint64_t ns)
+{
+    return ((ns / 1000000000ull) * HOST_CLK_SYS_HZ) + (((ns % 1000000000ull) * HOST_CLK_SYS_HZ) / 1000000000ull);
+}
+
+// 最小～最大(同じなら1つ、1度も出てこなければ"-")
+static const char *host_pio_fmt_range(char *p_buf, size_t size, uint32_t min, uint32_t max)
+{
+    if (max == 0) {
+        snprintf(p_buf, size, "-");
+    } else if (min == max) {
+        snprintf(p_buf, size, "%u", min);
+    } else {
+        snprintf(p_buf, size, "%u-%u", min, max);
+    }
+    return p_buf;
+}
+
+static void host_pio_stat_merge(host_pio_wave_stat_t *p_all, const host_pio_wave_stat_t *p_lane, bool is_first)
+{
+    if (is_first) {
+        *p_all = *p_lane;
+        return;
+    }
+#define HOST_PIO_MERGE_MIN(m)   if ((p_lane->m != 0) && ((p_all->m == 0) || (p_lane->m < p_all->m))) { p_all->m = p_lane->m; }
+#define HOST_PIO_MERGE_MAX(m)   if (p_lane->m > p_all->m) { p_all->m = p_lane->m; }
+    HOST_PIO_MERGE_MIN(t0h_min) HOST_PIO_MERGE_MAX(t0h_max)
+    HOST_PIO_MERGE_MIN(t1h_min) HOST_PIO_MERGE_MAX(t1h_max)
+    HOST_PIO_MERGE_MIN(t0l_min) HOST_PIO_MERGE_MAX(t0l_max)
+    HOST_PIO_MERGE_MIN(t1l_min) HOST_PIO_MERGE_MAX(t1l_max)
+    HOST_PIO_MERGE_MIN(bit_min) HOST_PIO_MERGE_MAX(bit_max)
+    HOST_PIO_MERGE_MAX(gap_max) HOST_PIO_MERGE_MAX(frame_ns)
+#undef HOST_PIO_MERGE_MIN
+#undef HOST_PIO_MERGE_MAX
+    p_all->gap_cnt += p_lane->gap_cnt;
+    p_all->bad_cnt += p_lane->bad_cnt;
+    p_all->one_cnt += p_lane->one_cnt;
+}
+
+/**
+ * @brief 記録した1フレーム分の語をエミュレータで実行し、波形を検証して表示(s_pio_mutexを取った状態で呼ぶ)
+ *
+ * 1ピン(サイドセット)のプログラムは語の上位(左シフト)/下位(右シフト)からpull_threshold個のビット、
+ * 複数ピン(OUT/MOV pins)のプログラムは1語 = 全レーンの同じビット(レーンiは語のビットi)として期待値と比べる。
+ */
+static void host_pio_trace_frame(host_pio_sm_t *p_sm)
+{
+    const pio_sm_config *c = &p_sm->config;
+    bool is_lane = (c->out_count != 0);
+    uint32_t pin_base = is_lane ? c->out_base : c->sideset_base;
+    uint32_t pin_cnt = is_lane ? c->out_count : 1u;
+    uint32_t word_bits = is_lane ? 1u : c->pull_threshold;
+    uint32_t bit_max = p_sm->trace_cnt * word_bits;
+    uint32_t edge_max = p_sm->trace_cnt * ((2u * c->pull_threshold) + 4u);
+    uint32_t bad_lane = 0, bad_bit = 0, pin_mask = 0, mismatch_cnt = 0;
+    uint64_t at, word_cycles, start_cycle;
+    host_pio_wave_stat_t stat, lane;
+    host_pio_emu_t emu;
+    uint8_t *p_bits;
+    char t0h[24], t0l[24], t1h[24], t1l[24], bit[24], pins[24];
+    bool is_ok;
+
+    edge_max = (edge_max < HOST_PIO_TRACE_EDGE_MAX) ? edge_max : HOST_PIO_TRACE_EDGE_MAX;
+    emu.p_edge = malloc(edge_max * sizeof(host_pio_edge_t));
+    emu.edge_max = edge_max;
+    p_bits = malloc(bit_max);
+    if ((emu.p_edge == NULL) || (p_bits == NULL)) {
+        free(emu.p_edge);
+        free(p_bits);
+        p_sm->trace_cnt = 0;
+        return;
+    }
+
+    // 語を積んだ時刻どおりにFIFOへ入れながら実行
+    start_cycle = host_ns_to_cycle(p_sm->p_trace_ns[0]);
+    host_pio_emu_init(&emu, s_pio[p_sm->pio_idx].instr, c, p_sm->initial_pc, start_cycle);
+    for (uint32_t i = 0; (i < p_sm->trace_cnt) && !emu.is_err; i++)
+    {
+        at = host_ns_to_cycle(p_sm->p_trace_ns[i]);
+        host_pio_emu_run(&emu, at);
+        host_pio_emu_resume(&emu, at);
+        while (!host_pio_emu_push(&emu, p_sm->p_trace_word[i]))
+        {
+            // FIFOが満杯(モデルより遅れている) ... 1命令ずつ進めて空きを待つ
+            if (host_pio_emu_run(&emu, host_pio_emu_cycle(&emu, emu.tick) + 1u) == HOST_PIO_EMU_CYCLE_NEVER) {
+                break;
+            }
+        }
+    }
+    word_cycles = host_ns_to_cycle(p_sm->word_ns) + 1u;
+    host_pio_emu_run(&emu, host_pio_emu_cycle(&emu, emu.tick) + ((p_sm->trace_cnt + 16u) * word_cycles * 2u));
+
+    // ピン毎に復号して期待値と比べる
+    memset(&stat, 0, sizeof(stat));
+    for (uint32_t l = 0; l < pin_cnt; l++)
+    {
+        uint32_t pin = (pin_base + l) % 32u;
+        uint32_t n = host_pio_wave_decode(emu.p_edge, emu.edge_cnt, pin, HOST_CLK_SYS_HZ, p_bits, bit_max, &lane);
+
+        pin_mask |= 1u << pin;
+        host_pio_stat_merge(&stat, &lane, (l == 0));
+        for (uint32_t k = 0; k < bit_max; k++)
+        {
+            uint32_t word = p_sm->p_trace_word[k / word_bits];
+            uint32_t b = k % word_bits;
+            uint8_t expect;
+
+            if (is_lane) {
+                expect = (word >> l) & 1u;
+            } else {
+                expect = c->out_shift_right ? ((word >> b) & 1u) : ((word >> (31u - b)) & 1u);
+            }
+            if ((k >= n) || (p_bits[k] != expect)) {
+                if (mismatch_cnt == 0) {
+                    bad_lane = l;
+                    bad_bit = k;
+                }
+                mismatch_cnt++;
+                break;
+            }
+        }
+        if (n > bit_max) {
+            mismatch_cnt++;
+        }
+    }
+
+    is_ok = !emu.is_err && !p_sm->is_trace_over && (emu.edge_cnt < emu.edge_max) &&
+            (stat.bad_cnt == 0) && (stat.gap_cnt == 0) && (mismatch_cnt == 0);
+    p_sm->gap_max_ns = (stat.gap_max > p_sm->gap_max_ns) ? stat.gap_max : p_sm->gap_max_ns;
+
+    // 最初のフレーム、NGのフレーム、ビット数が変わったフレームを表示
+    if ((p_sm->frame_cnt == 0) || !is_ok || (bit_max != p_sm->last_bit_cnt)) {
+        if (pin_cnt == 1) {
+            snprintf(pins, sizeof(pins), "GPIO%u", pin_base);
+        } else {
+            snprintf(pins, sizeof(pins), "GPIO%u-%u", pin_base, pin_base + pin_cnt - 1u);
+        }
+        fprintf(stderr, "[HOST PIO] pio%u sm%u %s: %u bits%s, %.1f us (model %.1f us), "
+                "T0H %s T0L %s T1H %s T1L %s ns, bit %s ns, gaps %u (max %.1f us), %s\n",
+                p_sm->pio_idx, p_sm->sm_idx, pins, is_lane ? p_sm->trace_cnt : bit_max, is_lane ? "/lane" : "",
+                (double)stat.frame_ns / 1000.0, (double)(p_sm->trace_end_ns - p_sm->trace_pull_ns) / 1000.0,
+                host_pio_fmt_range(t0h, sizeof(t0h), stat.t0h_min, stat.t0h_max),
+                host_pio_fmt_range(t0l, sizeof(t0l), stat.t0l_min, stat.t0l_max),
+                host_pio_fmt_range(t1h, sizeof(t1h), stat.t1h_min, stat.t1h_max),
+                host_pio_fmt_range(t1l, sizeof(t1l), stat.t1l_min, stat.t1l_max),
+                host_pio_fmt_range(bit, sizeof(bit), stat.bit_min, stat.bit_max),
+                stat.gap_cnt, (double)stat.gap_max / 1000.0, is_ok ? "OK" : "NG");
+        if (emu.is_err) {
+            fprintf(stderr, "[HOST PIO]   unsupported instruction 0x%04X at pc %u\n", emu.instr[emu.pc], emu.pc);
+        }
+        if (p_sm->is_trace_over || (emu.edge_cnt >= emu.edge_max)) {
+            fprintf(stderr, "[HOST PIO]   frame truncated (max %u words)\n", HOST_PIO_TRACE_WORD_MAX);
+        }
+        if (stat.bad_cnt != 0) {
+            fprintf(stderr, "[HOST PIO]   %u bits out of WS2812 timing\n", stat.bad_cnt);
+        }
+        if (mismatch_cnt != 0) {
+            fprintf(stderr, "[HOST PIO]   data mismatch on %u lanes (first: GPIO%u bit %u)\n",
+                    mismatch_cnt, (pin_base + bad_lane) % 32u, bad_bit);
+        }
+    }
+
+    if ((s_p_pio_vcd != NULL) && !p_sm->is_vcd_done) {
+        char path[256];
+        snprintf(path, sizeof(path), "%s_pio%u_sm%u.vcd", s_p_pio_vcd, p_sm->pio_idx, p_sm->sm_idx);
+        if (host_pio_wave_write_vcd(path, emu.p_edge, emu.edge_cnt, pin_mask, HOST_CLK_SYS_HZ)) {
+            fprintf(stderr, "[HOST PIO] pio%u sm%u waveform -> %s\n", p_sm->pio_idx, p_sm->sm_idx, path);
+        }
+        p_sm->is_vcd_done = true;
+    }
+
+    p_sm->frame_cnt++;
+    p_sm->frame_ng_cnt += is_ok ? 0u : 1u;
+    p_sm->last_bit_cnt = bit_max;
+    p_sm->trace_cnt = 0;
+    p_sm->is_trace_over = false;
+    free(emu.p_edge);
+    free(p_bits);
+}
+
+/**
+ * @brief TX FIFOに積んだ語を記録(s_pio_mutexを取った状態で呼ぶ)
+ *
+ * @param p_sm ステートマシン
+ * @param data 語
+ * @param issue_ns FIFOに積んだ時刻
+ * @param pull_ns モデルでOSRに取り込む時刻
+ */
+static void host_pio_trace_word(host_pio_sm_t *p_sm, uint32_t data, uint64_t issue_ns, uint64_t pull_ns)
+{
+    // SMがリセット時間以上空いていたら前のフレームは終わり
+    if ((p_sm->trace_cnt != 0) && (issue_ns >= (p_sm->trace_end_ns + HOST_PIO_TRACE_IDLE_NS))) {
+        host_pio_trace_frame(p_sm);
+    }
+
+    if (p_sm->p_trace_word == NULL) {
+        p_sm->p_trace_word = malloc(HOST_PIO_TRACE_WORD_MAX * sizeof(uint32_t));
+        p_sm->p_trace_ns = malloc(HOST_PIO_TRACE_WORD_MAX * sizeof(uint64_t));
+    }
+    if (p_sm->trace_cnt == 0) {
+        p_sm->trace_pull_ns = pull_ns;
+    }
+    if (p_sm->trace_cnt < HOST_PIO_TRACE_WORD_MAX) {
+        p_sm->p_trace_word[p_sm->trace_cnt] = data;
+        p_sm->p_trace_ns[p_sm->trace_cnt] = issue_ns;
+        p_sm->trace_cnt++;
+    } else {
+        p_sm->is_trace_over = true;
+    }
+    p_sm->trace_end_ns = p_sm->busy_until_ns;
+}
+
+// 終了時に最後のフレームを検証してまとめを表示
+static void host_pio_trace_exit(void)
+{
+    pthread_mutex_lock(&s_pio_mutex);
+    for (uint32_t p = 0; p < NUM_PIOS; p++)
+    {
+        for (uint32_t sm = 0; sm < NUM_PIO_STATE_MACHINES; sm++)
+        {
+            host_pio_sm_t *p_sm = &s_pio[p].sm[sm];
+
+            if (p_sm->trace_cnt != 0) {
+                host_pio_trace_frame(p_sm);
+            }
+            if (p_sm->frame_cnt != 0) {
+                fprintf(stderr, "[HOST PIO] pio%u sm%u: %u frames, %u NG, max gap %.1f us\n",
+                        p, sm, p_sm->frame_cnt, p_sm->frame_ng_cnt, (double)p_sm->gap_max_ns / 1000.0);
+            }
+        }
+    }
+    pthread_mutex_unlock(&s_pio_mutex);
+}
+
+static void host_pio_trace_init(void)
+{
+    s_pio_trace = (getenv("RP2XXX_PIO_TRACE") != NULL) || (getenv("RP2XXX_PIO_VCD") != NULL);
+    s_p_pio_vcd = getenv("RP2XXX_PIO_VCD");
+    if (s_pio_trace) {
+        atexit(host_pio_trace_exit);
+    }
+}
+
+// -------------------------------------------------------------------------
+// [DMA]
+// -------------------------------------------------------------------------
+#define HOST_DMA_CTRL_EN            (1u << 0)
+#define HOST_DMA_CTRL_SIZE_LSB      2
+#define HOST_DMA_CTRL_INCR_READ     (1u << 4)
+#define HOST_DMA_CTRL_INCR_WRITE    (1u << 6)
+#define HOST_DMA_CTRL_CHAIN_LSB     13
+#define HOST_DMA_CTRL_TREQ_LSB      17
+#define HOST_DMA_CTRL_IRQ_QUIET     (1u << 23)
+#define HOST_DMA_CTRL_BSWAP         (1u << 24)
+
+typedef struct {
+    bool is_claimed;
+    dma_channel_config config;
+    uintptr_t read_addr;
+    uintptr_t write_addr;
+    uint32_t trans_count;
+    uint64_t busy_until_ns;
+    bool irq0_enabled;
+    bool irq0_status;
+} host_dma_ch_t;
+
+static host_dma_ch_t s_dma[NUM_DMA_CHANNELS];
+static irq_handler_t s_irq_handler[2][32];   // [コア][IRQ番号]
+static bool s_irq_enabled[2][32];
+static uint s_irq_core[32];                 // 最後にハンドラを登録したコア
+
+int dma_claim_unused_channel(bool required)
+{
+    for (uint32_t ch = 0; ch < NUM_DMA_CHANNELS; ch++)
+    {
+        if (!s_dma[ch].is_claimed) {
+            s_dma[ch].is_claimed = true;
+            return (int)ch;
+        }
+    }
+    hard_assert(!required);
+    return -1;
+}
+
+void dma_channel_claim(uint channel)
+{
+    s_dma[channel].is_claimed = true;
+}
+
+void dma_channel_unclaim(uint channel)
+{
+    s_dma[channel].is_claimed = false;
+}
+
+dma_channel_config dma_channel_get_default_config(uint channel)
+{
+    dma_channel_config c = {
+        .ctrl = HOST_DMA_CTRL_EN | (DMA_SIZE_32 << HOST_DMA_CTRL_SIZE_LSB) | HOST_DMA_CTRL_INCR_READ |
+                ((channel & 0xfu) << HOST_DMA_CTRL_CHAIN_LSB) | (DREQ_FORCE << HOST_DMA_CTRL_TREQ_LSB),
+    };
+    return c;
+}
+
+void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size size)
+{
+    c->ctrl = (c->ctrl & ~(3u << HOST_DMA_CTRL_SIZE_LSB)) | ((uint32_t)size << HOST_DMA_CTRL_SIZE_LSB);
+}
+
+void channel_config_set_read_increment(dma_channel_config *c, bool incr)
+{
+    c->ctrl = incr ? (c->ctrl | HOST_DMA_CTRL_INCR_READ) : (c->ctrl & ~HOST_DMA_CTRL_INCR_READ);
+}
+
+void channel_config_set_write_increment(dma_channel_config *c, bool incr)
+{
+    c->ctrl = incr ? (c->ctrl | HOST_DMA_CTRL_INCR_WRITE) : (c->ctrl & ~HOST_DMA_CTRL_INCR_WRITE);
+}
+
+void channel_config_set_dreq(dma_channel_config *c, uint dreq)
+{
+    c->ctrl = (c->ctrl & ~(0x3fu << HOST_DMA_CTRL_TREQ_LSB)) | ((dreq & 0x3fu) << HOST_DMA_CTRL_TREQ_LSB);
+}
+
+void channel_config_set_chain_to(dma_channel_config *c, uint chain_to)
+{
+    c->ctrl = (c->ctrl & ~(0xfu << HOST_DMA_CTRL_CHAIN_LSB)) | ((chain_to & 0xfu) << HOST_DMA_CTRL_CHAIN_LSB);
+}
+
+void channel_config_set_bswap(dma_channel_config *c, bool bswap)
+{
+    c->ctrl = bswap ? (c->ctrl | HOST_DMA_CTRL_BSWAP) : (c->ctrl & ~HOST_DMA_CTRL_BSWAP);
+}
+
+void channel_config_set_irq_quiet(dma_channel_config *c, bool irq_quiet)
+{
+    c->ctrl = irq_quiet ? (c->ctrl | HOST_DMA_CTRL_IRQ_QUIET) : (c->ctrl & ~HOST_DMA_CTRL_IRQ_QUIET);
+}
+
+void channel_config_set_enable(dma_channel_config *c, bool enable)
+{
+    c->ctrl = enable ? (c->ctrl | HOST_DMA_CTRL_EN) : (c->ctrl & ~HOST_DMA_CTRL_EN);
+}
+
+static int64_t host_dma_irq_alarm(alarm_id_t id, void *user_data)
+{
+    uint ch = (uint)(uintptr_t)user_data;
+
+    (void)id;
+    s_dma[ch].irq0_status = true;
+    if (s_irq_enabled[s_core_num][DMA_IRQ_0] && (s_irq_handler[s_core_num][DMA_IRQ_0] != NULL)) {
+        s_irq_handler[s_core_num][DMA_IRQ_0]();
+    }
+    return 0;
+}
+
+/**
+ * @brief DMA転送の実行(シンク毎にFIFOへ積める時刻を求めてビジー期間にする)
+ */
+static void host_dma_run(uint ch)
+{
+    host_dma_ch_t *p_ch = &s_dma[ch];
+    uint32_t ctrl = p_ch->config.ctrl;
+    uint32_t size = 1u << ((ctrl >> HOST_DMA_CTRL_SIZE_LSB) & 3u);
+    uint64_t done_ns = host_now_ns();
+    uint32_t chain_to = (ctrl >> HOST_DMA_CTRL_CHAIN_LSB) & 0xfu;
+
+    if ((ctrl & HOST_DMA_CTRL_EN) == 0) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < p_ch->trans_count; i++)
+    {
+        uint32_t val = 0;
+        bool is_sink = false;
+
+        if ((p_ch->read_addr == XIP_AUX_BASE) || (p_ch->read_addr == (uintptr_t)&g_host_xip_ctrl_hw.stream_fifo)) {
+            val = host_xip_stream_pop();
+        } else {
+            memcpy(&val, (const void *)p_ch->read_addr, size);
+        }
+        if ((ctrl & HOST_DMA_CTRL_BSWAP) && (size > 1)) {
+            val = (size == 4) ? __builtin_bswap32(val) : __builtin_bswap16((uint16_t)val);
+        }
+
+        // PIOのTX FIFO
+        for (uint32_t p = 0; (p < NUM_PIOS) && !is_sink; p++)
+        {
+            for (uint32_t sm = 0; sm < NUM_PIO_STATE_MACHINES; sm++)
+            {
+                if (p_ch->write_addr == (uintptr_t)&g_host_pio[p].txf[sm]) {
+                    // 8/16bitの書き込みは実機と同じく32bitの全レーンに複製される
+                    val = (size == 1) ? (val * 0x01010101u) : ((size == 2) ? (val * 0x00010001u) : val);
+                    pthread_mutex_lock(&s_pio_mutex);
+                    g_host_pio[p].txf[sm] = val;
+                    uint64_t issue_ns = host_pio_push_word(&s_pio[p].sm[sm], val, done_ns);
+                    pthread_mutex_unlock(&s_pio_mutex);
+                    done_ns = (issue_ns > done_ns) ? issue_ns : done_ns;
+                    is_sink = true;
+                    break;
+                }
+            }
+        }
+
+        // SHA-256のWDATA
+        if (!is_sink && (p_ch->write_addr == (uintptr_t)&g_host_sha256_hw.wdata)) {
+            // 8/16bitの転送はDMA_SIZEを合わせてあれば1転送=1/2バイトとして取り込まれる
+            host_sha_flush_wdata();
+            if (size == 4) {
+                host_sha_feed_word(val);
+            } else {
+                for (uint32_t i = 0; i < size; i++)
+                {
+                    host_sha_feed_byte((uint8_t)(val >> (8 * i)));
+                }
+            }
+            is_sink = true;
+        }
+
+        if (!is_sink) {
+            memcpy((void *)p_ch->write_addr, &val, size);
+        }
+
+        if (ctrl & HOST_DMA_CTRL_INCR_READ) {
+            p_ch->read_addr += size;
+        }
+        if (ctrl & HOST_DMA_CTRL_INCR_WRITE) {
+            p_ch->write_addr += size;
+        }
+    }
+    p_ch->busy_until_ns = done_ns;
+
+    if (p_ch->irq0_enabled && ((ctrl & HOST_DMA_CTRL_IRQ_QUIET) == 0)) {
+        // 完了時刻にDMA_IRQ_0を発生
+        alarm_id_t id = add_alarm_at(done_ns / 1000u, host_dma_irq_alarm, (void *)(uintptr_t)ch, true);
+        if (id > 0) {
+            pthread_mutex_lock(&s_alarm_mutex);
+            for (int32_t i = 0; i < HOST_ALARM_MAX; i++)
+            {
+                if (s_alarm[i].is_used && (s_alarm[i].id == id)) {
+                    s_alarm[i].core = s_irq_core[DMA_IRQ_0];
+                }
+            }
+            pthread_mutex_unlock(&s_alarm_mutex);
+        }
+    }
+
+    if (chain_to != ch) {
+        host_dma_run(chain_to);
+    }
+}
+
+void dma_channel_configure(uint channel, const dma_channel_config *config, volatile void *write_addr,
+                            const volatile void *read_addr, uint transfer_count, bool trigger)
+{
+    host_dma_ch_t *p_ch = &s_dma[channel];
+
+    p_ch->config = *config;
+    p_ch->write_addr = (uintptr_t)write_addr;
+    p_ch->read_addr = (uintptr_t)read_addr;
+    p_ch->trans_count = transfer_count;
+    if (trigger) {
+        host_dma_run(channel);
+    }
+}
+
+void dma_channel_set_config(uint channel, const dma_channel_config *config, bool trigger)
+{
+    s_dma[channel].config = *config;
+    if (trigger) {
+        host_dma_run(channel);
+    }
+}
+
+void dma_channel_set_read_addr(uint channel, const volatile void *read_addr, bool trigger)
+{
+    s_dma[channel].read_addr = (uintptr_t)read_addr;
+    if (trigger) {
+        host_dma_run(channel);
+    }
+}
+
+void dma_channel_set_write_addr(uint channel, volatile void *write_addr, bool trigger)
+{
+    s_dma[channel].write_addr = (uintptr_t)write_addr;
+    if (trigger) {
+        host_dma_run(channel);
+    }
+}
+
+void dma_channel_set_trans_count(uint channel, uint32_t trans_count, bool trigger)
+{
+    s_dma[channel].trans_count = trans_count;
+    if (trigger) {
+        host_dma_run(channel);
+    }
+}
+
+void dma_channel_transfer_from_buffer_now(uint channel, const volatile void *read_addr, uint32_t transfer_count)
+{
+    s_dma[channel].read_addr = (uintptr_t)read_addr;
+    s_dma[channel].trans_count = transfer_count;
+    host_dma_run(channel);
+}
+
+void dma_channel_start(uint channel)
+{
+    host_dma_run(channel);
+}
+
+bool dma_channel_is_busy(uint channel)
+{
+    return host_now_ns() < s_dma[channel].busy_until_ns;
+}
+
+void dma_channel_wait_for_finish_blocking(uint channel)
+{
+    host_sleep_until_us((s_dma[channel].busy_until_ns + 999u) / 1000u);
+}
+
+void dma_channel_abort(uint channel)
+{
+    s_dma[channel].busy_until_ns = 0;
+}
+
+void dma_channel_set_irq0_enabled(uint channel, bool enabled)
+{
+    s_dma[channel].irq0_enabled = enabled;
+}
+
+bool dma_channel_get_irq0_status(uint channel)
+{
+    return s_dma[channel].irq0_status;
+}
+
+void dma_channel_acknowledge_irq0(uint channel)
+{
+    s_dma[channel].irq0_status = false;
+}
+
+static bool host_bell_is_pending(void);
+static void host_bell_irq_call(void *arg);
+
+// -------------------------------------------------------------------------
+// [IRQ]
+// -------------------------------------------------------------------------
+void irq_set_exclusive_handler(uint num, irq_handler_t handler)
+{
+    s_irq_handler[s_core_num][num % 32] = handler;
+    s_irq_core[num % 32] = s_core_num;
+}
+
+void irq_set_enabled(uint num, bool enabled)
+{
+    s_irq_enabled[s_core_num][num % 32] = enabled;
+
+    // 実機と同じく、有効化した時点で鳴っているベルは割り込みになる
+    if (enabled && (num == SIO_IRQ_BELL) && host_bell_is_pending()) {
+        host_run_irq(s_core_num, host_bell_irq_call, NULL);
+    }
+}
+
+bool irq_is_enabled(uint num)
+{
+    return s_irq_enabled[s_core_num][num % 32];
+}
+
+void irq_set_priority(uint num, uint8_t hardware_priority)
+{
+    (void)num;
+    (void)hardware_priority;
+}
+
+// -------------------------------------------------------------------------
+// [H/Wスピンロック]
+// -------------------------------------------------------------------------
+static spin_lock_t s_spin_lock[NUM_SPIN_LOCKS];
+static uint32_t s_spin_lock_claimed = 0;
+
+spin_lock_t *spin_lock_instance(uint lock_num)
+{
+    return &s_spin_lock[lock_num % NUM_SPIN_LOCKS];
+}
+
+int spin_lock_claim_unused(bool required)
+{
+    // SDKと同じく上位(16～)から割り当て ※0～15はSDK/OSの予約
+    for (uint32_t i = 16; i < NUM_SPIN_LOCKS; i++)
+    {
+        if (!(__atomic_fetch_or(&s_spin_lock_claimed, 1u << i, __ATOMIC_ACQ_REL) & (1u << i))) {
+            return (int)i;
+        }
+    }
+    hard_assert(!required);
+    return -1;
+}
+
+void spin_lock_unclaim(uint lock_num)
+{
+    spin_unlock_unsafe(spin_lock_instance(lock_num));
+    __atomic_fetch_and(&s_spin_lock_claimed, ~(1u << (lock_num % NUM_SPIN_LOCKS)), __ATOMIC_ACQ_REL);
+}
+
+// -------------------------------------------------------------------------
+// [Doorbell]
+// -------------------------------------------------------------------------
+static uint32_t s_doorbell_claimed = 0;
+static volatile uint32_t s_doorbell[2] = {0, 0};    // [受信側コア]
+
+static void host_bell_irq_call(void *arg)
+{
+    (void)arg;
+    s_irq_handler[s_core_num][SIO_IRQ_BELL]();
+}
+
+static bool host_bell_is_pending(void)
+{
+    return (s_doorbell[s_core_num] != 0) && (s_irq_handler[s_core_num][SIO_IRQ_BELL] != NULL);
+}
+
+int multicore_doorbell_claim_unused(uint core_mask, bool required)
+{
+    (void)core_mask;
+    for (uint32_t i = 0; i < NUM_DOORBELLS; i++)
+    {
+        if (!(__atomic_fetch_or(&s_doorbell_claimed, 1u << i, __ATOMIC_ACQ_REL) & (1u << i))) {
+            return (int)i;
+        }
+    }
+    hard_assert(!required);
+    return -1;
+}
+
+void multicore_doorbell_unclaim(uint doorbell_num, uint core_mask)
+{
+    (void)core_mask;
+    __atomic_fetch_and(&s_doorbell_claimed, ~(1u << doorbell_num), __ATOMIC_ACQ_REL);
+}
+
+void multicore_doorbell_set_other_core(uint doorbell_num)
+{
+    uint other = s_core_num ^ 1u;
+
+    __atomic_fetch_or(&s_doorbell[other], 1u << doorbell_num, __ATOMIC_ACQ_REL);
+    if (s_irq_enabled[other][SIO_IRQ_BELL] && (s_irq_handler[other][SIO_IRQ_BELL] != NULL)) {
+        host_run_irq(other, host_bell_irq_call, NULL);
+    } else {
+        __sev();
+    }
+}
+
+void multicore_doorbell_set_current_core(uint doorbell_num)
+{
+    __atomic_fetch_or(&s_doorbell[s_core_num], 1u << doorbell_num, __ATOMIC_ACQ_REL);
+    if (s_irq_enabled[s_core_num][SIO_IRQ_BELL] && (s_irq_handler[s_core_num][SIO_IRQ_BELL] != NULL)) {
+        host_run_irq(s_core_num, host_bell_irq_call, NULL);
+    }
+}
+
+void multicore_doorbell_clear_current_core(uint doorbell_num)
+{
+    __atomic_fetch_and(&s_doorbell[s_core_num], ~(1u << doorbell_num), __ATOMIC_ACQ_REL);
+}
+
+bool multicore_doorbell_is_set_current_core(uint doorbell_num)
+{
+    return (s_doorbell[s_core_num] & (1u << doorbell_num)) != 0;
+}
+
+// -------------------------------------------------------------------------
+// [Flash]
+// -------------------------------------------------------------------------
+void flash_range_erase(uint32_t flash_offs, size_t count)
+{
+    memset((void *)(uintptr_t)(XIP_BASE + flash_offs), 0xFF, count);
+}
+
+void flash_range_program(uint32_t flash_offs, const uint8_t *data, size_t count)
+{
+    uint8_t *p_dst = (uint8_t *)(uintptr_t)(XIP_BASE + flash_offs);
+
+    // NORフラッシュなので1→0方向にしか書けない
+    for (size_t i = 0; i < count; i++)
+    {
+        p_dst[i] &= data[i];
+    }
+}
+
+int flash_safe_execute(void (*func)(void *), void *param, uint32_t enter_exit_timeout_ms)
+{
+    (void)enter_exit_timeout_ms;
+    func(param);
+    return PICO_OK;
+}
@@ -0,0 +1,5 @@
+// Pico SDK hardware/adc.h のホスト用スタンドイン
+#ifndef HOST_HARDWARE_ADC_H
+#define HOST_HARDWARE_ADC_H
+#include "host_sdk.h"
+#endif // HOST_HARDWARE_ADC_H
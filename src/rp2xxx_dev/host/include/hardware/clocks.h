@@ -0,0 +1,5 @@
+// Pico SDK hardware/clocks.h のホスト用スタンドイン
+#ifndef HOST_HARDWARE_CLOCKS_H
+#define HOST_HARDWARE_CLOCKS_H
+#include "host_sdk.h"
+#endif // HOST_HARDWARE_CLOCKS_H
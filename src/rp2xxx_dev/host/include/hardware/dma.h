@@ -0,0 +1,5 @@
+// Pico SDK hardware/dma.h のホスト用スタンドイン
+#ifndef HOST_HARDWARE_DMA_H
+#define HOST_HARDWARE_DMA_H
+#include "host_sdk.h"
+#endif // HOST_HARDWARE_DMA_H
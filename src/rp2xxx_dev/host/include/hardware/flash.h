@@ -0,0 +1,5 @@
+// Pico SDK hardware/flash.h のホスト用スタンドイン
+#ifndef HOST_HARDWARE_FLASH_H
+#define HOST_HARDWARE_FLASH_H
+#include "host_sdk.h"
+#endif // HOST_HARDWARE_FLASH_H
@@ -0,0 +1,5 @@
+// Pico SDK hardware/gpio.h のホスト用スタンドイン
+#ifndef HOST_HARDWARE_GPIO_H
+#define HOST_HARDWARE_GPIO_H
+#include "host_sdk.h"
+#endif // HOST_HARDWARE_GPIO_H
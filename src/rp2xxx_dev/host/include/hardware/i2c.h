@@ -0,0 +1,5 @@
+// Pico SDK hardware/i2c.h のホスト用スタンドイン
+#ifndef HOST_HARDWARE_I2C_H
+#define HOST_HARDWARE_I2C_H
+#include "host_sdk.h"
+#endif // HOST_HARDWARE_I2C_H
@@ -0,0 +1,5 @@
+// Pico SDK hardware/interp.h のホスト用スタンドイン
+#ifndef HOST_HARDWARE_INTERP_H
+#define HOST_HARDWARE_INTERP_H
+#include "host_sdk.h"
+#endif // HOST_HARDWARE_INTERP_H
@@ -0,0 +1,5 @@
+// Pico SDK hardware/irq.h のホスト用スタンドイン
+#ifndef HOST_HARDWARE_IRQ_H
+#define HOST_HARDWARE_IRQ_H
+#include "host_sdk.h"
+#endif // HOST_HARDWARE_IRQ_H
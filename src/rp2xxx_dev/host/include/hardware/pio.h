@@ -0,0 +1,5 @@
+// Pico SDK hardware/pio.h のホスト用スタンドイン
+#ifndef HOST_HARDWARE_PIO_H
+#define HOST_HARDWARE_PIO_H
+#include "host_sdk.h"
+#endif // HOST_HARDWARE_PIO_H
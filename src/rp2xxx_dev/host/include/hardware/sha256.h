@@ -0,0 +1,5 @@
+// Pico SDK hardware/sha256.h のホスト用スタンドイン
+#ifndef HOST_HARDWARE_SHA256_H
+#define HOST_HARDWARE_SHA256_H
+#include "host_sdk.h"
+#endif // HOST_HARDWARE_SHA256_H
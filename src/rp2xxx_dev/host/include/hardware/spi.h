@@ -0,0 +1,5 @@
+// Pico SDK hardware/spi.h のホスト用スタンドイン
+#ifndef HOST_HARDWARE_SPI_H
+#define HOST_HARDWARE_SPI_H
+#include "host_sdk.h"
+#endif // HOST_HARDWARE_SPI_H
@@ -0,0 +1,5 @@
+// Pico SDK hardware/structs/xip_ctrl.h のホスト用スタンドイン
+#ifndef HOST_HARDWARE_STRUCTS_XIP_CTRL_H
+#define HOST_HARDWARE_STRUCTS_XIP_CTRL_H
+#include "host_sdk.h"
+#endif // HOST_HARDWARE_STRUCTS_XIP_CTRL_H
@@ -0,0 +1,5 @@
+// Pico SDK hardware/sync.h のホスト用スタンドイン
+#ifndef HOST_HARDWARE_SYNC_H
+#define HOST_HARDWARE_SYNC_H
+#include "host_sdk.h"
+#endif // HOST_HARDWARE_SYNC_H
@@ -0,0 +1,5 @@
+// Pico SDK hardware/timer.h のホスト用スタンドイン
+#ifndef HOST_HARDWARE_TIMER_H
+#define HOST_HARDWARE_TIMER_H
+#include "host_sdk.h"
+#endif // HOST_HARDWARE_TIMER_H
@@ -0,0 +1,5 @@
+// Pico SDK hardware/uart.h のホスト用スタンドイン
+#ifndef HOST_HARDWARE_UART_H
+#define HOST_HARDWARE_UART_H
+#include "host_sdk.h"
+#endif // HOST_HARDWARE_UART_H
@@ -0,0 +1,5 @@
+// Pico SDK hardware/watchdog.h のホスト用スタンドイン
+#ifndef HOST_HARDWARE_WATCHDOG_H
+#define HOST_HARDWARE_WATCHDOG_H
+#include "host_sdk.h"
+#endif // HOST_HARDWARE_WATCHDOG_H
@@ -0,0 +1,536 @@
+/**
+ * @file host_sdk.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief ホスト(Linux)ビルド用 Pico SDKスタンドインのヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026 Chimipupu All Rights Reserved.
+ *
+ * pico/xxx.h, hardware/xxx.h のスタンドインは全てこのヘッダをインクルードする。
+ * F/Wのソースはそのまま(#ifdef無し)でビルドできることを目標にしている。
+ */
+#ifndef HOST_SDK_H
+#define HOST_SDK_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <assert.h>
+#include <time.h>
+#include <sched.h>
+
+// -------------------------------------------------------------------------
+// [プラットフォーム]
+// -------------------------------------------------------------------------
+#define PICO_ON_DEVICE                  0
+#define PICO_RP2350                     1
+#define PICO_SDK_VERSION_STRING         "2.1.1 (host stand-in)"
+#define PICO_SDK_VERSION_MAJOR          2
+#define PICO_SDK_VERSION_MINOR          1
+#define PICO_SDK_VERSION_REVISION       1
+#define LIB_PICO_STDIO_USB              1
+
+typedef unsigned int uint;
+
+#define count_of(a)                     (sizeof(a) / sizeof((a)[0]))
+// NDEBUGでも式は必ず評価する(実機のhard_assertと同じく失敗で停止)
+#define hard_assert(x)                  ((x) ? (void)0 : host_hard_assert_fail(#x, __FILE__, __LINE__))
+void host_hard_assert_fail(const char *p_expr, const char *p_file, int line) __attribute__((noreturn));
+#define __not_in_flash_func(func)       func
+#define __time_critical_func(func)      func
+#define __no_inline_not_in_flash_func(func) __attribute__((noinline)) func
+#define __scratch_x(name)
+#define __scratch_y(name)
+#define __uninitialized_ram(name)       name
+#ifndef __aligned
+#define __aligned(n)                    __attribute__((aligned(n)))
+#endif
+
+#define PICO_OK                         0
+#define PICO_ERROR_NONE                 0
+#define PICO_ERROR_TIMEOUT              -1
+#define PICO_ERROR_GENERIC              -2
+#define PICO_ERROR_NO_DATA              -3
+
+// メモリマップ(ホストでは同じアドレスに疑似メモリをmmapする)
+#define XIP_BASE                        0x10000000u
+#define XIP_NOCACHE_NOALLOC_BASE        0x14000000u
+#define SRAM_BASE                       0x20000000u
+#define SRAM_END                        0x20082000u
+#define SYSINFO_BASE                    0x40000000u
+#define SIO_BASE                        0xD0000000u
+#define PPB_BASE                        0xE0000000u
+#define PICO_FLASH_SIZE_BYTES           (4u * 1024u * 1024u)
+#define FLASH_SECTOR_SIZE               4096u
+#define FLASH_PAGE_SIZE                 256u
+#define FLASH_BLOCK_SIZE                65536u
+
+// -------------------------------------------------------------------------
+// [stdio] ... printf等は全てstdioドライバ経由(実機のpico_stdioと同じ)
+// -------------------------------------------------------------------------
+typedef struct stdio_driver stdio_driver_t;
+struct stdio_driver {
+    void (*out_chars)(const char *buf, int len);
+    void (*out_flush)(void);
+    int (*in_chars)(char *buf, int len);
+    void (*set_chars_available_callback)(void (*fn)(void*), void *param);
+    stdio_driver_t *next;
+    bool crlf_enabled;
+    bool last_ended_with_cr;
+};
+
+extern stdio_driver_t stdio_usb;
+
+bool stdio_init_all(void);
+void stdio_set_driver_enabled(stdio_driver_t *driver, bool enabled);
+void stdio_filter_driver(stdio_driver_t *driver);
+void stdio_set_translate_crlf(stdio_driver_t *driver, bool translate);
+int stdio_getchar_timeout_us(uint32_t timeout_us);
+int getchar_timeout_us(uint32_t timeout_us);
+void stdio_flush(void);
+
+int host_printf(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
+int host_putchar(int c);
+int host_puts(const char *s);
+int host_getchar(void);
+size_t host_fwrite(const void *ptr, size_t size, size_t nmemb, FILE *fp);
+int host_fflush(FILE *fp);
+
+#ifndef HOST_SDK_IMPL
+#define printf          host_printf
+#define putchar         host_putchar
+#define puts            host_puts
+#define fwrite          host_fwrite
+#define fflush          host_fflush
+#undef  getchar
+#define getchar()       host_getchar()
+#endif // HOST_SDK_IMPL
+
+// -------------------------------------------------------------------------
+// [同期/コア]
+// -------------------------------------------------------------------------
+void host_sdk_init(void);
+uint get_core_num(void);
+
+// WFE/SEVはコア間の条件変数で再現(タイムアウト付きなので取りこぼしても止まらない)
+void __wfe(void);
+void __wfi(void);
+void __sev(void);
+static inline void __nop(void) { }
+static inline void __dmb(void) { __atomic_thread_fence(__ATOMIC_SEQ_CST); }
+static inline void __dsb(void) { __atomic_thread_fence(__ATOMIC_SEQ_CST); }
+static inline void __isb(void) { __atomic_thread_fence(__ATOMIC_SEQ_CST); }
+static inline void __mem_fence_acquire(void) { __atomic_thread_fence(__ATOMIC_ACQUIRE); }
+static inline void __mem_fence_release(void) { __atomic_thread_fence(__ATOMIC_RELEASE); }
+// スピン待ちは相手コア(スレッド)に実行を譲る ※ホストのCPU数がコア数より少なくても進む
+static inline void tight_loop_contents(void) { sched_yield(); }
+
+uint32_t save_and_disable_interrupts(void);
+void restore_interrupts(uint32_t status);
+void restore_interrupts_from_disabled(uint32_t status);
+
+// H/Wスピンロック(SIO) ... 32個、アトミック変数で再現
+#define NUM_SPIN_LOCKS                  32
+typedef volatile uint32_t spin_lock_t;
+spin_lock_t *spin_lock_instance(uint lock_num);
+int spin_lock_claim_unused(bool required);
+void spin_lock_unclaim(uint lock_num);
+static inline void spin_lock_unsafe_blocking(spin_lock_t *lock)
+{
+    while (__atomic_exchange_n(lock, 1u, __ATOMIC_ACQUIRE) != 0) {
+        tight_loop_contents();
+    }
+}
+static inline void spin_unlock_unsafe(spin_lock_t *lock) { __atomic_store_n(lock, 0u, __ATOMIC_RELEASE); }
+static inline bool is_spin_locked(spin_lock_t *lock) { return *lock != 0; }
+static inline uint32_t spin_lock_blocking(spin_lock_t *lock)
+{
+    uint32_t save = save_and_disable_interrupts();
+    spin_lock_unsafe_blocking(lock);
+    return save;
+}
+static inline void spin_unlock(spin_lock_t *lock, uint32_t saved_irq)
+{
+    spin_unlock_unsafe(lock);
+    restore_interrupts(saved_irq);
+}
+
+// -------------------------------------------------------------------------
+// [タイマー]
+// -------------------------------------------------------------------------
+typedef uint64_t absolute_time_t;
+typedef int32_t alarm_id_t;
+typedef int64_t (*alarm_callback_t)(alarm_id_t id, void *user_data);
+typedef struct alarm_pool alarm_pool_t;
+
+typedef struct repeating_timer repeating_timer_t;
+typedef bool (*repeating_timer_callback_t)(repeating_timer_t *rt);
+struct repeating_timer {
+    int64_t delay_us;
+    alarm_pool_t *pool;
+    alarm_id_t alarm_id;
+    repeating_timer_callback_t callback;
+    void *user_data;
+};
+
+#define PICO_TIME_DEFAULT_ALARM_POOL_MAX_TIMERS     16
+
+uint64_t time_us_64(void);
+uint32_t time_us_32(void);
+absolute_time_t get_absolute_time(void);
+static inline uint64_t to_us_since_boot(absolute_time_t t) { return t; }
+static inline uint32_t to_ms_since_boot(absolute_time_t t) { return (uint32_t)(t / 1000u); }
+static inline absolute_time_t make_timeout_time_us(uint64_t us) { return time_us_64() + us; }
+static inline absolute_time_t make_timeout_time_ms(uint32_t ms) { return time_us_64() + (uint64_t)ms * 1000u; }
+static inline int64_t absolute_time_diff_us(absolute_time_t from, absolute_time_t to) { return (int64_t)(to - from); }
+void sleep_us(uint64_t us);
+void sleep_ms(uint32_t ms);
+void busy_wait_us(uint64_t us);
+void busy_wait_us_32(uint32_t us);
+void busy_wait_ms(uint32_t ms);
+alarm_id_t add_alarm_in_us(uint64_t us, alarm_callback_t callback, void *user_data, bool fire_if_past);
+alarm_id_t add_alarm_in_ms(uint32_t ms, alarm_callback_t callback, void *user_data, bool fire_if_past);
+alarm_id_t add_alarm_at(absolute_time_t time, alarm_callback_t callback, void *user_data, bool fire_if_past);
+bool cancel_alarm(alarm_id_t alarm_id);
+bool add_repeating_timer_us(int64_t delay_us, repeating_timer_callback_t callback, void *user_data, repeating_timer_t *out);
+bool add_repeating_timer_ms(int32_t delay_ms, repeating_timer_callback_t callback, void *user_data, repeating_timer_t *out);
+bool cancel_repeating_timer(repeating_timer_t *timer);
+
+// AONタイマー
+bool aon_timer_start(const struct timespec *ts);
+bool aon_timer_set_time(const struct timespec *ts);
+bool aon_timer_get_time(struct timespec *ts);
+
+// -------------------------------------------------------------------------
+// [マルチコア]
+// -------------------------------------------------------------------------
+#define NUM_CORES                       2
+
+void multicore_launch_core1(void (*entry)(void));
+void multicore_reset_core1(void);
+void multicore_fifo_push_blocking(uint32_t data);
+bool multicore_fifo_push_timeout_us(uint32_t data, uint64_t timeout_us);
+uint32_t multicore_fifo_pop_blocking(void);
+bool multicore_fifo_pop_timeout_us(uint64_t timeout_us, uint32_t *out);
+bool multicore_fifo_rvalid(void);
+bool multicore_fifo_wready(void);
+void multicore_fifo_drain(void);
+void multicore_lockout_victim_init(void);
+bool multicore_lockout_victim_is_initialized(uint core_num);
+
+// Doorbell(RP2350のSIO) ... 相手コアのSIO_IRQ_BELLを送信側スレッドから即時発火
+#define NUM_DOORBELLS                   8
+#define SIO_IRQ_BELL                    26
+int multicore_doorbell_claim_unused(uint core_mask, bool required);
+void multicore_doorbell_unclaim(uint doorbell_num, uint core_mask);
+void multicore_doorbell_set_other_core(uint doorbell_num);
+void multicore_doorbell_set_current_core(uint doorbell_num);
+void multicore_doorbell_clear_current_core(uint doorbell_num);
+bool multicore_doorbell_is_set_current_core(uint doorbell_num);
+static inline uint multicore_doorbell_irq_num(uint doorbell_num) { (void)doorbell_num; return SIO_IRQ_BELL; }
+
+// -------------------------------------------------------------------------
+// [クロック/WDT]
+// -------------------------------------------------------------------------
+enum clock_index {
+    clk_gpout0 = 0,
+    clk_gpout1,
+    clk_gpout2,
+    clk_gpout3,
+    clk_ref,
+    clk_sys,
+    clk_peri,
+    clk_hstx,
+    clk_usb,
+    clk_adc,
+    CLK_COUNT
+};
+typedef enum clock_index clock_handle_t;
+uint32_t clock_get_hz(enum clock_index clk_index);
+
+void watchdog_enable(uint32_t delay_ms, bool pause_on_debug);
+void watchdog_update(void);
+void watchdog_reboot(uint32_t pc, uint32_t sp, uint32_t delay_ms);
+bool watchdog_caused_reboot(void);
+
+// -------------------------------------------------------------------------
+// [GPIO]
+// -------------------------------------------------------------------------
+#define GPIO_OUT                        1
+#define GPIO_IN                         0
+#define GPIO_IRQ_LEVEL_LOW              0x1u
+#define GPIO_IRQ_LEVEL_HIGH             0x2u
+#define GPIO_IRQ_EDGE_FALL              0x4u
+#define GPIO_IRQ_EDGE_RISE              0x8u
+#define NUM_BANK0_GPIOS                 48
+
+enum gpio_function {
+    GPIO_FUNC_HSTX = 0,
+    GPIO_FUNC_SPI = 1,
+    GPIO_FUNC_UART = 2,
+    GPIO_FUNC_I2C = 3,
+    GPIO_FUNC_PWM = 4,
+    GPIO_FUNC_SIO = 5,
+    GPIO_FUNC_PIO0 = 6,
+    GPIO_FUNC_PIO1 = 7,
+    GPIO_FUNC_PIO2 = 8,
+    GPIO_FUNC_NULL = 0x1f,
+};
+typedef void (*gpio_irq_callback_t)(uint gpio, uint32_t event_mask);
+
+void gpio_init(uint gpio);
+void gpio_set_dir(uint gpio, bool out);
+void gpio_put(uint gpio, bool value);
+bool gpio_get(uint gpio);
+void gpio_set_function(uint gpio, enum gpio_function fn);
+void gpio_pull_up(uint gpio);
+void gpio_pull_down(uint gpio);
+void gpio_set_irq_enabled(uint gpio, uint32_t event_mask, bool enabled);
+void gpio_set_irq_enabled_with_callback(uint gpio, uint32_t event_mask, bool enabled, gpio_irq_callback_t callback);
+void host_gpio_drive_input(uint gpio, bool value);
+
+// -------------------------------------------------------------------------
+// [I2C/SPI/UART/ADC]
+// -------------------------------------------------------------------------
+struct host_periph_inst {
+    uint baudrate;
+};
+typedef struct host_periph_inst i2c_inst_t;
+typedef struct host_periph_inst spi_inst_t;
+typedef struct host_periph_inst uart_inst_t;
+extern i2c_inst_t g_host_i2c[2];
+extern spi_inst_t g_host_spi[2];
+extern uart_inst_t g_host_uart[2];
+#define i2c0    (&g_host_i2c[0])
+#define i2c1    (&g_host_i2c[1])
+#define spi0    (&g_host_spi[0])
+#define spi1    (&g_host_spi[1])
+#define uart0   (&g_host_uart[0])
+#define uart1   (&g_host_uart[1])
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate);
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop);
+uint spi_init(spi_inst_t *spi, uint baudrate);
+uint uart_init(uart_inst_t *uart, uint baudrate);
+void uart_puts(uart_inst_t *uart, const char *s);
+
+void adc_init(void);
+void adc_select_input(uint input);
+void adc_set_temp_sensor_enabled(bool enable);
+uint16_t adc_read(void);
+
+// -------------------------------------------------------------------------
+// [乱数(TRNG)]
+// -------------------------------------------------------------------------
+uint32_t get_rand_32(void);
+uint64_t get_rand_64(void);
+
+// -------------------------------------------------------------------------
+// [XIPストリーム] ... DMAがXIP_AUX_BASEを読むとstream_addrから1語ずつ取り出す
+// -------------------------------------------------------------------------
+#define XIP_AUX_BASE                    0x50500000u
+#define XIP_STAT_FIFO_EMPTY_BITS        0x00000002u
+
+typedef struct {
+    volatile uint32_t ctrl;
+    volatile uint32_t stat;
+    volatile uint32_t ctr_hit;
+    volatile uint32_t ctr_acc;
+    volatile uint32_t stream_addr;
+    volatile uint32_t stream_ctr;
+    volatile uint32_t stream_fifo;
+} xip_ctrl_hw_t;
+extern xip_ctrl_hw_t g_host_xip_ctrl_hw;
+#define xip_ctrl_hw     (&g_host_xip_ctrl_hw)
+
+// -------------------------------------------------------------------------
+// [SHA-256アクセラレータ]
+// -------------------------------------------------------------------------
+enum sha256_endianness {
+    SHA256_LITTLE_ENDIAN,
+    SHA256_BIG_ENDIAN,
+};
+typedef union {
+    uint32_t words[8];
+    uint8_t bytes[32];
+} sha256_result_t;
+
+typedef struct {
+    volatile uint32_t csr;
+    volatile uint32_t wdata;
+    volatile uint32_t sum[8];
+} sha256_hw_t;
+extern sha256_hw_t g_host_sha256_hw;
+#define sha256_hw   (&g_host_sha256_hw)
+
+void sha256_set_dma_size(uint size_in_bytes);
+void sha256_set_bswap(bool swap);
+void sha256_start(void);
+bool sha256_is_sum_valid(void);
+bool sha256_is_ready(void);
+void sha256_wait_ready_blocking(void);
+void sha256_wait_valid_blocking(void);
+void sha256_put_word(uint32_t word);
+void sha256_put_byte(uint8_t b);
+void sha256_get_result(sha256_result_t *out, enum sha256_endianness endianness);
+volatile void *sha256_get_write_addr(void);
+
+// -------------------------------------------------------------------------
+// [DMA] ... 転送は起動時に即時実行(FIFOシンクは時間モデルでビジー期間を表現)
+// -------------------------------------------------------------------------
+#define NUM_DMA_CHANNELS                16
+#define DMA_IRQ_0                       10
+#define DMA_IRQ_1                       11
+
+enum dma_channel_transfer_size {
+    DMA_SIZE_8 = 0,
+    DMA_SIZE_16 = 1,
+    DMA_SIZE_32 = 2
+};
+typedef struct {
+    uint32_t ctrl;
+} dma_channel_config;
+
+#define DREQ_PIO0_TX0                   0
+#define DREQ_PIO1_TX0                   8
+#define DREQ_PIO2_TX0                   16
+#define DREQ_SHA256                     53
+#define DREQ_XIP_STREAM                 55
+#define DREQ_FORCE                      63
+
+int dma_claim_unused_channel(bool required);
+void dma_channel_claim(uint channel);
+void dma_channel_unclaim(uint channel);
+dma_channel_config dma_channel_get_default_config(uint channel);
+void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size size);
+void channel_config_set_read_increment(dma_channel_config *c, bool incr);
+void channel_config_set_write_increment(dma_channel_config *c, bool incr);
+void channel_config_set_dreq(dma_channel_config *c, uint dreq);
+void channel_config_set_chain_to(dma_channel_config *c, uint chain_to);
+void channel_config_set_bswap(dma_channel_config *c, bool bswap);
+void channel_config_set_irq_quiet(dma_channel_config *c, bool irq_quiet);
+void channel_config_set_enable(dma_channel_config *c, bool enable);
+void dma_channel_configure(uint channel, const dma_channel_config *config, volatile void *write_addr,
+                            const volatile void *read_addr, uint transfer_count, bool trigger);
+void dma_channel_set_config(uint channel, const dma_channel_config *config, bool trigger);
+void dma_channel_set_read_addr(uint channel, const volatile void *read_addr, bool trigger);
+void dma_channel_set_write_addr(uint channel, volatile void *write_addr, bool trigger);
+void dma_channel_set_trans_count(uint channel, uint32_t trans_count, bool trigger);
+void dma_channel_transfer_from_buffer_now(uint channel, const volatile void *read_addr, uint32_t transfer_count);
+void dma_channel_start(uint channel);
+bool dma_channel_is_busy(uint channel);
+void dma_channel_wait_for_finish_blocking(uint channel);
+void dma_channel_abort(uint channel);
+void dma_channel_set_irq0_enabled(uint channel, bool enabled);
+bool dma_channel_get_irq0_status(uint channel);
+void dma_channel_acknowledge_irq0(uint channel);
+
+// IRQ
+typedef void (*irq_handler_t)(void);
+void irq_set_exclusive_handler(uint num, irq_handler_t handler);
+void irq_set_enabled(uint num, bool enabled);
+bool irq_is_enabled(uint num);
+void irq_set_priority(uint num, uint8_t hardware_priority);
+
+// -------------------------------------------------------------------------
+// [PIO] ... TX FIFOはプログラムから求めたワード当たりのサイクル数で排出する
+// -------------------------------------------------------------------------
+#define NUM_PIOS                        3
+#define NUM_PIO_STATE_MACHINES          4
+#define PIO_INSTRUCTION_COUNT           32
+
+typedef struct {
+    volatile uint32_t ctrl;
+    volatile uint32_t fstat;
+    volatile uint32_t fdebug;
+    volatile uint32_t flevel;
+    volatile uint32_t txf[NUM_PIO_STATE_MACHINES];
+    volatile uint32_t rxf[NUM_PIO_STATE_MACHINES];
+} pio_hw_t;
+typedef pio_hw_t *PIO;
+extern pio_hw_t g_host_pio[NUM_PIOS];
+#define pio0    (&g_host_pio[0])
+#define pio1    (&g_host_pio[1])
+#define pio2    (&g_host_pio[2])
+
+typedef struct pio_program {
+    const uint16_t *instructions;
+    uint8_t length;
+    int8_t origin;
+    uint8_t pio_version;
+    uint32_t used_gpio_ranges;
+} pio_program_t;
+
+typedef struct {
+    uint32_t clkdiv_x256;       // クロック分周(8.8固定小数点)
+    uint32_t wrap_target;
+    uint32_t wrap;
+    uint32_t sideset_count;
+    bool sideset_optional;
+    bool sideset_pindirs;
+    uint32_t sideset_base;
+    uint32_t out_base;
+    uint32_t out_count;
+    uint32_t set_base;
+    uint32_t set_count;
+    bool out_shift_right;
+    bool autopull;
+    uint32_t pull_threshold;
+    uint32_t fifo_join;
+} pio_sm_config;
+
+enum pio_fifo_join {
+    PIO_FIFO_JOIN_NONE = 0,
+    PIO_FIFO_JOIN_TX = 1,
+    PIO_FIFO_JOIN_RX = 2,
+};
+
+uint pio_add_program(PIO pio, const pio_program_t *program);
+bool pio_can_add_program(PIO pio, const pio_program_t *program);
+void pio_remove_program(PIO pio, const pio_program_t *program, uint loaded_offset);
+bool pio_claim_free_sm_and_add_program_for_gpio_range(const pio_program_t *program, PIO *pio, uint *sm,
+                                                        uint *offset, uint gpio_base, uint gpio_count, bool set_gpio_base);
+void pio_remove_program_and_unclaim_sm(const pio_program_t *program, PIO pio, uint sm, uint offset);
+int pio_claim_unused_sm(PIO pio, bool required);
+void pio_sm_claim(PIO pio, uint sm);
+void pio_sm_unclaim(PIO pio, uint sm);
+void pio_gpio_init(PIO pio, uint pin);
+int pio_sm_set_consecutive_pindirs(PIO pio, uint sm, uint pin_base, uint pin_count, bool is_out);
+pio_sm_config pio_get_default_sm_config(void);
+void sm_config_set_wrap(pio_sm_config *c, uint wrap_target, uint wrap);
+void sm_config_set_sideset(pio_sm_config *c, uint bit_count, bool optional, bool pindirs);
+void sm_config_set_sideset_pins(pio_sm_config *c, uint sideset_base);
+void sm_config_set_out_pins(pio_sm_config *c, uint out_base, uint out_count);
+void sm_config_set_set_pins(pio_sm_config *c, uint set_base, uint set_count);
+void sm_config_set_out_shift(pio_sm_config *c, bool shift_right, bool autopull, uint pull_threshold);
+void sm_config_set_fifo_join(pio_sm_config *c, enum pio_fifo_join join);
+void sm_config_set_clkdiv(pio_sm_config *c, float div);
+int pio_sm_init(PIO pio, uint sm, uint initial_pc, const pio_sm_config *config);
+void pio_sm_set_enabled(PIO pio, uint sm, bool enabled);
+void pio_sm_put(PIO pio, uint sm, uint32_t data);
+void pio_sm_put_blocking(PIO pio, uint sm, uint32_t data);
+bool pio_sm_is_tx_fifo_full(PIO pio, uint sm);
+bool pio_sm_is_tx_fifo_empty(PIO pio, uint sm);
+uint pio_sm_get_tx_fifo_level(PIO pio, uint sm);
+void pio_sm_clear_fifos(PIO pio, uint sm);
+uint pio_get_index(PIO pio);
+uint pio_get_dreq(PIO pio, uint sm, bool is_tx);
+
+// -------------------------------------------------------------------------
+// [Flash] ... XIP_BASEにmmapした疑似Flashを書き換える
+// -------------------------------------------------------------------------
+void flash_range_erase(uint32_t flash_offs, size_t count);
+void flash_range_program(uint32_t flash_offs, const uint8_t *data, size_t count);
+int flash_safe_execute(void (*func)(void *), void *param, uint32_t enter_exit_timeout_ms);
+
+// 補間器(ホストでは未使用)
+typedef struct {
+    uint32_t ctrl;
+} interp_config;
+
+#endif // HOST_SDK_H
@@ -0,0 +1,138 @@
+// neopixel.pio をpioasmでアセンブルした結果のホスト用スタンドイン
+// 命令列はpioasmの出力と同じエンコード(T1=3, T2=3, T3=4)
+#pragma once
+
+#include "hardware/pio.h"
+#include "hardware/clocks.h"
+
+// -------- //
+// neopixel //
+// -------- //
+
+#define neopixel_wrap_target 0
+#define neopixel_wrap 3
+#define neopixel_pio_version 0
+
+#define neopixel_T1 3
+#define neopixel_T2 3
+#define neopixel_T3 4
+
+static const uint16_t neopixel_program_instructions[] = {
+            //     .wrap_target
+    0x6321, //  0: out    x, 1            side 0 [3]
+    0x1223, //  1: jmp    !x, 3           side 1 [2]
+    0x1200, //  2: jmp    0               side 1 [2]
+    0xa242, //  3: nop                    side 0 [2]
+            //     .wrap
+};
+
+static const struct pio_program neopixel_program = {
+    .instructions = neopixel_program_instructions,
+    .length = 4,
+    .origin = -1,
+    .pio_version = neopixel_pio_version,
+    .used_gpio_ranges = 0x0
+};
+
+static inline pio_sm_config neopixel_program_get_default_config(uint offset)
+{
+    pio_sm_config c = pio_get_default_sm_config();
+    sm_config_set_wrap(&c, offset + neopixel_wrap_target, offset + neopixel_wrap);
+    sm_config_set_sideset(&c, 1, false, false);
+    return c;
+}
+
+static inline void pio_neopixel_init(PIO pio, uint sm, uint offset, uint pin, float freq, bool rgbw)
+{
+    pio_gpio_init(pio, pin);
+    pio_sm_set_consecutive_pindirs(pio, sm, pin, 1, true);
+
+    pio_sm_config c = neopixel_program_get_default_config(offset);
+    sm_config_set_sideset_pins(&c, pin);
+    sm_config_set_out_shift(&c, false, true, rgbw ? 32 : 24);
+    sm_config_set_fifo_join(&c, PIO_FIFO_JOIN_TX);
+
+    int cycles_per_bit = neopixel_T1 + neopixel_T2 + neopixel_T3;
+    float div = clock_get_hz(clk_sys) / (freq * cycles_per_bit);
+    sm_config_set_clkdiv(&c, div);
+
+    pio_sm_init(pio, sm, offset, &c);
+    pio_sm_set_enabled(pio, sm, true);
+}
+
+// 詰めたGRBのバイト列をDMA(8bit)で送る版 ... 自動プル8bit、左シフト
+// DMAの8bit書き込みはFIFOの32bitの全バイトレーンに複製されるので、上位8bitから1バイト分を出す
+static inline void pio_neopixel_packed_init(PIO pio, uint sm, uint offset, uint pin, float freq)
+{
+    pio_gpio_init(pio, pin);
+    pio_sm_set_consecutive_pindirs(pio, sm, pin, 1, true);
+
+    pio_sm_config c = neopixel_program_get_default_config(offset);
+    sm_config_set_sideset_pins(&c, pin);
+    sm_config_set_out_shift(&c, false, true, 8);
+    sm_config_set_fifo_join(&c, PIO_FIFO_JOIN_TX);
+
+    int cycles_per_bit = neopixel_T1 + neopixel_T2 + neopixel_T3;
+    float div = clock_get_hz(clk_sys) / (freq * cycles_per_bit);
+    sm_config_set_clkdiv(&c, div);
+
+    pio_sm_init(pio, sm, offset, &c);
+    pio_sm_set_enabled(pio, sm, true);
+}
+
+// ----------------- //
+// neopixel_parallel //
+// ----------------- //
+
+#define neopixel_parallel_wrap_target 0
+#define neopixel_parallel_wrap 3
+#define neopixel_parallel_pio_version 0
+
+#define neopixel_parallel_T1 3
+#define neopixel_parallel_T2 3
+#define neopixel_parallel_T3 4
+
+static const uint16_t neopixel_parallel_program_instructions[] = {
+            //     .wrap_target
+    0x6020, //  0: out    x, 32
+    0xa20b, //  1: mov    pins, ~null            [2]
+    0xa201, //  2: mov    pins, x                [2]
+    0xa203, //  3: mov    pins, null             [2]
+            //     .wrap
+};
+
+static const struct pio_program neopixel_parallel_program = {
+    .instructions = neopixel_parallel_program_instructions,
+    .length = 4,
+    .origin = -1,
+    .pio_version = neopixel_parallel_pio_version,
+    .used_gpio_ranges = 0x0
+};
+
+static inline pio_sm_config neopixel_parallel_program_get_default_config(uint offset)
+{
+    pio_sm_config c = pio_get_default_sm_config();
+    sm_config_set_wrap(&c, offset + neopixel_parallel_wrap_target, offset + neopixel_parallel_wrap);
+    return c;
+}
+
+static inline void pio_neopixel_parallel_init(PIO pio, uint sm, uint offset, uint pin_base, uint pin_count, float freq)
+{
+    for(uint i=pin_base; i<pin_base+pin_count; i++)
+    {
+        pio_gpio_init(pio, i);
+    }
+    pio_sm_set_consecutive_pindirs(pio, sm, pin_base, pin_count, true);
+
+    pio_sm_config c = neopixel_parallel_program_get_default_config(offset);
+    sm_config_set_out_shift(&c, true, true, 32);
+    sm_config_set_out_pins(&c, pin_base, pin_count);
+    sm_config_set_fifo_join(&c, PIO_FIFO_JOIN_TX);
+
+    int cycles_per_bit = neopixel_parallel_T1 + neopixel_parallel_T2 + neopixel_parallel_T3;
+    float div = clock_get_hz(clk_sys) / (freq * cycles_per_bit);
+    sm_config_set_clkdiv(&c, div);
+
+    pio_sm_init(pio, sm, offset, &c);
+    pio_sm_set_enabled(pio, sm, true);
+}
@@ -0,0 +1,5 @@
+// Pico SDK pico/aon_timer.h のホスト用スタンドイン
+#ifndef HOST_PICO_AON_TIMER_H
+#define HOST_PICO_AON_TIMER_H
+#include "host_sdk.h"
+#endif // HOST_PICO_AON_TIMER_H
@@ -0,0 +1,5 @@
+// Pico SDK pico/flash.h のホスト用スタンドイン
+#ifndef HOST_PICO_FLASH_H
+#define HOST_PICO_FLASH_H
+#include "host_sdk.h"
+#endif // HOST_PICO_FLASH_H
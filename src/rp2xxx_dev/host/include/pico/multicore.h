@@ -0,0 +1,5 @@
+// Pico SDK pico/multicore.h のホスト用スタンドイン
+#ifndef HOST_PICO_MULTICORE_H
+#define HOST_PICO_MULTICORE_H
+#include "host_sdk.h"
+#endif // HOST_PICO_MULTICORE_H
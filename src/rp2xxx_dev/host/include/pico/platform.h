@@ -0,0 +1,5 @@
+// Pico SDK pico/platform.h のホスト用スタンドイン
+#ifndef HOST_PICO_PLATFORM_H
+#define HOST_PICO_PLATFORM_H
+#include "host_sdk.h"
+#endif // HOST_PICO_PLATFORM_H
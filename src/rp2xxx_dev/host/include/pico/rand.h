@@ -0,0 +1,5 @@
+// Pico SDK pico/rand.h のホスト用スタンドイン
+#ifndef HOST_PICO_RAND_H
+#define HOST_PICO_RAND_H
+#include "host_sdk.h"
+#endif // HOST_PICO_RAND_H
@@ -0,0 +1,5 @@
+// Pico SDK pico/stdio.h のホスト用スタンドイン
+#ifndef HOST_PICO_STDIO_H
+#define HOST_PICO_STDIO_H
+#include "host_sdk.h"
+#endif // HOST_PICO_STDIO_H
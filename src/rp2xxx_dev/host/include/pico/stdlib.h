@@ -0,0 +1,5 @@
+// Pico SDK pico/stdlib.h のホスト用スタンドイン
+#ifndef HOST_PICO_STDLIB_H
+#define HOST_PICO_STDLIB_H
+#include "host_sdk.h"
+#endif // HOST_PICO_STDLIB_H
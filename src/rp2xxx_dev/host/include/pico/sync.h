@@ -0,0 +1,5 @@
+// Pico SDK pico/sync.h のホスト用スタンドイン
+#ifndef HOST_PICO_SYNC_H
+#define HOST_PICO_SYNC_H
+#include "host_sdk.h"
+#endif // HOST_PICO_SYNC_H
@@ -0,0 +1,5 @@
+// Pico SDK pico/time.h のホスト用スタンドイン
+#ifndef HOST_PICO_TIME_H
+#define HOST_PICO_TIME_H
+#include "host_sdk.h"
+#endif // HOST_PICO_TIME_H
@@ -0,0 +1,5 @@
+// Pico SDK pico/version.h のホスト用スタンドイン
+#ifndef HOST_PICO_VERSION_H
+#define HOST_PICO_VERSION_H
+#include "host_sdk.h"
+#endif // HOST_PICO_VERSION_H
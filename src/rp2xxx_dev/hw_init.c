@@ -10,6 +10,9 @@
  */
 #include "muc_rpxxx_util.h"
 #include "app_main.h"
+#include "drv_debounce.h"
+#include "app_rtos.h"
+#include "app_load.h"
 
 #include "pico/multicore.h"
 #include "hardware/adc.h"
@@ -72,28 +75,27 @@ void blink_pin_forever(PIO pio, uint sm, uint offset, uint pin, uint freq)
 #endif
 
 #if defined(PCB_BTN_PIN)
-/**
- * @brief 基板ボタン外部割り込みハンドラ
- * 
- * @param gpio 
- * @param event_mask 
- */
-void btn_ex_irq_handler(uint gpio, uint32_t event_mask)
+// 基板ボタンの確定イベント(Core0のイベントループ)
+static void btn_event_handler(int32_t id, bool level, uint32_t edge_us)
 {
-    // 割り込みマスク
-    gpio_set_irq_enabled(PCB_BTN_PIN, GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, false);
+    (void)id;
+    (void)edge_us;
 
-    // チャタリング除去(@30ms待機)
-    sleep_ms(30);
-
-    if (gpio_get(PCB_BTN_PIN) != PORT_OFF) {
+    if (level != PORT_OFF) {
         printf("[Core%d] Button OFF!\n", s_core_num);
     } else {
         printf("[Core%d] Button ON!\n", s_core_num);
     }
+}
 
-    // 割り込み有効
-    gpio_set_irq_enabled(PCB_BTN_PIN, GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, true);
+/**
+ * @brief 基板ボタンをチャタリング除去に登録して外部割り込みを有効化(Core0)
+ * 
+ */
+void hw_btn_event_init(void)
+{
+    // 安定待ち30ms(ISRでは待たず、エッジ割り込み + アラームで確定)
+    drv_debounce_add("btn", PCB_BTN_PIN, DEBOUNCE_DEFAULT_US, DEBOUNCE_PULL_NONE, btn_event_handler);
 }
 #endif
 
@@ -136,13 +138,7 @@ static void hw_gpio_init(void)
 #if defined(PCB_BTN_PIN)
     gpio_init(PCB_BTN_PIN);
     gpio_set_dir(PCB_BTN_PIN, GPIO_IN);
-
-    // 外部割り込み
-    gpio_set_irq_enabled_with_callback(PCB_BTN_PIN,   // GPIOピン
-                                        GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, // 立ち上がり or 立ち下がりエッジでIRQ
-                                        true,              // 割り込み 有効 / 無効
-                                        &btn_ex_irq_handler // 割り込みハンドラ
-                                        );
+    // 外部割り込みはCore0のイベントループ起動時に有効化(hw_btn_event_init())
 #endif
 }
 
@@ -392,9 +388,17 @@ int main()
 
     s_core_num = get_core_num();
 
+    // スタックを塗って負荷のサンプリング開始(Core1の起動前)
+    app_load_init();
+
+#if defined(RP2XXX_USE_FREERTOS)
+    // FreeRTOS SMP(Core1の起動はスケジューラが行う)
+    app_rtos_start();
+#else
     // CPU Core1を起動
     multicore_launch_core1(core_1_main);
 
     // CPU Core0 アプリメイン
     core_0_main();
+#endif
 }
\ No newline at end of file
@@ -10,8 +10,10 @@
  */
 #include "muc_rpxxx_util.h"
 #include "pcb_def.h"
+#include "app_rtos.h"
 
 #include "hardware/adc.h"
+#include "hardware/flash.h"
 
 #if defined(MCU_RP2040)
 const char *p_cpu_name_str = "M0PLUS";
@@ -192,7 +194,100 @@ uint32_t get_multicore_fifo(void)
 
 void set_multicore_fifo(uint32_t data)
 {
+#if defined(RP2XXX_USE_FREERTOS)
+    // SMPポートがFIFOを使うのでCore0のI/Oタスクのキューへ
+    app_rtos_post(data);
+#else
     multicore_fifo_push_blocking(data);
+#endif
+}
+
+/**
+ * @brief CPUサイクルカウンタ(DWT CYCCNT)の有効化
+ * @note 各コアのDWTは独立なので両コアで呼ぶこと
+ */
+void rp2xxx_cycle_cnt_init(void)
+{
+#if defined(MCU_RP2350) && PICO_ON_DEVICE
+    REG_WRITE_DWORD(DWT_DEMCR_ADDR, 0, REG_READ_DWORD(DWT_DEMCR_ADDR, 0) | DWT_DEMCR_TRCENA);
+    REG_WRITE_DWORD(DWT_CYCCNT_ADDR, 0, 0);
+    REG_WRITE_DWORD(DWT_CTRL_ADDR, 0, REG_READ_DWORD(DWT_CTRL_ADDR, 0) | DWT_CTRL_CYCCNTENA);
+#endif
+}
+
+// Flash書き込み中の相手コア待機フラグ
+static volatile bool s_is_flash_parked = false;
+static volatile bool s_is_flash_release = false;
+
+/**
+ * @brief Flash書き込みが終わるまでRAM上で待機(Core0がPROC_FLASH_PARKで呼ぶ)
+ * @note SDKのmulticore_lockoutはFIFOを読み捨てるのでアプリのFIFOコードと共存できない
+ */
+void __not_in_flash_func(rp2xxx_flash_park)(void)
+{
+    uint32_t irq;
+
+    irq = save_and_disable_interrupts();
+    s_is_flash_parked = true;
+    __mem_fence_release();
+    while (!s_is_flash_release) {
+        tight_loop_contents();
+    }
+    s_is_flash_release = false;
+    s_is_flash_parked = false;
+    __mem_fence_release();
+    restore_interrupts(irq);
+}
+
+/**
+ * @brief Flashへの書き込み(セクタ消去 + ページ書き込み)
+ * 
+ * @param flash_offs Flash先頭からのオフセット(セクタ境界)
+ * @param p_data 書き込みデータ(長さはFLASH_PAGE_SIZEの倍数に切り上げて書く)
+ * @param len 書き込みバイト数
+ * @return true 成功
+ * @return false 引数エラー or 相手コアが待機しない
+ */
+bool rp2xxx_flash_write(uint32_t flash_offs, const uint8_t *p_data, size_t len)
+{
+    uint32_t irq;
+    uint32_t erase_len, prog_len;
+    uint64_t timeout;
+
+    if ((flash_offs % FLASH_SECTOR_SIZE) != 0 || len == 0 ||
+        (flash_offs + len) > PICO_FLASH_SIZE_BYTES) {
+        return false;
+    }
+
+    erase_len = ((len + FLASH_SECTOR_SIZE - 1) / FLASH_SECTOR_SIZE) * FLASH_SECTOR_SIZE;
+    prog_len = ((len + FLASH_PAGE_SIZE - 1) / FLASH_PAGE_SIZE) * FLASH_PAGE_SIZE;
+
+    // 相手コアをRAM上で待機させる(XIPが止まるため)
+    set_multicore_fifo(PROC_FLASH_PARK);
+    s_is_flash_release = false;
+    timeout = time_us_64() + 1000000;
+    while (!s_is_flash_parked) {
+        if (time_us_64() > timeout) {
+            // 後から待機に入っても即抜けるように解放しておく
+            s_is_flash_release = true;
+            return false;
+        }
+        tight_loop_contents();
+    }
+    __mem_fence_acquire();
+
+    irq = save_and_disable_interrupts();
+    flash_range_erase(flash_offs, erase_len);
+    flash_range_program(flash_offs, p_data, prog_len);
+    restore_interrupts(irq);
+
+    s_is_flash_release = true;
+    __mem_fence_release();
+    while (s_is_flash_parked) {
+        tight_loop_contents();
+    }
+
+    return true;
 }
 
 /**
@@ -38,15 +38,23 @@
 
 #define CORE_1_WUP_RESULT_DATA     0x12345678
 #define MULTI_CORE_TEST_DATA       0x97654321
-#define PROC_NEOPIXEL_FADE         0x00000123
+#define PROC_NEOPIXEL_FX           0x00000123   // NeoPixelのエフェクトの開始/停止/周期の変更
+#define PROC_FLASH_PARK            0x00000F1A   // Flash書き込み中はRAM上で待機
+#define PROC_JOB_RUN               0x00000B60   // 待ちジョブを実行
+#define PROC_IPC_SERVER            0x00000C0C   // コア間メッセージキューの応答側を実行
+#define PROC_TASK_RUN              0x00007A5C   // タスクスケジューラのワーカーを実行
+#define PROC_MCT_SERVER            0x00000AC7   // コア間通信ベンチマークの応答側を実行
+#define PROC_LOCK_SERVER           0x0000010C   // ロックのベンチマーク/自己テストの相手を実行
+#define PROC_DEBOUNCE_ARM          0x00000DEB   // 追加された入力のエッジ割り込みをCore0で有効化
+#define PROC_SHA_RUN               0x000005A2   // SHA-256の2コア分割の後半を実行
 
 // レジスタを8/16/32bitでR/Wするマクロ
-#define REG_READ_BYTE(base, offset)         (*(volatile uint8_t  *)((base) + (offset)))
-#define REG_READ_WORD(base, offset)         (*(volatile uint16_t *)((base) + (offset)))
-#define REG_READ_DWORD(base, offset)        (*(volatile uint32_t *)((base) + (offset)))
-#define REG_WRITE_BYTE(base, offset, val)   (*(volatile uint8_t  *)((base) + (offset)) = (val))
-#define REG_WRITE_WORD(base, offset, val)   (*(volatile uint16_t *)((base) + (offset)) = (val))
-#define REG_WRITE_DWORD(base, offset, val)  (*(volatile uint32_t *)((base) + (offset)) = (val))
+#define REG_READ_BYTE(base, offset)         (*(volatile uint8_t  *)(uintptr_t)((base) + (offset)))
+#define REG_READ_WORD(base, offset)         (*(volatile uint16_t *)(uintptr_t)((base) + (offset)))
+#define REG_READ_DWORD(base, offset)        (*(volatile uint32_t *)(uintptr_t)((base) + (offset)))
+#define REG_WRITE_BYTE(base, offset, val)   (*(volatile uint8_t  *)(uintptr_t)((base) + (offset)) = (val))
+#define REG_WRITE_WORD(base, offset, val)   (*(volatile uint16_t *)(uintptr_t)((base) + (offset)) = (val))
+#define REG_WRITE_DWORD(base, offset, val)  (*(volatile uint32_t *)(uintptr_t)((base) + (offset)) = (val))
 
 // レジスタビット操作
 #define REG_BIT_SET(reg, bit)               ((reg) |=  (1UL << (bit))) // レジスタのビットをセット
@@ -63,13 +71,17 @@ __attribute__( ( always_inline ) ) static inline void NOP(void)
  // 割り込み禁止
 __attribute__( ( always_inline ) ) static inline void _DI(void)
 {
+#if PICO_ON_DEVICE
     __asm__ __volatile__("cpsid i");
+#endif
 }
 
 // 割り込み許可
 __attribute__( ( always_inline ) ) static inline void _EI(void)
 {
+#if PICO_ON_DEVICE
     __asm__ __volatile__("cpsie i");
+#endif
 }
 
 // WDTをなでるマクロ
@@ -82,6 +94,24 @@ static inline void WDT_RST(void)
 #endif // _WDT_ENABLE_
 }
 
+// DWT(サイクルカウンタ) ※Cortex-M33のみ
+#define DWT_DEMCR_ADDR             0xE000EDFC
+#define DWT_CTRL_ADDR              0xE0001000
+#define DWT_CYCCNT_ADDR            0xE0001004
+#define DWT_DEMCR_TRCENA           (1UL << 24)
+#define DWT_CTRL_CYCCNTENA         (1UL << 0)
+
+// CPUサイクル数を取得(32bitでラップ)
+static inline uint32_t rp2xxx_get_cycle_cnt(void)
+{
+#if defined(MCU_RP2350) && PICO_ON_DEVICE
+    return REG_READ_DWORD(DWT_CYCCNT_ADDR, 0);
+#else
+    // RP2040(Cortex-M0+)はDWTのサイクルカウンタが無いのでタイマーから換算
+    return (uint32_t)(time_us_64() * (clock_get_hz(clk_sys) / 1000000));
+#endif
+}
+
 #if defined(MCU_RP2350)
 bool aon_set_time_from_string(const char *p_datetime_str);
 void aon_current_time_print(void);
@@ -100,5 +130,8 @@ uint8_t rp2xxx_get_chip_package(void);
 void rp2xxx_chip_package_print(void);
 void rp2xxx_chip_rev_print(void);
 void rp2xxx_reg_info(void);
+void rp2xxx_cycle_cnt_init(void);
+void rp2xxx_flash_park(void);
+bool rp2xxx_flash_write(uint32_t flash_offs, const uint8_t *p_data, size_t len);
 
 #endif // MCU_RP2XXX_UTIL_H
\ No newline at end of file
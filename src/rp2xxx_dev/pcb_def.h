@@ -101,6 +101,10 @@
     #define PCB_BTN_PIN           23                          // 基板のボタンピン
 #endif //PCB_WEACT_RP2350A_V10
 
+#if defined(PCB_BTN_PIN)
+    void hw_btn_event_init(void);
+#endif
+
 #if defined(PCB_RP2350_PIZERO)
     // USB
     #define PIO_USB_DP_PIN        28                          // RP2350-PiZeroのPIOUSBのD+ピン
@@ -172,6 +176,14 @@
 #endif
 #endif //PCB_NEOPIXEL
 
+// [NeoPixel 複数ストリップ並列出力]
+#define PCB_NEOPIXEL_MULTI
+#ifdef PCB_NEOPIXEL_MULTI
+    #define PCB_NEOPIXEL_MULTI_PIN_BASE     2   // ストリップ0のデータピン(以降のストリップは連続したピン)
+    #define NEOPIXEL_MULTI_STRIP_CNT        2   // ストリップの数(GPIO2, GPIO3)
+    #define NEOPIXEL_MULTI_LED_CNT          8   // 1ストリップのNeoPixelの数
+#endif //PCB_NEOPIXEL_MULTI
+
 // [タイマ関連]
 // #define TIMER_ALARM_IRQ_ENABLE
 